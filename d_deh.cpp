@@ -0,0 +1,251 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      DeHackEd thing changes
+//
+//      Only the parts of a patch which decide how things are counted are
+//      read: the DoomEd number and Bits of each Thing block, and its name.
+//      Everything else, including BEX sections, is skipped.
+//
+//-----------------------------------------------------------------------------
+
+#include "z_zone.h"
+#include "d_deh.h"
+#include "d_dehtbl.h"
+#include "d_dwfile.h"
+#include "i_system.h"
+#include "m_collection.h"
+#include "m_ctype.h"
+#include "p_thingtypes.h"
+#include "w_wad.h"
+
+// Longest line read from a patch
+#define DEH_MAXLINE 1024
+
+// Changes from -deh files, applied before those of each archive
+static PODCollection<dehthing_t> filethings;
+
+// Changes in use for the current archive
+static PODCollection<dehthing_t> dehthings;
+
+//
+// Remove leading and trailing whitespace from a line, in place.
+//
+static char *D_trimLine(char *line)
+{
+   while(ectype::isSpace(*line))
+      ++line;
+
+   char *end = line + strlen(line);
+   while(end != line && ectype::isSpace(end[-1]))
+      *--end = '\0';
+
+   return line;
+}
+
+//
+// Find the changes to a mobjinfo entry, adding them if there are none yet.
+// Returns their index.
+//
+static size_t D_thingForNum(PODCollection<dehthing_t> &things, int mobjnum)
+{
+   size_t num = things.getLength();
+
+   for(size_t i = 0; i < num; i++)
+   {
+      if(things[i].mobjnum == mobjnum)
+         return i;
+   }
+
+   dehthing_t &dt = things.addNew();
+   memset(&dt, 0, sizeof(dt));
+   dt.mobjnum = mobjnum;
+   return num;
+}
+
+//
+// Parse a block header line. Returns the index of the thing a Thing header
+// selects, or -1 for any other block. The text of a Text block is skipped.
+//
+static int D_parseHeader(DWFILE &file, PODCollection<dehthing_t> &things,
+                         const char *line)
+{
+   int mobjnum, oldlen, newlen;
+
+   if(!strncasecmp(line, "Thing", 5) && sscanf(line + 5, "%d", &mobjnum) == 1)
+   {
+      int idx = static_cast<int>(D_thingForNum(things, mobjnum));
+      const char *lparen, *rparen;
+
+      // the name is in parentheses after the number
+      if((lparen = strchr(line, '(')) && (rparen = strchr(lparen, ')')))
+      {
+         size_t len = rparen - lparen - 1;
+         if(len >= sizeof(things[idx].name))
+            len = sizeof(things[idx].name) - 1;
+         memcpy(things[idx].name, lparen + 1, len);
+         things[idx].name[len] = '\0';
+      }
+      return idx;
+   }
+
+   if(!strncasecmp(line, "Text", 4) &&
+      sscanf(line + 4, "%d %d", &oldlen, &newlen) == 2)
+   {
+      // old and new text follow, and may contain anything
+      for(int i = 0; i < oldlen + newlen; i++)
+      {
+         if(file.getChar() == EOF)
+            break;
+      }
+   }
+
+   return -1;
+}
+
+//
+// Parse an assignment in a Thing block.
+//
+static void D_parseThingValue(dehthing_t &dt, const char *key, const char *value)
+{
+   if(!strcasecmp(key, "ID #"))
+   {
+      dt.fields   |= DEH_THING_ID;
+      dt.doomednum = atoi(value);
+   }
+   else if(!strcasecmp(key, "Bits"))
+   {
+      // a number, or BEX mnemonics
+      dt.fields |= DEH_THING_BITS;
+      if(ectype::isDigit(*value) || *value == '-')
+         dt.bits = static_cast<unsigned int>(strtol(value, NULL, 0));
+      else
+         dt.bits = deh_ParseFlagsSingle(value, DEHFLAGS_MODE1);
+   }
+}
+
+//
+// Read the thing changes of an open patch. Later changes to the same thing
+// replace earlier ones.
+//
+static void D_parsePatch(DWFILE &file, PODCollection<dehthing_t> &things)
+{
+   char buf[DEH_MAXLINE];
+   int  thing = -1; // index of the thing whose block is being read
+
+   while(file.getStr(buf, sizeof(buf)))
+   {
+      char *line = D_trimLine(buf);
+      char *equals;
+
+      if(!*line || *line == '#')
+         continue;
+
+      if(*line == '[')
+      {
+         // a BEX section ends the block
+         thing = -1;
+      }
+      else if(!(equals = strchr(line, '=')))
+         thing = D_parseHeader(file, things, line);
+      else if(thing >= 0)
+      {
+         *equals = '\0';
+         D_parseThingValue(things[thing], D_trimLine(line), D_trimLine(equals + 1));
+      }
+   }
+}
+
+//
+// Read the thing changes of a patch file given with -deh. They apply to
+// every archive.
+//
+void D_ParseDEHFile(const char *filename)
+{
+   DWFILE file;
+
+   file.openFile(filename, "rt");
+   if(!file.isOpen())
+      I_Error("Could not open DeHackEd file '%s'\n", filename);
+
+   D_parsePatch(file, filethings);
+}
+
+//
+// Set up the thingtypes for an archive: the changes of any -deh files, then
+// those of each DEHACKED lump in the archive, in order, unless uselumps is
+// false.
+//
+void D_ApplyDEH(WadDirectory &dir, bool uselumps)
+{
+   dehthings.makeEmpty();
+   for(const dehthing_t &dt : filethings)
+      dehthings.add(dt);
+
+   if(uselumps)
+   {
+      uint64_t key      = WadDirectory::LumpNameKey("DEHACKED");
+      int      numlumps = dir.getNumLumps();
+
+      for(int i = 0; i < numlumps; i++)
+      {
+         if(dir.getLumpKey(i) != key)
+            continue;
+
+         DWFILE file;
+         file.openLump(dir, i);
+         if(file.isOpen())
+            D_parsePatch(file, dehthings);
+      }
+   }
+
+   P_SetDEHThings(dehthings.getLength() ? &dehthings[0] : NULL,
+                  dehthings.getLength());
+}
+
+//
+// Whether an archive has any DEHACKED lumps.
+//
+bool D_HasDEHLumps(WadDirectory &dir)
+{
+   uint64_t key      = WadDirectory::LumpNameKey("DEHACKED");
+   int      numlumps = dir.getNumLumps();
+
+   for(int i = 0; i < numlumps; i++)
+   {
+      if(dir.getLumpKey(i) == key)
+         return true;
+   }
+
+   return false;
+}
+
+//
+// Whether D_ApplyDEH would change the thingtypes for an archive: there are
+// -deh files, or DEHACKED lumps that are to be used.
+//
+bool D_ChangesThingTypes(WadDirectory &dir, bool uselumps)
+{
+   return filethings.getLength() || (uselumps && D_HasDEHLumps(dir));
+}
+
+// EOF
+
@@ -0,0 +1,58 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      DeHackEd thing changes
+//
+//-----------------------------------------------------------------------------
+
+#ifndef D_DEH_H__
+#define D_DEH_H__
+
+class WadDirectory;
+
+// Fields of a thing a DeHackEd patch has changed
+enum
+{
+   DEH_THING_ID   = 0x01, // "ID #", the DoomEd number
+   DEH_THING_BITS = 0x02  // "Bits"
+};
+
+//
+// The changes to one mobjinfo entry which matter for counting
+//
+struct dehthing_t
+{
+   int          mobjnum;   // DeHackEd thing number, from 1
+   int          fields;    // DEH_THING_* flags
+   int          doomednum;
+   unsigned int bits;
+   char         name[32];  // from the Thing header, if given
+};
+
+void D_ParseDEHFile(const char *filename);
+void D_ApplyDEH(WadDirectory &dir, bool uselumps);
+bool D_HasDEHLumps(WadDirectory &dir);
+bool D_ChangesThingTypes(WadDirectory &dir, bool uselumps);
+
+#endif
+
+// EOF
+
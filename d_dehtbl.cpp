@@ -35,6 +35,7 @@
 #include "doomtype.h"
 #include "m_argv.h"
 #include "m_fixed.h"
+#include "m_qstr.h"
 
 //
 // Shared Hash functions
@@ -89,6 +90,139 @@ unsigned int D_HashTableKeyCase(const char *str)
    return h;
 }
 
+//
+// Thing Tables
+//
+
+//
+// BEX mnemonics for mobjinfo Bits
+//
+dehflags_t deh_mobjflags[] =
+{
+   { "SPECIAL",      0x00000001, 0 }, // call P_Specialthing when touched
+   { "SOLID",        0x00000002, 0 }, // block movement
+   { "SHOOTABLE",    0x00000004, 0 }, // can be hit
+   { "NOSECTOR",     0x00000008, 0 }, // invisible but touchable
+   { "NOBLOCKMAP",   0x00000010, 0 }, // inert but displayable
+   { "AMBUSH",       0x00000020, 0 }, // deaf monster
+   { "JUSTHIT",      0x00000040, 0 }, // will try to attack right back
+   { "JUSTATTACKED", 0x00000080, 0 }, // take at least one step before attacking
+   { "SPAWNCEILING", 0x00000100, 0 }, // initially hang from ceiling
+   { "NOGRAVITY",    0x00000200, 0 }, // don't apply gravity
+   { "DROPOFF",      0x00000400, 0 }, // can jump from high places
+   { "PICKUP",       0x00000800, 0 }, // will pick up items
+   { "NOCLIP",       0x00001000, 0 }, // goes through walls
+   { "SLIDE",        0x00002000, 0 }, // keep info about sliding along walls
+   { "FLOAT",        0x00004000, 0 }, // allow movement to any height
+   { "TELEPORT",     0x00008000, 0 }, // don't cross lines or look at heights
+   { "MISSILE",      0x00010000, 0 }, // don't hit same species, explode on block
+   { "DROPPED",      0x00020000, 0 }, // dropped, not spawned (like ammo clip)
+   { "SHADOW",       0x00040000, 0 }, // use fuzzy draw like spectres
+   { "NOBLOOD",      0x00080000, 0 }, // puffs instead of blood when shot
+   { "CORPSE",       0x00100000, 0 }, // so it will slide down steps when dead
+   { "INFLOAT",      0x00200000, 0 }, // float but not to target height
+   { "COUNTKILL",    0x00400000, 0 }, // count toward the kills total
+   { "COUNTITEM",    0x00800000, 0 }, // count toward the items total
+   { "SKULLFLY",     0x01000000, 0 }, // special handling for flying skulls
+   { "NOTDMATCH",    0x02000000, 0 }, // do not spawn in deathmatch
+   { "TRANSLATION",  0x0c000000, 0 }, // BOOM: both translation bits
+   { "TRANSLATION1", 0x04000000, 0 }, // player sprite translation
+   { "TRANSLATION2", 0x08000000, 0 },
+   { "UNUSED1",      0x08000000, 0 },
+   { "UNUSED2",      0x10000000, 0 },
+   { "UNUSED3",      0x20000000, 0 },
+   { "UNUSED4",      0x40000000, 0 },
+   { "TOUCHY",       0x10000000, 0 }, // MBF: dies on contact with solid objects
+   { "BOUNCES",      0x20000000, 0 }, // MBF: bounces off floors and walls
+   { "FRIEND",       0x40000000, 0 }, // MBF: a friend of the player
+   { "TRANSLUCENT",  0x80000000, 0 }, // BOOM: apply translucency
+   { NULL,           0,          0 }
+};
+
+//
+// DoomEd numbers of the mobjinfo entries, in DeHackEd thing order
+//
+const int deh_mobjdoomednums[] =
+{
+   // 1 - 10: player, monsters, and their missiles
+   -1, 3004, 9, 64, -1, 66, -1, -1, 67, -1,
+   // 11 - 20
+   65, 3001, 3002, 58, 3005, 3003, -1, 69, 3006, 7,
+   // 21 - 30
+   68, 16, 71, 84, 72, 88, 89, 87, -1, -1,
+   // 31 - 40: barrel, missiles, and effects
+   2035, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+   // 41 - 50: pickups begin at 44
+   -1, 14, -1, 2018, 2019, 2014, 2015, 5, 13, 6,
+   // 51 - 60
+   39, 38, 40, 2011, 2012, 2013, 2022, 2023, 2024, 2025,
+   // 61 - 70
+   2026, 2045, 83, 2007, 2048, 2010, 2046, 2047, 17, 2008,
+   // 71 - 80: shell box, backpack, BFG9000 (MT_MISC25), chaingun, chainsaw,
+   // rocket launcher, plasma gun, shotgun, super shotgun; decorations at 80
+   2049, 8, 2006, 2002, 2005, 2003, 2004, 2001, 82, 85,
+   // 81 - 90
+   86, 2028, 30, 31, 32, 33, 37, 36, 41, 42,
+   // 91 - 100
+   43, 44, 45, 46, 55, 56, 57, 47, 48, 34,
+   // 101 - 110
+   35, 49, 50, 51, 52, 53, 59, 60, 61, 62,
+   // 111 - 120
+   63, 22, 15, 18, 21, 23, 20, 19, 10, 12,
+   // 121 - 130
+   28, 24, 27, 29, 25, 26, 54, 70, 73, 74,
+   // 131 - 137
+   75, 76, 77, 78, 79, 80, 81,
+   // 138 - 139: BOOM point pusher and puller
+   5001, 5002,
+   // 140 - 144: MBF dog, beta plasma, sceptre, and bible
+   888, -1, -1, 2016, 2017
+};
+
+const int deh_nummobjinfo = earrlen(deh_mobjdoomednums);
+
+//
+// deh_ParseFlagsSingle
+//
+// Parse BEX flag mnemonics separated by spaces, commas, plus signs or bars,
+// and return their combined value. Unknown mnemonics are ignored. Only mode
+// DEHFLAGS_MODE1, mobjinfo Bits, is supported.
+//
+unsigned int deh_ParseFlagsSingle(const char *strval, int mode)
+{
+   unsigned int results = 0;
+   qstring      buffer(strval);
+   char        *rover = buffer.getBuffer();
+
+   if(mode != DEHFLAGS_MODE1)
+      return 0;
+
+   while(*rover)
+   {
+      while(*rover && strchr(" \t\r\n,+|", *rover))
+         ++rover;
+      if(!*rover)
+         break;
+
+      char *name = rover;
+      while(*rover && !strchr(" \t\r\n,+|", *rover))
+         ++rover;
+      if(*rover)
+         *rover++ = '\0';
+
+      for(dehflags_t *flag = deh_mobjflags; flag->name; flag++)
+      {
+         if(!strcasecmp(flag->name, name))
+         {
+            results |= flag->value;
+            break;
+         }
+      }
+   }
+
+   return results;
+}
+
 // EOF
 
 
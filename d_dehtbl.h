@@ -88,6 +88,17 @@ struct dehflagset_t
    unsigned int results[MAXFLAGFIELDS];
 };
 
+extern dehflags_t deh_mobjflags[];
+
+// Flags of mobjinfo Bits which decide how a thing is classified
+#define DEH_MF_SHOOTABLE 0x00000004
+#define DEH_MF_COUNTKILL 0x00400000
+
+// DoomEd number of each Doom mobjinfo entry, from DeHackEd thing number 1,
+// or -1 if it cannot be placed in a map. Includes the BOOM and MBF additions.
+extern const int deh_mobjdoomednums[];
+extern const int deh_nummobjinfo;
+
 void          deh_ParseFlags(dehflagset_t *dehflags, char **strval);
 unsigned int  deh_ParseFlagsSingle(const char *strval, int mode);
 unsigned int *deh_ParseFlagsCombined(const char *strval);
@@ -39,6 +39,8 @@
 
 #include "doomtype.h"
 
+class WadDirectory;
+
 //
 // DWFILE
 //
@@ -64,7 +66,7 @@ public:
    int    getChar();
    int    unGetChar(int c);
    void   openFile(const char *filename, const char *mode);
-   void   openLump(int p_lumpnum);
+   void   openLump(WadDirectory &dir, int p_lumpnum);
    void   close();
    size_t read(void *dest, size_t p_size, size_t p_num);
    long   fileLength() const;
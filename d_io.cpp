@@ -150,15 +150,15 @@ void DWFILE::openFile(const char *filename, const char *mode)
 // Open a wad lump into the DWFILE structure. The wad lump will
 // be cached in zone memory at static allocation level.
 //
-void DWFILE::openLump(int p_lumpnum)
+void DWFILE::openLump(WadDirectory &dir, int p_lumpnum)
 {
    if(isOpen())
       close();
 
    // haleyjd 04/03/03: added origsize field for D_Ungetc
    lumpnum = p_lumpnum;
-   size    = origsize = W_LumpLength(lumpnum);
-   inp     = lump     = (byte *)(wGlobalDir.cacheLumpNum(lumpnum, PU_STATIC));
+   size    = origsize = dir.lumpLength(lumpnum);
+   inp     = lump     = (byte *)(dir.cacheLumpNum(lumpnum, PU_STATIC));
    type    = DWF_LUMP;
 
    // zero out fields not used for lump reading
@@ -72,6 +72,15 @@
   #endif
 #endif
 
+// THREADLOCAL -- storage class for per-thread statics. Visual C++ 2012 has
+// no C++11 thread_local, and __thread is cheaper than thread_local under
+// GNU C; both require trivially constructed types.
+#ifdef _MSC_VER
+#define THREADLOCAL __declspec(thread)
+#else
+#define THREADLOCAL __thread
+#endif
+
 #ifdef _MSC_VER
 #define strcasecmp  stricmp
 #define strncasecmp strnicmp
@@ -0,0 +1,914 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Serving requests over a local socket
+//
+//   The daemon forks a pool of workers up front, each of which inherits the
+//   thingtypes and everything else loaded at startup. A worker serves one
+//   request and exits, so that no request sees state left by another, and
+//   is replaced once its response has been sent. Successful responses are
+//   kept in a cache for as long as their keys stay the same.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _MSC_VER
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "z_zone.h"
+#include "doomtype.h"
+#include "e_hash.h"
+#include "i_daemon.h"
+#include "i_system.h"
+#include "m_collection.h"
+#include "m_dllist.h"
+#include "m_qstr.h"
+
+#ifndef _MSC_VER
+
+//=============================================================================
+//
+// Buffers
+//
+
+// A growable byte buffer
+struct daemonbuf_t
+{
+   byte  *data;
+   size_t len;
+   size_t alloc;
+};
+
+static void I_bufAppend(daemonbuf_t &buf, const void *data, size_t size)
+{
+   if(buf.len + size > buf.alloc)
+   {
+      size_t alloc = buf.alloc ? buf.alloc : 4096;
+      while(alloc < buf.len + size)
+         alloc *= 2;
+      buf.data  = erealloc(byte *, buf.data, alloc);
+      buf.alloc = alloc;
+   }
+   memcpy(buf.data + buf.len, data, size);
+   buf.len += size;
+}
+
+static void I_bufAppendUint32(daemonbuf_t &buf, uint32_t num)
+{
+   byte bytes[4] =
+   {
+      static_cast<byte>(num), static_cast<byte>(num >> 8),
+      static_cast<byte>(num >> 16), static_cast<byte>(num >> 24)
+   };
+   I_bufAppend(buf, bytes, sizeof(bytes));
+}
+
+// Remove the first size bytes
+static void I_bufConsume(daemonbuf_t &buf, size_t size)
+{
+   memmove(buf.data, buf.data + size, buf.len - size);
+   buf.len -= size;
+}
+
+static void I_bufFree(daemonbuf_t &buf)
+{
+   if(buf.data)
+      efree(buf.data);
+   buf.data  = NULL;
+   buf.len   = 0;
+   buf.alloc = 0;
+}
+
+static uint32_t I_getUint32(const byte *p)
+{
+   return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+//=============================================================================
+//
+// Response Cache
+//
+
+struct daemoncache_t
+{
+   DLListItem<daemoncache_t> links;
+   daemoncache_t *prev;  // toward the most recently used
+   daemoncache_t *next;  // toward the least recently used
+   const char    *key;
+   byte          *data;  // the whole response, as sent
+   size_t         size;
+};
+
+typedef EHashTable<daemoncache_t, EStringHashKey,
+                   &daemoncache_t::key, &daemoncache_t::links> cachehash_t;
+
+//
+// DaemonCache
+//
+// Responses by key, dropping the least recently used ones to stay within a
+// number of bytes.
+//
+class DaemonCache
+{
+protected:
+   cachehash_t    hash;
+   daemoncache_t *head;  // most recently used
+   daemoncache_t *tail;  // least recently used
+   size_t         used;
+   size_t         limit;
+
+   void unlink(daemoncache_t *entry)
+   {
+      if(entry->prev)
+         entry->prev->next = entry->next;
+      else
+         head = entry->next;
+      if(entry->next)
+         entry->next->prev = entry->prev;
+      else
+         tail = entry->prev;
+   }
+
+   void linkFirst(daemoncache_t *entry)
+   {
+      entry->prev = NULL;
+      if((entry->next = head))
+         head->prev = entry;
+      else
+         tail = entry;
+      head = entry;
+   }
+
+   void drop(daemoncache_t *entry)
+   {
+      unlink(entry);
+      hash.removeObject(entry);
+      used -= entry->size + strlen(entry->key);
+      efree(const_cast<char *>(entry->key));
+      efree(entry->data);
+      efree(entry);
+   }
+
+public:
+   DaemonCache(size_t pLimit)
+      : hash(127), head(NULL), tail(NULL), used(0), limit(pLimit)
+   {
+   }
+
+   ~DaemonCache()
+   {
+      while(head)
+         drop(head);
+      hash.destroy();
+   }
+
+   // Returns the entry for key, if there is one, and marks it most recent.
+   const daemoncache_t *find(const char *key)
+   {
+      daemoncache_t *entry;
+
+      if((entry = hash.objectForKey(key)))
+      {
+         unlink(entry);
+         linkFirst(entry);
+      }
+      return entry;
+   }
+
+   void add(const char *key, const byte *data, size_t size)
+   {
+      size_t cost = size + strlen(key);
+      daemoncache_t *entry;
+
+      if(cost > limit / 4)
+         return; // would push out too much else
+      if((entry = hash.objectForKey(key)))
+         drop(entry);
+      while(used + cost > limit)
+         drop(tail);
+
+      entry = estructalloc(daemoncache_t, 1);
+      entry->key  = estrdup(key);
+      entry->data = emalloc(byte *, size);
+      entry->size = size;
+      memcpy(entry->data, data, size);
+
+      hash.addObject(entry);
+      if(hash.getLoadFactor() > 2.0f)
+         hash.rebuild(hash.getNumChains() * 2 + 1);
+      linkFirst(entry);
+      used += cost;
+   }
+};
+
+//=============================================================================
+//
+// Connections and Workers
+//
+
+// Connection states
+enum
+{
+   CONN_IDLE,    // waiting for a request
+   CONN_QUEUED,  // waiting for a worker
+   CONN_RUNNING  // a worker is serving the request
+};
+
+struct daemonworker_t;
+
+struct daemonconn_t
+{
+   int             fd;
+   int             state;
+   unsigned int    ticket;   // order in which queued requests are served
+   daemonbuf_t     in;       // received, not yet handled
+   daemonbuf_t     out;      // responses not yet sent
+   daemonbuf_t     result;   // output of the running request
+   qstring         key;      // cache key of the current request
+   daemonworker_t *worker;   // serving the current request
+   bool            closing;  // close once out has been sent
+};
+
+struct daemonworker_t
+{
+   pid_t         pid;    // 0 if there is no process
+   int           reqfd;  // requests are written here
+   int           outfd;  // and output read from here
+   daemonconn_t *conn;   // connection being served, or NULL if idle
+};
+
+static volatile sig_atomic_t daemonstop;
+
+static void I_daemonSignal(int sig)
+{
+   daemonstop = 1;
+}
+
+//
+// I_readFully
+//
+// Read exactly size bytes, or fail.
+//
+static bool I_readFully(int fd, void *data, size_t size)
+{
+   byte *p = static_cast<byte *>(data);
+
+   while(size)
+   {
+      ssize_t n = read(fd, p, size);
+      if(n < 0 && errno == EINTR)
+         continue;
+      if(n <= 0)
+         return false;
+      p    += n;
+      size -= static_cast<size_t>(n);
+   }
+   return true;
+}
+
+//
+// I_writeFully
+//
+static bool I_writeFully(int fd, const void *data, size_t size)
+{
+   const byte *p = static_cast<const byte *>(data);
+
+   while(size)
+   {
+      ssize_t n = write(fd, p, size);
+      if(n < 0 && errno == EINTR)
+         continue;
+      if(n <= 0)
+         return false;
+      p    += n;
+      size -= static_cast<size_t>(n);
+   }
+   return true;
+}
+
+//
+// DaemonServer
+//
+class DaemonServer : public ZoneObject
+{
+protected:
+   DaemonHandler                 &handler;
+   DaemonCache                    cache;
+   int                            listenfd;
+   daemonworker_t                *workers;
+   int                            numworkers;
+   PODCollection<daemonconn_t *>  conns;
+   unsigned int                   nextticket;
+
+   void workerMain(daemonworker_t &worker);
+   bool spawnWorker(daemonworker_t &worker);
+   void stopWorker(daemonworker_t &worker, bool kill);
+   void finishRequest(daemonworker_t &worker);
+   void readWorker(daemonworker_t &worker);
+
+   void respond(daemonconn_t &conn, uint32_t status, const void *data, size_t size);
+   void startRequest(daemonconn_t &conn);
+   void cancelRequest(daemonconn_t &conn);
+   void handleInput(daemonconn_t &conn);
+   void dispatch();
+   void acceptConn();
+   bool readConn(daemonconn_t &conn);
+   bool writeConn(daemonconn_t &conn);
+   void closeConn(size_t index);
+
+public:
+   DaemonServer(DaemonHandler &pHandler, int pListenFd, int pNumWorkers,
+                size_t cachesize)
+      : ZoneObject(), handler(pHandler), cache(cachesize), listenfd(pListenFd),
+        workers(NULL), numworkers(pNumWorkers), conns(), nextticket(0)
+   {
+      workers = estructalloc(daemonworker_t, numworkers);
+   }
+
+   ~DaemonServer();
+
+   bool run();
+};
+
+//
+// DaemonServer::workerMain
+//
+// Runs in a newly forked worker; never returns. Waits for a request, then
+// serves it with its output going to the daemon.
+//
+void DaemonServer::workerMain(daemonworker_t &worker)
+{
+   byte     lenbytes[4];
+   uint32_t len;
+   char    *request;
+
+   // hold no other descriptors open, so that connections and the other
+   // workers' pipes close when the daemon closes them
+   close(listenfd);
+   for(daemonconn_t *conn : conns)
+      close(conn->fd);
+   for(int i = 0; i < numworkers; i++)
+   {
+      if(&workers[i] != &worker && workers[i].pid)
+      {
+         close(workers[i].reqfd);
+         close(workers[i].outfd);
+      }
+   }
+
+   signal(SIGINT,  SIG_DFL);
+   signal(SIGTERM, SIG_DFL);
+
+   if(!I_readFully(worker.reqfd, lenbytes, sizeof(lenbytes)))
+      _exit(0); // the daemon is gone
+   len     = I_getUint32(lenbytes);
+   request = emalloc(char *, len + 1);
+   if(!I_readFully(worker.reqfd, request, len))
+      _exit(0);
+   request[len] = '\0';
+   close(worker.reqfd);
+
+   if(dup2(worker.outfd, STDOUT_FILENO) < 0)
+      _exit(1);
+   close(worker.outfd);
+
+   bool ok = handler.run(request, len);
+   fflush(stdout);
+   _exit(ok ? 0 : 1);
+}
+
+//
+// DaemonServer::spawnWorker
+//
+bool DaemonServer::spawnWorker(daemonworker_t &worker)
+{
+   int reqpipe[2], outpipe[2];
+
+   if(pipe(reqpipe))
+      return false;
+   if(pipe(outpipe))
+   {
+      close(reqpipe[0]);
+      close(reqpipe[1]);
+      return false;
+   }
+
+   // anything still buffered would be output again by the worker
+   fflush(stdout);
+
+   pid_t pid = fork();
+   if(pid < 0)
+   {
+      close(reqpipe[0]);
+      close(reqpipe[1]);
+      close(outpipe[0]);
+      close(outpipe[1]);
+      return false;
+   }
+   if(!pid)
+   {
+      close(reqpipe[1]);
+      close(outpipe[0]);
+      worker.reqfd = reqpipe[0];
+      worker.outfd = outpipe[1];
+      workerMain(worker);
+   }
+
+   close(reqpipe[0]);
+   close(outpipe[1]);
+   worker.pid   = pid;
+   worker.reqfd = reqpipe[1];
+   worker.outfd = outpipe[0];
+   worker.conn  = NULL;
+   return true;
+}
+
+//
+// DaemonServer::stopWorker
+//
+// Close the worker's pipes and wait for it to exit, killing it first if
+// asked to.
+//
+void DaemonServer::stopWorker(daemonworker_t &worker, bool kill)
+{
+   if(!worker.pid)
+      return;
+
+   if(kill)
+      ::kill(worker.pid, SIGKILL);
+   close(worker.reqfd);
+   close(worker.outfd);
+   while(waitpid(worker.pid, NULL, 0) < 0 && errno == EINTR)
+      ;
+
+   if(worker.conn)
+      worker.conn->worker = NULL;
+   worker.pid  = 0;
+   worker.conn = NULL;
+}
+
+//
+// DaemonServer::finishRequest
+//
+// The worker has closed its output; send the response, and cache it if
+// the request succeeded.
+//
+void DaemonServer::finishRequest(daemonworker_t &worker)
+{
+   daemonconn_t *conn = worker.conn;
+   int status = 0;
+
+   close(worker.reqfd);
+   close(worker.outfd);
+   while(waitpid(worker.pid, &status, 0) < 0 && errno == EINTR)
+      ;
+   worker.pid  = 0;
+   worker.conn = NULL;
+
+   if(!conn)
+      return;
+
+   uint32_t result = (WIFEXITED(status) && !WEXITSTATUS(status)) ? DAEMON_OK : DAEMON_FAILED;
+   size_t   start  = conn->out.len;
+
+   respond(*conn, result, conn->result.data, conn->result.len);
+   if(result == DAEMON_OK)
+      cache.add(conn->key.constPtr(), conn->out.data + start, conn->out.len - start);
+
+   I_bufFree(conn->result);
+   conn->worker = NULL;
+   conn->state  = CONN_IDLE;
+   handleInput(*conn);
+}
+
+//
+// DaemonServer::readWorker
+//
+void DaemonServer::readWorker(daemonworker_t &worker)
+{
+   byte    chunk[65536];
+   ssize_t n = read(worker.outfd, chunk, sizeof(chunk));
+
+   if(n < 0 && errno == EINTR)
+      return;
+   if(n > 0)
+   {
+      if(worker.conn)
+         I_bufAppend(worker.conn->result, chunk, static_cast<size_t>(n));
+      return;
+   }
+
+   // end of output; an idle worker only gets here if it died
+   if(worker.conn)
+      finishRequest(worker);
+   else
+      stopWorker(worker, true);
+}
+
+//
+// DaemonServer::respond
+//
+void DaemonServer::respond(daemonconn_t &conn, uint32_t status,
+                           const void *data, size_t size)
+{
+   I_bufAppendUint32(conn.out, status);
+   I_bufAppendUint32(conn.out, static_cast<uint32_t>(size));
+   if(size)
+      I_bufAppend(conn.out, data, size);
+}
+
+//
+// DaemonServer::startRequest
+//
+// A complete request is at the start of the connection's input. Answer it
+// from the cache, or queue it for a worker.
+//
+void DaemonServer::startRequest(daemonconn_t &conn)
+{
+   uint32_t     len     = I_getUint32(conn.in.data);
+   const char  *request = reinterpret_cast<const char *>(conn.in.data + 4);
+   qstring      error;
+   const daemoncache_t *hit;
+
+   conn.key.clear();
+   if(!handler.prepare(request, len, conn.key, error))
+   {
+      respond(conn, DAEMON_BADREQUEST, error.constPtr(), error.length());
+      I_bufConsume(conn.in, 4 + len);
+      return;
+   }
+
+   if((hit = cache.find(conn.key.constPtr())))
+   {
+      I_bufAppend(conn.out, hit->data, hit->size);
+      I_bufConsume(conn.in, 4 + len);
+      return;
+   }
+
+   // the request stays in the input buffer until a worker takes it
+   conn.state  = CONN_QUEUED;
+   conn.ticket = nextticket++;
+}
+
+//
+// DaemonServer::cancelRequest
+//
+void DaemonServer::cancelRequest(daemonconn_t &conn)
+{
+   if(conn.state == CONN_RUNNING)
+   {
+      if(conn.worker)
+         stopWorker(*conn.worker, true);
+      I_bufFree(conn.result);
+   }
+   else if(conn.state == CONN_QUEUED)
+      I_bufConsume(conn.in, 4 + I_getUint32(conn.in.data));
+
+   conn.state = CONN_IDLE;
+   respond(conn, DAEMON_CANCELLED, NULL, 0);
+}
+
+//
+// DaemonServer::handleInput
+//
+// Act on whatever complete frames have arrived.
+//
+void DaemonServer::handleInput(daemonconn_t &conn)
+{
+   while(!conn.closing && conn.in.len >= 4)
+   {
+      uint32_t len = I_getUint32(conn.in.data);
+
+      if(conn.state != CONN_IDLE)
+      {
+         // while a request is outstanding, a cancel may follow it
+         size_t at = (conn.state == CONN_QUEUED) ? 4 + I_getUint32(conn.in.data) : 0;
+         if(conn.in.len >= at + 4 && !I_getUint32(conn.in.data + at))
+         {
+            memmove(conn.in.data + at, conn.in.data + at + 4, conn.in.len - at - 4);
+            conn.in.len -= 4;
+            cancelRequest(conn);
+            continue;
+         }
+         return;
+      }
+
+      if(!len)
+      {
+         // nothing to cancel
+         I_bufConsume(conn.in, 4);
+         continue;
+      }
+      if(len > DAEMON_MAXREQUEST)
+      {
+         static const char toolong[] = "Request is too long\n";
+         respond(conn, DAEMON_BADREQUEST, toolong, sizeof(toolong) - 1);
+         conn.closing = true;
+         return;
+      }
+      if(conn.in.len < 4 + len)
+         return;
+
+      startRequest(conn);
+   }
+}
+
+//
+// DaemonServer::dispatch
+//
+// Hand queued requests to idle workers, oldest first, and replace any
+// workers which have exited.
+//
+void DaemonServer::dispatch()
+{
+   for(int i = 0; i < numworkers; i++)
+   {
+      daemonworker_t &worker = workers[i];
+      daemonconn_t   *next   = NULL;
+
+      if(!worker.pid && !spawnWorker(worker))
+         continue;
+      if(worker.conn)
+         continue;
+
+      for(daemonconn_t *conn : conns)
+      {
+         if(conn->state == CONN_QUEUED && (!next || conn->ticket < next->ticket))
+            next = conn;
+      }
+      if(!next)
+         continue;
+
+      uint32_t len = I_getUint32(next->in.data);
+      if(!I_writeFully(worker.reqfd, next->in.data, 4 + len))
+      {
+         stopWorker(worker, true);
+         continue;
+      }
+      I_bufConsume(next->in, 4 + len);
+
+      worker.conn   = next;
+      next->worker  = &worker;
+      next->state   = CONN_RUNNING;
+   }
+}
+
+//
+// DaemonServer::acceptConn
+//
+void DaemonServer::acceptConn()
+{
+   int fd = accept(listenfd, NULL, NULL);
+
+   if(fd < 0)
+      return;
+
+   daemonconn_t *conn = new daemonconn_t();
+   conn->fd    = fd;
+   conn->state = CONN_IDLE;
+   conns.add(conn);
+}
+
+//
+// DaemonServer::readConn
+//
+// Returns false if the connection has been closed by the client.
+//
+bool DaemonServer::readConn(daemonconn_t &conn)
+{
+   byte    chunk[4096];
+   ssize_t n = recv(conn.fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+
+   if(n < 0)
+      return (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK);
+   if(!n)
+      return false;
+
+   I_bufAppend(conn.in, chunk, static_cast<size_t>(n));
+   handleInput(conn);
+   return true;
+}
+
+//
+// DaemonServer::writeConn
+//
+// Send what can be sent without blocking. Returns false if the connection
+// is broken, or is finished with.
+//
+bool DaemonServer::writeConn(daemonconn_t &conn)
+{
+   ssize_t n = send(conn.fd, conn.out.data, conn.out.len, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+   if(n < 0)
+      return (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK);
+
+   I_bufConsume(conn.out, static_cast<size_t>(n));
+   return !(conn.closing && !conn.out.len);
+}
+
+//
+// DaemonServer::closeConn
+//
+// Close a connection, cancelling anything it asked for.
+//
+void DaemonServer::closeConn(size_t index)
+{
+   daemonconn_t *conn = conns[index];
+
+   if(conn->worker)
+      stopWorker(*conn->worker, true);
+   close(conn->fd);
+   I_bufFree(conn->in);
+   I_bufFree(conn->out);
+   I_bufFree(conn->result);
+   delete conn;
+
+   // order does not matter; queued requests are served by ticket
+   conns[index] = conns[conns.getLength() - 1];
+   conns.pop();
+}
+
+//
+// DaemonServer::run
+//
+// Serve connections until interrupted. Returns false if no worker could be
+// started.
+//
+bool DaemonServer::run()
+{
+   PODCollection<pollfd>  fds;
+   PODCollection<size_t>  connidx; // pollfd index of each connection
+
+   dispatch();
+   for(int i = 0; i < numworkers; i++)
+   {
+      if(!workers[i].pid)
+         return false;
+   }
+
+   while(!daemonstop)
+   {
+      pollfd pfd;
+
+      fds.makeEmpty();
+      pfd.fd      = listenfd;
+      pfd.events  = POLLIN;
+      pfd.revents = 0;
+      fds.add(pfd);
+      for(int i = 0; i < numworkers; i++)
+      {
+         pfd.fd = workers[i].pid ? workers[i].outfd : -1;
+         fds.add(pfd);
+      }
+      for(daemonconn_t *conn : conns)
+      {
+         pfd.fd     = conn->fd;
+         pfd.events = static_cast<short>(conn->out.len ? POLLIN | POLLOUT : POLLIN);
+         fds.add(pfd);
+      }
+
+      if(poll(&fds[0], fds.getLength(), -1) < 0)
+      {
+         if(errno == EINTR)
+            continue;
+         I_Error("I_RunDaemon: poll failed: %s\n", strerror(errno));
+      }
+
+      // worker output first, so that responses go out in this pass
+      for(int i = 0; i < numworkers; i++)
+      {
+         if(fds[1 + i].revents && workers[i].pid)
+            readWorker(workers[i]);
+      }
+
+      // then connections, newest first so that closing one does not
+      // disturb the order of those yet to be handled
+      size_t base = 1 + numworkers;
+      for(size_t i = conns.getLength(); i-- > 0; )
+      {
+         daemonconn_t *conn    = conns[i];
+         short         revents = (base + i < fds.getLength()) ? fds[base + i].revents : 0;
+         bool          keep    = true;
+
+         if(revents & (POLLIN | POLLHUP | POLLERR))
+            keep = readConn(*conn);
+         if(keep && conn->out.len)
+            keep = writeConn(*conn);
+         if(!keep)
+            closeConn(i);
+      }
+
+      if(fds[0].revents & POLLIN)
+         acceptConn();
+
+      dispatch();
+   }
+
+   return true;
+}
+
+//
+// DaemonServer Destructor
+//
+DaemonServer::~DaemonServer()
+{
+   for(int i = 0; i < numworkers; i++)
+      stopWorker(workers[i], true);
+   while(conns.getLength())
+      closeConn(conns.getLength() - 1);
+   efree(workers);
+}
+
+#endif
+
+//
+// I_RunDaemon
+//
+// Listen on a Unix domain socket, and serve requests with a pool of
+// numworkers worker processes until interrupted or terminated. Up to
+// cachesize bytes of responses are cached. Returns false if the daemon could
+// not be started.
+//
+bool I_RunDaemon(const char *socketpath, DaemonHandler &handler, int numworkers,
+                 size_t cachesize)
+{
+#ifndef _MSC_VER
+   sockaddr_un addr;
+   struct stat sbuf;
+   int fd;
+
+   if(strlen(socketpath) >= sizeof(addr.sun_path))
+   {
+      printf("Socket path '%s' is too long\n", socketpath);
+      return false;
+   }
+
+   // a socket left behind by an earlier daemon is replaced
+   if(!stat(socketpath, &sbuf) && S_ISSOCK(sbuf.st_mode))
+      unlink(socketpath);
+
+   memset(&addr, 0, sizeof(addr));
+   addr.sun_family = AF_UNIX;
+   strcpy(addr.sun_path, socketpath);
+
+   if((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+      return false;
+   if(bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) ||
+      listen(fd, SOMAXCONN))
+   {
+      printf("Could not listen on '%s': %s\n", socketpath, strerror(errno));
+      close(fd);
+      return false;
+   }
+
+   struct sigaction sa;
+   memset(&sa, 0, sizeof(sa));
+   sa.sa_handler = I_daemonSignal;
+   sigemptyset(&sa.sa_mask);
+   sigaction(SIGINT,  &sa, NULL);
+   sigaction(SIGTERM, &sa, NULL);
+   signal(SIGPIPE, SIG_IGN);
+
+   printf("Serving on %s with %d workers\n", socketpath, numworkers);
+
+   bool ok;
+   {
+      DaemonServer server(handler, fd, numworkers, cachesize);
+      ok = server.run();
+   }
+
+   close(fd);
+   unlink(socketpath);
+   return ok;
+#else
+   puts("-daemon is not supported on this platform");
+   return false;
+#endif
+}
+
+// EOF
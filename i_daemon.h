@@ -0,0 +1,85 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Serving requests over a local socket
+//
+//-----------------------------------------------------------------------------
+
+#ifndef I_DAEMON_H__
+#define I_DAEMON_H__
+
+class qstring;
+
+//
+// Daemon protocol
+//
+// Clients connect to a Unix domain socket and send requests, one at a time.
+// All integers are 32-bit little-endian.
+//
+//    request     length, then that many bytes of request text
+//    cancel      a length of 0, sent while a request is outstanding
+//    response    status (DAEMON_*), length, then that many bytes of output
+//
+// Each request is answered by exactly one response. A cancelled request is
+// answered with DAEMON_CANCELLED, unless it had already finished. Closing
+// the connection also cancels any outstanding request.
+//
+
+enum
+{
+   DAEMON_OK,         // output is the complete report
+   DAEMON_FAILED,     // something could not be processed; output says what
+   DAEMON_BADREQUEST, // output is an error message
+   DAEMON_CANCELLED   // no output
+};
+
+// Largest request accepted, in bytes
+#define DAEMON_MAXREQUEST 16384
+
+//
+// DaemonHandler
+//
+// What the daemon does with each request. prepare is called in the daemon
+// itself, and must not change any state. run is called in a worker process
+// forked from the daemon, which exits afterward, with standard output
+// going to the response.
+//
+class DaemonHandler
+{
+public:
+   virtual ~DaemonHandler() {}
+
+   // Check a request. On success, fill in the key under which its response
+   // can be cached, which must change whenever the response would. On
+   // failure, fill in an error message for the client.
+   virtual bool prepare(const char *request, size_t len, qstring &key,
+                        qstring &error) = 0;
+
+   // Carry out a prepared request. Returns false if anything failed.
+   virtual bool run(const char *request, size_t len) = 0;
+};
+
+bool I_RunDaemon(const char *socketpath, DaemonHandler &handler, int numworkers,
+                 size_t cachesize);
+
+#endif
+
+// EOF
@@ -26,10 +26,14 @@
 
 #include "z_zone.h"
 #include "i_system.h"
+#include "psnprintf.h"
 
 static int error_exitcode;
 static bool has_exited;
 
+// number of IRecoverableScope objects alive on this thread
+static THREADLOCAL int recoverable_depth;
+
 enum
 {
    I_ERRORLEVEL_NONE,    // no error
@@ -76,6 +80,33 @@ void I_FatalError(int code, const char *error, ...)
    }
 }
 
+//
+// I_ErrorException Constructor
+//
+I_ErrorException::I_ErrorException(const char *error, va_list args)
+{
+   pvsnprintf(message, sizeof(message), error, args);
+}
+
+//
+// IRecoverableScope Constructor
+//
+// While any scope is alive on this thread, I_Error throws I_ErrorException
+// instead of exiting.
+//
+IRecoverableScope::IRecoverableScope()
+{
+   ++recoverable_depth;
+}
+
+//
+// IRecoverableScope Destructor
+//
+IRecoverableScope::~IRecoverableScope()
+{
+   --recoverable_depth;
+}
+
 //
 // I_Error
 //
@@ -83,6 +114,15 @@ void I_FatalError(int code, const char *error, ...)
 //
 void I_Error(const char *error, ...) // killough 3/20/98: add const
 {
+   if(recoverable_depth)
+   {
+      va_list argptr;
+      va_start(argptr, error);
+      I_ErrorException exc(error, argptr);
+      va_end(argptr);
+      throw exc;
+   }
+
    // do not demote error level
    if(error_exitcode < I_ERRORLEVEL_NORMAL)
       error_exitcode = I_ERRORLEVEL_NORMAL; // a normal error
@@ -108,6 +148,9 @@ void I_Error(const char *error, ...) // killough 3/20/98: add const
 //
 void I_ErrorVA(const char *error, va_list args)
 {
+   if(recoverable_depth)
+      throw I_ErrorException(error, args);
+
    // do not demote error level
    if(error_exitcode < I_ERRORLEVEL_NORMAL)
       error_exitcode = I_ERRORLEVEL_NORMAL;
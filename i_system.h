@@ -42,6 +42,37 @@ void I_ErrorVA(const char *error, va_list args);
 // haleyjd 05/21/10
 void I_FatalError(int code, const char *error, ...);
 
+//
+// I_ErrorException
+//
+// Thrown by I_Error and I_ErrorVA, instead of exiting, while an
+// IRecoverableScope is active on the calling thread. I_FatalError is never
+// recoverable.
+//
+class I_ErrorException
+{
+protected:
+   char message[1024];
+
+public:
+   I_ErrorException(const char *error, va_list args);
+   const char *GetMessage() const { return message; }
+};
+
+//
+// IRecoverableScope
+//
+// While an instance of this class is alive, errors raised through I_Error on
+// the same thread are thrown as I_ErrorException so that the caller can clean
+// up and carry on. Scopes may be nested.
+//
+class IRecoverableScope
+{
+public:
+   IRecoverableScope();
+   ~IRecoverableScope();
+};
+
 #endif
 
 // EOF
@@ -0,0 +1,634 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Watching a spool directory for archives to count
+//
+//   Archives already in the directory are counted first, and then each one
+//   written to it, or moved into it, once it has been closed. A file is only
+//   counted again when the key its request is prepared with changes, so an
+//   archive which is unchanged is never reopened. Archives are counted by a
+//   pool of worker processes, each of which counts one archive and exits,
+//   and the whole of an archive's report is appended to the output at once.
+//
+//-----------------------------------------------------------------------------
+
+#ifdef __linux__
+#include <dirent.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "z_zone.h"
+#include "doomtype.h"
+#include "e_hash.h"
+#include "i_daemon.h"
+#include "i_system.h"
+#include "i_watch.h"
+#include "m_collection.h"
+#include "m_dllist.h"
+#include "m_qstr.h"
+#include "m_textbuf.h"
+
+#ifdef __linux__
+
+// A file in the directory
+struct watchfile_t
+{
+   DLListItem<watchfile_t> links;
+   const char *name;     // name within the directory
+   qstring     key;      // key it was last counted under, if it has been
+   bool        queued;   // waiting for a worker
+   bool        running;  // being counted
+   bool        changed;  // changed again while being counted
+   bool        removed;  // removed while queued or being counted
+};
+
+typedef EHashTable<watchfile_t, EStringHashKey,
+                   &watchfile_t::name, &watchfile_t::links> filehash_t;
+
+struct watchworker_t
+{
+   pid_t        pid;    // 0 if idle
+   int          outfd;  // output is read from here
+   watchfile_t *file;   // file being counted
+   qstring      key;    // key it is being counted under
+   TextBuffer   output; // output so far
+};
+
+static volatile sig_atomic_t watchstop;
+
+static void I_watchSignal(int sig)
+{
+   watchstop = 1;
+}
+
+//
+// I_watchableName
+//
+// Hidden files are skipped, so that an archive being uploaded under a
+// temporary name is only counted once it is renamed into place. So are
+// names which cannot be given in a request.
+//
+static bool I_watchableName(const char *name)
+{
+   size_t len = strlen(name);
+
+   if(!len || *name == '.')
+      return false;
+   if(strchr(" \t", name[0]) || strchr(" \t", name[len - 1]))
+      return false;
+   for(const char *c = name; *c; c++)
+   {
+      if(*c == '\n' || *c == '\r')
+         return false;
+   }
+   return true;
+}
+
+//
+// WatchServer
+//
+class WatchServer : public ZoneObject
+{
+protected:
+   DaemonHandler                &handler;
+   const char                   *dirpath;
+   int                           inotifyfd;
+   FILE                         *sink;
+   watchworker_t                *workers;
+   int                           numworkers;
+   filehash_t                    files;
+   PODCollection<watchfile_t *>  queue;
+   size_t                        queuehead; // next file in queue to count
+
+   void enqueue(watchfile_t &file);
+   void forget(watchfile_t &file);
+   void fileChanged(const char *name);
+   void fileRemoved(const char *name);
+   void scanDirectory();
+   bool readEvents();
+
+   void workerMain(watchworker_t &worker, const qstring &request);
+   bool startFile(watchworker_t &worker, watchfile_t &file);
+   bool finishFile(watchworker_t &worker);
+   bool readWorker(watchworker_t &worker);
+   void dispatch();
+
+public:
+   WatchServer(DaemonHandler &pHandler, const char *pDirPath, int pInotifyFd,
+               FILE *pSink, int pNumWorkers)
+      : ZoneObject(), handler(pHandler), dirpath(pDirPath), inotifyfd(pInotifyFd),
+        sink(pSink), workers(NULL), numworkers(pNumWorkers), files(127), queue(),
+        queuehead(0)
+   {
+      workers = new watchworker_t[numworkers];
+      for(int i = 0; i < numworkers; i++)
+      {
+         workers[i].pid   = 0;
+         workers[i].outfd = -1;
+         workers[i].file  = NULL;
+      }
+   }
+
+   ~WatchServer();
+
+   bool run();
+};
+
+//
+// WatchServer::enqueue
+//
+void WatchServer::enqueue(watchfile_t &file)
+{
+   if(file.queued)
+      return;
+
+   // start over once everything queued has been taken
+   if(queuehead == queue.getLength())
+   {
+      queue.makeEmpty();
+      queuehead = 0;
+   }
+   queue.add(&file);
+   file.queued = true;
+}
+
+//
+// WatchServer::forget
+//
+void WatchServer::forget(watchfile_t &file)
+{
+   files.removeObject(file);
+   efree(const_cast<char *>(file.name));
+   delete &file;
+}
+
+//
+// WatchServer::fileChanged
+//
+// A file has been closed after writing, or moved into the directory.
+//
+void WatchServer::fileChanged(const char *name)
+{
+   watchfile_t *file;
+
+   if(!I_watchableName(name))
+      return;
+
+   if(!(file = files.objectForKey(name)))
+   {
+      file = new watchfile_t();
+      file->name = estrdup(name);
+      files.addObject(file);
+      if(files.getLoadFactor() > 2.0f)
+         files.rebuild(files.getNumChains() * 2 + 1);
+   }
+
+   file->removed = false;
+   if(file->running)
+      file->changed = true;
+   else
+      enqueue(*file);
+}
+
+//
+// WatchServer::fileRemoved
+//
+// A file has been deleted, or moved out of the directory.
+//
+void WatchServer::fileRemoved(const char *name)
+{
+   watchfile_t *file;
+
+   if(!(file = files.objectForKey(name)))
+      return;
+
+   // a queued file is forgotten when a worker finds it gone
+   if(file->queued || file->running)
+   {
+      file->changed = false;
+      file->removed = true;
+   }
+   else
+      forget(*file);
+}
+
+static int I_compareNames(const void *a, const void *b)
+{
+   return strcmp(*static_cast<const char *const *>(a),
+                 *static_cast<const char *const *>(b));
+}
+
+//
+// WatchServer::scanDirectory
+//
+// Treat every file in the directory as changed; those whose keys are the
+// same are not counted again. Files are queued in order by name.
+//
+void WatchServer::scanDirectory()
+{
+   PODCollection<char *> names;
+   DIR    *dir;
+   dirent *ent;
+
+   if(!(dir = opendir(dirpath)))
+      return;
+   while((ent = readdir(dir)))
+   {
+      if(ent->d_type != DT_DIR)
+         names.add(estrdup(ent->d_name));
+   }
+   closedir(dir);
+
+   if(names.getLength())
+      qsort(&names[0], names.getLength(), sizeof(char *), I_compareNames);
+   for(char *name : names)
+   {
+      fileChanged(name);
+      efree(name);
+   }
+}
+
+//
+// WatchServer::readEvents
+//
+// Returns false if the directory itself has gone away.
+//
+bool WatchServer::readEvents()
+{
+   alignas(inotify_event) char buf[65536];
+
+   for(;;)
+   {
+      ssize_t n = read(inotifyfd, buf, sizeof(buf));
+
+      if(n < 0 && errno == EINTR)
+         continue;
+      if(n <= 0)
+         return true; // nothing more for now
+
+      for(char *p = buf; p < buf + n; )
+      {
+         const inotify_event *ev = reinterpret_cast<const inotify_event *>(p);
+         p += sizeof(inotify_event) + ev->len;
+
+         if(ev->mask & IN_Q_OVERFLOW)
+         {
+            // events were lost
+            scanDirectory();
+            continue;
+         }
+         if(ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+            return false;
+         if(!ev->len || (ev->mask & IN_ISDIR))
+            continue;
+
+         if(ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+            fileChanged(ev->name);
+         else if(ev->mask & (IN_DELETE | IN_MOVED_FROM))
+            fileRemoved(ev->name);
+      }
+   }
+}
+
+//
+// WatchServer::workerMain
+//
+// Runs in a newly forked worker; never returns. Counts one archive with its
+// output going to the watcher.
+//
+void WatchServer::workerMain(watchworker_t &worker, const qstring &request)
+{
+   // hold no other descriptors open
+   close(inotifyfd);
+   for(int i = 0; i < numworkers; i++)
+   {
+      if(&workers[i] != &worker && workers[i].pid)
+         close(workers[i].outfd);
+   }
+
+   signal(SIGINT,  SIG_DFL);
+   signal(SIGTERM, SIG_DFL);
+
+   if(dup2(worker.outfd, STDOUT_FILENO) < 0)
+      _exit(1);
+   close(worker.outfd);
+
+   bool ok = handler.run(request.constPtr(), request.length());
+   fflush(stdout);
+   _exit(ok ? 0 : 1);
+}
+
+//
+// WatchServer::startFile
+//
+// Start counting a file if it is still there and has changed since it was
+// last counted. Returns false if there was nothing to do.
+//
+bool WatchServer::startFile(watchworker_t &worker, watchfile_t &file)
+{
+   qstring     path, request, key, error;
+   struct stat sbuf;
+   int         outpipe[2];
+
+   path << dirpath << "/" << file.name;
+   if(stat(path.constPtr(), &sbuf) || !S_ISREG(sbuf.st_mode))
+   {
+      forget(file);
+      return false;
+   }
+
+   request << "file " << path << "\n";
+   if(!handler.prepare(request.constPtr(), request.length(), key, error))
+   {
+      forget(file);
+      return false;
+   }
+   if(key == file.key)
+      return false; // unchanged
+
+   if(pipe(outpipe))
+      I_Error("I_RunWatch: pipe failed: %s\n", strerror(errno));
+
+   // anything still buffered would be output again by the worker
+   fflush(stdout);
+   fflush(sink);
+
+   pid_t pid = fork();
+   if(pid < 0)
+      I_Error("I_RunWatch: fork failed: %s\n", strerror(errno));
+   if(!pid)
+   {
+      close(outpipe[0]);
+      worker.outfd = outpipe[1];
+      workerMain(worker, request);
+   }
+
+   close(outpipe[1]);
+   worker.pid   = pid;
+   worker.outfd = outpipe[0];
+   worker.file  = &file;
+   worker.key   = key;
+   worker.output.clear();
+   file.running = true;
+   return true;
+}
+
+//
+// WatchServer::finishFile
+//
+// The worker has closed its output; append it to the report. Returns false
+// if the report could not be written.
+//
+bool WatchServer::finishFile(watchworker_t &worker)
+{
+   watchfile_t *file   = worker.file;
+   int          status = 0;
+   bool         ok     = true;
+
+   close(worker.outfd);
+   while(waitpid(worker.pid, &status, 0) < 0 && errno == EINTR)
+      ;
+   worker.pid   = 0;
+   worker.outfd = -1;
+   worker.file  = NULL;
+
+   if(WIFSIGNALED(status))
+   {
+      fprintf(stderr, "Counting '%s' was stopped by signal %d\n", file->name,
+              WTERMSIG(status));
+   }
+   else if(worker.output.getLength())
+   {
+      ok = (fwrite(worker.output.getBuffer(), 1, worker.output.getLength(), sink) ==
+            worker.output.getLength());
+      if(fflush(sink))
+         ok = false;
+   }
+
+   // an archive which failed fails the same way until it changes
+   file->running = false;
+   file->key     = worker.key;
+   if(file->changed)
+   {
+      file->changed = false;
+      enqueue(*file);
+   }
+   else if(file->removed)
+      forget(*file);
+
+   return ok;
+}
+
+//
+// WatchServer::readWorker
+//
+bool WatchServer::readWorker(watchworker_t &worker)
+{
+   char    chunk[65536];
+   ssize_t n = read(worker.outfd, chunk, sizeof(chunk));
+
+   if(n < 0 && errno == EINTR)
+      return true;
+   if(n > 0)
+   {
+      worker.output.addStr(chunk, static_cast<size_t>(n));
+      return true;
+   }
+   return finishFile(worker);
+}
+
+//
+// WatchServer::dispatch
+//
+// Hand queued files to idle workers, oldest first.
+//
+void WatchServer::dispatch()
+{
+   for(int i = 0; i < numworkers; i++)
+   {
+      if(workers[i].pid)
+         continue;
+
+      while(queuehead < queue.getLength())
+      {
+         watchfile_t *file = queue[queuehead++];
+
+         file->queued = false;
+         if(startFile(workers[i], *file))
+            break;
+      }
+   }
+}
+
+//
+// WatchServer::run
+//
+// Count archives as they arrive until interrupted. Returns false if the
+// directory went away or the report could not be written.
+//
+bool WatchServer::run()
+{
+   PODCollection<pollfd> fds;
+
+   scanDirectory();
+   dispatch();
+
+   while(!watchstop)
+   {
+      pollfd pfd;
+
+      fds.makeEmpty();
+      pfd.fd      = inotifyfd;
+      pfd.events  = POLLIN;
+      pfd.revents = 0;
+      fds.add(pfd);
+      for(int i = 0; i < numworkers; i++)
+      {
+         pfd.fd = workers[i].pid ? workers[i].outfd : -1;
+         fds.add(pfd);
+      }
+
+      if(poll(&fds[0], fds.getLength(), -1) < 0)
+      {
+         if(errno == EINTR)
+            continue;
+         I_Error("I_RunWatch: poll failed: %s\n", strerror(errno));
+      }
+
+      for(int i = 0; i < numworkers; i++)
+      {
+         if(fds[1 + i].revents && workers[i].pid && !readWorker(workers[i]))
+         {
+            printf("Could not write the report: %s\n", strerror(errno));
+            return false;
+         }
+      }
+
+      if(fds[0].revents & POLLIN)
+      {
+         if(!readEvents())
+         {
+            printf("Directory '%s' has gone away\n", dirpath);
+            return false;
+         }
+      }
+
+      dispatch();
+   }
+
+   return true;
+}
+
+//
+// WatchServer Destructor
+//
+// Stops any workers; archives they were counting are not reported.
+//
+WatchServer::~WatchServer()
+{
+   watchfile_t *file;
+
+   for(int i = 0; i < numworkers; i++)
+   {
+      if(!workers[i].pid)
+         continue;
+      kill(workers[i].pid, SIGKILL);
+      close(workers[i].outfd);
+      while(waitpid(workers[i].pid, NULL, 0) < 0 && errno == EINTR)
+         ;
+   }
+   delete [] workers;
+
+   while((file = files.tableIterator(static_cast<watchfile_t *>(NULL))))
+      forget(*file);
+   files.destroy();
+}
+
+#endif
+
+//
+// I_RunWatch
+//
+// Count the archives in a directory, and then those written to it, with a
+// pool of numworkers worker processes, until interrupted or terminated.
+// Each archive's report is appended to outputfile, or written to standard
+// output if it is NULL. Returns false if watching could not be started, or
+// had to stop.
+//
+bool I_RunWatch(const char *dirpath, DaemonHandler &handler, int numworkers,
+                const char *outputfile)
+{
+#ifdef __linux__
+   int   fd;
+   FILE *sink = stdout;
+
+   if((fd = inotify_init1(IN_NONBLOCK)) < 0)
+   {
+      printf("Could not start watching: %s\n", strerror(errno));
+      return false;
+   }
+   if(inotify_add_watch(fd, dirpath,
+                        IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM |
+                        IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR) < 0)
+   {
+      printf("Could not watch '%s': %s\n", dirpath, strerror(errno));
+      close(fd);
+      return false;
+   }
+   if(outputfile && !(sink = fopen(outputfile, "ab")))
+   {
+      printf("Could not open output file '%s'\n", outputfile);
+      close(fd);
+      return false;
+   }
+
+   struct sigaction sa;
+   memset(&sa, 0, sizeof(sa));
+   sa.sa_handler = I_watchSignal;
+   sigemptyset(&sa.sa_mask);
+   sigaction(SIGINT,  &sa, NULL);
+   sigaction(SIGTERM, &sa, NULL);
+
+   fprintf(stderr, "Watching %s with %d workers\n", dirpath, numworkers);
+
+   bool ok;
+   {
+      WatchServer server(handler, dirpath, fd, sink, numworkers);
+      ok = server.run();
+   }
+
+   if(sink != stdout)
+      fclose(sink);
+   close(fd);
+   return ok;
+#else
+   puts("-watch is not supported on this platform");
+   return false;
+#endif
+}
+
+// EOF
@@ -0,0 +1,380 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//   Buffered file output written from a separate thread.
+//
+//-----------------------------------------------------------------------------
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "z_zone.h"
+#include "m_asyncbuf.h"
+
+// Buffers are aligned to, and sized in multiples of, this many bytes
+#define ASYNC_ALIGN 4096
+
+// States of a queued buffer
+enum
+{
+   SLOT_QUEUED,   // waiting for a worker
+   SLOT_ENCODING, // being encoded
+   SLOT_ENCODED   // ready to be written
+};
+
+//
+// AsyncOutBufferPimpl
+//
+// The ring of buffers and the worker threads. The producer fills the buffer
+// at (head + count) % numbuffers; queued buffers start at head, and are
+// written out in that order.
+//
+class AsyncOutBufferPimpl : public ZoneObject
+{
+public:
+   AsyncOutBuffer         *owner;
+   FILE                   *f;
+   byte                   *pool;       // allocation holding all buffers
+   byte                  **buffers;
+   size_t                 *lengths;    // amount of data in each queued buffer
+   byte                  **encoded;    // encoding output for each buffer
+   const byte            **outdata;    // what to write for each buffer
+   size_t                 *outlengths;
+   int                    *states;
+   int                     numbuffers;
+   int                     head;       // next buffer to write
+   int                     count;      // number of buffers queued
+   bool                    writing;    // a worker is writing to the file
+   bool                    stopping;   // workers exit once queue is empty
+   bool                    failed;     // a write has failed
+   std::mutex              lock;
+   std::condition_variable queued;     // signalled when a buffer is queued
+   std::condition_variable written;    // signalled when a buffer is written
+   std::thread            *workers;
+   int                     numworkers;
+
+   AsyncOutBufferPimpl(AsyncOutBuffer *pOwner)
+      : ZoneObject(), owner(pOwner), f(NULL), pool(NULL), buffers(NULL),
+        lengths(NULL), encoded(NULL), outdata(NULL), outlengths(NULL),
+        states(NULL), numbuffers(0), head(0), count(0), writing(false),
+        stopping(false), failed(false), lock(), queued(), written(),
+        workers(NULL), numworkers(0)
+   {
+   }
+
+   //
+   // findWork
+   //
+   // Find the oldest buffer no worker has taken yet. Returns -1 if there is
+   // none.
+   //
+   int findWork() const
+   {
+      for(int i = 0; i < count; i++)
+      {
+         int slot = (head + i) % numbuffers;
+         if(states[slot] == SLOT_QUEUED)
+            return slot;
+      }
+      return -1;
+   }
+
+   //
+   // writeEncoded
+   //
+   // Write out encoded buffers from the head of the queue, for as long as
+   // they are ready. Only one worker writes at a time. Called with the lock
+   // held.
+   //
+   void writeEncoded(std::unique_lock<std::mutex> &guard)
+   {
+      while(!writing && count && states[head] == SLOT_ENCODED)
+      {
+         int slot = head;
+
+         // write without holding the lock, so the others can keep going
+         writing = true;
+         guard.unlock();
+         bool ok = (fwrite(outdata[slot], sizeof(byte), outlengths[slot], f) ==
+                    outlengths[slot]);
+         guard.lock();
+         writing = false;
+
+         if(!ok)
+            failed = true;
+
+         head = (head + 1) % numbuffers;
+         --count;
+         written.notify_all();
+
+         // idle workers may be waiting to exit
+         if(stopping && !count)
+            queued.notify_all();
+      }
+   }
+
+   //
+   // run
+   //
+   // Worker thread main loop.
+   //
+   void run()
+   {
+      void  *context = owner->CreateWorkerContext();
+      size_t bound   = encoded ? owner->EncodedBound(owner->len) : 0;
+
+      std::unique_lock<std::mutex> guard(lock);
+
+      for(;;)
+      {
+         int slot;
+
+         while((slot = findWork()) < 0 && !(stopping && !count))
+            queued.wait(guard);
+
+         if(slot < 0)
+            break;
+
+         states[slot] = SLOT_ENCODING;
+         guard.unlock();
+
+         bool ok = true;
+         if(bound)
+         {
+            size_t outsize = bound;
+            ok = owner->EncodeBlock(context, buffers[slot], lengths[slot],
+                                    encoded[slot], outsize);
+            outdata[slot]    = encoded[slot];
+            outlengths[slot] = ok ? outsize : 0;
+         }
+         else
+         {
+            outdata[slot]    = buffers[slot];
+            outlengths[slot] = lengths[slot];
+         }
+
+         guard.lock();
+         if(!ok)
+            failed = true;
+         states[slot] = SLOT_ENCODED;
+         writeEncoded(guard);
+      }
+
+      guard.unlock();
+      owner->DestroyWorkerContext(context);
+   }
+};
+
+//
+// AsyncOutBuffer Constructor
+//
+AsyncOutBuffer::AsyncOutBuffer()
+   : OutBuffer(), pImpl(new AsyncOutBufferPimpl(this))
+{
+}
+
+//
+// AsyncOutBuffer Destructor
+//
+AsyncOutBuffer::~AsyncOutBuffer()
+{
+   Close();
+   delete pImpl;
+}
+
+//
+// AsyncOutBuffer::OpenAsync
+//
+// Attach to an already open file, and start the workers. pLen is the size of
+// each of the pNumBuffers buffers, and is rounded up to a whole number of
+// pages. At least two buffers are needed.
+//
+bool AsyncOutBuffer::OpenAsync(FILE *pf, size_t pLen, int pNumBuffers, int pEndian,
+                               int pNumWorkers)
+{
+   if(!(f = pf) || pNumBuffers < 2 || pNumWorkers < 1)
+      return false;
+
+   pLen = (pLen + ASYNC_ALIGN - 1) & ~static_cast<size_t>(ASYNC_ALIGN - 1);
+   if(!pLen)
+      pLen = ASYNC_ALIGN;
+
+   len     = pLen;
+   idx     = 0;
+   endian  = pEndian;
+   ownFile = false;
+
+   pImpl->f          = pf;
+   pImpl->numbuffers = pNumBuffers;
+   pImpl->pool       = emalloc(byte *, pLen * pNumBuffers + ASYNC_ALIGN);
+   pImpl->buffers    = ecalloc(byte **,       pNumBuffers, sizeof(byte *));
+   pImpl->lengths    = ecalloc(size_t *,      pNumBuffers, sizeof(size_t));
+   pImpl->outdata    = ecalloc(const byte **, pNumBuffers, sizeof(const byte *));
+   pImpl->outlengths = ecalloc(size_t *,      pNumBuffers, sizeof(size_t));
+   pImpl->states     = ecalloc(int *,         pNumBuffers, sizeof(int));
+
+   byte *aligned = pImpl->pool +
+      ((ASYNC_ALIGN - (reinterpret_cast<uintptr_t>(pImpl->pool) & (ASYNC_ALIGN - 1)))
+       & (ASYNC_ALIGN - 1));
+
+   for(int i = 0; i < pNumBuffers; i++)
+      pImpl->buffers[i] = aligned + i * pLen;
+
+   size_t bound;
+   if((bound = EncodedBound(pLen)))
+   {
+      pImpl->encoded = ecalloc(byte **, pNumBuffers, sizeof(byte *));
+      for(int i = 0; i < pNumBuffers; i++)
+         pImpl->encoded[i] = emalloc(byte *, bound);
+   }
+
+   pImpl->head       = 0;
+   pImpl->count      = 0;
+   pImpl->writing    = false;
+   pImpl->stopping   = false;
+   pImpl->failed     = false;
+   pImpl->numworkers = pNumWorkers;
+   pImpl->workers    = new std::thread[pNumWorkers];
+   for(int i = 0; i < pNumWorkers; i++)
+      pImpl->workers[i] = std::thread(&AsyncOutBufferPimpl::run, pImpl);
+
+   buffer = pImpl->buffers[0];
+
+   return true;
+}
+
+//
+// AsyncOutBuffer::Flush
+//
+// Overrides OutBuffer::Flush()
+// Queue the current buffer for writing and move on to the next one, waiting
+// for it to be written out first if the ring is full. Returns false if a
+// write has failed.
+//
+bool AsyncOutBuffer::Flush()
+{
+   std::unique_lock<std::mutex> guard(pImpl->lock);
+
+   if(idx && !pImpl->failed)
+   {
+      int slot = (pImpl->head + pImpl->count) % pImpl->numbuffers;
+
+      pImpl->lengths[slot] = idx;
+      pImpl->states[slot]  = SLOT_QUEUED;
+      ++pImpl->count;
+      pImpl->queued.notify_one();
+
+      // the next buffer must not still be waiting to be written
+      while(pImpl->count == pImpl->numbuffers)
+         pImpl->written.wait(guard);
+
+      buffer = pImpl->buffers[(slot + 1) % pImpl->numbuffers];
+   }
+   idx = 0;
+
+   if(pImpl->failed)
+   {
+      if(throwing)
+         throw BufferedIOException("fwrite did not write the requested amount");
+      return false;
+   }
+
+   return true;
+}
+
+//
+// AsyncOutBuffer::Drain
+//
+// Queue any pending data, and wait until everything has been written out.
+// Returns false if any write failed.
+//
+bool AsyncOutBuffer::Drain()
+{
+   if(!pImpl->workers)
+      return true;
+
+   bool ok = Flush();
+
+   std::unique_lock<std::mutex> guard(pImpl->lock);
+   while(pImpl->count)
+      pImpl->written.wait(guard);
+
+   return ok && !pImpl->failed;
+}
+
+//
+// AsyncOutBuffer::Close
+//
+// Overrides OutBuffer::Close()
+// Write out everything, stop the workers, and free the buffers. The
+// file itself is left open.
+//
+void AsyncOutBuffer::Close()
+{
+   if(!pImpl->workers)
+      return;
+
+   try
+   {
+      Drain();
+   }
+   catch(...)
+   {
+   }
+
+   {
+      std::lock_guard<std::mutex> guard(pImpl->lock);
+      pImpl->stopping = true;
+      pImpl->queued.notify_all();
+   }
+   for(int i = 0; i < pImpl->numworkers; i++)
+      pImpl->workers[i].join();
+   delete [] pImpl->workers;
+   pImpl->workers    = NULL;
+   pImpl->numworkers = 0;
+
+   if(pImpl->encoded)
+   {
+      for(int i = 0; i < pImpl->numbuffers; i++)
+         efree(pImpl->encoded[i]);
+      efree(pImpl->encoded);
+      pImpl->encoded = NULL;
+   }
+   efree(pImpl->pool);
+   efree(pImpl->buffers);
+   efree(pImpl->lengths);
+   efree(pImpl->outdata);
+   efree(pImpl->outlengths);
+   efree(pImpl->states);
+   pImpl->pool       = NULL;
+   pImpl->buffers    = NULL;
+   pImpl->lengths    = NULL;
+   pImpl->outdata    = NULL;
+   pImpl->outlengths = NULL;
+   pImpl->states     = NULL;
+
+   // the buffer belonged to the pool
+   buffer = NULL;
+   BufferedFileBase::Close();
+}
+
+// EOF
@@ -0,0 +1,86 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//   Buffered file output written from a separate thread.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef M_ASYNCBUF_H__
+#define M_ASYNCBUF_H__
+
+#include "m_buffer.h"
+
+class AsyncOutBufferPimpl;
+
+//
+// AsyncOutBuffer
+//
+// An OutBuffer which hands each full buffer to worker threads instead of
+// writing it itself. Output cycles through a ring of equally sized buffers;
+// the producer only waits when every buffer but the one it is filling is
+// still queued. Buffers are page-aligned, and every write but the last is a
+// whole buffer.
+//
+// Subclasses can transform each buffer before it is written, by overriding
+// the encoding hooks. Buffers are then encoded by several workers at once,
+// and written out in order.
+//
+// Write errors are noticed by the workers, and reported by the next call to
+// Flush, Drain, or Close. Subclasses which encode must call Close from their
+// own destructor, so that the workers are stopped before the subclass is
+// destroyed.
+//
+class AsyncOutBuffer : public OutBuffer
+{
+protected:
+   AsyncOutBufferPimpl *pImpl;
+
+   friend class AsyncOutBufferPimpl;
+
+   // Encoding hooks, called from worker threads. EncodedBound returns the
+   // largest size a buffer of "size" bytes can encode to, or 0 if buffers
+   // are written as they are. Each worker has its own context.
+   virtual size_t EncodedBound(size_t size) { return 0; }
+   virtual void  *CreateWorkerContext() { return NULL; }
+   virtual void   DestroyWorkerContext(void *context) {}
+   virtual bool   EncodeBlock(void *context, const byte *data, size_t size,
+                              byte *out, size_t &outsize)
+   {
+      return false;
+   }
+
+public:
+   AsyncOutBuffer();
+   virtual ~AsyncOutBuffer();
+
+   bool OpenAsync(FILE *pf, size_t pLen, int pNumBuffers, int pEndian,
+                  int pNumWorkers = 1);
+
+   virtual bool Flush();
+   virtual void Close();
+
+   bool Drain();
+};
+
+#endif
+
+// EOF
+
@@ -64,13 +64,15 @@ long BufferedFileBase::Tell()
 //
 // BufferedFileBase::Close
 //
-// Common functionality for closing the file.
+// Common functionality for closing the file. Files the buffer was attached
+// to, rather than opened itself, are left open.
 //
 void BufferedFileBase::Close()
 {
    if(f)
    {
-      fclose(f);
+      if(ownFile)
+         fclose(f);
       f = NULL;
    }
 
@@ -191,6 +193,24 @@ bool OutBuffer::CreateFile(const char *filename, size_t pLen, int pEndian)
    return true;
 }
 
+//
+// OutBuffer::OpenExisting
+//
+// Attach the output buffer to an already open file, which the buffer will not
+// close.
+//
+bool OutBuffer::OpenExisting(FILE *pf, size_t pLen, int pEndian)
+{
+   if(!(f = pf))
+      return false;
+
+   InitBuffer(pLen, pEndian);
+
+   ownFile = false;
+
+   return true;
+}
+
 //
 // OutBuffer::Flush
 //
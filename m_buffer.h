@@ -111,8 +111,9 @@ class OutBuffer : public BufferedFileBase
 {
 public:
    bool CreateFile(const char *filename, size_t pLen, int pEndian);
-   bool Flush();
-   void Close();
+   bool OpenExisting(FILE *pf, size_t pLen, int pEndian);
+   virtual bool Flush();
+   virtual void Close();
 
    bool Write(const void *data, size_t size);
    bool WriteSint32(int32_t  num);
@@ -0,0 +1,315 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      ASCII case-insensitive string kernels
+//
+//-----------------------------------------------------------------------------
+
+#include "z_zone.h"
+#include "m_casefold.h"
+#include "m_ctype.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FOLD_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Index of the lowest set bit of a nonzero mask
+static inline int M_lowestBit(unsigned int mask)
+{
+#ifdef _MSC_VER
+   unsigned long bit;
+   _BitScanForward(&bit, mask);
+   return static_cast<int>(bit);
+#else
+   return __builtin_ctz(mask);
+#endif
+}
+
+//
+// M_canLoad16
+//
+// True if 16 bytes can be read starting at p without touching the next page.
+//
+static inline bool M_canLoad16(const char *p)
+{
+   return (reinterpret_cast<uintptr_t>(p) & 4095) <= 4096 - 16;
+}
+
+static inline __m128i M_load16(const char *p)
+{
+   return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+//
+// M_caseMask
+//
+// 0xFF in each byte of v which lies between first and first + 25. Bytes are
+// biased so that the range starts at -128, which lets one signed comparison
+// test both ends.
+//
+static inline __m128i M_caseMask(__m128i v, char first)
+{
+   __m128i biased = _mm_sub_epi8(v, _mm_set1_epi8(static_cast<char>(first + 128)));
+   return _mm_cmplt_epi8(biased, _mm_set1_epi8(-128 + 26));
+}
+
+static inline __m128i M_lower16(__m128i v)
+{
+   return _mm_or_si128(v, _mm_and_si128(M_caseMask(v, 'A'), _mm_set1_epi8(0x20)));
+}
+
+static inline __m128i M_upper16(__m128i v)
+{
+   return _mm_andnot_si128(_mm_and_si128(M_caseMask(v, 'a'), _mm_set1_epi8(0x20)), v);
+}
+#endif
+
+static inline int M_lowerChar(char c)
+{
+   return ectype::toLower(static_cast<unsigned char>(c));
+}
+
+//
+// M_FoldCompare
+//
+// Compare up to n characters of s1 and s2 without regard to case. Returns
+// the difference of the first pair of folded characters which differ, or 0;
+// a null ends the comparison.
+//
+int M_FoldCompare(const char *s1, const char *s2, size_t n)
+{
+#ifdef FOLD_SSE2
+   const __m128i zero = _mm_setzero_si128();
+
+   while(n && M_canLoad16(s1) && M_canLoad16(s2))
+   {
+      __m128i a = M_load16(s1);
+      __m128i b = M_load16(s2);
+      __m128i same = _mm_cmpeq_epi8(M_lower16(a), M_lower16(b));
+
+      // stop at the first difference, or at the end of s1
+      unsigned int stop = (~static_cast<unsigned int>(_mm_movemask_epi8(same)) |
+                           static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, zero))))
+                          & 0xFFFF;
+      if(n < 16)
+         stop &= (1u << n) - 1;
+      if(stop)
+      {
+         int i = M_lowestBit(stop);
+         return M_lowerChar(s1[i]) - M_lowerChar(s2[i]);
+      }
+      if(n <= 16)
+         return 0;
+
+      s1 += 16;
+      s2 += 16;
+      n  -= 16;
+   }
+#endif
+
+   for(; n; --n, ++s1, ++s2)
+   {
+      int c1 = M_lowerChar(*s1);
+      int c2 = M_lowerChar(*s2);
+
+      if(c1 != c2 || !c1)
+         return c1 - c2;
+   }
+
+   return 0;
+}
+
+//
+// M_FoldPrefix
+//
+// True if str begins with prefix, without regard to case.
+//
+bool M_FoldPrefix(const char *str, const char *prefix)
+{
+#ifdef FOLD_SSE2
+   const __m128i zero = _mm_setzero_si128();
+
+   while(M_canLoad16(str) && M_canLoad16(prefix))
+   {
+      __m128i s = M_load16(str);
+      __m128i p = M_load16(prefix);
+      __m128i same = _mm_cmpeq_epi8(M_lower16(s), M_lower16(p));
+
+      // the prefix matches if it ends before the first difference
+      unsigned int stop = (~static_cast<unsigned int>(_mm_movemask_epi8(same)) |
+                           static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(p, zero))))
+                          & 0xFFFF;
+      if(stop)
+         return !prefix[M_lowestBit(stop)];
+
+      str    += 16;
+      prefix += 16;
+   }
+#endif
+
+   for(; *prefix; ++str, ++prefix)
+   {
+      if(M_lowerChar(*str) != M_lowerChar(*prefix))
+         return false;
+   }
+
+   return true;
+}
+
+//
+// M_FoldFindChar
+//
+// Returns a pointer to the first character in str which equals c without
+// regard to case, or NULL if the string ends first. Once the scan reaches a
+// 16-byte boundary it uses aligned loads, which never cross a page.
+//
+const char *M_FoldFindChar(const char *str, int c)
+{
+   int lc = ectype::toLower(static_cast<unsigned char>(c));
+
+#ifdef FOLD_SSE2
+   while(reinterpret_cast<uintptr_t>(str) & 15)
+   {
+      if(M_lowerChar(*str) == lc)
+         return str;
+      if(!*str)
+         return NULL;
+      ++str;
+   }
+
+   const __m128i zero   = _mm_setzero_si128();
+   const __m128i target = _mm_set1_epi8(static_cast<char>(lc));
+
+   for(;; str += 16)
+   {
+      __m128i block = _mm_load_si128(reinterpret_cast<const __m128i *>(str));
+      unsigned int found =
+         static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(M_lower16(block), target)));
+      unsigned int end =
+         static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)));
+
+      if(found | end)
+      {
+         int i = M_lowestBit(found | end);
+         return (found & (1u << i)) ? str + i : NULL;
+      }
+   }
+#else
+   while(*str && M_lowerChar(*str) != lc)
+      ++str;
+   return (M_lowerChar(*str) == lc) ? str : NULL;
+#endif
+}
+
+//
+// M_FoldLower
+//
+// Convert the first n characters of s to lowercase.
+//
+void M_FoldLower(char *s, size_t n)
+{
+#ifdef FOLD_SSE2
+   for(; n >= 16; s += 16, n -= 16)
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(s), M_lower16(M_load16(s)));
+#endif
+
+   for(; n; --n, ++s)
+      *s = static_cast<char>(M_lowerChar(*s));
+}
+
+//
+// M_FoldUpper
+//
+// Convert the first n characters of s to uppercase.
+//
+void M_FoldUpper(char *s, size_t n)
+{
+#ifdef FOLD_SSE2
+   for(; n >= 16; s += 16, n -= 16)
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(s), M_upper16(M_load16(s)));
+#endif
+
+   for(; n; --n, ++s)
+      *s = static_cast<char>(ectype::toUpper(static_cast<unsigned char>(*s)));
+}
+
+//
+// M_FoldKey
+//
+// Packs an up-to-eight-character name into a single upper-cased 64-bit key,
+// so that names can be compared with one integer comparison. Bytes following
+// the name's terminator are zero.
+//
+uint64_t M_FoldKey(const char *s)
+{
+   uint64_t key = 0;
+
+#ifdef FOLD_SSE2
+   if(M_canLoad16(s))
+   {
+      __m128i name = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(s));
+      int     len  = M_lowestBit(static_cast<unsigned int>(
+         _mm_movemask_epi8(_mm_cmpeq_epi8(name, _mm_setzero_si128()))) | 0x100);
+
+      // clear everything from the terminator on
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(&key), M_upper16(name));
+      if(len < 8)
+         key &= (UINT64_C(1) << (len * 8)) - 1;
+      return key;
+   }
+#endif
+
+   for(int i = 0; i < 8 && s[i]; i++)
+   {
+      key |= static_cast<uint64_t>(ectype::toUpper(static_cast<unsigned char>(s[i])))
+             << (i * 8);
+   }
+
+   return key;
+}
+
+//
+// M_FoldKeyHash
+//
+// Killough's lump name hash, taken over the characters of a key from
+// M_FoldKey rather than over the name itself. The eighth character is
+// always included once the seventh is present.
+//
+unsigned int M_FoldKeyHash(uint64_t key)
+{
+   unsigned int hash = static_cast<unsigned int>(key & 0xFF);
+
+   for(int i = 1; i < 8; i++)
+   {
+      unsigned int c = static_cast<unsigned int>((key >> (i * 8)) & 0xFF);
+
+      if(!c && i < 7)
+         break;
+      hash = hash * (i == 1 ? 3 : 2) + c;
+   }
+
+   return hash;
+}
+
+// EOF
@@ -0,0 +1,61 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      ASCII case-insensitive string kernels
+//
+//-----------------------------------------------------------------------------
+
+#ifndef M_CASEFOLD_H__
+#define M_CASEFOLD_H__
+
+#include "doomtype.h"
+
+//
+// Case folding
+//
+// Only the ASCII letters are folded; every other byte compares as itself.
+// Where SSE2 is available, strings are processed 16 bytes at a time. The
+// kernels may read past the end of a string, but never into another page.
+//
+
+// Compare up to n characters, stopping at a null; same result as strncasecmp
+int M_FoldCompare(const char *s1, const char *s2, size_t n);
+
+// True if str begins with prefix, ignoring case
+bool M_FoldPrefix(const char *str, const char *prefix);
+
+// Find the first character equal to c, ignoring case; NULL if none
+const char *M_FoldFindChar(const char *str, int c);
+
+// Fold the first n characters of s in place
+void M_FoldLower(char *s, size_t n);
+void M_FoldUpper(char *s, size_t n);
+
+// Pack up to eight characters into an upper-cased key; bytes following the
+// string's terminator are zero
+uint64_t M_FoldKey(const char *s);
+
+// Lump name hash of a key produced by M_FoldKey
+unsigned int M_FoldKeyHash(uint64_t key);
+
+#endif
+
+// EOF
@@ -0,0 +1,136 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//   Gzip-compressed buffered file output.
+//
+//-----------------------------------------------------------------------------
+
+#include "z_zone.h"
+#include "m_gzbuf.h"
+
+#include "zlib/zlib.h"
+
+// Speed matters more than size here; output is compressed while it is being
+// produced
+#define GZBUF_LEVEL Z_BEST_SPEED
+
+// Window bits for deflateInit2; adding 16 selects a gzip header and trailer
+#define GZBUF_WBITS (MAX_WBITS + 16)
+
+//
+// GzipOutBuffer Destructor
+//
+// The workers call back into this object, so they must be stopped before it
+// is destroyed.
+//
+GzipOutBuffer::~GzipOutBuffer()
+{
+   Close();
+}
+
+//
+// GzipOutBuffer::CreateWorkerContext
+//
+// Each worker gets its own deflate stream, which is reset for every buffer.
+// zlib allocates with malloc, not the zone, as this runs on the worker's
+// thread.
+//
+void *GzipOutBuffer::CreateWorkerContext()
+{
+   z_stream *zs = new z_stream;
+
+   memset(zs, 0, sizeof(*zs));
+   zs->zalloc = NULL;
+   zs->zfree  = NULL;
+   zs->opaque = NULL;
+
+   if(deflateInit2(zs, GZBUF_LEVEL, Z_DEFLATED, GZBUF_WBITS, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+   {
+      delete zs;
+      return NULL;
+   }
+
+   return zs;
+}
+
+//
+// GzipOutBuffer::DestroyWorkerContext
+//
+void GzipOutBuffer::DestroyWorkerContext(void *context)
+{
+   z_stream *zs;
+
+   if((zs = static_cast<z_stream *>(context)))
+   {
+      deflateEnd(zs);
+      delete zs;
+   }
+}
+
+//
+// GzipOutBuffer::EncodedBound
+//
+// Largest gzip member a buffer of the given size can compress to.
+//
+size_t GzipOutBuffer::EncodedBound(size_t size)
+{
+   z_stream zs;
+   size_t   bound;
+
+   memset(&zs, 0, sizeof(zs));
+   if(deflateInit2(&zs, GZBUF_LEVEL, Z_DEFLATED, GZBUF_WBITS, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+      return compressBound(static_cast<uLong>(size)) + 32;
+
+   bound = deflateBound(&zs, static_cast<uLong>(size));
+   deflateEnd(&zs);
+
+   return bound;
+}
+
+//
+// GzipOutBuffer::EncodeBlock
+//
+// Compress one buffer into a complete gzip member.
+//
+bool GzipOutBuffer::EncodeBlock(void *context, const byte *data, size_t size,
+                                byte *out, size_t &outsize)
+{
+   z_stream *zs = static_cast<z_stream *>(context);
+
+   if(!zs || deflateReset(zs) != Z_OK)
+      return false;
+
+   zs->next_in   = const_cast<Bytef *>(data);
+   zs->avail_in  = static_cast<uInt>(size);
+   zs->next_out  = out;
+   zs->avail_out = static_cast<uInt>(outsize);
+
+   if(deflate(zs, Z_FINISH) != Z_STREAM_END)
+      return false;
+
+   outsize = zs->total_out;
+   return true;
+}
+
+// EOF
+
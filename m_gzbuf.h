@@ -0,0 +1,56 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//   Gzip-compressed buffered file output.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef M_GZBUF_H__
+#define M_GZBUF_H__
+
+#include "m_asyncbuf.h"
+
+//
+// GzipOutBuffer
+//
+// An AsyncOutBuffer which compresses its output. Each buffer is deflated by
+// one of the workers into an independent gzip member; a file of several
+// members concatenated together is itself a valid gzip file, and decompresses
+// to the original output in full.
+//
+class GzipOutBuffer : public AsyncOutBuffer
+{
+protected:
+   virtual size_t EncodedBound(size_t size);
+   virtual void  *CreateWorkerContext();
+   virtual void   DestroyWorkerContext(void *context);
+   virtual bool   EncodeBlock(void *context, const byte *data, size_t size,
+                              byte *out, size_t &outsize);
+
+public:
+   GzipOutBuffer() : AsyncOutBuffer() {}
+   virtual ~GzipOutBuffer();
+};
+
+#endif
+
+// EOF
+
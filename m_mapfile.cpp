@@ -0,0 +1,115 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Read-only files mapped into memory
+//
+//-----------------------------------------------------------------------------
+
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <utility>
+
+#include "z_zone.h"
+#include "m_mapfile.h"
+#include "m_misc.h"
+
+//
+// MappedFile::open
+//
+// Map a file into memory. Returns false if it cannot be read, or is empty.
+//
+bool MappedFile::open(const char *filename)
+{
+   close();
+
+#ifndef _MSC_VER
+   int fd;
+   struct stat sbuf;
+
+   if((fd = ::open(filename, O_RDONLY)) < 0)
+      return false;
+
+   if(!fstat(fd, &sbuf) && sbuf.st_size > 0)
+   {
+      void *map = mmap(NULL, static_cast<size_t>(sbuf.st_size), PROT_READ,
+                       MAP_PRIVATE, fd, 0);
+      if(map != MAP_FAILED)
+      {
+         data   = static_cast<const byte *>(map);
+         size   = static_cast<size_t>(sbuf.st_size);
+         mapped = true;
+      }
+   }
+   ::close(fd);
+#else
+   // no mapping; read the whole file instead
+   byte *buffer = NULL;
+   int   len;
+
+   if((len = M_ReadFile(filename, &buffer)) > 0)
+   {
+      data = buffer;
+      size = static_cast<size_t>(len);
+   }
+#endif
+
+   return data != NULL;
+}
+
+//
+// MappedFile::close
+//
+void MappedFile::close()
+{
+   if(data)
+   {
+#ifndef _MSC_VER
+      if(mapped)
+         munmap(const_cast<byte *>(data), size);
+      else
+#endif
+         efree(const_cast<byte *>(data));
+   }
+
+   data   = NULL;
+   size   = 0;
+   mapped = false;
+}
+
+//
+// MappedFile::swap
+//
+// Exchange files with another MappedFile.
+//
+void MappedFile::swap(MappedFile &other)
+{
+   std::swap(data,   other.data);
+   std::swap(size,   other.size);
+   std::swap(mapped, other.mapped);
+}
+
+// EOF
+
@@ -0,0 +1,61 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Read-only files mapped into memory
+//
+//-----------------------------------------------------------------------------
+
+#ifndef M_MAPFILE_H__
+#define M_MAPFILE_H__
+
+#include "doomtype.h"
+
+//
+// MappedFile
+//
+// A whole file, mapped read-only so that its pages are shared with any other
+// process mapping it. Where mapping is not available, the file is read into
+// memory instead.
+//
+class MappedFile
+{
+protected:
+   const byte *data;
+   size_t      size;
+   bool        mapped; // true if data is a memory mapping
+
+public:
+   MappedFile() : data(NULL), size(0), mapped(false) {}
+   ~MappedFile() { close(); }
+
+   bool open(const char *filename);
+   void close();
+   void swap(MappedFile &other);
+
+   const byte *getData() const { return data; }
+   size_t      getSize() const { return size; }
+   bool        isOpen()  const { return !!data; }
+};
+
+#endif
+
+// EOF
+
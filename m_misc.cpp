@@ -41,6 +41,7 @@
 #include "i_opndir.h"
 #include "i_system.h"
 #include "m_argv.h"
+#include "m_casefold.h"
 #include "m_misc.h"
 #include "m_qstr.h"
 #include "w_wad.h"
@@ -166,28 +167,14 @@ char *M_LoadStringFromFile(const char *filename)
 // haleyjd: portable strupr function
 char *M_Strupr(char *string)
 {
-   char *s = string;
-
-   while(*s)
-   {
-      int c = ectype::toUpper(*s);
-      *s++ = c;
-   }
-
+   M_FoldUpper(string, strlen(string));
    return string;
 }
 
 // haleyjd: portable strlwr function
 char *M_Strlwr(char *string)
 {
-   char *s = string;
-
-   while(*s)
-   {
-      int c = ectype::toLower(*s);
-      *s++ = c;
-   }
-
+   M_FoldLower(string, strlen(string));
    return string;
 }
 
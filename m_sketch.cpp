@@ -0,0 +1,181 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Mergeable streaming quantile sketches
+//
+//-----------------------------------------------------------------------------
+
+#include <math.h>
+
+#include "z_zone.h"
+#include "m_sketch.h"
+
+// Values below this are counted exactly
+#define SKETCH_EXACT 64
+
+// Ratio between the bounds of each bucket above SKETCH_EXACT
+#define SKETCH_GAMMA 1.02
+
+//
+// SK_bucketForValue
+//
+static int SK_bucketForValue(int value)
+{
+   if(value < SKETCH_EXACT)
+      return value < 0 ? 0 : value;
+
+   return SKETCH_EXACT +
+      static_cast<int>(floor(log(static_cast<double>(value) / SKETCH_EXACT) /
+                             log(SKETCH_GAMMA)));
+}
+
+//
+// SK_valueForBucket
+//
+// The value that stands for everything in a bucket: for a geometric bucket,
+// the point with the same relative distance to either bound.
+//
+static double SK_valueForBucket(int bucket)
+{
+   if(bucket < SKETCH_EXACT)
+      return bucket;
+
+   double lower = SKETCH_EXACT * pow(SKETCH_GAMMA, bucket - SKETCH_EXACT);
+   return 2.0 * lower * SKETCH_GAMMA / (1.0 + SKETCH_GAMMA);
+}
+
+//
+// QuantileSketch Destructor
+//
+QuantileSketch::~QuantileSketch()
+{
+   free(buckets);
+}
+
+//
+// QuantileSketch::growTo
+//
+// Make room for at least newnumbuckets buckets. Allocation failure cannot be
+// reported from a worker thread, so it aborts.
+//
+void QuantileSketch::growTo(int newnumbuckets)
+{
+   uint64_t *newbuckets;
+   int       newsize = numbuckets ? numbuckets : 8;
+
+   while(newsize < newnumbuckets)
+      newsize *= 2;
+
+   if(!(newbuckets = static_cast<uint64_t *>(realloc(buckets, newsize * sizeof(uint64_t)))))
+      abort();
+
+   memset(newbuckets + numbuckets, 0, (newsize - numbuckets) * sizeof(uint64_t));
+   buckets    = newbuckets;
+   numbuckets = newsize;
+}
+
+//
+// QuantileSketch::add
+//
+// Add a value to the stream, weight times over. Negative values are not
+// expected; they are kept in the sum and minimum, but counted as zero.
+//
+void QuantileSketch::add(int value, uint64_t weight)
+{
+   if(!weight)
+      return;
+
+   int bucket = SK_bucketForValue(value);
+
+   if(bucket >= numbuckets)
+      growTo(bucket + 1);
+   buckets[bucket] += weight;
+
+   if(!count || value < minimum)
+      minimum = value;
+   if(!count || value > maximum)
+      maximum = value;
+   count += weight;
+   sum   += static_cast<int64_t>(value) * static_cast<int64_t>(weight);
+}
+
+//
+// QuantileSketch::merge
+//
+// Add everything in another sketch to this one.
+//
+void QuantileSketch::merge(const QuantileSketch &other)
+{
+   if(!other.count)
+      return;
+
+   if(other.numbuckets > numbuckets)
+      growTo(other.numbuckets);
+   for(int i = 0; i < other.numbuckets; i++)
+      buckets[i] += other.buckets[i];
+
+   if(!count || other.minimum < minimum)
+      minimum = other.minimum;
+   if(!count || other.maximum > maximum)
+      maximum = other.maximum;
+   count += other.count;
+   sum   += other.sum;
+}
+
+//
+// QuantileSketch::quantile
+//
+// Value at quantile q (0 to 1) of the stream, by nearest rank. Exact below
+// SKETCH_EXACT, and always within the minimum and maximum. Returns 0 for an
+// empty sketch.
+//
+int QuantileSketch::quantile(double q) const
+{
+   if(!count)
+      return 0;
+
+   // the rank-th smallest value, counting from 1
+   uint64_t rank = static_cast<uint64_t>(ceil(q * static_cast<double>(count)));
+   if(rank < 1)
+      rank = 1;
+   else if(rank > count)
+      rank = count;
+
+   uint64_t seen = 0;
+   for(int i = 0; i < numbuckets; i++)
+   {
+      if((seen += buckets[i]) >= rank)
+      {
+         double value = SK_valueForBucket(i);
+
+         if(value < minimum)
+            return minimum;
+         if(value > maximum)
+            return maximum;
+         return static_cast<int>(floor(value + 0.5));
+      }
+   }
+
+   return maximum;
+}
+
+// EOF
+
@@ -0,0 +1,78 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Mergeable streaming quantile sketches
+//
+//-----------------------------------------------------------------------------
+
+#ifndef M_SKETCH_H__
+#define M_SKETCH_H__
+
+//
+// QuantileSketch
+//
+// Summarizes a stream of non-negative integers in bounded memory: count,
+// sum, minimum, maximum, and approximate quantiles. Values below
+// SKETCH_EXACT are counted exactly; larger ones fall into buckets whose
+// bounds grow geometrically, so a quantile is accurate to within about 1%
+// of its value. No more than a thousand or so buckets are ever needed, and
+// most streams of small counts need only a few.
+//
+// Sketches of separate streams can be merged, giving the same result as a
+// single sketch of both. Storage comes from malloc rather than the zone, so
+// sketches may be built on worker threads.
+//
+class QuantileSketch
+{
+protected:
+   uint64_t *buckets;
+   int       numbuckets;
+   uint64_t  count;
+   int64_t   sum;
+   int       minimum;
+   int       maximum;
+
+   void growTo(int newnumbuckets);
+
+public:
+   QuantileSketch()
+      : buckets(NULL), numbuckets(0), count(0), sum(0), minimum(0), maximum(0)
+   {
+   }
+   ~QuantileSketch();
+
+   void add(int value, uint64_t weight = 1);
+   void merge(const QuantileSketch &other);
+   int  quantile(double q) const;
+
+   uint64_t getCount()   const { return count;   }
+   int      getMinimum() const { return minimum; }
+   int      getMaximum() const { return maximum; }
+   double   getMean()    const
+   {
+      return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+   }
+};
+
+#endif
+
+// EOF
+
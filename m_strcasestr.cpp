@@ -27,6 +27,7 @@
 //-----------------------------------------------------------------------------
 
 #include "z_zone.h"
+#include "m_casefold.h"
 #include "m_ctype.h"
 #include "i_system.h"
 
@@ -162,8 +163,14 @@ const char *M_StrCaseStr(const char *haystack, const char *needle)
       ++needle;
       for(;; haystack++)
       {
-         if(!*haystack)
+         // Skip ahead to the next occurrence of the first character; each
+         // character passed over counts as one loop and one comparison.
+         const char *next = M_FoldFindChar(haystack, b);
+         if(!next)
             return NULL; // No match.
+         outer_loop_count += next - haystack;
+         comparison_count += next - haystack;
+         haystack = next;
 
          // See whether it's advisable to use an asymptotically faster algorithm
          if(try_kmp && 
@@ -192,22 +199,20 @@ const char *M_StrCaseStr(const char *haystack, const char *needle)
 
          ++outer_loop_count;
          ++comparison_count;
-         if(ectype::toLower(*haystack) == b)
+
+         // The first character matches
+         const char *rhaystack = haystack + 1;
+         const char *rneedle = needle;
+         for(;; rhaystack++, rneedle++)
          {
-            // The first character matches
-            const char *rhaystack = haystack + 1;
-            const char *rneedle = needle;
-            for(;; rhaystack++, rneedle++)
-            {
-               if(!*rneedle)
-                  return haystack; // Found a match
-               if(!*rhaystack)
-                  return NULL; // No match.
-               
-               ++comparison_count;
-               if(ectype::toLower(*rhaystack) != ectype::toLower(*rneedle))
-                  break; // Nothing in this round.
-            }
+            if(!*rneedle)
+               return haystack; // Found a match
+            if(!*rhaystack)
+               return NULL; // No match.
+            
+            ++comparison_count;
+            if(ectype::toLower(*rhaystack) != ectype::toLower(*rneedle))
+               break; // Nothing in this round.
          }
       }
    }
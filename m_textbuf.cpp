@@ -0,0 +1,372 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//   Reusable text output buffer with fixed-width field emitters.
+//
+//-----------------------------------------------------------------------------
+
+#include <math.h>
+
+#include "z_zone.h"
+#include "m_buffer.h"
+#include "m_textbuf.h"
+
+//
+// TextBuffer Destructor
+//
+TextBuffer::~TextBuffer()
+{
+   if(buffer)
+   {
+      efree(buffer);
+      buffer = NULL;
+   }
+}
+
+//
+// TextBuffer::grow
+//
+// Enlarge the buffer to hold at least "needed" characters, at least doubling
+// it so that appends stay amortized constant time.
+//
+void TextBuffer::grow(size_t needed)
+{
+   size_t newsize = size ? size * 2 : 1024;
+
+   while(newsize < needed)
+      newsize *= 2;
+
+   buffer = erealloc(char *, buffer, newsize);
+   size   = newsize;
+}
+
+//
+// TextBuffer::addStr
+//
+// Append "len" characters of a string.
+//
+TextBuffer &TextBuffer::addStr(const char *str, size_t len)
+{
+   reserve(len);
+   memcpy(buffer + length, str, len);
+   length += len;
+   return *this;
+}
+
+//
+// TextBuffer::addStr
+//
+// Append a null-terminated string.
+//
+TextBuffer &TextBuffer::addStr(const char *str)
+{
+   return addStr(str, strlen(str));
+}
+
+//
+// TextBuffer::addRepeated
+//
+// Append a character "count" times.
+//
+TextBuffer &TextBuffer::addRepeated(char c, size_t count)
+{
+   reserve(count);
+   memset(buffer + length, c, count);
+   length += count;
+   return *this;
+}
+
+//
+// TB_formatInt
+//
+// Write the decimal digits of value, with a leading minus sign if negative,
+// to the end of the 12-character area ending at "end". Returns a pointer to
+// the first character written.
+//
+static char *TB_formatInt(int value, char *end)
+{
+   // go through unsigned so that INT_MIN negates properly
+   unsigned int uval = value < 0 ? 0u - static_cast<unsigned int>(value) :
+                                   static_cast<unsigned int>(value);
+   char *p = end;
+
+   do
+   {
+      *--p  = static_cast<char>('0' + uval % 10);
+      uval /= 10;
+   }
+   while(uval);
+
+   if(value < 0)
+      *--p = '-';
+
+   return p;
+}
+
+//
+// TB_formatInt64
+//
+// As TB_formatInt, for a 64-bit value; the area ending at "end" must hold 21
+// characters.
+//
+static char *TB_formatInt64(int64_t value, char *end)
+{
+   uint64_t uval = value < 0 ? 0u - static_cast<uint64_t>(value) :
+                               static_cast<uint64_t>(value);
+   char *p = end;
+
+   do
+   {
+      *--p  = static_cast<char>('0' + uval % 10);
+      uval /= 10;
+   }
+   while(uval);
+
+   if(value < 0)
+      *--p = '-';
+
+   return p;
+}
+
+//
+// TextBuffer::addInt
+//
+// Append an integer in decimal, as "%d".
+//
+TextBuffer &TextBuffer::addInt(int value)
+{
+   char  digits[12];
+   char *end   = digits + sizeof(digits);
+   char *start = TB_formatInt(value, end);
+
+   return addStr(start, end - start);
+}
+
+//
+// TextBuffer::addIntRight
+//
+// Append an integer right-justified in a field of "width" characters, as
+// "%<width>d". Like printf, wider values are not truncated.
+//
+TextBuffer &TextBuffer::addIntRight(int value, size_t width)
+{
+   char   digits[12];
+   char  *end   = digits + sizeof(digits);
+   char  *start = TB_formatInt(value, end);
+   size_t len   = end - start;
+
+   if(len < width)
+      addRepeated(' ', width - len);
+
+   return addStr(start, len);
+}
+
+//
+// TextBuffer::addInt64
+//
+// Append a 64-bit integer in decimal, as "%lld".
+//
+TextBuffer &TextBuffer::addInt64(int64_t value)
+{
+   char  digits[21];
+   char *end   = digits + sizeof(digits);
+   char *start = TB_formatInt64(value, end);
+
+   return addStr(start, end - start);
+}
+
+//
+// TextBuffer::addInt64Right
+//
+// Append a 64-bit integer right-justified in a field of "width" characters,
+// as "%<width>lld".
+//
+TextBuffer &TextBuffer::addInt64Right(int64_t value, size_t width)
+{
+   char   digits[21];
+   char  *end   = digits + sizeof(digits);
+   char  *start = TB_formatInt64(value, end);
+   size_t len   = end - start;
+
+   if(len < width)
+      addRepeated(' ', width - len);
+
+   return addStr(start, len);
+}
+
+// Most decimal places addFixed produces
+#define TB_MAXDECIMALS 9
+
+// Largest scaled magnitude formatted directly. Scaled values this small are
+// accurate to well under TB_TIEMARGIN, so rounding can only be mistaken
+// when the value is very nearly a tie.
+#define TB_MAXFIXED  1e12
+#define TB_TIEMARGIN 1e-3
+
+//
+// TB_formatFixed
+//
+// Format a value with a fixed number of decimal places, as "%.<decimals>f",
+// into the 32-character area ending at "end". Rather than going through
+// printf (or M_Fcvt), the value is scaled and rounded to an integer and its
+// digits written directly. Returns the number of characters written, or 0
+// for values which must be left to the C library: NaNs, infinities, huge
+// values, and those so close to halfway between two results that the
+// scaling may have rounded them the wrong way.
+//
+static size_t TB_formatFixed(double value, int decimals, char *end)
+{
+   static const double scales[TB_MAXDECIMALS + 1] =
+   {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+   };
+
+   double scaled = fabs(value) * scales[decimals];
+
+   if(!(scaled < TB_MAXFIXED))
+      return 0;
+
+   double whole = floor(scaled);
+   double frac  = scaled - whole;
+
+   if(fabs(frac - 0.5) < TB_TIEMARGIN)
+      return 0;
+
+   uint64_t uval = static_cast<uint64_t>(whole) + (frac > 0.5);
+   char    *p    = end;
+
+   // fractional digits, then the integer part
+   for(int i = 0; i < decimals; i++)
+   {
+      *--p  = static_cast<char>('0' + uval % 10);
+      uval /= 10;
+   }
+   if(decimals)
+      *--p = '.';
+   do
+   {
+      *--p  = static_cast<char>('0' + uval % 10);
+      uval /= 10;
+   }
+   while(uval);
+   if(signbit(value))
+      *--p = '-';
+
+   return end - p;
+}
+
+//
+// TextBuffer::addFixed
+//
+// Append a value with a fixed number of decimal places, as "%.<decimals>f".
+// At most TB_MAXDECIMALS places are produced.
+//
+TextBuffer &TextBuffer::addFixed(double value, int decimals)
+{
+   return addFixedRight(value, decimals, 0);
+}
+
+//
+// TextBuffer::addFixedRight
+//
+// Append a value with a fixed number of decimal places, right-justified in a
+// field of "width" characters, as "%<width>.<decimals>f".
+//
+TextBuffer &TextBuffer::addFixedRight(double value, int decimals, size_t width)
+{
+   char   digits[32];
+   char  *end = digits + sizeof(digits);
+   size_t len;
+
+   if(decimals < 0)
+      decimals = 0;
+   else if(decimals > TB_MAXDECIMALS)
+      decimals = TB_MAXDECIMALS;
+
+   if((len = TB_formatFixed(value, decimals, end)))
+   {
+      if(len < width)
+         addRepeated(' ', width - len);
+      return addStr(end - len, len);
+   }
+
+   // the C library handles everything else
+   int needed = snprintf(NULL, 0, "%*.*f", static_cast<int>(width), decimals, value);
+   reserve(static_cast<size_t>(needed) + 1);
+   snprintf(buffer + length, needed + 1, "%*.*f", static_cast<int>(width), decimals, value);
+   length += needed;
+
+   return *this;
+}
+
+//
+// TextBuffer::addStrMax
+//
+// Append at most "maxlen" characters of a string, as "%.<maxlen>s".
+//
+TextBuffer &TextBuffer::addStrMax(const char *str, size_t maxlen)
+{
+   size_t len = 0;
+
+   while(len < maxlen && str[len])
+      ++len;
+
+   return addStr(str, len);
+}
+
+//
+// TextBuffer::addStrLeft
+//
+// Append a string left-justified in a field of exactly "width" characters,
+// truncating it if it is longer, as "%-<width>.<width>s".
+//
+TextBuffer &TextBuffer::addStrLeft(const char *str, size_t width)
+{
+   size_t len = 0;
+
+   while(len < width && str[len])
+      ++len;
+
+   reserve(width);
+   memcpy(buffer + length, str, len);
+   memset(buffer + length + len, ' ', width - len);
+   length += width;
+
+   return *this;
+}
+
+//
+// TextBuffer::writeTo
+//
+// Write the contents of the buffer to an output buffer with a single call,
+// and empty the buffer. Returns false if the write failed.
+//
+bool TextBuffer::writeTo(OutBuffer &ob)
+{
+   size_t towrite = length;
+
+   length = 0;
+
+   return !towrite || ob.Write(buffer, towrite);
+}
+
+// EOF
+
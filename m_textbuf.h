@@ -0,0 +1,91 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//   Reusable text output buffer with fixed-width field emitters.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef M_TEXTBUF_H__
+#define M_TEXTBUF_H__
+
+class OutBuffer;
+
+//
+// TextBuffer
+//
+// Accumulates report text in memory so that it can be written out with a
+// single call. The emitters produce the same text as the printf conversions
+// noted beside them, without parsing a format string. Clearing the buffer
+// keeps its storage, so a buffer reused for each report stops allocating
+// once it has grown to fit the largest one.
+//
+class TextBuffer
+{
+protected:
+   char  *buffer; // text storage; not null-terminated
+   size_t length; // amount of text in the buffer
+   size_t size;   // allocated size of the buffer
+
+   void grow(size_t needed);
+
+   // make sure "amount" more characters fit
+   void reserve(size_t amount)
+   {
+      if(length + amount > size)
+         grow(length + amount);
+   }
+
+public:
+   TextBuffer() : buffer(NULL), length(0), size(0) {}
+   ~TextBuffer();
+
+   void clear() { length = 0; }
+
+   TextBuffer &addChar(char c)
+   {
+      reserve(1);
+      buffer[length++] = c;
+      return *this;
+   }
+
+   TextBuffer &addStr(const char *str, size_t len);
+   TextBuffer &addStr(const char *str);
+   TextBuffer &addRepeated(char c, size_t count);
+   TextBuffer &addInt(int value);                    // %d
+   TextBuffer &addIntRight(int value, size_t width); // %<width>d
+   TextBuffer &addInt64(int64_t value);                    // %lld
+   TextBuffer &addInt64Right(int64_t value, size_t width); // %<width>lld
+   TextBuffer &addFixed(double value, int decimals);      // %.<decimals>f
+   TextBuffer &addFixedRight(double value, int decimals, size_t width); // %<width>.<decimals>f
+   TextBuffer &addStrMax(const char *str, size_t maxlen); // %.<maxlen>s
+   TextBuffer &addStrLeft(const char *str, size_t width); // %-<width>.<width>s
+
+   bool writeTo(OutBuffer &ob);
+
+   // Accessors
+   const char *getBuffer() const { return buffer; }
+   size_t      getLength() const { return length; }
+};
+
+#endif
+
+// EOF
+
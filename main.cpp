@@ -21,20 +21,46 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <thread>
+#include <sys/types.h>
+#include <sys/stat.h>
+
 #include "z_zone.h"
+#include "d_deh.h"
+#include "i_daemon.h"
 #include "i_system.h"
+#include "i_watch.h"
 #include "m_argv.h"
 #include "m_collection.h"
+#include "m_misc.h"
+#include "m_qstr.h"
+#include "p_compat.h"
+#include "p_rollup.h"
+#include "p_scancache.h"
 #include "p_things.h"
 #include "p_thingtypes.h"
 #include "w_levels.h"
 #include "w_wad.h"
+#include "xl_ednums.h"
 
 // input file name
-static const char *inputfile;
+static PODCollection<const char *> inputfiles;
+
+// built-in thingtypes, or a thingtype script to load instead
+static const char *thinggame   = "doom";
+static const char *thingscript = NULL;
+
+// thingtype script to compile into a registry, instead of counting things
+static const char *compilescript;
 
-// thingtype script
-static const char *thingscript = "scripts/doom.cfg";
+// DeHackEd patches applying to every archive, and whether to also apply the
+// DEHACKED lumps of each
+static PODCollection<const char *> dehfiles;
+static bool usedehlumps = true;
+
+// whether to add thingtypes defined by each archive's DECORATE, ZSCRIPT and
+// MAPINFO lumps
+static bool usethingdefs = true;
 
 // maps specified on the command line
 static PODCollection<const char *> maps;
@@ -42,6 +68,41 @@ static PODCollection<const char *> maps;
 static int gametype = -1; // default: run for all game types
 static int pclass   = -1; // default: run for all player classes
 
+// how thing flags are interpreted
+static int compat = COMPAT_AUTO;
+
+// report output format, and file to write it to (default: stdout)
+static const char *reportformat = "text";
+static const char *outputfile;
+
+// memory for asynchronous output buffers; 0 for the default
+static size_t writebuffer;
+
+// levels of aggregation to output (ROLLUP_* values)
+static int rolluplevels;
+
+// threads for merging rollup tallies; 0 for one per core
+static int numthreads;
+
+// results file to output as a report instead of processing archives
+static const char *dumpfile;
+
+// socket to serve requests on instead of processing archives, the number of
+// worker processes serving them, and memory for caching responses
+static const char *daemonsocket;
+static int         daemonworkers;
+static size_t      daemoncache = 32 * 1024 * 1024;
+
+// directory to count archives from as they arrive instead, with as many
+// worker processes as the daemon
+static const char *watchdir;
+
+// cache of the counts of archives from earlier runs, and the tallies of the
+// archive being read
+static const char *scancachefile;
+static ScanCache  *scancache;
+static ScanRecord  scanrecord;
+
 // input wad directory object
 WadDirectory inputDir;
 
@@ -63,18 +124,99 @@ static const char *usagestr =
 "\n"
 "thingcount options:\n"
 "\n"
-"-file <archive>\n"
-"  Required. List a WAD or PKE/PK3 archive to open.\n"
+"-file <archive> [<archive> ...]\n"
+"  Required. List one or more WAD or PKE/PK3 archives to open.\n"
+"-game <doom|boom|mbf|heretic|hexen|strife|psx|chex>\n"
+"  Select the built-in thingtype definitions of a game. Default is doom.\n"
 "-script <scriptfile>\n"
-"  Change the thingtype definition script.\n"
-"  Default is 'scripts/doom.cfg'\n"
+"  Load thingtype definitions from a script instead, such as one of those\n"
+"  in scripts/, which the built-in definitions are made from, or from a\n"
+"  registry made by -compile-script.\n"
+"-compile-script <scriptfile>\n"
+"  Compile a thingtype script into a registry, written to the -output file,\n"
+"  and exit. A registry is mapped into memory and used in place rather than\n"
+"  parsed, so its pages are shared by every process using it.\n"
+"-deh <patchfile> [<patchfile> ...]\n"
+"  Apply DeHackEd patches to the thingtypes when counting every archive,\n"
+"  before any DEHACKED lumps in the archive itself. Changed DoomEd numbers\n"
+"  and Bits are used; COUNTKILL makes a thing a monster. Corpus totals and\n"
+"  -stats use the thingtypes without any patches.\n"
+"-nodeh\n"
+"  Ignore DEHACKED lumps in archives.\n"
+"-nodefs\n"
+"  Ignore thingtypes defined by DECORATE and ZSCRIPT actors and MAPINFO\n"
+"  DoomEdNums in archives. These are otherwise counted under the actor's\n"
+"  name, and classed by the actors it inherits from. As with -deh, corpus\n"
+"  totals and -stats do not use them.\n"
 "-maps <map> [<map> ...]\n"
 "  Specify one or more maps to tabulate by map header name.\n"
 "  By default, all maps will be autodetected and tabulated.\n"
 "-gametype <single|coop|dm>\n"
 "  Restrict output to a single game type.\n"
 "-class <fighter|cleric|mage>\n"
-"  Restrict output to a single player class for Hexen maps.\n";
+"  Restrict output to a single player class for Hexen maps.\n"
+"-compat <vanilla|boom|mbf|strife|psx|hexen>\n"
+"  Interpret thing flags as the given game does, for every level. By\n"
+"  default, Hexen-format levels use hexen, PSX levels psx, and others mbf.\n"
+"-format <text|jsonl|csv|tcol>\n"
+"  Change the output format. Default is human-readable text tables.\n"
+"  jsonl and csv output one record per thing type per table.\n"
+"  tcol writes a columnar binary results file, and requires -output.\n"
+"-output <file>\n"
+"  Write the report to a file instead of the console. If the name ends in\n"
+"  .gz, the file is gzip-compressed on separate threads.\n"
+"-writebuffer <KiB>\n"
+"  Memory for output buffers, which are written out by a separate thread.\n"
+"  Default is 1024 when using -output. When not using -output, specifying\n"
+"  this also makes console output asynchronous, though messages printed\n"
+"  while loading archives may then appear out of order with the report.\n"
+"-rollup <map|episode|archive|corpus|all> ...\n"
+"  Select the totals to output. map is each level's own tables, and is the\n"
+"  default. episode totals levels sharing a name prefix (E1, MAP) within an\n"
+"  archive, archive totals each archive, and corpus totals all archives.\n"
+"-stats\n"
+"  Output the mean, minimum, maximum, and 50th, 90th and 99th percentiles of\n"
+"  the count per level of each thing type and class, over all archives.\n"
+"  Unless -rollup is also given, only the statistics are output. They are\n"
+"  not recorded by the tcol format.\n"
+"-attributes\n"
+"  Also output each table's counts weighted by the attributes thingtype\n"
+"  scripts give: monster hit points, damage of ammo and weapons, and health\n"
+"  and armor points. Not recorded by the tcol format.\n"
+"-threads <n>\n"
+"  Number of threads used to merge totals. Default is one per core.\n"
+"-scancache <file>\n"
+"  Keep the counts of each archive in a cache file, and use them instead of\n"
+"  reading the archive again on later runs, for as long as its path, size,\n"
+"  modification time and inode stay the same. Archives with DEHACKED,\n"
+"  DECORATE, ZSCRIPT or MAPINFO lumps that are used are always read. The\n"
+"  cache is only used by runs with the same -maps, -gametype, -class,\n"
+"  -compat, -nodeh and -nodefs; it is not used by -daemon or -watch.\n"
+"-dump <resultsfile>\n"
+"  Output a tcol results file as a report in the selected format,\n"
+"  instead of processing any archives.\n"
+"-daemon <socket>\n"
+"  Serve requests on a Unix domain socket instead of processing archives,\n"
+"  until interrupted. Thingtypes are loaded once, and each request is run\n"
+"  by a worker process forked in advance. A request is lines of a keyword\n"
+"  and its values: file <archive> (required; repeat for more archives),\n"
+"  maps <map> ..., gametype <single|coop|dm>, class <fighter|cleric|mage>,\n"
+"  and format <text|jsonl|csv>. The other options apply to every request.\n"
+"  See i_daemon.h for how requests and responses are framed.\n"
+"-workers <n>\n"
+"  Number of requests -daemon runs, or archives -watch counts, at once.\n"
+"  Default is one per core.\n"
+"-cache <KiB>\n"
+"  Memory -daemon uses to keep responses, which are reused until the\n"
+"  archives they came from change. Default is 32768; 0 disables it.\n"
+"-watch <directory>\n"
+"  Count the archives in a directory, and then each one written or moved\n"
+"  into it once it has been closed, until interrupted. Hidden files are\n"
+"  skipped, and an archive is only counted again after it changes. -workers\n"
+"  sets how many are counted at once. Each archive's report is appended to\n"
+"  the -output file, or written to the console, as a whole. Only the text\n"
+"  and jsonl formats can be used, without compression, and corpus totals\n"
+"  and -stats cover a single archive. Linux only.\n";
 
 //
 // D_PrintUsage
@@ -88,6 +230,38 @@ static void D_PrintUsage()
    exit(0);
 }
 
+//
+// D_GameTypeForName
+//
+// Returns -1 if the name is not a game type.
+//
+static int D_GameTypeForName(const char *type)
+{
+   if(!strcasecmp(type, "single"))
+      return 0;
+   else if(!strcasecmp(type, "coop"))
+      return 1;
+   else if(!strcasecmp(type, "dm"))
+      return 2;
+   return -1;
+}
+
+//
+// D_ClassForName
+//
+// Returns -1 if the name is not a Hexen player class.
+//
+static int D_ClassForName(const char *tpclass)
+{
+   if(!strcasecmp(tpclass, "fighter"))
+      return 0;
+   else if(!strcasecmp(tpclass, "cleric"))
+      return 1;
+   else if(!strcasecmp(tpclass, "mage"))
+      return 2;
+   return -1;
+}
+
 //
 // D_CheckForParameters
 //
@@ -102,16 +276,69 @@ static void D_CheckForParameters()
    if(myargc < 3 || M_CheckMultiParm(helpParams, 0))
       D_PrintUsage();
 
-   // check for input file
+   // compile a thingtype script, and do nothing else
+   if((p = M_CheckParm("-compile-script")) && p < myargc - 1)
+   {
+      compilescript = myargv[p + 1];
+      if(!(p = M_CheckParm("-output")) || p >= myargc - 1)
+         I_Error("-compile-script requires -output <file>\n");
+      outputfile = myargv[p + 1];
+      return;
+   }
+
+   // check for input files
    if((p = M_CheckParm("-file")) && p < myargc - 1)
-      inputfile = myargv[p + 1];
-   else
+   {
+      ++p;
+      while(p != myargc && *myargv[p] != '-')
+      {
+         inputfiles.add(myargv[p]);
+         ++p;
+      }
+   }
+   if((p = M_CheckParm("-dump")) && p < myargc - 1)
+      dumpfile = myargv[p + 1];
+   if((p = M_CheckParm("-daemon")) && p < myargc - 1)
+   {
+      daemonsocket = myargv[p + 1];
+      if((p = M_CheckParm("-cache")) && p < myargc - 1)
+         daemoncache = static_cast<size_t>(atoi(myargv[p + 1])) * 1024;
+   }
+   else if((p = M_CheckParm("-watch")) && p < myargc - 1)
+      watchdir = myargv[p + 1];
+   if(daemonsocket || watchdir)
+   {
+      if((p = M_CheckParm("-workers")) && p < myargc - 1)
+         daemonworkers = atoi(myargv[p + 1]);
+      if(daemonworkers <= 0)
+         daemonworkers = static_cast<int>(std::thread::hardware_concurrency());
+      if(daemonworkers <= 0)
+         daemonworkers = 1;
+   }
+   if(!inputfiles.getLength() && !dumpfile && !daemonsocket && !watchdir)
       I_Error("Need an input file\n");
 
-   // check for script specification
+   // check for game or script specification
+   if((p = M_CheckParm("-game")) && p < myargc - 1)
+      thinggame = myargv[p + 1];
    if((p = M_CheckParm("-script")) && p < myargc - 1)
       thingscript = myargv[p + 1];
 
+   // check for DeHackEd patches
+   if((p = M_CheckParm("-deh")) && p < myargc - 1)
+   {
+      ++p;
+      while(p != myargc && *myargv[p] != '-')
+      {
+         dehfiles.add(myargv[p]);
+         ++p;
+      }
+   }
+   if(M_CheckParm("-nodeh"))
+      usedehlumps = false;
+   if(M_CheckParm("-nodefs"))
+      usethingdefs = false;
+
    // check for -maps param
    if((p = M_CheckParm("-maps")) && p < myargc - 1)
    {
@@ -125,39 +352,101 @@ static void D_CheckForParameters()
 
    // check for game type
    if((p = M_CheckParm("-gametype")) && p < myargc - 1)
-   {
-      const char *type = myargv[p + 1];
-      if(!strcasecmp(type, "single"))
-         gametype = 0;
-      else if(!strcasecmp(type, "coop"))
-         gametype = 1;
-      else if(!strcasecmp(type, "dm"))
-         gametype = 2;
-   }
+      gametype = D_GameTypeForName(myargv[p + 1]);
 
    // check for player class
    if((p = M_CheckParm("-class")) && p < myargc - 1)
+      pclass = D_ClassForName(myargv[p + 1]);
+
+   // check for thing flag semantics
+   if((p = M_CheckParm("-compat")) && p < myargc - 1)
+   {
+      if((compat = P_CompatForName(myargv[p + 1])) < 0)
+         I_Error("Unknown compat profile '%s'\n", myargv[p + 1]);
+   }
+   P_SetCompat(compat);
+
+   // check for output format
+   if((p = M_CheckParm("-format")) && p < myargc - 1)
+      reportformat = myargv[p + 1];
+   if((p = M_CheckParm("-output")) && p < myargc - 1)
+      outputfile = myargv[p + 1];
+   if((p = M_CheckParm("-writebuffer")) && p < myargc - 1)
+   {
+      int kib = atoi(myargv[p + 1]);
+      if(kib > 0)
+         writebuffer = static_cast<size_t>(kib) * 1024;
+   }
+
+   // check for rollups
+   if((p = M_CheckParm("-rollup")))
+   {
+      ++p;
+      while(p != myargc && *myargv[p] != '-')
+      {
+         const char *level = myargv[p];
+         if(!strcasecmp(level, "map"))
+            rolluplevels |= ROLLUP_MAP;
+         else if(!strcasecmp(level, "episode"))
+            rolluplevels |= ROLLUP_EPISODE;
+         else if(!strcasecmp(level, "archive"))
+            rolluplevels |= ROLLUP_ARCHIVE;
+         else if(!strcasecmp(level, "corpus"))
+            rolluplevels |= ROLLUP_CORPUS;
+         else if(!strcasecmp(level, "all"))
+            rolluplevels |= ROLLUP_MAP | ROLLUP_EPISODE | ROLLUP_ARCHIVE | ROLLUP_CORPUS;
+         else
+            I_Error("Unknown rollup '%s'\n", level);
+         ++p;
+      }
+   }
+   if((p = M_CheckParm("-scancache")) && p < myargc - 1)
+      scancachefile = myargv[p + 1];
+   if(M_CheckParm("-stats"))
+      P_SetStats(true);
+   else if(!rolluplevels)
+      rolluplevels = ROLLUP_MAP;
+   if((p = M_CheckParm("-threads")) && p < myargc - 1)
+      numthreads = atoi(myargv[p + 1]);
+   if(numthreads <= 0)
+      numthreads = static_cast<int>(std::thread::hardware_concurrency());
+   P_SetRollups(rolluplevels, numthreads);
+
+   // reports from -watch are appended by the watcher itself
+   if(watchdir)
    {
-      const char *tpclass = myargv[p + 1];
-      if(!strcasecmp(tpclass, "fighter"))
-         pclass = 0;
-      else if(!strcasecmp(tpclass, "cleric"))
-         pclass = 1;
-      else if(!strcasecmp(tpclass, "mage"))
-         pclass = 2;
+      size_t len = outputfile ? strlen(outputfile) : 0;
+
+      if(!strcasecmp(reportformat, "csv") || !strcasecmp(reportformat, "tcol"))
+         I_Error("Format '%s' cannot be appended to by -watch\n", reportformat);
+      if(len >= 3 && !strcasecmp(outputfile + len - 3, ".gz"))
+         I_Error("-watch cannot append to compressed file '%s'\n", outputfile);
+      if(!P_SetReportFormat(reportformat, NULL, 0))
+         I_Error("Unknown output format '%s'\n", reportformat);
+      return;
    }
+
+   if(!strcasecmp(reportformat, "tcol") && !outputfile)
+      I_Error("Format 'tcol' requires -output <file>\n");
+   if(!P_SetReportFormat(reportformat, outputfile, writebuffer))
+      I_Error("Unknown output format '%s'\n", reportformat);
 }
 
 //
 // Load the input file. If the -maps command-line option was not specified,
 // also scan it for levels.
 //
-static void D_LoadInput()
+static void D_LoadInput(const char *inputfile)
 {
    // open the file
    if(!inputDir.addNewPrivateFile(inputfile))
       I_Error("Could not load input file '%s'\n", inputfile);
 
+   // apply DeHackEd changes to the thingtypes
+   D_ApplyDEH(inputDir, usedehlumps);
+   if(usethingdefs)
+      XL_HarvestThingDefs(inputDir);
+
    // if maps to open were not specified on the command line, then scan for
    // them in the directory now
    if(!maps.getLength())
@@ -198,12 +487,56 @@ static void D_Init()
 
    // Check for command line parameters
    D_CheckForParameters();
+   if(compilescript)
+      return;
 
-   // Load input file and create wadlevels array
-   D_LoadInput();
+   // Load the thing type script, or use a built-in game's thing types
+   if(thingscript)
+      P_LoadThingTypes(thingscript);
+   else if(!P_UseBuiltinThingTypes(thinggame))
+   {
+      I_Error("Unknown game '%s'; built-in games are %s\n", thinggame,
+              P_BuiltinThingTypesNames());
+   }
+   for(const char *dehfile : dehfiles)
+      D_ParseDEHFile(dehfile);
+   if(M_CheckParm("-attributes"))
+      P_SetAttributes(true);
+}
 
-   // Load the thing type script
-   P_LoadThingTypes(thingscript);
+//
+// D_ScanCacheOptions
+//
+// The options which make a difference to the tallies kept in the scan cache.
+// Thingtypes do not, as they are looked up again when tallies are used.
+//
+static void D_ScanCacheOptions(qstring &options)
+{
+   options.Printf(0, "gametype %d class %d compat %d deh %d defs %d maps",
+                  gametype, pclass, compat, usedehlumps ? 1 : 0, usethingdefs ? 1 : 0);
+   for(const char *map : maps)
+      options << " " << map;
+}
+
+//
+// D_ReplayInput
+//
+// Output the counts of an archive from the scan cache, if they were recorded
+// while it was the same as it is now. Returns false if the archive has to be
+// read instead.
+//
+static bool D_ReplayInput(const char *inputfile, const scanfileid_t &id)
+{
+   const byte *data;
+   size_t      size;
+
+   if(!scancache->find(inputfile, id, data, size))
+      return false;
+
+   // archives with thingtypes of their own are not kept, but -deh patches
+   // still apply
+   D_ApplyDEH(inputDir, false);
+   return P_ReplayThingCounts(data, size);
 }
 
 //
@@ -221,6 +554,260 @@ static void D_ProcessLevels()
    }
 }
 
+//
+// Run each input archive through the same directory, which is reset in
+// between so that its allocations are reused rather than accumulated.
+// An error in one archive is reported and that archive is skipped.
+// Returns the number of archives that failed.
+//
+static int D_ProcessInputFiles()
+{
+   bool multiple = (inputfiles.getLength() > 1 || watchdir);
+   int  failures = 0;
+
+   P_BeginReport();
+
+   for(const char *inputfile : inputfiles)
+   {
+      P_BeginArchive(inputfile, multiple);
+
+      try
+      {
+         IRecoverableScope scope;
+         scanfileid_t      id;
+         bool              cache = (scancache && P_ScanFileID(inputfile, id));
+
+         if(!cache || !D_ReplayInput(inputfile, id))
+         {
+            // Load input file and create wadlevels array
+            D_LoadInput(inputfile);
+
+            if(cache)
+            {
+               scanrecord.clear();
+               P_RecordThingCounts(&scanrecord);
+            }
+            D_ProcessLevels();
+            P_RecordThingCounts(NULL);
+
+            // counts using the archive's own thingtypes need it to be read
+            if(cache && !(usedehlumps && D_HasDEHLumps(inputDir)) &&
+               !(usethingdefs && XL_HasThingDefs(inputDir)))
+               scancache->store(inputfile, id, scanrecord);
+         }
+      }
+      catch(const I_ErrorException &err)
+      {
+         P_ReportError(err.GetMessage());
+         P_RecordThingCounts(NULL);
+         ++failures;
+      }
+
+      P_EndArchive();
+
+      // back to the thingtypes without this archive's changes
+      P_ResetThingTypes();
+
+      if(wadlevels)
+      {
+         efree(wadlevels);
+         wadlevels = NULL;
+      }
+      inputDir.reset();
+
+      // automatic allocations made while loading are dead now
+      Z_FreeAlloca();
+   }
+
+   P_EndReport();
+
+   return failures;
+}
+
+//=============================================================================
+//
+// Daemon Requests
+//
+
+// A request, pointing into a copy of its text
+struct daemonrequest_t
+{
+   PODCollection<const char *> files;
+   PODCollection<const char *> maps;
+   int         gametype;
+   int         pclass;
+   const char *format;
+};
+
+//
+// D_ParseRequest
+//
+// Parse a request's lines of keywords and values; see -daemon in the usage.
+// The text is modified. Returns false with a message in error if the request
+// is not valid.
+//
+static bool D_ParseRequest(char *text, daemonrequest_t &req, qstring &error)
+{
+   static const char *formats[] = { "text", "jsonl", "csv" };
+
+   req.gametype = -1;
+   req.pclass   = -1;
+   req.format   = strcasecmp(reportformat, "tcol") ? reportformat : "text";
+
+   for(char *line = text, *next; line; line = next)
+   {
+      if((next = strchr(line, '\n')))
+         *next++ = '\0';
+
+      // split off the keyword, and trim the value
+      char  *value = line + strcspn(line, " \t\r");
+      size_t len;
+      if(*value)
+         *value++ = '\0';
+      value += strspn(value, " \t");
+      len = strlen(value);
+      while(len && strchr(" \t\r", value[len - 1]))
+         value[--len] = '\0';
+
+      if(!*line)
+         continue;
+      if(!*value)
+      {
+         error.Printf(0, "No value for '%s'\n", line);
+         return false;
+      }
+
+      if(!strcmp(line, "file"))
+         req.files.add(value);
+      else if(!strcmp(line, "maps"))
+      {
+         for(char *map = strtok(value, " \t"); map; map = strtok(NULL, " \t"))
+            req.maps.add(map);
+      }
+      else if(!strcmp(line, "gametype"))
+      {
+         if((req.gametype = D_GameTypeForName(value)) < 0)
+         {
+            error.Printf(0, "Unknown game type '%s'\n", value);
+            return false;
+         }
+      }
+      else if(!strcmp(line, "class"))
+      {
+         if((req.pclass = D_ClassForName(value)) < 0)
+         {
+            error.Printf(0, "Unknown player class '%s'\n", value);
+            return false;
+         }
+      }
+      else if(!strcmp(line, "format"))
+      {
+         int numformats = static_cast<int>(earrlen(formats));
+         if(M_StrToNumLinear(formats, numformats, value) == numformats)
+         {
+            error.Printf(0, "Unknown output format '%s'\n", value);
+            return false;
+         }
+         req.format = value;
+      }
+      else
+      {
+         error.Printf(0, "Unknown keyword '%s'\n", line);
+         return false;
+      }
+   }
+
+   if(!req.files.getLength())
+   {
+      error = "Need an input file\n";
+      return false;
+   }
+
+   return true;
+}
+
+//
+// CountRequestHandler
+//
+// Counts things in the archives a request names, as if its options had been
+// given on the command line along with those the daemon was started with.
+//
+class CountRequestHandler : public DaemonHandler
+{
+public:
+   virtual bool prepare(const char *request, size_t len, qstring &key,
+                        qstring &error)
+   {
+      qstring         text;
+      daemonrequest_t req;
+      char            buf[64];
+
+      text.copy(request, len);
+      if(!D_ParseRequest(text.getBuffer(), req, error))
+         return false;
+
+      // the response depends on the options, and on what is in each archive
+      // right now
+      snprintf(buf, sizeof(buf), "%s %d %d\n", req.format, req.gametype, req.pclass);
+      key = buf;
+      for(const char *map : req.maps)
+      {
+         key += map;
+         key += " ";
+      }
+      for(const char *file : req.files)
+      {
+         struct stat sbuf;
+         long nsec = 0;
+
+         if(stat(file, &sbuf))
+         {
+            error.Printf(0, "Could not load input file '%s'\n", file);
+            return false;
+         }
+#ifdef __linux__
+         nsec = sbuf.st_mtim.tv_nsec;
+#endif
+         snprintf(buf, sizeof(buf), "\n%llu %llu %lld %lld.%ld ",
+                  static_cast<unsigned long long>(sbuf.st_dev),
+                  static_cast<unsigned long long>(sbuf.st_ino),
+                  static_cast<long long>(sbuf.st_size),
+                  static_cast<long long>(sbuf.st_mtime), nsec);
+         key += buf;
+         key += file;
+      }
+
+      return true;
+   }
+
+   virtual bool run(const char *request, size_t len)
+   {
+      qstring         text;
+      qstring         error;
+      daemonrequest_t req;
+
+      text.copy(request, len);
+      if(!D_ParseRequest(text.getBuffer(), req, error))
+      {
+         fputs(error.constPtr(), stdout);
+         return false;
+      }
+
+      inputfiles.makeEmpty();
+      for(const char *file : req.files)
+         inputfiles.add(file);
+      maps.makeEmpty();
+      for(const char *map : req.maps)
+         maps.add(map);
+      gametype = req.gametype;
+      pclass   = req.pclass;
+
+      if(!P_SetReportFormat(req.format, NULL, 0))
+         return false;
+      return !D_ProcessInputFiles();
+   }
+};
+
 //
 // Main Program
 //
@@ -233,8 +820,59 @@ int main(int argc, char **argv)
    // perform initialization
    D_Init();
 
-   // print out thing information for each level
-   D_ProcessLevels();
+   // compile a thingtype script into a registry?
+   if(compilescript)
+   {
+      P_LoadThingTypes(compilescript);
+      if(!P_WriteThingRegistry(outputfile))
+         I_Error("Could not write registry '%s'\n", outputfile);
+      return 0;
+   }
+
+   // serve requests until interrupted?
+   if(daemonsocket)
+   {
+      CountRequestHandler handler;
+      if(!I_RunDaemon(daemonsocket, handler, daemonworkers, daemoncache))
+         I_Error("Could not start daemon on '%s'\n", daemonsocket);
+      return 0;
+   }
+
+   // count archives as they arrive until interrupted?
+   if(watchdir)
+   {
+      CountRequestHandler handler;
+      if(!I_RunWatch(watchdir, handler, daemonworkers, outputfile))
+         I_Error("Could not watch '%s'\n", watchdir);
+      return 0;
+   }
+
+   // output a previously written results file?
+   if(dumpfile)
+   {
+      if(!P_DumpResults(dumpfile))
+         I_Error("Could not read results file '%s'\n", dumpfile);
+      return 0;
+   }
+
+   // reuse the counts of archives which have not changed since the last run?
+   if(scancachefile)
+   {
+      qstring options;
+
+      D_ScanCacheOptions(options);
+      scancache = new ScanCache();
+      scancache->open(scancachefile, options.constPtr());
+   }
+
+   // print out thing information for each level of each archive
+   int failures = D_ProcessInputFiles();
+
+   if(scancache && !scancache->save())
+      I_Error("Could not write scan cache '%s'\n", scancachefile);
+
+   if(failures)
+      return -1;
 
    return 0;
 }
@@ -0,0 +1,319 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Thing flag semantics of each game
+//
+//-----------------------------------------------------------------------------
+
+#include "z_zone.h"
+#include "m_misc.h"
+#include "p_compat.h"
+#include "p_udmf.h"
+#include "w_levels.h"
+
+// DOOM mapthing flags
+#define MTF_EASY        1
+#define MTF_NORMAL      2
+#define MTF_HARD        4
+#define MTF_AMBUSH      8
+#define MTF_NOTSINGLE  16
+#define MTF_NOTDM      32
+#define MTF_NOTCOOP    64
+#define MTF_FRIEND    128
+#define MTF_RESERVED  256
+
+// PSX flags
+#define MTF_PSX_GHOST      32         // 50% transparent monster
+#define MTF_PSX_ADDITIVE  (32|64)     // 100% additive monster
+#define MTF_PSX_NIGHTMARE (32|128)    // subtractive w/2x spawn health
+#define MTF_PSX_SPECTRE   (32|64|128) // 25% additive monster
+
+// Strife flags. They reuse the bits BOOM gives to MTF_NOTDM and MTF_NOTCOOP,
+// which is why the strife profile tests only MTF_NOTSINGLE. None of them
+// decides which tables a thing appears in, so they are deliberately ignored
+// there; they are listed to show what the reused bits mean.
+#define MTF_STRIFE_STANDSTILL    8
+#define MTF_STRIFE_AMBUSH       32
+#define MTF_STRIFE_FRIEND       64
+#define MTF_STRIFE_TRANSLUCENT 256
+#define MTF_STRIFE_INVISIBLE   512
+
+// Hexen mapthing flags
+#define MTF_HX_EASY           1
+#define MTF_HX_NORMAL         2
+#define MTF_HX_HARD           4
+#define MTF_HX_AMBUSH         8
+#define MTF_HX_DORMANT       16
+#define MTF_HX_FIGHTER       32
+#define MTF_HX_CLERIC        64
+#define MTF_HX_MAGE         128
+#define MTF_HX_GSINGLE      256
+#define MTF_HX_GCOOP        512
+#define MTF_HX_GDEATHMATCH 1024
+
+static const char *compatnames[NUM_COMPATS] =
+{
+   "vanilla",
+   "boom",
+   "mbf",
+   "strife",
+   "psx",
+   "hexen"
+};
+
+// Profile selected with -compat, or COMPAT_AUTO
+static int compatprofile = COMPAT_AUTO;
+
+// Compiled tables, indexed by the thing's flags
+static uint16_t *compattables[NUM_COMPATS];
+
+// NB: Same for every game
+static unsigned int FlagsForSkill[NUM_SKILLS] =
+{
+   MTF_EASY,
+   MTF_NORMAL,
+   MTF_HARD
+};
+
+// For Hexen, the flag MUST be present
+static unsigned int HxFlagForGameType[NUM_GAME_TYPES] =
+{
+   MTF_HX_GSINGLE,
+   MTF_HX_GCOOP,
+   MTF_HX_GDEATHMATCH
+};
+
+// For Doom with BOOM extensions, the flag must NOT be present
+static unsigned int DoomFlagForGameType[NUM_GAME_TYPES] =
+{
+   MTF_NOTSINGLE,
+   MTF_NOTCOOP,
+   MTF_NOTDM
+};
+
+static unsigned int FlagsForClass[NUM_CLASSES] =
+{
+   MTF_HX_FIGHTER,
+   MTF_HX_CLERIC,
+   MTF_HX_MAGE
+};
+
+//
+// Check if a thing with the given flags is present for a game type, and for
+// Hexen, a player class.
+//
+static bool P_isInTable(int profile, unsigned int options, int gametype, int pclass)
+{
+   switch(profile)
+   {
+   case COMPAT_VANILLA:
+   case COMPAT_STRIFE:
+   case COMPAT_PSX:
+      // the only multiplayer flag keeps things out of single player
+      return !(gametype == GAME_TYPE_SINGLE && (options & MTF_NOTSINGLE));
+
+   case COMPAT_MBF:
+      // flags unused by Doom are ignored if MTF_RESERVED is set, due to
+      // editors such as Hellmaker setting them
+      if(options & MTF_RESERVED)
+         options &= MTF_EASY|MTF_NORMAL|MTF_HARD|MTF_AMBUSH|MTF_NOTSINGLE;
+      // fall through
+   case COMPAT_BOOM:
+      return !(options & DoomFlagForGameType[gametype]);
+
+   case COMPAT_HEXEN:
+      if(!(options & HxFlagForGameType[gametype]))
+         return false;
+      // class flags are only checked in single player and cooperative
+      if(gametype == GAME_TYPE_DM)
+         return true;
+      return !!(options & FlagsForClass[pclass]);
+
+   default:
+      return false;
+   }
+}
+
+//
+// Build the table of what every combination of thing flags means under a
+// profile.
+//
+static void P_compileProfile(int profile)
+{
+   if(compattables[profile])
+      return;
+
+   uint16_t *table = ecalloc(uint16_t *, 65536, sizeof(uint16_t));
+   int firstclass = P_CompatHasClasses(profile) ? 0 : -1;
+   int lastclass  = P_CompatHasClasses(profile) ? NUM_CLASSES - 1 : -1;
+
+   for(unsigned int options = 0; options < 65536; options++)
+   {
+      unsigned int bits = 0;
+
+      for(int skill = 0; skill < NUM_SKILLS; skill++)
+      {
+         if((options & FlagsForSkill[skill]) == FlagsForSkill[skill])
+            bits |= 1 << skill;
+      }
+
+      for(int gametype = 0; gametype < NUM_GAME_TYPES; gametype++)
+      {
+         for(int pclass = firstclass; pclass <= lastclass; pclass++)
+         {
+            if(P_isInTable(profile, options, gametype, pclass))
+               bits |= COMPAT_TABLEBIT(gametype, pclass);
+         }
+      }
+
+      table[options] = static_cast<uint16_t>(bits);
+   }
+
+   compattables[profile] = table;
+}
+
+//
+// Look up a profile by its -compat name. Returns -1 if there is no such
+// profile.
+//
+int P_CompatForName(const char *name)
+{
+   int profile = M_StrToNumLinear(compatnames, NUM_COMPATS, name);
+   return profile == NUM_COMPATS ? -1 : profile;
+}
+
+//
+// Select the profile for all levels, or COMPAT_AUTO to choose by level
+// format, and compile the tables that may be used.
+//
+void P_SetCompat(int profile)
+{
+   compatprofile = profile;
+
+   if(profile == COMPAT_AUTO)
+   {
+      P_compileProfile(P_CompatForLevel(LEVEL_FORMAT_DOOM));
+      P_compileProfile(P_CompatForLevel(LEVEL_FORMAT_PSX));
+      P_compileProfile(P_CompatForLevel(LEVEL_FORMAT_HEXEN));
+   }
+   else
+      P_compileProfile(profile);
+
+   // UDMF levels use one of these whatever the profile; see P_CompatForUDMF
+   P_compileProfile(COMPAT_BOOM);
+   P_compileProfile(COMPAT_HEXEN);
+}
+
+//
+// Get the profile that applies to levels of a format.
+//
+int P_CompatForLevel(int levelformat)
+{
+   if(compatprofile != COMPAT_AUTO)
+      return compatprofile;
+
+   switch(levelformat)
+   {
+   case LEVEL_FORMAT_HEXEN:
+      return COMPAT_HEXEN;
+   case LEVEL_FORMAT_PSX:
+      return COMPAT_PSX;
+   default:
+      return COMPAT_MBF;
+   }
+}
+
+//
+// Check if a profile counts things separately for each player class.
+//
+bool P_CompatHasClasses(int profile)
+{
+   return profile == COMPAT_HEXEN;
+}
+
+//
+// Get the compiled table of a profile; see p_compat.h. P_SetCompat must
+// have been called.
+//
+const uint16_t *P_CompatTable(int profile)
+{
+   return compattables[profile];
+}
+
+//
+// Get the profile that applies to a UDMF level in a namespace. UDMF flags
+// mean the same in every port, so the only choice is whether there are
+// player classes: there are in the Hexen namespace, or if -compat hexen
+// asks for them. Other levels get BOOM, which is able to express every
+// other combination of flags.
+//
+int P_CompatForUDMF(const char *nspace)
+{
+   if(!strcmp(nspace, "hexen") || P_CompatHasClasses(compatprofile))
+      return COMPAT_HEXEN;
+   return COMPAT_BOOM;
+}
+
+//
+// Translate UDMF_ thing flags into thing options for a profile chosen by
+// P_CompatForUDMF.
+//
+int P_CompatUDMFOptions(int profile, unsigned int udmfflags)
+{
+   int options = 0;
+
+   if(udmfflags & (UDMF_SKILL1|UDMF_SKILL2))
+      options |= MTF_EASY;
+   if(udmfflags & UDMF_SKILL3)
+      options |= MTF_NORMAL;
+   if(udmfflags & (UDMF_SKILL4|UDMF_SKILL5))
+      options |= MTF_HARD;
+
+   if(profile == COMPAT_HEXEN)
+   {
+      if(udmfflags & UDMF_SINGLE)
+         options |= MTF_HX_GSINGLE;
+      if(udmfflags & UDMF_COOP)
+         options |= MTF_HX_GCOOP;
+      if(udmfflags & UDMF_DM)
+         options |= MTF_HX_GDEATHMATCH;
+      if(udmfflags & UDMF_CLASS1)
+         options |= MTF_HX_FIGHTER;
+      if(udmfflags & UDMF_CLASS2)
+         options |= MTF_HX_CLERIC;
+      if(udmfflags & UDMF_CLASS3)
+         options |= MTF_HX_MAGE;
+   }
+   else
+   {
+      if(!(udmfflags & UDMF_SINGLE))
+         options |= MTF_NOTSINGLE;
+      if(!(udmfflags & UDMF_COOP))
+         options |= MTF_NOTCOOP;
+      if(!(udmfflags & UDMF_DM))
+         options |= MTF_NOTDM;
+   }
+
+   return options;
+}
+
+// EOF
+
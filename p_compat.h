@@ -0,0 +1,65 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Thing flag semantics of each game
+//
+//-----------------------------------------------------------------------------
+
+#ifndef P_COMPAT_H__
+#define P_COMPAT_H__
+
+#include "p_report.h"
+
+// Compatibility profiles, for -compat
+enum
+{
+   COMPAT_VANILLA, // Doom 1.9: multiplayer-only flag
+   COMPAT_BOOM,    // adds not-deathmatch and not-coop flags
+   COMPAT_MBF,     // as BOOM, but ignores them if the reserved bit is set
+   COMPAT_STRIFE,  // multiplayer-only flag; the rest are rendering/AI flags
+   COMPAT_PSX,     // multiplayer-only flag; the rest are rendering flags
+   COMPAT_HEXEN,   // game type and player class flags must be present
+   NUM_COMPATS,
+
+   COMPAT_AUTO = -1 // chosen by level format
+};
+
+//
+// A compiled profile is a table of what each combination of thing flags
+// means: bit s is set if the thing is present on skill s, and bit
+// NUM_SKILLS + P_ReportTable(gametype, pclass) if it is present in that
+// table. Profiles without player classes only set the bits for pclass -1.
+//
+#define COMPAT_TABLEBIT(gametype, pclass) \
+   (1 << (NUM_SKILLS + P_ReportTable(gametype, pclass)))
+
+int         P_CompatForName(const char *name);
+void        P_SetCompat(int profile);
+int         P_CompatForLevel(int levelformat);
+bool        P_CompatHasClasses(int profile);
+const uint16_t *P_CompatTable(int profile);
+int         P_CompatForUDMF(const char *nspace);
+int         P_CompatUDMFOptions(int profile, unsigned int udmfflags);
+
+#endif
+
+// EOF
+
@@ -0,0 +1,2771 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Built-in thingtype tables.
+//      Generated from scripts/*.cfg by tools/mkgamedefs.awk; do not edit.
+//
+//-----------------------------------------------------------------------------
+
+// boom
+
+static const thingtype_t boomTypes[] =
+{
+   {     1, CLASS_TECHNICAL,     0,   0 },
+   {     2, CLASS_TECHNICAL,    15,   1 },
+   {     3, CLASS_TECHNICAL,    30,   2 },
+   {     4, CLASS_TECHNICAL,    45,   3 },
+   {     5, CLASS_KEY,          60,   4 },
+   {     6, CLASS_KEY,          70,   5 },
+   {     7, CLASS_MONSTER,      82,   6 },
+   {     8, CLASS_AMMO,        100,   7 },
+   {     9, CLASS_MONSTER,     109,   8 },
+   {    10, CLASS_DECOR,       121,   9 },
+   {    11, CLASS_TECHNICAL,   135,  10 },
+   {    12, CLASS_DECOR,       152,  11 },
+   {    13, CLASS_KEY,         168,  12 },
+   {    14, CLASS_TECHNICAL,   177,  13 },
+   {    15, CLASS_DECOR,       198,  14 },
+   {    16, CLASS_MONSTER,     210,  15 },
+   {    17, CLASS_AMMO,        221,  16 },
+   {    18, CLASS_DECOR,       238,  17 },
+   {    19, CLASS_DECOR,       253,  18 },
+   {    20, CLASS_DECOR,       270,  19 },
+   {    21, CLASS_DECOR,       279,  20 },
+   {    22, CLASS_DECOR,       290,  21 },
+   {    23, CLASS_DECOR,       305,  22 },
+   {    24, CLASS_DECOR,       320,  23 },
+   {    25, CLASS_DECOR,       325,  24 },
+   {    26, CLASS_DECOR,       350,  25 },
+   {    27, CLASS_DECOR,       376,  26 },
+   {    28, CLASS_DECOR,       389,  27 },
+   {    29, CLASS_DECOR,       406,  28 },
+   {    30, CLASS_DECOR,       425,  29 },
+   {    31, CLASS_DECOR,       443,  30 },
+   {    32, CLASS_DECOR,       462,  31 },
+   {    33, CLASS_DECOR,       478,  32 },
+   {    34, CLASS_DECOR,       495,  33 },
+   {    35, CLASS_DECOR,       502,  34 },
+   {    36, CLASS_DECOR,       513,  35 },
+   {    37, CLASS_DECOR,       531,  36 },
+   {    38, CLASS_KEY,         549,  37 },
+   {    39, CLASS_KEY,         563,  38 },
+   {    40, CLASS_KEY,         580,  39 },
+   {    41, CLASS_DECOR,       595,  40 },
+   {    42, CLASS_DECOR,       604,  41 },
+   {    43, CLASS_DECOR,       620,  42 },
+   {    44, CLASS_DECOR,       630,  43 },
+   {    45, CLASS_DECOR,       641,  44 },
+   {    46, CLASS_DECOR,       653,  45 },
+   {    47, CLASS_DECOR,       663,  46 },
+   {    48, CLASS_DECOR,       674,  47 },
+   {    49, CLASS_DECOR,       686,  48 },
+   {    50, CLASS_DECOR,       711,  49 },
+   {    51, CLASS_DECOR,       733,  50 },
+   {    52, CLASS_DECOR,       755,  51 },
+   {    53, CLASS_DECOR,       776,  52 },
+   {    54, CLASS_DECOR,       788,  53 },
+   {    55, CLASS_DECOR,       797,  54 },
+   {    56, CLASS_DECOR,       814,  55 },
+   {    57, CLASS_DECOR,       832,  56 },
+   {    58, CLASS_MONSTER,     848,  57 },
+   {    59, CLASS_DECOR,       856,  58 },
+   {    60, CLASS_DECOR,       881,  59 },
+   {    61, CLASS_DECOR,       905,  60 },
+   {    62, CLASS_DECOR,       930,  61 },
+   {    63, CLASS_DECOR,       947,  62 },
+   {    64, CLASS_MONSTER,     972,  63 },
+   {    65, CLASS_MONSTER,     982,  64 },
+   {    66, CLASS_MONSTER,     994,  65 },
+   {    67, CLASS_MONSTER,    1003,  66 },
+   {    68, CLASS_MONSTER,    1012,  67 },
+   {    69, CLASS_MONSTER,    1024,  68 },
+   {    70, CLASS_DECOR,      1036,  69 },
+   {    71, CLASS_MONSTER,    1051,  70 },
+   {    72, CLASS_MONSTER,    1066,  71 },
+   {    73, CLASS_DECOR,      1081,  72 },
+   {    74, CLASS_DECOR,      1104,  73 },
+   {    75, CLASS_DECOR,      1128,  74 },
+   {    76, CLASS_DECOR,      1153,  75 },
+   {    77, CLASS_DECOR,      1177,  76 },
+   {    78, CLASS_DECOR,      1203,  77 },
+   {    79, CLASS_DECOR,      1228,  78 },
+   {    80, CLASS_DECOR,      1239,  79 },
+   {    81, CLASS_DECOR,      1256,  80 },
+   {    82, CLASS_WEAPON,     1267,  81 },
+   {    83, CLASS_HEALTH,     1281,  82 },
+   {    84, CLASS_MONSTER,    1292,  83 },
+   {    85, CLASS_DECOR,      1307,  84 },
+   {    86, CLASS_DECOR,      1319,  85 },
+   {    87, CLASS_TECHNICAL,  1331,  86 },
+   {    88, CLASS_MONSTER,    1347,  87 },
+   {    89, CLASS_TECHNICAL,  1358,  88 },
+   {  2001, CLASS_WEAPON,     1371,  89 },
+   {  2002, CLASS_WEAPON,     1379,  90 },
+   {  2003, CLASS_WEAPON,     1388,  91 },
+   {  2004, CLASS_WEAPON,     1404,  92 },
+   {  2005, CLASS_WEAPON,     1417,  93 },
+   {  2006, CLASS_WEAPON,     1426,  94 },
+   {  2007, CLASS_AMMO,       1434,  95 },
+   {  2008, CLASS_AMMO,       1439,  96 },
+   {  2010, CLASS_AMMO,       1446,  97 },
+   {  2011, CLASS_HEALTH,     1453,  98 },
+   {  2012, CLASS_HEALTH,     1462,  99 },
+   {  2013, CLASS_HEALTH,     1470, 100 },
+   {  2014, CLASS_HEALTH,     1481, 101 },
+   {  2015, CLASS_ARMOR,      1494, 102 },
+   {  2018, CLASS_ARMOR,      1506, 103 },
+   {  2019, CLASS_ARMOR,      1518, 104 },
+   {  2022, CLASS_POWERUP,    1529, 105 },
+   {  2023, CLASS_POWERUP,    1552, 106 },
+   {  2024, CLASS_POWERUP,    1560, 107 },
+   {  2025, CLASS_POWERUP,    1572, 108 },
+   {  2026, CLASS_POWERUP,    1587, 109 },
+   {  2028, CLASS_DECOR,      1605, 110 },
+   {  2035, CLASS_HAZARD,     1612, 111 },
+   {  2045, CLASS_POWERUP,    1629, 112 },
+   {  2046, CLASS_AMMO,       1645, 113 },
+   {  2047, CLASS_AMMO,       1660, 114 },
+   {  2048, CLASS_AMMO,       1680, 115 },
+   {  2049, CLASS_AMMO,       1695, 116 },
+   {  3001, CLASS_MONSTER,    1709, 117 },
+   {  3002, CLASS_MONSTER,    1713, 118 },
+   {  3003, CLASS_MONSTER,    1719, 119 },
+   {  3004, CLASS_MONSTER,    1733, 120 },
+   {  3005, CLASS_MONSTER,    1743, 121 },
+   {  3006, CLASS_MONSTER,    1753, 122 },
+   {  4001, CLASS_TECHNICAL,  1763, 123 },
+   {  4002, CLASS_TECHNICAL,  1778, 124 },
+   {  4003, CLASS_TECHNICAL,  1793, 125 },
+   {  4004, CLASS_TECHNICAL,  1808, 126 },
+   {  5001, CLASS_TECHNICAL,  1823, 127 },
+   {  5002, CLASS_TECHNICAL,  1834, 128 },
+};
+
+static const char boomNames[] =
+   "Player 1 start\0"
+   "Player 2 start\0"
+   "Player 3 start\0"
+   "Player 4 start\0"
+   "Blue card\0"
+   "Yellow card\0"
+   "Spider Mastermind\0"
+   "Backpack\0"
+   "Shotgun guy\0"
+   "Gibbed marine\0"
+   "Deathmatch start\0"
+   "Gibbed marine 2\0"
+   "Red card\0"
+   "Teleport destination\0"
+   "Dead marine\0"
+   "Cyberdemon\0"
+   "Energy cell pack\0"
+   "Dead Zombieman\0"
+   "Dead shotguy guy\0"
+   "Dead imp\0"
+   "Dead demon\0"
+   "Dead cacodemon\0"
+   "Dead lost soul\0"
+   "Gibs\0"
+   "Impaled zombieman (dead)\0"
+   "Impaled zombieman (alive)\0"
+   "Impaled head\0"
+   "Heads shishkabob\0"
+   "Skulls and candles\0"
+   "Tall green column\0"
+   "Short green column\0"
+   "Tall red column\0"
+   "Short red column\0"
+   "Candle\0"
+   "Candelabra\0"
+   "Column with heart\0"
+   "Column with skull\0"
+   "Red skull key\0"
+   "Yellow skull key\0"
+   "Blue skull key\0"
+   "Evil eye\0"
+   "Floating skulls\0"
+   "Gray tree\0"
+   "Blue torch\0"
+   "Green torch\0"
+   "Red torch\0"
+   "Stalagtite\0"
+   "Tech pillar\0"
+   "Hanging body - twitching\0"
+   "Hanging body - jacket\0"
+   "Hanging body - no leg\0"
+   "Hanging body - torso\0"
+   "Hanging leg\0"
+   "Tan tree\0"
+   "Short blue torch\0"
+   "Short green torch\0"
+   "Short red torch\0"
+   "Spectre\0"
+   "Hanging body jacket pass\0"
+   "Hanging body torso pass\0"
+   "Hanging body no leg pass\0"
+   "Hanging leg pass\0"
+   "Hanging body twitch pass\0"
+   "Arch-vile\0"
+   "Chaingunner\0"
+   "Revenant\0"
+   "Mancubus\0"
+   "Arachnotron\0"
+   "Hell knight\0"
+   "Burning barrel\0"
+   "Pain elemental\0"
+   "Commander Keen\0"
+   "Hanging body - no guts\0"
+   "Hanging body - no brain\0"
+   "Hanging body - look down\0"
+   "Hanging body - t. skull\0"
+   "Hanging body - t. look up\0"
+   "Hanging body t. no brain\0"
+   "Colon gibs\0"
+   "Small blood pool\0"
+   "Brain stem\0"
+   "Super shotgun\0"
+   "Megasphere\0"
+   "Wolfenstein SS\0"
+   "Tech lamp 1\0"
+   "Tech lamp 2\0"
+   "Boss spawn spot\0"
+   "Boss brain\0"
+   "Boss spawner\0"
+   "Shotgun\0"
+   "Chaingun\0"
+   "Rocket launcher\0"
+   "Plasma rifle\0"
+   "Chainsaw\0"
+   "BFG9000\0"
+   "Clip\0"
+   "Shells\0"
+   "Rocket\0"
+   "Stimpack\0"
+   "Medikit\0"
+   "Soulsphere\0"
+   "Health bonus\0"
+   "Armor bonus\0"
+   "Green armor\0"
+   "Blue armor\0"
+   "Invulnerability sphere\0"
+   "Berserk\0"
+   "Blur sphere\0"
+   "Radiation suit\0"
+   "Computer area map\0"
+   "Column\0"
+   "Explosive barrel\0"
+   "Light amp visor\0"
+   "Box of rockets\0"
+   "Energy cells (Doom)\0"
+   "Box of bullets\0"
+   "Box of shells\0"
+   "Imp\0"
+   "Demon\0"
+   "Baron of Hell\0"
+   "Zombieman\0"
+   "Cacodemon\0"
+   "Lost soul\0"
+   "Player start 5\0"
+   "Player start 6\0"
+   "Player start 7\0"
+   "Player start 8\0"
+   "Push point\0"
+   "Pull point\0";
+
+static const int boomAttrs[NUM_THINGATTRS * 129] =
+{
+   // $hp
+   0, 0, 0, 0, 0, 0, 3000, 0, 30, 0, 0, 0, 0, 0, 0, 4000,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 150, 0, 0, 0, 0, 0, 700,
+   70, 300, 600, 500, 500, 0, 400, 100, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 50, 0, 0, 0, 250, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 60, 150, 1000, 20, 400, 100, 0, 0, 0, 0, 0,
+   0,
+   // $damage
+   0, 0, 0, 0, 0, 0, 0, 920, 0, 0, 0, 0, 0, 0, 0, 0,
+   2250, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 560, 0, 0, 0, 0, 0, 0, 0, 560, 200, 180, 900, 0, 900, 100,
+   280, 90, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 450, 450, 500, 1400, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0,
+   // $health
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 200, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 10, 25, 100, 1, 0, 0, 0, 0, 100, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0,
+   // $armor
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 200, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 1, 100, 200, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0,
+};
+
+// chex
+
+static const thingtype_t chexTypes[] =
+{
+   {     1, CLASS_TECHNICAL,     0,   0 },
+   {     2, CLASS_TECHNICAL,    15,   1 },
+   {     3, CLASS_TECHNICAL,    30,   2 },
+   {     4, CLASS_TECHNICAL,    45,   3 },
+   {     5, CLASS_KEY,          60,   4 },
+   {     6, CLASS_KEY,          69,   5 },
+   {     8, CLASS_AMMO,         80,   6 },
+   {     9, CLASS_MONSTER,      90,   7 },
+   {    11, CLASS_TECHNICAL,   110,   8 },
+   {    13, CLASS_KEY,         127,   9 },
+   {    14, CLASS_TECHNICAL,   135,  10 },
+   {    17, CLASS_AMMO,        156,  11 },
+   {    25, CLASS_DECOR,       175,  12 },
+   {    28, CLASS_DECOR,       189,  13 },
+   {    30, CLASS_DECOR,       201,  14 },
+   {    31, CLASS_DECOR,       219,  15 },
+   {    32, CLASS_DECOR,       235,  16 },
+   {    33, CLASS_DECOR,       249,  17 },
+   {    34, CLASS_DECOR,       259,  18 },
+   {    35, CLASS_DECOR,       274,  19 },
+   {    37, CLASS_DECOR,       283,  20 },
+   {    41, CLASS_DECOR,       296,  21 },
+   {    43, CLASS_DECOR,       310,  22 },
+   {    44, CLASS_DECOR,       322,  23 },
+   {    45, CLASS_DECOR,       337,  24 },
+   {    47, CLASS_DECOR,       348,  25 },
+   {    48, CLASS_DECOR,       359,  26 },
+   {    54, CLASS_DECOR,       369,  27 },
+   {    55, CLASS_DECOR,       381,  28 },
+   {    56, CLASS_DECOR,       394,  29 },
+   {    57, CLASS_DECOR,       405,  30 },
+   {  2001, CLASS_WEAPON,      416,  31 },
+   {  2002, CLASS_WEAPON,      430,  32 },
+   {  2003, CLASS_WEAPON,      444,  33 },
+   {  2004, CLASS_WEAPON,      460,  34 },
+   {  2005, CLASS_WEAPON,      476,  35 },
+   {  2006, CLASS_WEAPON,      492,  36 },
+   {  2007, CLASS_AMMO,        503,  37 },
+   {  2008, CLASS_AMMO,        523,  38 },
+   {  2010, CLASS_AMMO,        544,  39 },
+   {  2011, CLASS_HEALTH,      560,  40 },
+   {  2012, CLASS_HEALTH,      574,  41 },
+   {  2013, CLASS_HEALTH,      593,  42 },
+   {  2014, CLASS_HEALTH,      615,  43 },
+   {  2015, CLASS_ARMOR,       630,  44 },
+   {  2018, CLASS_ARMOR,       646,  45 },
+   {  2019, CLASS_ARMOR,       657,  46 },
+   {  2025, CLASS_POWERUP,     674,  47 },
+   {  2026, CLASS_POWERUP,     691,  48 },
+   {  2028, CLASS_DECOR,       709,  49 },
+   {  2046, CLASS_AMMO,        728,  50 },
+   {  2047, CLASS_AMMO,        749,  51 },
+   {  2048, CLASS_AMMO,        763,  52 },
+   {  2049, CLASS_AMMO,        779,  53 },
+   {  3001, CLASS_MONSTER,     796,  54 },
+   {  3002, CLASS_MONSTER,     824,  55 },
+   {  3003, CLASS_MONSTER,     853,  56 },
+   {  3004, CLASS_MONSTER,     863,  57 },
+};
+
+static const char chexNames[] =
+   "Player 1 start\0"
+   "Player 2 start\0"
+   "Player 3 start\0"
+   "Player 4 start\0"
+   "Blue key\0"
+   "Yellow key\0"
+   "Zorchpack\0"
+   "Flemoidus bipedicus\0"
+   "Deathmatch start\0"
+   "Red key\0"
+   "Teleport destination\0"
+   "Phasing zorch pack\0"
+   "Tall flower 2\0"
+   "Tall flower\0"
+   "Cavern stalagmite\0"
+   "Submerged plant\0"
+   "Cavern column\0"
+   "Mine cart\0"
+   "Chemical flask\0"
+   "Gas tank\0"
+   "Flag on pole\0"
+   "Bunsen burner\0"
+   "Orange tree\0"
+   "Slime fountain\0"
+   "Civilian 1\0"
+   "Apple tree\0"
+   "Spaceship\0"
+   "Banana tree\0"
+   "Light column\0"
+   "Civilian 2\0"
+   "Civilian 3\0"
+   "Large zorcher\0"
+   "Rapid zorcher\0"
+   "Zorch propulsor\0"
+   "Phasing zorcher\0"
+   "Super bootspork\0"
+   "LAZ Device\0"
+   "Mini zorch recharge\0"
+   "Large zorch recharge\0"
+   "Propulsor zorch\0"
+   "Bowl of fruit\0"
+   "Bowl of vegetables\0"
+   "Supercharge breakfast\0"
+   "Glass of water\0"
+   "Slime repellent\0"
+   "Chex armor\0"
+   "Super Chex armor\0"
+   "Slime-proof suit\0"
+   "Computer area map\0"
+   "Chex landing light\0"
+   "Propulsor zorch pack\0"
+   "Phasing zorch\0"
+   "Mini zorch pack\0"
+   "Large zorch pack\0"
+   "Armored Flemoidus bipedicus\0"
+   "Flemoidus cycloptis commonus\0"
+   "Flembrane\0"
+   "Flemoidus commonus\0";
+
+static const int chexAttrs[NUM_THINGATTRS * 58] =
+{
+   // $hp
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   // $damage
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   // $health
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   // $armor
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+// doom
+
+static const thingtype_t doomTypes[] =
+{
+   {     1, CLASS_TECHNICAL,     0,   0 },
+   {     2, CLASS_TECHNICAL,    15,   1 },
+   {     3, CLASS_TECHNICAL,    30,   2 },
+   {     4, CLASS_TECHNICAL,    45,   3 },
+   {     5, CLASS_KEY,          60,   4 },
+   {     6, CLASS_KEY,          70,   5 },
+   {     7, CLASS_MONSTER,      82,   6 },
+   {     8, CLASS_AMMO,        100,   7 },
+   {     9, CLASS_MONSTER,     109,   8 },
+   {    10, CLASS_DECOR,       121,   9 },
+   {    11, CLASS_TECHNICAL,   135,  10 },
+   {    12, CLASS_DECOR,       152,  11 },
+   {    13, CLASS_KEY,         168,  12 },
+   {    14, CLASS_TECHNICAL,   177,  13 },
+   {    15, CLASS_DECOR,       198,  14 },
+   {    16, CLASS_MONSTER,     210,  15 },
+   {    17, CLASS_AMMO,        221,  16 },
+   {    18, CLASS_DECOR,       238,  17 },
+   {    19, CLASS_DECOR,       253,  18 },
+   {    20, CLASS_DECOR,       270,  19 },
+   {    21, CLASS_DECOR,       279,  20 },
+   {    22, CLASS_DECOR,       290,  21 },
+   {    23, CLASS_DECOR,       305,  22 },
+   {    24, CLASS_DECOR,       320,  23 },
+   {    25, CLASS_DECOR,       325,  24 },
+   {    26, CLASS_DECOR,       350,  25 },
+   {    27, CLASS_DECOR,       376,  26 },
+   {    28, CLASS_DECOR,       389,  27 },
+   {    29, CLASS_DECOR,       406,  28 },
+   {    30, CLASS_DECOR,       425,  29 },
+   {    31, CLASS_DECOR,       443,  30 },
+   {    32, CLASS_DECOR,       462,  31 },
+   {    33, CLASS_DECOR,       478,  32 },
+   {    34, CLASS_DECOR,       495,  33 },
+   {    35, CLASS_DECOR,       502,  34 },
+   {    36, CLASS_DECOR,       513,  35 },
+   {    37, CLASS_DECOR,       531,  36 },
+   {    38, CLASS_KEY,         549,  37 },
+   {    39, CLASS_KEY,         563,  38 },
+   {    40, CLASS_KEY,         580,  39 },
+   {    41, CLASS_DECOR,       595,  40 },
+   {    42, CLASS_DECOR,       604,  41 },
+   {    43, CLASS_DECOR,       620,  42 },
+   {    44, CLASS_DECOR,       630,  43 },
+   {    45, CLASS_DECOR,       641,  44 },
+   {    46, CLASS_DECOR,       653,  45 },
+   {    47, CLASS_DECOR,       663,  46 },
+   {    48, CLASS_DECOR,       674,  47 },
+   {    49, CLASS_DECOR,       686,  48 },
+   {    50, CLASS_DECOR,       711,  49 },
+   {    51, CLASS_DECOR,       733,  50 },
+   {    52, CLASS_DECOR,       755,  51 },
+   {    53, CLASS_DECOR,       776,  52 },
+   {    54, CLASS_DECOR,       788,  53 },
+   {    55, CLASS_DECOR,       797,  54 },
+   {    56, CLASS_DECOR,       814,  55 },
+   {    57, CLASS_DECOR,       832,  56 },
+   {    58, CLASS_MONSTER,     848,  57 },
+   {    59, CLASS_DECOR,       856,  58 },
+   {    60, CLASS_DECOR,       881,  59 },
+   {    61, CLASS_DECOR,       905,  60 },
+   {    62, CLASS_DECOR,       930,  61 },
+   {    63, CLASS_DECOR,       947,  62 },
+   {    64, CLASS_MONSTER,     972,  63 },
+   {    65, CLASS_MONSTER,     982,  64 },
+   {    66, CLASS_MONSTER,     994,  65 },
+   {    67, CLASS_MONSTER,    1003,  66 },
+   {    68, CLASS_MONSTER,    1012,  67 },
+   {    69, CLASS_MONSTER,    1024,  68 },
+   {    70, CLASS_DECOR,      1036,  69 },
+   {    71, CLASS_MONSTER,    1051,  70 },
+   {    72, CLASS_MONSTER,    1066,  71 },
+   {    73, CLASS_DECOR,      1081,  72 },
+   {    74, CLASS_DECOR,      1104,  73 },
+   {    75, CLASS_DECOR,      1128,  74 },
+   {    76, CLASS_DECOR,      1153,  75 },
+   {    77, CLASS_DECOR,      1177,  76 },
+   {    78, CLASS_DECOR,      1203,  77 },
+   {    79, CLASS_DECOR,      1228,  78 },
+   {    80, CLASS_DECOR,      1239,  79 },
+   {    81, CLASS_DECOR,      1256,  80 },
+   {    82, CLASS_WEAPON,     1267,  81 },
+   {    83, CLASS_HEALTH,     1281,  82 },
+   {    84, CLASS_MONSTER,    1292,  83 },
+   {    85, CLASS_DECOR,      1307,  84 },
+   {    86, CLASS_DECOR,      1319,  85 },
+   {    87, CLASS_TECHNICAL,  1331,  86 },
+   {    88, CLASS_MONSTER,    1347,  87 },
+   {    89, CLASS_TECHNICAL,  1358,  88 },
+   {  2001, CLASS_WEAPON,     1371,  89 },
+   {  2002, CLASS_WEAPON,     1379,  90 },
+   {  2003, CLASS_WEAPON,     1388,  91 },
+   {  2004, CLASS_WEAPON,     1404,  92 },
+   {  2005, CLASS_WEAPON,     1417,  93 },
+   {  2006, CLASS_WEAPON,     1426,  94 },
+   {  2007, CLASS_AMMO,       1434,  95 },
+   {  2008, CLASS_AMMO,       1439,  96 },
+   {  2010, CLASS_AMMO,       1446,  97 },
+   {  2011, CLASS_HEALTH,     1453,  98 },
+   {  2012, CLASS_HEALTH,     1462,  99 },
+   {  2013, CLASS_HEALTH,     1470, 100 },
+   {  2014, CLASS_HEALTH,     1481, 101 },
+   {  2015, CLASS_ARMOR,      1494, 102 },
+   {  2018, CLASS_ARMOR,      1506, 103 },
+   {  2019, CLASS_ARMOR,      1518, 104 },
+   {  2022, CLASS_POWERUP,    1529, 105 },
+   {  2023, CLASS_POWERUP,    1552, 106 },
+   {  2024, CLASS_POWERUP,    1560, 107 },
+   {  2025, CLASS_POWERUP,    1572, 108 },
+   {  2026, CLASS_POWERUP,    1587, 109 },
+   {  2028, CLASS_DECOR,      1605, 110 },
+   {  2035, CLASS_HAZARD,     1612, 111 },
+   {  2045, CLASS_POWERUP,    1629, 112 },
+   {  2046, CLASS_AMMO,       1645, 113 },
+   {  2047, CLASS_AMMO,       1660, 114 },
+   {  2048, CLASS_AMMO,       1680, 115 },
+   {  2049, CLASS_AMMO,       1695, 116 },
+   {  3001, CLASS_MONSTER,    1709, 117 },
+   {  3002, CLASS_MONSTER,    1713, 118 },
+   {  3003, CLASS_MONSTER,    1719, 119 },
+   {  3004, CLASS_MONSTER,    1733, 120 },
+   {  3005, CLASS_MONSTER,    1743, 121 },
+   {  3006, CLASS_MONSTER,    1753, 122 },
+};
+
+static const char doomNames[] =
+   "Player 1 start\0"
+   "Player 2 start\0"
+   "Player 3 start\0"
+   "Player 4 start\0"
+   "Blue card\0"
+   "Yellow card\0"
+   "Spider Mastermind\0"
+   "Backpack\0"
+   "Shotgun guy\0"
+   "Gibbed marine\0"
+   "Deathmatch start\0"
+   "Gibbed marine 2\0"
+   "Red card\0"
+   "Teleport destination\0"
+   "Dead marine\0"
+   "Cyberdemon\0"
+   "Energy cell pack\0"
+   "Dead Zombieman\0"
+   "Dead shotguy guy\0"
+   "Dead imp\0"
+   "Dead demon\0"
+   "Dead cacodemon\0"
+   "Dead lost soul\0"
+   "Gibs\0"
+   "Impaled zombieman (dead)\0"
+   "Impaled zombieman (alive)\0"
+   "Impaled head\0"
+   "Heads shishkabob\0"
+   "Skulls and candles\0"
+   "Tall green column\0"
+   "Short green column\0"
+   "Tall red column\0"
+   "Short red column\0"
+   "Candle\0"
+   "Candelabra\0"
+   "Column with heart\0"
+   "Column with skull\0"
+   "Red skull key\0"
+   "Yellow skull key\0"
+   "Blue skull key\0"
+   "Evil eye\0"
+   "Floating skulls\0"
+   "Gray tree\0"
+   "Blue torch\0"
+   "Green torch\0"
+   "Red torch\0"
+   "Stalagtite\0"
+   "Tech pillar\0"
+   "Hanging body - twitching\0"
+   "Hanging body - jacket\0"
+   "Hanging body - no leg\0"
+   "Hanging body - torso\0"
+   "Hanging leg\0"
+   "Tan tree\0"
+   "Short blue torch\0"
+   "Short green torch\0"
+   "Short red torch\0"
+   "Spectre\0"
+   "Hanging body jacket pass\0"
+   "Hanging body torso pass\0"
+   "Hanging body no leg pass\0"
+   "Hanging leg pass\0"
+   "Hanging body twitch pass\0"
+   "Arch-vile\0"
+   "Chaingunner\0"
+   "Revenant\0"
+   "Mancubus\0"
+   "Arachnotron\0"
+   "Hell knight\0"
+   "Burning barrel\0"
+   "Pain elemental\0"
+   "Commander Keen\0"
+   "Hanging body - no guts\0"
+   "Hanging body - no brain\0"
+   "Hanging body - look down\0"
+   "Hanging body - t. skull\0"
+   "Hanging body - t. look up\0"
+   "Hanging body t. no brain\0"
+   "Colon gibs\0"
+   "Small blood pool\0"
+   "Brain stem\0"
+   "Super shotgun\0"
+   "Megasphere\0"
+   "Wolfenstein SS\0"
+   "Tech lamp 1\0"
+   "Tech lamp 2\0"
+   "Boss spawn spot\0"
+   "Boss brain\0"
+   "Boss spawner\0"
+   "Shotgun\0"
+   "Chaingun\0"
+   "Rocket launcher\0"
+   "Plasma rifle\0"
+   "Chainsaw\0"
+   "BFG9000\0"
+   "Clip\0"
+   "Shells\0"
+   "Rocket\0"
+   "Stimpack\0"
+   "Medikit\0"
+   "Soulsphere\0"
+   "Health bonus\0"
+   "Armor bonus\0"
+   "Green armor\0"
+   "Blue armor\0"
+   "Invulnerability sphere\0"
+   "Berserk\0"
+   "Blur sphere\0"
+   "Radiation suit\0"
+   "Computer area map\0"
+   "Column\0"
+   "Explosive barrel\0"
+   "Light amp visor\0"
+   "Box of rockets\0"
+   "Energy cells (Doom)\0"
+   "Box of bullets\0"
+   "Box of shells\0"
+   "Imp\0"
+   "Demon\0"
+   "Baron of Hell\0"
+   "Zombieman\0"
+   "Cacodemon\0"
+   "Lost soul\0";
+
+static const int doomAttrs[NUM_THINGATTRS * 123] =
+{
+   // $hp
+   0, 0, 0, 0, 0, 0, 3000, 0, 30, 0, 0, 0, 0, 0, 0, 4000,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 150, 0, 0, 0, 0, 0, 700,
+   70, 300, 600, 500, 500, 0, 400, 100, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 50, 0, 0, 0, 250, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 60, 150, 1000, 20, 400, 100,
+   // $damage
+   0, 0, 0, 0, 0, 0, 0, 920, 0, 0, 0, 0, 0, 0, 0, 0,
+   2250, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 560, 0, 0, 0, 0, 0, 0, 0, 560, 200, 180, 900, 0, 900, 100,
+   280, 90, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 450, 450, 500, 1400, 0, 0, 0, 0, 0, 0,
+   // $health
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 200, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 10, 25, 100, 1, 0, 0, 0, 0, 100, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   // $armor
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 200, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 1, 100, 200, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+// heretic
+
+static const thingtype_t hereticTypes[] =
+{
+   {     1, CLASS_TECHNICAL,     0,   0 },
+   {     2, CLASS_TECHNICAL,    15,   1 },
+   {     3, CLASS_TECHNICAL,    30,   2 },
+   {     4, CLASS_TECHNICAL,    45,   3 },
+   {     5, CLASS_MONSTER,      60,   4 },
+   {     6, CLASS_MONSTER,      74,   5 },
+   {     7, CLASS_MONSTER,      84,   6 },
+   {     8, CLASS_AMMO,         93,   7 },
+   {     9, CLASS_MONSTER,     108,   8 },
+   {    10, CLASS_AMMO,        118,   9 },
+   {    11, CLASS_TECHNICAL,   131,  10 },
+   {    12, CLASS_AMMO,        148,  11 },
+   {    13, CLASS_KEY,         162,  12 },
+   {    14, CLASS_TECHNICAL,   175,  13 },
+   {    15, CLASS_MONSTER,     196,  14 },
+   {    16, CLASS_AMMO,        217,  15 },
+   {    17, CLASS_DECOR,       238,  16 },
+   {    18, CLASS_AMMO,        252,  17 },
+   {    19, CLASS_AMMO,        268,  18 },
+   {    20, CLASS_AMMO,        294,  19 },
+   {    21, CLASS_AMMO,        307,  20 },
+   {    22, CLASS_AMMO,        321,  21 },
+   {    23, CLASS_AMMO,        331,  22 },
+   {    24, CLASS_DECOR,       343,  23 },
+   {    25, CLASS_DECOR,       357,  24 },
+   {    26, CLASS_DECOR,       371,  25 },
+   {    27, CLASS_DECOR,       385,  26 },
+   {    28, CLASS_DECOR,       399,  27 },
+   {    29, CLASS_DECOR,       410,  28 },
+   {    30, CLASS_ARTIFACT,    423,  29 },
+   {    31, CLASS_ARMOR,       434,  30 },
+   {    32, CLASS_HEALTH,      451,  31 },
+   {    33, CLASS_POWERUP,     462,  32 },
+   {    35, CLASS_POWERUP,     468,  33 },
+   {    36, CLASS_ARTIFACT,    479,  34 },
+   {    37, CLASS_DECOR,       492,  35 },
+   {    38, CLASS_DECOR,       509,  36 },
+   {    39, CLASS_DECOR,       526,  37 },
+   {    40, CLASS_DECOR,       543,  38 },
+   {    41, CLASS_AMBIENT,     560,  39 },
+   {    42, CLASS_AMBIENT,     576,  40 },
+   {    43, CLASS_HAZARD,      587,  41 },
+   {    44, CLASS_DECOR,       601,  42 },
+   {    45, CLASS_MONSTER,     608,  43 },
+   {    46, CLASS_MONSTER,     619,  44 },
+   {    47, CLASS_DECOR,       636,  45 },
+   {    48, CLASS_DECOR,       649,  46 },
+   {    49, CLASS_DECOR,       656,  47 },
+   {    50, CLASS_DECOR,       663,  48 },
+   {    51, CLASS_DECOR,       674,  49 },
+   {    52, CLASS_DECOR,       689,  50 },
+   {    53, CLASS_WEAPON,      706,  51 },
+   {    54, CLASS_AMMO,        717,  52 },
+   {    55, CLASS_AMMO,        726,  53 },
+   {    56, CLASS_TECHNICAL,   737,  54 },
+   {    64, CLASS_MONSTER,     760,  55 },
+   {    65, CLASS_MONSTER,     774,  56 },
+   {    66, CLASS_MONSTER,     794,  57 },
+   {    68, CLASS_MONSTER,     803,  58 },
+   {    69, CLASS_MONSTER,     809,  59 },
+   {    70, CLASS_MONSTER,     821,  60 },
+   {    73, CLASS_KEY,         832,  61 },
+   {    74, CLASS_DECOR,       842,  62 },
+   {    75, CLASS_POWERUP,     858,  63 },
+   {    76, CLASS_DECOR,       871,  64 },
+   {    79, CLASS_KEY,         884,  65 },
+   {    80, CLASS_KEY,         893,  66 },
+   {    81, CLASS_HEALTH,      904,  67 },
+   {    82, CLASS_HEALTH,      917,  68 },
+   {    83, CLASS_POWERUP,     930,  69 },
+   {    84, CLASS_POWERUP,     945,  70 },
+   {    85, CLASS_ARMOR,       969,  71 },
+   {    86, CLASS_POWERUP,     983,  72 },
+   {    87, CLASS_HAZARD,      997,  73 },
+   {    90, CLASS_MONSTER,    1005,  74 },
+   {    92, CLASS_MONSTER,    1015,  75 },
+   {    94, CLASS_DECOR,      1024,  76 },
+   {    95, CLASS_DECOR,      1039,  77 },
+   {    96, CLASS_DECOR,      1055,  78 },
+   {  1200, CLASS_AMBIENT,    1072,  79 },
+   {  1201, CLASS_AMBIENT,    1089,  80 },
+   {  1202, CLASS_AMBIENT,    1106,  81 },
+   {  1203, CLASS_AMBIENT,    1123,  82 },
+   {  1204, CLASS_AMBIENT,    1140,  83 },
+   {  1205, CLASS_AMBIENT,    1157,  84 },
+   {  1206, CLASS_AMBIENT,    1174,  85 },
+   {  1207, CLASS_AMBIENT,    1191,  86 },
+   {  1208, CLASS_AMBIENT,    1208,  87 },
+   {  1209, CLASS_AMBIENT,    1225,  88 },
+   {  2001, CLASS_WEAPON,     1243,  89 },
+   {  2002, CLASS_WEAPON,     1261,  90 },
+   {  2003, CLASS_WEAPON,     1271,  91 },
+   {  2004, CLASS_WEAPON,     1283,  92 },
+   {  2005, CLASS_WEAPON,     1293,  93 },
+   {  2035, CLASS_HAZARD,     1322,  94 },
+};
+
+static const char hereticNames[] =
+   "Player 1 start\0"
+   "Player 2 start\0"
+   "Player 3 start\0"
+   "Player 4 start\0"
+   "Fire gargoyle\0"
+   "Iron lich\0"
+   "D'Sparil\0"
+   "Bag of Holding\0"
+   "Maulotaur\0"
+   "Wand crystal\0"
+   "Deathmatch start\0"
+   "Crystal geode\0"
+   "Mace spheres\0"
+   "Teleport destination\0"
+   "Disciple of D'Sparil\0"
+   "Pile of mace spheres\0"
+   "Skull hang 70\0"
+   "Ethereal arrows\0"
+   "Quiver of ethereal arrows\0"
+   "Lesser runes\0"
+   "Greater runes\0"
+   "Flame orb\0"
+   "Inferno orb\0"
+   "Skull hang 60\0"
+   "Skull hang 45\0"
+   "Skull hang 35\0"
+   "Serpent torch\0"
+   "Chandelier\0"
+   "Small pillar\0"
+   "Morph ovum\0"
+   "Enchanted shield\0"
+   "Mystic urn\0"
+   "Torch\0"
+   "Map scroll\0"
+   "Chaos device\0"
+   "Small stalagmite\0"
+   "Large stalagmite\0"
+   "Small stalactite\0"
+   "Large stalactite\0"
+   "Waterfall sound\0"
+   "Wind sound\0"
+   "Pod generator\0"
+   "Barrel\0"
+   "Nitrogolem\0"
+   "Nitrogolem ghost\0"
+   "Brown pillar\0"
+   "Moss 1\0"
+   "Moss 2\0"
+   "Wall torch\0"
+   "Hanging corpse\0"
+   "Blue teleglitter\0"
+   "Dragonclaw\0"
+   "Claw orb\0"
+   "Energy orb\0"
+   "D'Sparil teleport spot\0"
+   "Undead knight\0"
+   "Undead knight ghost\0"
+   "Gargoyle\0"
+   "Golem\0"
+   "Golem ghost\0"
+   "Weredragon\0"
+   "Green key\0"
+   "Red teleglitter\0"
+   "Shadowsphere\0"
+   "Fire brazier\0"
+   "Blue key\0"
+   "Yellow key\0"
+   "Crystal vial\0"
+   "Quartz flask\0"
+   "Wings of Wrath\0"
+   "Ring of Invulnerability\0"
+   "Silver shield\0"
+   "Tome of Power\0"
+   "Volcano\0"
+   "Sabreclaw\0"
+   "Ophidian\0"
+   "Blue key gizmo\0"
+   "Green key gizmo\0"
+   "Yellow key gizmo\0"
+   "Sound sequence 1\0"
+   "Sound sequence 2\0"
+   "Sound sequence 3\0"
+   "Sound sequence 4\0"
+   "Sound sequence 5\0"
+   "Sound sequence 6\0"
+   "Sound sequence 7\0"
+   "Sound sequence 8\0"
+   "Sound sequence 9\0"
+   "Sound sequence 10\0"
+   "Ethereal crossbow\0"
+   "Mace spot\0"
+   "Phoenix rod\0"
+   "Skull rod\0"
+   "Gauntlets of the Necromancer\0"
+   "Pod\0";
+
+static const int hereticAttrs[NUM_THINGATTRS * 95] =
+{
+   // $hp
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   // $damage
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   // $health
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   // $armor
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+// hexen
+
+static const thingtype_t hexenTypes[] =
+{
+   {     1, CLASS_TECHNICAL,     0,   0 },
+   {     2, CLASS_TECHNICAL,    15,   1 },
+   {     3, CLASS_TECHNICAL,    30,   2 },
+   {     4, CLASS_TECHNICAL,    45,   3 },
+   {     5, CLASS_DECOR,        60,   4 },
+   {     6, CLASS_DECOR,        74,   5 },
+   {     7, CLASS_DECOR,        81,   6 },
+   {     9, CLASS_DECOR,        88,   7 },
+   {    10, CLASS_WEAPON,       95,   8 },
+   {    11, CLASS_TECHNICAL,   109,   9 },
+   {    12, CLASS_WEAPON,      126,  10 },
+   {    13, CLASS_WEAPON,      142,  11 },
+   {    14, CLASS_TECHNICAL,   158,  12 },
+   {    15, CLASS_DECOR,       179,  13 },
+   {    16, CLASS_WEAPON,      186,  14 },
+   {    17, CLASS_DECOR,       202,  15 },
+   {    18, CLASS_WEAPON,      213,  16 },
+   {    19, CLASS_WEAPON,      233,  17 },
+   {    20, CLASS_WEAPON,      253,  18 },
+   {    21, CLASS_WEAPON,      273,  19 },
+   {    22, CLASS_WEAPON,      294,  20 },
+   {    23, CLASS_WEAPON,      315,  21 },
+   {    24, CLASS_DECOR,       336,  22 },
+   {    25, CLASS_DECOR,       346,  23 },
+   {    26, CLASS_DECOR,       351,  24 },
+   {    27, CLASS_DECOR,       366,  25 },
+   {    28, CLASS_DECOR,       381,  26 },
+   {    29, CLASS_DECOR,       399,  27 },
+   {    30, CLASS_ARTIFACT,    410,  28 },
+   {    31, CLASS_MONSTER,     421,  29 },
+   {    32, CLASS_HEALTH,      441,  30 },
+   {    33, CLASS_POWERUP,     452,  31 },
+   {    34, CLASS_MONSTER,     458,  32 },
+   {    36, CLASS_ARTIFACT,    465,  33 },
+   {    37, CLASS_DECOR,       478,  34 },
+   {    38, CLASS_DECOR,       492,  35 },
+   {    39, CLASS_DECOR,       506,  36 },
+   {    40, CLASS_DECOR,       523,  37 },
+   {    41, CLASS_DECOR,       540,  38 },
+   {    42, CLASS_DECOR,       557,  39 },
+   {    44, CLASS_DECOR,       574,  40 },
+   {    45, CLASS_DECOR,       591,  41 },
+   {    46, CLASS_DECOR,       608,  42 },
+   {    47, CLASS_DECOR,       625,  43 },
+   {    48, CLASS_DECOR,       642,  44 },
+   {    49, CLASS_DECOR,       660,  45 },
+   {    50, CLASS_DECOR,       677,  46 },
+   {    51, CLASS_DECOR,       695,  47 },
+   {    52, CLASS_DECOR,       712,  48 },
+   {    53, CLASS_WEAPON,      729,  49 },
+   {    54, CLASS_DECOR,       742,  50 },
+   {    55, CLASS_DECOR,       753,  51 },
+   {    56, CLASS_DECOR,       770,  52 },
+   {    57, CLASS_DECOR,       788,  53 },
+   {    58, CLASS_DECOR,       805,  54 },
+   {    59, CLASS_DECOR,       820,  55 },
+   {    60, CLASS_DECOR,       835,  56 },
+   {    61, CLASS_DECOR,       846,  57 },
+   {    62, CLASS_DECOR,       859,  58 },
+   {    63, CLASS_DECOR,       875,  59 },
+   {    64, CLASS_DECOR,       891,  60 },
+   {    65, CLASS_DECOR,       909,  61 },
+   {    66, CLASS_DECOR,       933,  62 },
+   {    67, CLASS_DECOR,       953,  63 },
+   {    68, CLASS_DECOR,       978,  64 },
+   {    69, CLASS_DECOR,      1002,  65 },
+   {    71, CLASS_DECOR,      1022,  66 },
+   {    72, CLASS_DECOR,      1037,  67 },
+   {    73, CLASS_DECOR,      1059,  68 },
+   {    74, CLASS_DECOR,      1080,  69 },
+   {    76, CLASS_DECOR,      1103,  70 },
+   {    77, CLASS_DECOR,      1125,  71 },
+   {    78, CLASS_DECOR,      1141,  72 },
+   {    79, CLASS_DECOR,      1154,  73 },
+   {    80, CLASS_DECOR,      1167,  74 },
+   {    81, CLASS_HEALTH,     1182,  75 },
+   {    82, CLASS_HEALTH,     1195,  76 },
+   {    83, CLASS_POWERUP,    1208,  77 },
+   {    84, CLASS_POWERUP,    1223,  78 },
+   {    86, CLASS_POWERUP,    1244,  79 },
+   {    87, CLASS_DECOR,      1257,  80 },
+   {    88, CLASS_DECOR,      1272,  81 },
+   {    89, CLASS_DECOR,      1276,  82 },
+   {    90, CLASS_DECOR,      1297,  83 },
+   {    91, CLASS_DECOR,      1319,  84 },
+   {    92, CLASS_DECOR,      1340,  85 },
+   {    93, CLASS_DECOR,      1360,  86 },
+   {    94, CLASS_DECOR,      1381,  87 },
+   {    95, CLASS_DECOR,      1403,  88 },
+   {    96, CLASS_DECOR,      1424,  89 },
+   {    97, CLASS_DECOR,      1444,  90 },
+   {    98, CLASS_DECOR,      1457,  91 },
+   {    99, CLASS_DECOR,      1470,  92 },
+   {   100, CLASS_DECOR,      1481,  93 },
+   {   101, CLASS_DECOR,      1490,  94 },
+   {   102, CLASS_DECOR,      1499,  95 },
+   {   103, CLASS_DECOR,      1508,  96 },
+   {   104, CLASS_DECOR,      1520,  97 },
+   {   105, CLASS_DECOR,      1530,  98 },
+   {   106, CLASS_DECOR,      1540,  99 },
+   {   107, CLASS_MONSTER,    1550, 100 },
+   {   108, CLASS_DECOR,      1558, 101 },
+   {   109, CLASS_DECOR,      1573, 102 },
+   {   110, CLASS_DECOR,      1598, 103 },
+   {   111, CLASS_DECOR,      1613, 104 },
+   {   113, CLASS_TECHNICAL,  1627, 105 },
+   {   114, CLASS_MONSTER,    1640, 106 },
+   {   115, CLASS_MONSTER,    1652, 107 },
+   {   116, CLASS_DECOR,      1663, 108 },
+   {   117, CLASS_DECOR,      1676, 109 },
+   {   118, CLASS_TECHNICAL,  1695, 110 },
+   {   119, CLASS_DECOR,      1702, 111 },
+   {   120, CLASS_MONSTER,    1709, 112 },
+   {   121, CLASS_MONSTER,    1722, 113 },
+   {   122, CLASS_AMMO,       1730, 114 },
+   {   123, CLASS_WEAPON,     1740, 115 },
+   {   124, CLASS_AMMO,       1762, 116 },
+   {   140, CLASS_DECOR,      1773, 117 },
+   {   254, CLASS_MONSTER,    1790, 118 },
+   {  1400, CLASS_TECHNICAL,  1803, 119 },
+   {  1401, CLASS_TECHNICAL,  1820, 120 },
+   {  1402, CLASS_TECHNICAL,  1837, 121 },
+   {  1403, CLASS_TECHNICAL,  1854, 122 },
+   {  1404, CLASS_TECHNICAL,  1871, 123 },
+   {  1405, CLASS_TECHNICAL,  1888, 124 },
+   {  1406, CLASS_TECHNICAL,  1905, 125 },
+   {  1407, CLASS_TECHNICAL,  1922, 126 },
+   {  1408, CLASS_TECHNICAL,  1939, 127 },
+   {  1409, CLASS_TECHNICAL,  1956, 128 },
+   {  1410, CLASS_AMBIENT,    1974, 129 },
+   {  3000, CLASS_TECHNICAL,  1985, 130 },
+   {  3001, CLASS_TECHNICAL,  2003, 131 },
+   {  3002, CLASS_TECHNICAL,  2025, 132 },
+   {  8000, CLASS_ARTIFACT,   2053, 133 },
+   {  8002, CLASS_POWERUP,    2063, 134 },
+   {  8003, CLASS_AMMO,       2078, 135 },
+   {  8004, CLASS_AMMO,       2094, 136 },
+   {  8005, CLASS_ARMOR,      2108, 137 },
+   {  8006, CLASS_ARMOR,      2119, 138 },
+   {  8007, CLASS_ARMOR,      2133, 139 },
+   {  8008, CLASS_ARMOR,      2147, 140 },
+   {  8009, CLASS_WEAPON,     2165, 141 },
+   {  8010, CLASS_WEAPON,     2175, 142 },
+   {  8020, CLASS_MONSTER,    2187, 143 },
+   {  8030, CLASS_KEY,        2195, 144 },
+   {  8031, CLASS_KEY,        2205, 145 },
+   {  8032, CLASS_KEY,        2214, 146 },
+   {  8033, CLASS_KEY,        2222, 147 },
+   {  8034, CLASS_KEY,        2231, 148 },
+   {  8035, CLASS_KEY,        2243, 149 },
+   {  8036, CLASS_KEY,        2255, 150 },
+   {  8037, CLASS_KEY,        2266, 151 },
+   {  8038, CLASS_KEY,        2277, 152 },
+   {  8039, CLASS_KEY,        2286, 153 },
+   {  8040, CLASS_WEAPON,     2296, 154 },
+   {  8041, CLASS_ARMOR,      2309, 155 },
+   {  8042, CLASS_DECOR,      2328, 156 },
+   {  8043, CLASS_DECOR,      2344, 157 },
+   {  8044, CLASS_DECOR,      2366, 158 },
+   {  8045, CLASS_DECOR,      2390, 159 },
+   {  8046, CLASS_DECOR,      2415, 160 },
+   {  8047, CLASS_DECOR,      2435, 161 },
+   {  8048, CLASS_DECOR,      2455, 162 },
+   {  8049, CLASS_DECOR,      2476, 163 },
+   {  8050, CLASS_DECOR,      2502, 164 },
+   {  8051, CLASS_DECOR,      2523, 165 },
+   {  8052, CLASS_DECOR,      2544, 166 },
+   {  8060, CLASS_DECOR,      2566, 167 },
+   {  8061, CLASS_DECOR,      2580, 168 },
+   {  8062, CLASS_DECOR,      2592, 169 },
+   {  8063, CLASS_DECOR,      2610, 170 },
+   {  8064, CLASS_DECOR,      2627, 171 },
+   {  8065, CLASS_DECOR,      2641, 172 },
+   {  8066, CLASS_DECOR,      2646, 173 },
+   {  8067, CLASS_DECOR,      2658, 174 },
+   {  8068, CLASS_DECOR,      2670, 175 },
+   {  8069, CLASS_DECOR,      2682, 176 },
+   {  8070, CLASS_DECOR,      2691, 177 },
+   {  8071, CLASS_DECOR,      2706, 178 },
+   {  8072, CLASS_DECOR,      2719, 179 },
+   {  8073, CLASS_DECOR,      2732, 180 },
+   {  8074, CLASS_DECOR,      2748, 181 },
+   {  8075, CLASS_DECOR,      2765, 182 },
+   {  8076, CLASS_DECOR,      2782, 183 },
+   {  8077, CLASS_DECOR,      2798, 184 },
+   {  8080, CLASS_MONSTER,    2814, 185 },
+   {  8100, CLASS_DECOR,      2834, 186 },
+   {  8101, CLASS_DECOR,      2841, 187 },
+   {  8102, CLASS_DECOR,      2849, 188 },
+   {  8103, CLASS_DECOR,      2857, 189 },
+   {  8104, CLASS_HAZARD,     2864, 190 },
+   {  8200, CLASS_KEY,        2883, 191 },
+   {  8500, CLASS_DECOR,      2894, 192 },
+   {  8501, CLASS_DECOR,      2904, 193 },
+   {  8502, CLASS_DECOR,      2915, 194 },
+   {  8503, CLASS_DECOR,      2941, 195 },
+   {  8504, CLASS_DECOR,      2954, 196 },
+   {  8505, CLASS_DECOR,      2972, 197 },
+   {  8506, CLASS_DECOR,      2987, 198 },
+   {  8507, CLASS_DECOR,      2994, 199 },
+   {  8508, CLASS_DECOR,      3007, 200 },
+   {  8509, CLASS_DECOR,      3039, 201 },
+   {  9001, CLASS_TECHNICAL,  3052, 202 },
+   {  9002, CLASS_QUEST,      3061, 203 },
+   {  9003, CLASS_QUEST,      3076, 204 },
+   {  9004, CLASS_QUEST,      3094, 205 },
+   {  9005, CLASS_QUEST,      3106, 206 },
+   {  9006, CLASS_QUEST,      3121, 207 },
+   {  9007, CLASS_QUEST,      3137, 208 },
+   {  9008, CLASS_QUEST,      3150, 209 },
+   {  9009, CLASS_QUEST,      3163, 210 },
+   {  9010, CLASS_QUEST,      3180, 211 },
+   {  9011, CLASS_DECOR,      3198, 212 },
+   {  9012, CLASS_DECOR,      3212, 213 },
+   {  9013, CLASS_TECHNICAL,  3239, 214 },
+   {  9014, CLASS_QUEST,      3259, 215 },
+   {  9015, CLASS_QUEST,      3270, 216 },
+   {  9016, CLASS_QUEST,      3282, 217 },
+   {  9017, CLASS_QUEST,      3293, 218 },
+   {  9018, CLASS_QUEST,      3312, 219 },
+   {  9019, CLASS_QUEST,      3325, 220 },
+   {  9020, CLASS_QUEST,      3338, 221 },
+   {  9021, CLASS_QUEST,      3351, 222 },
+   {  9100, CLASS_TECHNICAL,  3364, 223 },
+   {  9101, CLASS_TECHNICAL,  3379, 224 },
+   {  9102, CLASS_TECHNICAL,  3394, 225 },
+   {  9103, CLASS_TECHNICAL,  3409, 226 },
+   { 10000, CLASS_TECHNICAL,  3424, 227 },
+   { 10001, CLASS_DECOR,      3436, 228 },
+   { 10002, CLASS_DECOR,      3452, 229 },
+   { 10003, CLASS_DECOR,      3469, 230 },
+   { 10011, CLASS_MONSTER,    3485, 231 },
+   { 10030, CLASS_MONSTER,    3499, 232 },
+   { 10040, CLASS_ARTIFACT,   3505, 233 },
+   { 10060, CLASS_MONSTER,    3523, 234 },
+   { 10080, CLASS_MONSTER,    3529, 235 },
+   { 10090, CLASS_HAZARD,     3540, 236 },
+   { 10091, CLASS_HAZARD,     3558, 237 },
+   { 10100, CLASS_MONSTER,    3574, 238 },
+   { 10101, CLASS_MONSTER,    3580, 239 },
+   { 10102, CLASS_MONSTER,    3590, 240 },
+   { 10110, CLASS_ARTIFACT,   3599, 241 },
+   { 10120, CLASS_ARTIFACT,   3617, 242 },
+   { 10200, CLASS_MONSTER,    3637, 243 },
+   { 10225, CLASS_TECHNICAL,  3643, 244 },
+   { 10500, CLASS_DECOR,      3655, 245 },
+   { 10501, CLASS_DECOR,      3677, 246 },
+   { 10502, CLASS_DECOR,      3689, 247 },
+   { 10503, CLASS_DECOR,      3711, 248 },
+};
+
+static const char hexenNames[] =
+   "Player 1 start\0"
+   "Player 2 start\0"
+   "Player 3 start\0"
+   "Player 4 start\0"
+   "ZWingedStatue\0"
+   "ZRock1\0"
+   "ZRock2\0"
+   "ZRock3\0"
+   "Serpent staff\0"
+   "Deathmatch start\0"
+   "Quietus piece 1\0"
+   "Quietus piece 2\0"
+   "Teleport destination\0"
+   "ZRock4\0"
+   "Quietus piece 3\0"
+   "Chandelier\0"
+   "Wraithverge piece 1\0"
+   "Wraithverge piece 2\0"
+   "Wraithverge piece 3\0"
+   "Bloodscourge piece 1\0"
+   "Bloodscourge piece 2\0"
+   "Bloodscourge piece 3\0"
+   "Dead tree\0"
+   "Tree\0"
+   "Swamp tree 150\0"
+   "Swamp tree 120\0"
+   "Burned tree stump\0"
+   "Bare stump\0"
+   "Porkalator\0"
+   "Green chaos serpent\0"
+   "Mystic urn\0"
+   "Torch\0"
+   "Wraith\0"
+   "Chaos device\0"
+   "Swamp stump 1\0"
+   "Swamp stump 2\0"
+   "Large mushroom 1\0"
+   "Large mushroom 2\0"
+   "Large mushroom 3\0"
+   "Small mushroom 1\0"
+   "Small mushroom 2\0"
+   "Small mushroom 3\0"
+   "Small mushroom 4\0"
+   "Small mushroom 5\0"
+   "Stalagmite pillar\0"
+   "Large stalagmite\0"
+   "Medium stalagmite\0"
+   "Small stalagmite\0"
+   "Large stalactite\0"
+   "Frost shards\0"
+   "Wall torch\0"
+   "Unlit wall torch\0"
+   "Medium stalactite\0"
+   "Small stalactite\0"
+   "Ceiling moss 1\0"
+   "Ceiling moss 2\0"
+   "Swamp vine\0"
+   "Corpse kabob\0"
+   "Sleeping corpse\0"
+   "Tombstone (RIP)\0"
+   "Tombstone (Shane)\0"
+   "Tombstone (large cross)\0"
+   "Tombstone (Brian R)\0"
+   "Tombstone (cross/circle)\0"
+   "Tombstone (small cross)\0"
+   "Tombstone (Brian P)\0"
+   "Hanging corpse\0"
+   "Gargoyle (green tall)\0"
+   "Gargoyle (blue tall)\0"
+   "Gargoyle (green short)\0"
+   "Gargoyle (blue short)\0"
+   "Tattered banner\0"
+   "Large tree 1\0"
+   "Large tree 2\0"
+   "Gnarled tree 1\0"
+   "Crystal vial\0"
+   "Quartz flask\0"
+   "Wings of Wrath\0"
+   "Icon of the Defender\0"
+   "Dark Servant\0"
+   "Gnarled tree 2\0"
+   "Log\0"
+   "Large ice stalactite\0"
+   "Medium ice stalactite\0"
+   "Small ice stalactite\0"
+   "Tiny ice stalactite\0"
+   "Large ice stalagmite\0"
+   "Medium ice stalagmite\0"
+   "Small ice stalagmite\0"
+   "Tiny ice stalagmite\0"
+   "Brown rock 1\0"
+   "Brown rock 2\0"
+   "Black rock\0"
+   "Rubble 1\0"
+   "Rubble 2\0"
+   "Rubble 3\0"
+   "Vase pillar\0"
+   "Pottery 1\0"
+   "Pottery 2\0"
+   "Pottery 3\0"
+   "Centaur\0"
+   "Lynched corpse\0"
+   "Lynched corpse, no heart\0"
+   "Sitting corpse\0"
+   "Pool of blood\0"
+   "Leaf spawner\0"
+   "Dark bishop\0"
+   "Slaughtaur\0"
+   "Twined torch\0"
+   "Unlit twined torch\0"
+   "Bridge\0"
+   "Candle\0"
+   "Stalker boss\0"
+   "Stalker\0"
+   "Blue mana\0"
+   "Hammer of Retribution\0"
+   "Green mana\0"
+   "Teleportal smoke\0"
+   "Death wyvern\0"
+   "Sound sequence 1\0"
+   "Sound sequence 2\0"
+   "Sound sequence 3\0"
+   "Sound sequence 4\0"
+   "Sound sequence 5\0"
+   "Sound sequence 6\0"
+   "Sound sequence 7\0"
+   "Sound sequence 8\0"
+   "Sound sequence 9\0"
+   "Sound sequence 10\0"
+   "Wind sound\0"
+   "Polyobject anchor\0"
+   "Polyobject spawn spot\0"
+   "Polyobject spawn spot crush\0"
+   "Flechette\0"
+   "Boots of speed\0"
+   "Krater of might\0"
+   "Combined mana\0"
+   "Mesh armor\0"
+   "Falcon shield\0"
+   "Platinum helm\0"
+   "Amulet of warding\0"
+   "Firestorm\0"
+   "Timon's axe\0"
+   "Wendigo\0"
+   "Steel key\0"
+   "Cave key\0"
+   "Axe key\0"
+   "Fire key\0"
+   "Emerald key\0"
+   "Dungeon key\0"
+   "Silver key\0"
+   "Rusted key\0"
+   "Horn key\0"
+   "Swamp key\0"
+   "Arc of death\0"
+   "Dragonskin bracers\0"
+   "Maulotaur torch\0"
+   "Unlit Maulotaur torch\0"
+   "Gargoyle (striped tall)\0"
+   "Gargoyle (dark red tall)\0"
+   "Gargoyle (red tall)\0"
+   "Gargoyle (tan tall)\0"
+   "Gargoyle (rust tall)\0"
+   "Gargoyle (dark red short)\0"
+   "Gargoyle (red short)\0"
+   "Gargoyle (tan short)\0"
+   "Gargoyle (rust short)\0"
+   "Skull brazier\0"
+   "Brass torch\0"
+   "Destructible tree\0"
+   "Unlit chandelier\0"
+   "Suit of armor\0"
+   "Bell\0"
+   "Blue candle\0"
+   "Iron maiden\0"
+   "Spruce tree\0"
+   "Cauldron\0"
+   "Unlit cauldron\0"
+   "Chain bit 32\0"
+   "Chain bit 64\0"
+   "Chain end heart\0"
+   "Chain end hook 1\0"
+   "Chain end hook 2\0"
+   "Chain end spike\0"
+   "Chain end skull\0"
+   "Brown chaos serpent\0"
+   "Barrel\0"
+   "Shrub 1\0"
+   "Shrub 2\0"
+   "Bucket\0"
+   "Poisonous mushroom\0"
+   "Castle key\0"
+   "Large mug\0"
+   "Beer stein\0"
+   "Unlit candle with cobwebs\0"
+   "Unlit candle\0"
+   "Tall unlit candle\0"
+   "Spilled goblet\0"
+   "Goblet\0"
+   "Short goblet\0"
+   "Short goblet with silver stripe\0"
+   "Meat cleaver\0"
+   "Map spot\0"
+   "Yorick's skull\0"
+   "Heart of D'Sparil\0"
+   "Ruby planet\0"
+   "Emerald planet\0"
+   "Sapphire planet\0"
+   "Daemon codex\0"
+   "Liber oscura\0"
+   "Emerald planet 2\0"
+   "Sapphire planet 2\0"
+   "Yorick statue\0"
+   "Heart of D'Sparil pedestal\0"
+   "Map spot no gravity\0"
+   "Flame mask\0"
+   "Glaive seal\0"
+   "Holy relic\0"
+   "Sigil of the magus\0"
+   "Clock gear 1\0"
+   "Clock gear 2\0"
+   "Clock gear 3\0"
+   "Clock gear 4\0"
+   "Player start 5\0"
+   "Player start 6\0"
+   "Player start 7\0"
+   "Player start 8\0"
+   "Fog spawner\0"
+   "Small fog patch\0"
+   "Medium fog patch\0"
+   "Large fog patch\0"
+   "Buried wraith\0"
+   "Ettin\0"
+   "Banishment device\0"
+   "Afrit\0"
+   "Heresiarch\0"
+   "Thrust spike down\0"
+   "Thrust spike up\0"
+   "Zedek\0"
+   "Traductus\0"
+   "Menelkir\0"
+   "Disc of repulsion\0"
+   "Mystic ambit incant\0"
+   "Korax\0"
+   "Bat spawner\0"
+   "Small temporary flame\0"
+   "Small flame\0"
+   "Large temporary flame\0"
+   "Large flame\0";
+
+static const int hexenAttrs[NUM_THINGATTRS * 249] =
+{
+   // $hp
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0,
+   // $damage
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0,
+   // $health
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0,
+   // $armor
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+// mbf
+
+static const thingtype_t mbfTypes[] =
+{
+   {     1, CLASS_TECHNICAL,     0,   0 },
+   {     2, CLASS_TECHNICAL,    15,   1 },
+   {     3, CLASS_TECHNICAL,    30,   2 },
+   {     4, CLASS_TECHNICAL,    45,   3 },
+   {     5, CLASS_KEY,          60,   4 },
+   {     6, CLASS_KEY,          70,   5 },
+   {     7, CLASS_MONSTER,      82,   6 },
+   {     8, CLASS_AMMO,        100,   7 },
+   {     9, CLASS_MONSTER,     109,   8 },
+   {    10, CLASS_DECOR,       121,   9 },
+   {    11, CLASS_TECHNICAL,   135,  10 },
+   {    12, CLASS_DECOR,       152,  11 },
+   {    13, CLASS_KEY,         168,  12 },
+   {    14, CLASS_TECHNICAL,   177,  13 },
+   {    15, CLASS_DECOR,       198,  14 },
+   {    16, CLASS_MONSTER,     210,  15 },
+   {    17, CLASS_AMMO,        221,  16 },
+   {    18, CLASS_DECOR,       238,  17 },
+   {    19, CLASS_DECOR,       253,  18 },
+   {    20, CLASS_DECOR,       270,  19 },
+   {    21, CLASS_DECOR,       279,  20 },
+   {    22, CLASS_DECOR,       290,  21 },
+   {    23, CLASS_DECOR,       305,  22 },
+   {    24, CLASS_DECOR,       320,  23 },
+   {    25, CLASS_DECOR,       325,  24 },
+   {    26, CLASS_DECOR,       350,  25 },
+   {    27, CLASS_DECOR,       376,  26 },
+   {    28, CLASS_DECOR,       389,  27 },
+   {    29, CLASS_DECOR,       406,  28 },
+   {    30, CLASS_DECOR,       425,  29 },
+   {    31, CLASS_DECOR,       443,  30 },
+   {    32, CLASS_DECOR,       462,  31 },
+   {    33, CLASS_DECOR,       478,  32 },
+   {    34, CLASS_DECOR,       495,  33 },
+   {    35, CLASS_DECOR,       502,  34 },
+   {    36, CLASS_DECOR,       513,  35 },
+   {    37, CLASS_DECOR,       531,  36 },
+   {    38, CLASS_KEY,         549,  37 },
+   {    39, CLASS_KEY,         563,  38 },
+   {    40, CLASS_KEY,         580,  39 },
+   {    41, CLASS_DECOR,       595,  40 },
+   {    42, CLASS_DECOR,       604,  41 },
+   {    43, CLASS_DECOR,       620,  42 },
+   {    44, CLASS_DECOR,       630,  43 },
+   {    45, CLASS_DECOR,       641,  44 },
+   {    46, CLASS_DECOR,       653,  45 },
+   {    47, CLASS_DECOR,       663,  46 },
+   {    48, CLASS_DECOR,       674,  47 },
+   {    49, CLASS_DECOR,       686,  48 },
+   {    50, CLASS_DECOR,       711,  49 },
+   {    51, CLASS_DECOR,       733,  50 },
+   {    52, CLASS_DECOR,       755,  51 },
+   {    53, CLASS_DECOR,       776,  52 },
+   {    54, CLASS_DECOR,       788,  53 },
+   {    55, CLASS_DECOR,       797,  54 },
+   {    56, CLASS_DECOR,       814,  55 },
+   {    57, CLASS_DECOR,       832,  56 },
+   {    58, CLASS_MONSTER,     848,  57 },
+   {    59, CLASS_DECOR,       856,  58 },
+   {    60, CLASS_DECOR,       881,  59 },
+   {    61, CLASS_DECOR,       905,  60 },
+   {    62, CLASS_DECOR,       930,  61 },
+   {    63, CLASS_DECOR,       947,  62 },
+   {    64, CLASS_MONSTER,     972,  63 },
+   {    65, CLASS_MONSTER,     982,  64 },
+   {    66, CLASS_MONSTER,     994,  65 },
+   {    67, CLASS_MONSTER,    1003,  66 },
+   {    68, CLASS_MONSTER,    1012,  67 },
+   {    69, CLASS_MONSTER,    1024,  68 },
+   {    70, CLASS_DECOR,      1036,  69 },
+   {    71, CLASS_MONSTER,    1051,  70 },
+   {    72, CLASS_MONSTER,    1066,  71 },
+   {    73, CLASS_DECOR,      1081,  72 },
+   {    74, CLASS_DECOR,      1104,  73 },
+   {    75, CLASS_DECOR,      1128,  74 },
+   {    76, CLASS_DECOR,      1153,  75 },
+   {    77, CLASS_DECOR,      1177,  76 },
+   {    78, CLASS_DECOR,      1203,  77 },
+   {    79, CLASS_DECOR,      1228,  78 },
+   {    80, CLASS_DECOR,      1239,  79 },
+   {    81, CLASS_DECOR,      1256,  80 },
+   {    82, CLASS_WEAPON,     1267,  81 },
+   {    83, CLASS_HEALTH,     1281,  82 },
+   {    84, CLASS_MONSTER,    1292,  83 },
+   {    85, CLASS_DECOR,      1307,  84 },
+   {    86, CLASS_DECOR,      1319,  85 },
+   {    87, CLASS_TECHNICAL,  1331,  86 },
+   {    88, CLASS_MONSTER,    1347,  87 },
+   {    89, CLASS_TECHNICAL,  1358,  88 },
+   {   888, CLASS_MONSTER,    1371,  89 },
+   {  2001, CLASS_WEAPON,     1386,  90 },
+   {  2002, CLASS_WEAPON,     1394,  91 },
+   {  2003, CLASS_WEAPON,     1403,  92 },
+   {  2004, CLASS_WEAPON,     1419,  93 },
+   {  2005, CLASS_WEAPON,     1432,  94 },
+   {  2006, CLASS_WEAPON,     1441,  95 },
+   {  2007, CLASS_AMMO,       1449,  96 },
+   {  2008, CLASS_AMMO,       1454,  97 },
+   {  2010, CLASS_AMMO,       1461,  98 },
+   {  2011, CLASS_HEALTH,     1468,  99 },
+   {  2012, CLASS_HEALTH,     1477, 100 },
+   {  2013, CLASS_HEALTH,     1485, 101 },
+   {  2014, CLASS_HEALTH,     1496, 102 },
+   {  2015, CLASS_ARMOR,      1509, 103 },
+   {  2018, CLASS_ARMOR,      1521, 104 },
+   {  2019, CLASS_ARMOR,      1533, 105 },
+   {  2022, CLASS_POWERUP,    1544, 106 },
+   {  2023, CLASS_POWERUP,    1567, 107 },
+   {  2024, CLASS_POWERUP,    1575, 108 },
+   {  2025, CLASS_POWERUP,    1587, 109 },
+   {  2026, CLASS_POWERUP,    1602, 110 },
+   {  2028, CLASS_DECOR,      1620, 111 },
+   {  2035, CLASS_HAZARD,     1627, 112 },
+   {  2045, CLASS_POWERUP,    1644, 113 },
+   {  2046, CLASS_AMMO,       1660, 114 },
+   {  2047, CLASS_AMMO,       1675, 115 },
+   {  2048, CLASS_AMMO,       1695, 116 },
+   {  2049, CLASS_AMMO,       1710, 117 },
+   {  3001, CLASS_MONSTER,    1724, 118 },
+   {  3002, CLASS_MONSTER,    1728, 119 },
+   {  3003, CLASS_MONSTER,    1734, 120 },
+   {  3004, CLASS_MONSTER,    1748, 121 },
+   {  3005, CLASS_MONSTER,    1758, 122 },
+   {  3006, CLASS_MONSTER,    1768, 123 },
+   {  4001, CLASS_TECHNICAL,  1778, 124 },
+   {  4002, CLASS_TECHNICAL,  1793, 125 },
+   {  4003, CLASS_TECHNICAL,  1808, 126 },
+   {  4004, CLASS_TECHNICAL,  1823, 127 },
+   {  5001, CLASS_TECHNICAL,  1838, 128 },
+   {  5002, CLASS_TECHNICAL,  1849, 129 },
+};
+
+static const char mbfNames[] =
+   "Player 1 start\0"
+   "Player 2 start\0"
+   "Player 3 start\0"
+   "Player 4 start\0"
+   "Blue card\0"
+   "Yellow card\0"
+   "Spider Mastermind\0"
+   "Backpack\0"
+   "Shotgun guy\0"
+   "Gibbed marine\0"
+   "Deathmatch start\0"
+   "Gibbed marine 2\0"
+   "Red card\0"
+   "Teleport destination\0"
+   "Dead marine\0"
+   "Cyberdemon\0"
+   "Energy cell pack\0"
+   "Dead Zombieman\0"
+   "Dead shotguy guy\0"
+   "Dead imp\0"
+   "Dead demon\0"
+   "Dead cacodemon\0"
+   "Dead lost soul\0"
+   "Gibs\0"
+   "Impaled zombieman (dead)\0"
+   "Impaled zombieman (alive)\0"
+   "Impaled head\0"
+   "Heads shishkabob\0"
+   "Skulls and candles\0"
+   "Tall green column\0"
+   "Short green column\0"
+   "Tall red column\0"
+   "Short red column\0"
+   "Candle\0"
+   "Candelabra\0"
+   "Column with heart\0"
+   "Column with skull\0"
+   "Red skull key\0"
+   "Yellow skull key\0"
+   "Blue skull key\0"
+   "Evil eye\0"
+   "Floating skulls\0"
+   "Gray tree\0"
+   "Blue torch\0"
+   "Green torch\0"
+   "Red torch\0"
+   "Stalagtite\0"
+   "Tech pillar\0"
+   "Hanging body - twitching\0"
+   "Hanging body - jacket\0"
+   "Hanging body - no leg\0"
+   "Hanging body - torso\0"
+   "Hanging leg\0"
+   "Tan tree\0"
+   "Short blue torch\0"
+   "Short green torch\0"
+   "Short red torch\0"
+   "Spectre\0"
+   "Hanging body jacket pass\0"
+   "Hanging body torso pass\0"
+   "Hanging body no leg pass\0"
+   "Hanging leg pass\0"
+   "Hanging body twitch pass\0"
+   "Arch-vile\0"
+   "Chaingunner\0"
+   "Revenant\0"
+   "Mancubus\0"
+   "Arachnotron\0"
+   "Hell knight\0"
+   "Burning barrel\0"
+   "Pain elemental\0"
+   "Commander Keen\0"
+   "Hanging body - no guts\0"
+   "Hanging body - no brain\0"
+   "Hanging body - look down\0"
+   "Hanging body - t. skull\0"
+   "Hanging body - t. look up\0"
+   "Hanging body t. no brain\0"
+   "Colon gibs\0"
+   "Small blood pool\0"
+   "Brain stem\0"
+   "Super shotgun\0"
+   "Megasphere\0"
+   "Wolfenstein SS\0"
+   "Tech lamp 1\0"
+   "Tech lamp 2\0"
+   "Boss spawn spot\0"
+   "Boss brain\0"
+   "Boss spawner\0"
+   "MBF helper dog\0"
+   "Shotgun\0"
+   "Chaingun\0"
+   "Rocket launcher\0"
+   "Plasma rifle\0"
+   "Chainsaw\0"
+   "BFG9000\0"
+   "Clip\0"
+   "Shells\0"
+   "Rocket\0"
+   "Stimpack\0"
+   "Medikit\0"
+   "Soulsphere\0"
+   "Health bonus\0"
+   "Armor bonus\0"
+   "Green armor\0"
+   "Blue armor\0"
+   "Invulnerability sphere\0"
+   "Berserk\0"
+   "Blur sphere\0"
+   "Radiation suit\0"
+   "Computer area map\0"
+   "Column\0"
+   "Explosive barrel\0"
+   "Light amp visor\0"
+   "Box of rockets\0"
+   "Energy cells (Doom)\0"
+   "Box of bullets\0"
+   "Box of shells\0"
+   "Imp\0"
+   "Demon\0"
+   "Baron of Hell\0"
+   "Zombieman\0"
+   "Cacodemon\0"
+   "Lost soul\0"
+   "Player start 5\0"
+   "Player start 6\0"
+   "Player start 7\0"
+   "Player start 8\0"
+   "Push point\0"
+   "Pull point\0";
+
+static const int mbfAttrs[NUM_THINGATTRS * 130] =
+{
+   // $hp
+   0, 0, 0, 0, 0, 0, 3000, 0, 30, 0, 0, 0, 0, 0, 0, 4000,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 150, 0, 0, 0, 0, 0, 700,
+   70, 300, 600, 500, 500, 0, 400, 100, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 50, 0, 0, 0, 250, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 60, 150, 1000, 20, 400, 100, 0, 0, 0, 0,
+   0, 0,
+   // $damage
+   0, 0, 0, 0, 0, 0, 0, 920, 0, 0, 0, 0, 0, 0, 0, 0,
+   2250, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 560, 0, 0, 0, 0, 0, 0, 0, 0, 560, 200, 180, 900, 0, 900,
+   100, 280, 90, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 450, 450, 500, 1400, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0,
+   // $health
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 200, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 10, 25, 100, 1, 0, 0, 0, 0, 100, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0,
+   // $armor
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 200, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 1, 100, 200, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0,
+};
+
+// psx
+
+static const thingtype_t psxTypes[] =
+{
+   {     1, CLASS_TECHNICAL,     0,   0 },
+   {     2, CLASS_TECHNICAL,    15,   1 },
+   {     5, CLASS_KEY,          30,   2 },
+   {     6, CLASS_KEY,          40,   3 },
+   {     7, CLASS_MONSTER,      52,   4 },
+   {     8, CLASS_AMMO,         70,   5 },
+   {     9, CLASS_MONSTER,      79,   6 },
+   {    10, CLASS_DECOR,        91,   7 },
+   {    11, CLASS_TECHNICAL,   105,   8 },
+   {    12, CLASS_DECOR,       122,   9 },
+   {    13, CLASS_KEY,         138,  10 },
+   {    14, CLASS_TECHNICAL,   147,  11 },
+   {    15, CLASS_DECOR,       168,  12 },
+   {    16, CLASS_MONSTER,     180,  13 },
+   {    17, CLASS_AMMO,        191,  14 },
+   {    18, CLASS_DECOR,       208,  15 },
+   {    19, CLASS_DECOR,       223,  16 },
+   {    20, CLASS_DECOR,       240,  17 },
+   {    21, CLASS_DECOR,       249,  18 },
+   {    22, CLASS_DECOR,       260,  19 },
+   {    23, CLASS_DECOR,       275,  20 },
+   {    24, CLASS_DECOR,       290,  21 },
+   {    25, CLASS_DECOR,       295,  22 },
+   {    26, CLASS_DECOR,       320,  23 },
+   {    27, CLASS_DECOR,       346,  24 },
+   {    28, CLASS_DECOR,       359,  25 },
+   {    29, CLASS_DECOR,       376,  26 },
+   {    30, CLASS_DECOR,       395,  27 },
+   {    31, CLASS_DECOR,       413,  28 },
+   {    32, CLASS_DECOR,       432,  29 },
+   {    33, CLASS_DECOR,       448,  30 },
+   {    34, CLASS_DECOR,       465,  31 },
+   {    35, CLASS_DECOR,       472,  32 },
+   {    36, CLASS_DECOR,       483,  33 },
+   {    37, CLASS_DECOR,       501,  34 },
+   {    38, CLASS_KEY,         519,  35 },
+   {    39, CLASS_KEY,         533,  36 },
+   {    40, CLASS_KEY,         550,  37 },
+   {    41, CLASS_DECOR,       565,  38 },
+   {    42, CLASS_DECOR,       574,  39 },
+   {    43, CLASS_DECOR,       590,  40 },
+   {    44, CLASS_DECOR,       600,  41 },
+   {    45, CLASS_DECOR,       611,  42 },
+   {    46, CLASS_DECOR,       623,  43 },
+   {    47, CLASS_DECOR,       633,  44 },
+   {    48, CLASS_DECOR,       644,  45 },
+   {    49, CLASS_DECOR,       656,  46 },
+   {    50, CLASS_DECOR,       681,  47 },
+   {    51, CLASS_DECOR,       703,  48 },
+   {    52, CLASS_DECOR,       725,  49 },
+   {    53, CLASS_DECOR,       746,  50 },
+   {    54, CLASS_DECOR,       758,  51 },
+   {    55, CLASS_DECOR,       767,  52 },
+   {    56, CLASS_DECOR,       784,  53 },
+   {    57, CLASS_DECOR,       802,  54 },
+   {    59, CLASS_DECOR,       818,  55 },
+   {    60, CLASS_DECOR,       843,  56 },
+   {    61, CLASS_DECOR,       867,  57 },
+   {    62, CLASS_DECOR,       892,  58 },
+   {    63, CLASS_DECOR,       909,  59 },
+   {    64, CLASS_DECOR,       934,  60 },
+   {    65, CLASS_MONSTER,     957,  61 },
+   {    66, CLASS_MONSTER,     969,  62 },
+   {    67, CLASS_MONSTER,     978,  63 },
+   {    68, CLASS_MONSTER,     987,  64 },
+   {    69, CLASS_MONSTER,     999,  65 },
+   {    70, CLASS_DECOR,      1011,  66 },
+   {    71, CLASS_MONSTER,    1026,  67 },
+   {    73, CLASS_DECOR,      1041,  68 },
+   {    74, CLASS_DECOR,      1064,  69 },
+   {    75, CLASS_DECOR,      1088,  70 },
+   {    76, CLASS_DECOR,      1113,  71 },
+   {    77, CLASS_DECOR,      1137,  72 },
+   {    78, CLASS_DECOR,      1163,  73 },
+   {    79, CLASS_DECOR,      1188,  74 },
+   {    80, CLASS_DECOR,      1199,  75 },
+   {    81, CLASS_DECOR,      1216,  76 },
+   {    82, CLASS_WEAPON,     1227,  77 },
+   {    83, CLASS_HEALTH,     1241,  78 },
+   {    85, CLASS_DECOR,      1252,  79 },
+   {    86, CLASS_DECOR,      1264,  80 },
+   {  2001, CLASS_WEAPON,     1276,  81 },
+   {  2002, CLASS_WEAPON,     1284,  82 },
+   {  2003, CLASS_WEAPON,     1293,  83 },
+   {  2004, CLASS_WEAPON,     1309,  84 },
+   {  2005, CLASS_WEAPON,     1322,  85 },
+   {  2006, CLASS_WEAPON,     1331,  86 },
+   {  2007, CLASS_AMMO,       1339,  87 },
+   {  2008, CLASS_AMMO,       1344,  88 },
+   {  2010, CLASS_AMMO,       1351,  89 },
+   {  2011, CLASS_HEALTH,     1358,  90 },
+   {  2012, CLASS_HEALTH,     1367,  91 },
+   {  2013, CLASS_HEALTH,     1375,  92 },
+   {  2014, CLASS_HEALTH,     1386,  93 },
+   {  2015, CLASS_ARMOR,      1399,  94 },
+   {  2018, CLASS_ARMOR,      1411,  95 },
+   {  2019, CLASS_ARMOR,      1423,  96 },
+   {  2022, CLASS_POWERUP,    1434,  97 },
+   {  2023, CLASS_POWERUP,    1457,  98 },
+   {  2024, CLASS_POWERUP,    1465,  99 },
+   {  2025, CLASS_POWERUP,    1477, 100 },
+   {  2026, CLASS_POWERUP,    1492, 101 },
+   {  2028, CLASS_DECOR,      1510, 102 },
+   {  2035, CLASS_HAZARD,     1517, 103 },
+   {  2045, CLASS_POWERUP,    1534, 104 },
+   {  2046, CLASS_AMMO,       1550, 105 },
+   {  2047, CLASS_AMMO,       1565, 106 },
+   {  2048, CLASS_AMMO,       1585, 107 },
+   {  2049, CLASS_AMMO,       1600, 108 },
+   {  3001, CLASS_MONSTER,    1614, 109 },
+   {  3002, CLASS_MONSTER,    1618, 110 },
+   {  3003, CLASS_MONSTER,    1650, 111 },
+   {  3004, CLASS_MONSTER,    1664, 112 },
+   {  3005, CLASS_MONSTER,    1674, 113 },
+   {  3006, CLASS_MONSTER,    1684, 114 },
+};
+
+static const char psxNames[] =
+   "Player 1 start\0"
+   "Player 2 start\0"
+   "Blue card\0"
+   "Yellow card\0"
+   "Spider Mastermind\0"
+   "Backpack\0"
+   "Shotgun guy\0"
+   "Gibbed marine\0"
+   "Deathmatch start\0"
+   "Gibbed marine 2\0"
+   "Red card\0"
+   "Teleport destination\0"
+   "Dead marine\0"
+   "Cyberdemon\0"
+   "Energy cell pack\0"
+   "Dead Zombieman\0"
+   "Dead shotguy guy\0"
+   "Dead imp\0"
+   "Dead demon\0"
+   "Dead cacodemon\0"
+   "Dead lost soul\0"
+   "Gibs\0"
+   "Impaled zombieman (dead)\0"
+   "Impaled zombieman (alive)\0"
+   "Impaled head\0"
+   "Heads shishkabob\0"
+   "Skulls and candles\0"
+   "Tall green column\0"
+   "Short green column\0"
+   "Tall red column\0"
+   "Short red column\0"
+   "Candle\0"
+   "Candelabra\0"
+   "Column with heart\0"
+   "Column with skull\0"
+   "Red skull key\0"
+   "Yellow skull key\0"
+   "Blue skull key\0"
+   "Evil eye\0"
+   "Floating skulls\0"
+   "Gray tree\0"
+   "Blue torch\0"
+   "Green torch\0"
+   "Red torch\0"
+   "Stalagtite\0"
+   "Tech pillar\0"
+   "Hanging body - twitching\0"
+   "Hanging body - jacket\0"
+   "Hanging body - no leg\0"
+   "Hanging body - torso\0"
+   "Hanging leg\0"
+   "Tan tree\0"
+   "Short blue torch\0"
+   "Short green torch\0"
+   "Short red torch\0"
+   "Hanging body jacket pass\0"
+   "Hanging body torso pass\0"
+   "Hanging body no leg pass\0"
+   "Hanging leg pass\0"
+   "Hanging body twitch pass\0"
+   "Chain with bloody hook\0"
+   "Chaingunner\0"
+   "Revenant\0"
+   "Mancubus\0"
+   "Arachnotron\0"
+   "Hell knight\0"
+   "Burning barrel\0"
+   "Pain elemental\0"
+   "Hanging body - no guts\0"
+   "Hanging body - no brain\0"
+   "Hanging body - look down\0"
+   "Hanging body - t. skull\0"
+   "Hanging body - t. look up\0"
+   "Hanging body t. no brain\0"
+   "Colon gibs\0"
+   "Small blood pool\0"
+   "Brain stem\0"
+   "Super shotgun\0"
+   "Megasphere\0"
+   "Tech lamp 1\0"
+   "Tech lamp 2\0"
+   "Shotgun\0"
+   "Chaingun\0"
+   "Rocket launcher\0"
+   "Plasma rifle\0"
+   "Chainsaw\0"
+   "BFG9000\0"
+   "Clip\0"
+   "Shells\0"
+   "Rocket\0"
+   "Stimpack\0"
+   "Medikit\0"
+   "Soulsphere\0"
+   "Health bonus\0"
+   "Armor bonus\0"
+   "Green armor\0"
+   "Blue armor\0"
+   "Invulnerability sphere\0"
+   "Berserk\0"
+   "Blur sphere\0"
+   "Radiation suit\0"
+   "Computer area map\0"
+   "Column\0"
+   "Explosive barrel\0"
+   "Light amp visor\0"
+   "Box of rockets\0"
+   "Energy cells (Doom)\0"
+   "Box of bullets\0"
+   "Box of shells\0"
+   "Imp\0"
+   "Demon/Spectre/Nightmare spectre\0"
+   "Baron of Hell\0"
+   "Zombieman\0"
+   "Cacodemon\0"
+   "Lost soul\0";
+
+static const int psxAttrs[NUM_THINGATTRS * 115] =
+{
+   // $hp
+   0, 0, 0, 0, 3000, 0, 30, 0, 0, 0, 0, 0, 0, 4000, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 70, 300, 600,
+   500, 500, 0, 400, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 60, 150, 1000,
+   20, 400, 100,
+   // $damage
+   0, 0, 0, 0, 0, 920, 0, 0, 0, 0, 0, 0, 0, 0, 2250, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 560, 0, 0,
+   0, 560, 200, 180, 900, 0, 900, 100, 280, 90, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 450, 450, 500, 1400, 0, 0, 0,
+   0, 0, 0,
+   // $health
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 200, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 25, 100, 1, 0, 0,
+   0, 0, 100, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0,
+   // $armor
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 200, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 100,
+   200, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0,
+};
+
+// strife
+
+static const thingtype_t strifeTypes[] =
+{
+   {     1, CLASS_TECHNICAL,     0,   0 },
+   {     2, CLASS_TECHNICAL,    15,   1 },
+   {     3, CLASS_TECHNICAL,    30,   2 },
+   {     4, CLASS_TECHNICAL,    45,   3 },
+   {     5, CLASS_TECHNICAL,    60,   4 },
+   {     6, CLASS_TECHNICAL,    75,   5 },
+   {     7, CLASS_TECHNICAL,    90,   6 },
+   {     8, CLASS_TECHNICAL,   105,   7 },
+   {     9, CLASS_NPC,         120,   8 },
+   {    10, CLASS_ARTIFACT,    128,   9 },
+   {    11, CLASS_TECHNICAL,   146,  10 },
+   {    12, CLASS_MONSTER,     163,  11 },
+   {    13, CLASS_KEY,         174,  12 },
+   {    14, CLASS_TECHNICAL,   182,  13 },
+   {    15, CLASS_DECOR,       203,  14 },
+   {    16, CLASS_MONSTER,     218,  15 },
+   {    17, CLASS_AMMO,        229,  16 },
+   {    18, CLASS_DECOR,       241,  17 },
+   {    19, CLASS_DECOR,       254,  18 },
+   {    20, CLASS_DECOR,       265,  19 },
+   {    21, CLASS_DECOR,       277,  20 },
+   {    22, CLASS_DECOR,       290,  21 },
+   {    23, CLASS_DECOR,       304,  22 },
+   {    24, CLASS_DECOR,       319,  23 },
+   {    25, CLASS_TECHNICAL,   332,  24 },
+   {    26, CLASS_DECOR,       350,  25 },
+   {    27, CLASS_MONSTER,     362,  26 },
+   {    28, CLASS_DECOR,       377,  27 },
+   {    29, CLASS_DECOR,       388,  28 },
+   {    30, CLASS_DECOR,       397,  29 },
+   {    31, CLASS_DECOR,       406,  30 },
+   {    32, CLASS_DECOR,       415,  31 },
+   {    33, CLASS_DECOR,       424,  32 },
+   {    34, CLASS_DECOR,       434,  33 },
+   {    35, CLASS_DECOR,       441,  34 },
+   {    36, CLASS_DECOR,       452,  35 },
+   {    37, CLASS_DECOR,       461,  36 },
+   {    38, CLASS_KEY,         470,  37 },
+   {    39, CLASS_KEY,         481,  38 },
+   {    40, CLASS_KEY,         491,  39 },
+   {    41, CLASS_DECOR,       500,  40 },
+   {    42, CLASS_DECOR,       509,  41 },
+   {    43, CLASS_DECOR,       518,  42 },
+   {    44, CLASS_DECOR,       531,  43 },
+   {    45, CLASS_DECOR,       545,  44 },
+   {    46, CLASS_DECOR,       552,  45 },
+   {    47, CLASS_DECOR,       565,  46 },
+   {    48, CLASS_DECOR,       577,  47 },
+   {    50, CLASS_DECOR,       591,  48 },
+   {    51, CLASS_DECOR,       602,  49 },
+   {    52, CLASS_QUEST,       612,  50 },
+   {    53, CLASS_DECOR,       630,  51 },
+   {    54, CLASS_DECOR,       641,  52 },
+   {    55, CLASS_DECOR,       654,  53 },
+   {    56, CLASS_DECOR,       675,  54 },
+   {    57, CLASS_DECOR,       695,  55 },
+   {    58, CLASS_MONSTER,     712,  56 },
+   {    59, CLASS_ARTIFACT,    727,  57 },
+   {    60, CLASS_DECOR,       738,  58 },
+   {    61, CLASS_KEY,         749,  59 },
+   {    62, CLASS_DECOR,       760,  60 },
+   {    63, CLASS_DECOR,       770,  61 },
+   {    64, CLASS_NPC,         784,  62 },
+   {    65, CLASS_NPC,         792,  63 },
+   {    66, CLASS_NPC,         802,  64 },
+   {    67, CLASS_NPC,         812,  65 },
+   {    68, CLASS_DECOR,       823,  66 },
+   {    69, CLASS_DECOR,       828,  67 },
+   {    70, CLASS_DECOR,       845,  68 },
+   {    71, CLASS_MONSTER,     860,  69 },
+   {    72, CLASS_NPC,         871,  70 },
+   {    73, CLASS_NPC,         879,  71 },
+   {    74, CLASS_NPC,         887,  72 },
+   {    75, CLASS_MONSTER,     893,  73 },
+   {    76, CLASS_MONSTER,     903,  74 },
+   {    77, CLASS_WEAPON,      913,  75 },
+   {    78, CLASS_WEAPON,      921,  76 },
+   {    79, CLASS_WEAPON,      929,  77 },
+   {    80, CLASS_WEAPON,      937,  78 },
+   {    81, CLASS_WEAPON,      945,  79 },
+   {    82, CLASS_DECOR,       953,  80 },
+   {    83, CLASS_HEALTH,      967,  81 },
+   {    85, CLASS_MONSTER,     979,  82 },
+   {    86, CLASS_KEY,         989,  83 },
+   {    90, CLASS_QUEST,       999,  84 },
+   {    91, CLASS_KEY,        1013,  85 },
+   {    92, CLASS_DECOR,      1026,  86 },
+   {    93, CLASS_ARTIFACT,   1040,  87 },
+   {    94, CLASS_HAZARD,     1045,  88 },
+   {    95, CLASS_DECOR,      1062,  89 },
+   {    96, CLASS_DECOR,      1087,  90 },
+   {    97, CLASS_DECOR,      1111,  91 },
+   {    98, CLASS_DECOR,      1134,  92 },
+   {    99, CLASS_DECOR,      1149,  93 },
+   {   100, CLASS_DECOR,      1156,  94 },
+   {   101, CLASS_DECOR,      1163,  95 },
+   {   102, CLASS_DECOR,      1170,  96 },
+   {   103, CLASS_DECOR,      1177,  97 },
+   {   104, CLASS_DECOR,      1194,  98 },
+   {   105, CLASS_DECOR,      1211,  99 },
+   {   106, CLASS_DECOR,      1224, 100 },
+   {   107, CLASS_DECOR,      1240, 101 },
+   {   108, CLASS_DECOR,      1256, 102 },
+   {   109, CLASS_DECOR,      1274, 103 },
+   {   110, CLASS_DECOR,      1288, 104 },
+   {   111, CLASS_DECOR,      1295, 105 },
+   {   112, CLASS_DECOR,      1308, 106 },
+   {   113, CLASS_DECOR,      1323, 107 },
+   {   114, CLASS_AMMO,       1340, 108 },
+   {   115, CLASS_AMMO,       1355, 109 },
+   {   116, CLASS_NPC,        1368, 110 },
+   {   117, CLASS_DECOR,      1381, 111 },
+   {   118, CLASS_TECHNICAL,  1394, 112 },
+   {   119, CLASS_TECHNICAL,  1406, 113 },
+   {   120, CLASS_TECHNICAL,  1418, 114 },
+   {   121, CLASS_TECHNICAL,  1430, 115 },
+   {   122, CLASS_TECHNICAL,  1442, 116 },
+   {   123, CLASS_TECHNICAL,  1454, 117 },
+   {   124, CLASS_TECHNICAL,  1466, 118 },
+   {   125, CLASS_TECHNICAL,  1478, 119 },
+   {   126, CLASS_TECHNICAL,  1490, 120 },
+   {   127, CLASS_TECHNICAL,  1502, 121 },
+   {   128, CLASS_MONSTER,    1515, 122 },
+   {   129, CLASS_MONSTER,    1522, 123 },
+   {   130, CLASS_NPC,        1532, 124 },
+   {   131, CLASS_NPC,        1542, 125 },
+   {   132, CLASS_NPC,        1552, 126 },
+   {   133, CLASS_NPC,        1562, 127 },
+   {   134, CLASS_NPC,        1572, 128 },
+   {   135, CLASS_NPC,        1582, 129 },
+   {   136, CLASS_NPC,        1592, 130 },
+   {   137, CLASS_NPC,        1603, 131 },
+   {   138, CLASS_ARTIFACT,   1614, 132 },
+   {   139, CLASS_ARTIFACT,   1622, 133 },
+   {   140, CLASS_ARTIFACT,   1630, 134 },
+   {   141, CLASS_NPC,        1638, 135 },
+   {   142, CLASS_MONSTER,    1647, 136 },
+   {   143, CLASS_MONSTER,    1661, 137 },
+   {   144, CLASS_NPC,        1676, 138 },
+   {   145, CLASS_NPC,        1684, 139 },
+   {   146, CLASS_MONSTER,    1692, 140 },
+   {   147, CLASS_MONSTER,    1707, 141 },
+   {   148, CLASS_MONSTER,    1728, 142 },
+   {   149, CLASS_NPC,        1743, 143 },
+   {   150, CLASS_NPC,        1751, 144 },
+   {   151, CLASS_NPC,        1759, 145 },
+   {   152, CLASS_AMMO,       1767, 146 },
+   {   153, CLASS_AMMO,       1779, 147 },
+   {   154, CLASS_WEAPON,     1799, 148 },
+   {   155, CLASS_NPC,        1816, 149 },
+   {   156, CLASS_NPC,        1825, 150 },
+   {   157, CLASS_NPC,        1834, 151 },
+   {   158, CLASS_NPC,        1843, 152 },
+   {   159, CLASS_DECOR,      1852, 153 },
+   {   160, CLASS_DECOR,      1868, 154 },
+   {   161, CLASS_DECOR,      1883, 155 },
+   {   162, CLASS_DECOR,      1900, 156 },
+   {   163, CLASS_DECOR,      1919, 157 },
+   {   164, CLASS_DECOR,      1936, 158 },
+   {   165, CLASS_DECOR,      1940, 159 },
+   {   166, CLASS_KEY,        1944, 160 },
+   {   167, CLASS_MONSTER,    1958, 161 },
+   {   168, CLASS_MONSTER,    1968, 162 },
+   {   169, CLASS_NPC,        1978, 163 },
+   {   170, CLASS_TECHNICAL,  1995, 164 },
+   {   172, CLASS_NPC,        2010, 165 },
+   {   173, CLASS_NPC,        2021, 166 },
+   {   174, CLASS_NPC,        2032, 167 },
+   {   175, CLASS_NPC,        2043, 168 },
+   {   176, CLASS_NPC,        2054, 169 },
+   {   177, CLASS_NPC,        2065, 170 },
+   {   178, CLASS_NPC,        2076, 171 },
+   {   179, CLASS_NPC,        2087, 172 },
+   {   180, CLASS_NPC,        2098, 173 },
+   {   181, CLASS_NPC,        2109, 174 },
+   {   182, CLASS_DECOR,      2120, 175 },
+   {   183, CLASS_AMMO,       2129, 176 },
+   {   184, CLASS_KEY,        2142, 177 },
+   {   185, CLASS_KEY,        2151, 178 },
+   {   186, CLASS_MONSTER,    2160, 179 },
+   {   187, CLASS_MONSTER,    2168, 180 },
+   {   188, CLASS_DECOR,      2175, 181 },
+   {   189, CLASS_DECOR,      2183, 182 },
+   {   190, CLASS_DECOR,      2189, 183 },
+   {   191, CLASS_DECOR,      2199, 184 },
+   {   192, CLASS_KEY,        2203, 185 },
+   {   193, CLASS_KEY,        2219, 186 },
+   {   194, CLASS_DECOR,      2236, 187 },
+   {   195, CLASS_KEY,        2242, 188 },
+   {   196, CLASS_DECOR,      2253, 189 },
+   {   197, CLASS_DECOR,      2270, 190 },
+   {   198, CLASS_DECOR,      2286, 191 },
+   {   199, CLASS_NPC,        2297, 192 },
+   {   200, CLASS_NPC,        2304, 193 },
+   {   201, CLASS_NPC,        2312, 194 },
+   {   202, CLASS_DECOR,      2329, 195 },
+   {   203, CLASS_DECOR,      2340, 196 },
+   {   204, CLASS_NPC,        2352, 197 },
+   {   205, CLASS_QUEST,      2365, 198 },
+   {   206, CLASS_QUEST,      2382, 199 },
+   {   207, CLASS_POWERUP,    2395, 200 },
+   {   208, CLASS_DECOR,      2404, 201 },
+   {   209, CLASS_DECOR,      2424, 202 },
+   {   210, CLASS_DECOR,      2431, 203 },
+   {   211, CLASS_DECOR,      2438, 204 },
+   {   212, CLASS_DECOR,      2445, 205 },
+   {   213, CLASS_DECOR,      2461, 206 },
+   {   214, CLASS_DECOR,      2468, 207 },
+   {   215, CLASS_DECOR,      2475, 208 },
+   {   216, CLASS_DECOR,      2490, 209 },
+   {   217, CLASS_DECOR,      2503, 210 },
+   {   218, CLASS_DECOR,      2515, 211 },
+   {   219, CLASS_DECOR,      2528, 212 },
+   {   220, CLASS_DECOR,      2540, 213 },
+   {   221, CLASS_DECOR,      2555, 214 },
+   {   222, CLASS_DECOR,      2575, 215 },
+   {   223, CLASS_DECOR,      2594, 216 },
+   {   224, CLASS_DECOR,      2615, 217 },
+   {   225, CLASS_DECOR,      2633, 218 },
+   {   226, CLASS_QUEST,      2652, 219 },
+   {   227, CLASS_DECOR,      2674, 220 },
+   {   228, CLASS_DECOR,      2693, 221 },
+   {   229, CLASS_DECOR,      2706, 222 },
+   {   230, CLASS_KEY,        2713, 223 },
+   {   231, CLASS_MONSTER,    2722, 224 },
+   {   232, CLASS_MONSTER,    2737, 225 },
+   {   233, CLASS_KEY,        2759, 226 },
+   {   234, CLASS_KEY,        2770, 227 },
+   {   235, CLASS_KEY,        2782, 228 },
+   {   236, CLASS_KEY,        2791, 229 },
+   {  2001, CLASS_WEAPON,     2800, 230 },
+   {  2002, CLASS_WEAPON,     2809, 231 },
+   {  2003, CLASS_WEAPON,     2823, 232 },
+   {  2004, CLASS_WEAPON,     2845, 233 },
+   {  2005, CLASS_WEAPON,     2852, 234 },
+   {  2006, CLASS_WEAPON,     2865, 235 },
+   {  2007, CLASS_AMMO,       2888, 236 },
+   {  2010, CLASS_AMMO,       2904, 237 },
+   {  2011, CLASS_HEALTH,     2918, 238 },
+   {  2012, CLASS_HEALTH,     2928, 239 },
+   {  2014, CLASS_DECOR,      2940, 240 },
+   {  2018, CLASS_ARMOR,      2953, 241 },
+   {  2019, CLASS_ARMOR,      2967, 242 },
+   {  2024, CLASS_POWERUP,    2979, 243 },
+   {  2025, CLASS_POWERUP,    2992, 244 },
+   {  2026, CLASS_POWERUP,    3011, 245 },
+   {  2027, CLASS_POWERUP,    3015, 246 },
+   {  2028, CLASS_DECOR,      3023, 247 },
+   {  2046, CLASS_AMMO,       3035, 248 },
+   {  2047, CLASS_AMMO,       3053, 249 },
+   {  2048, CLASS_AMMO,       3064, 250 },
+   {  3001, CLASS_MONSTER,    3079, 251 },
+   {  3002, CLASS_MONSTER,    3086, 252 },
+   {  3003, CLASS_MONSTER,    3100, 253 },
+   {  3004, CLASS_NPC,        3108, 254 },
+   {  3005, CLASS_MONSTER,    3118, 255 },
+   {  3006, CLASS_MONSTER,    3127, 256 },
+};
+
+static const char strifeNames[] =
+   "Player 1 start\0"
+   "Player 2 start\0"
+   "Player 3 start\0"
+   "Player 4 start\0"
+   "Player 5 start\0"
+   "Player 6 start\0"
+   "Player 7 start\0"
+   "Player 8 start\0"
+   "Rebel 1\0"
+   "Teleporter beacon\0"
+   "Deathmatch start\0"
+   "Loremaster\0"
+   "ID card\0"
+   "Teleport destination\0"
+   "Dead Strifeguy\0"
+   "Inquisitor\0"
+   "Energy pack\0"
+   "Dead peasant\0"
+   "Dead rebel\0"
+   "Dead reaver\0"
+   "Dead acolyte\0"
+   "Dead crusader\0"
+   "Teleport swirl\0"
+   "Alarm klaxon\0"
+   "Force field guard\0"
+   "Entity nest\0"
+   "Ceiling turret\0"
+   "Cage light\0"
+   "Rubble 1\0"
+   "Rubble 2\0"
+   "Rubble 3\0"
+   "Rubble 4\0"
+   "Tree stub\0"
+   "Candle\0"
+   "Candelabra\0"
+   "Rubble 5\0"
+   "Rubble 6\0"
+   "Silver key\0"
+   "Brass key\0"
+   "Gold key\0"
+   "Rubble 7\0"
+   "Rubble 8\0"
+   "Outside lamp\0"
+   "Ruined statue\0"
+   "Piston\0"
+   "Pole lantern\0"
+   "Large torch\0"
+   "Techno pillar\0"
+   "Huge torch\0"
+   "Palm tree\0"
+   "Officer's uniform\0"
+   "Water drip\0"
+   "Aztec pillar\0"
+   "Damaged Aztec pillar\0"
+   "Ruined Aztec pillar\0"
+   "Huge tech pillar\0"
+   "Shadow acolyte\0"
+   "Degnin ore\0"
+   "Short bush\0"
+   "Oracle key\0"
+   "Tall bush\0"
+   "Chimney stack\0"
+   "Macil 1\0"
+   "Peasant 4\0"
+   "Peasant 7\0"
+   "Peasant 10\0"
+   "Tray\0"
+   "Barricade column\0"
+   "Burning barrel\0"
+   "Programmer\0"
+   "Barkeep\0"
+   "Armorer\0"
+   "Medic\0"
+   "Spectre B\0"
+   "Spectre C\0"
+   "Sigil 1\0"
+   "Sigil 2\0"
+   "Sigil 3\0"
+   "Sigil 4\0"
+   "Sigil 5\0"
+   "Wooden barrel\0"
+   "Surgery kit\0"
+   "Rat buddy\0"
+   "Order key\0"
+   "Guard uniform\0"
+   "Severed hand\0"
+   "Power crystal\0"
+   "Coin\0"
+   "Explosive barrel\0"
+   "Silver fluorescent light\0"
+   "Brown fluorescent light\0"
+   "Gold fluorescent light\0"
+   "Big stalactite\0"
+   "Rock 1\0"
+   "Rock 2\0"
+   "Rock 3\0"
+   "Rock 4\0"
+   "Floor water drip\0"
+   "Waterfall splash\0"
+   "Burning bowl\0"
+   "Burning brazier\0"
+   "Small lit torch\0"
+   "Small unlit torch\0"
+   "Ceiling chain\0"
+   "Statue\0"
+   "Medium torch\0"
+   "Water fountain\0"
+   "Tank with hearts\0"
+   "Electric bolts\0"
+   "Poison bolts\0"
+   "Weapon smith\0"
+   "Surgery crab\0"
+   "Rift spot 1\0"
+   "Rift spot 2\0"
+   "Rift spot 3\0"
+   "Rift spot 4\0"
+   "Rift spot 5\0"
+   "Rift spot 6\0"
+   "Rift spot 7\0"
+   "Rift spot 8\0"
+   "Rift spot 9\0"
+   "Rift spot 10\0"
+   "Entity\0"
+   "Spectre A\0"
+   "Peasant 2\0"
+   "Peasant 3\0"
+   "Peasant 5\0"
+   "Peasant 6\0"
+   "Peasant 8\0"
+   "Peasant 9\0"
+   "Peasant 11\0"
+   "Peasant 12\0"
+   "10 gold\0"
+   "25 gold\0"
+   "50 gold\0"
+   "Beggar 1\0"
+   "Acolyte (red)\0"
+   "Acolyte (rust)\0"
+   "Rebel 2\0"
+   "Rebel 3\0"
+   "Acolyte (gray)\0"
+   "Acolyte (dark green)\0"
+   "Acolyte (gold)\0"
+   "Rebel 4\0"
+   "Rebel 5\0"
+   "Rebel 6\0"
+   "HE grenades\0"
+   "Phosphorus grenades\0"
+   "Grenade launcher\0"
+   "Beggar 2\0"
+   "Beggar 3\0"
+   "Beggar 4\0"
+   "Beggar 5\0"
+   "Cave pillar top\0"
+   "Big stalagmite\0"
+   "Small stalactite\0"
+   "Cave pillar bottom\0"
+   "Small stalagmite\0"
+   "Mug\0"
+   "Pot\0"
+   "Warehouse key\0"
+   "Spectre D\0"
+   "Spectre E\0"
+   "Converter zombie\0"
+   "Zombie spawner\0"
+   "Peasant 13\0"
+   "Peasant 14\0"
+   "Peasant 15\0"
+   "Peasant 16\0"
+   "Peasant 17\0"
+   "Peasant 18\0"
+   "Peasant 19\0"
+   "Peasant 20\0"
+   "Peasant 21\0"
+   "Peasant 22\0"
+   "Computer\0"
+   "Ammo satchel\0"
+   "ID badge\0"
+   "Passcard\0"
+   "Stalker\0"
+   "Bishop\0"
+   "Pitcher\0"
+   "Stool\0"
+   "Metal pot\0"
+   "Tub\0"
+   "Red crystal key\0"
+   "Blue crystal key\0"
+   "Anvil\0"
+   "Chapel key\0"
+   "Silver tech lamp\0"
+   "Brass tech lamp\0"
+   "Entity pod\0"
+   "Oracle\0"
+   "Macil 2\0"
+   "Becoming acolyte\0"
+   "Big tree 2\0"
+   "Potted tree\0"
+   "Kneeling guy\0"
+   "Offering chalice\0"
+   "Communicator\0"
+   "Targeter\0"
+   "Firing range target\0"
+   "Tank 1\0"
+   "Tank 2\0"
+   "Tank 3\0"
+   "Sacrificed body\0"
+   "Tank 4\0"
+   "Tank 5\0"
+   "Stick in water\0"
+   "Sigil banner\0"
+   "Rebel boots\0"
+   "Rebel helmet\0"
+   "Rebel shirt\0"
+   "Power coupling\0"
+   "Alien bubble column\0"
+   "Alien floor bubble\0"
+   "Alien ceiling bubble\0"
+   "Alien asp climber\0"
+   "Alien spider light\0"
+   "Broken power coupling\0"
+   "Alien power pillar\0"
+   "Bullet sieve\0"
+   "Tank 6\0"
+   "Base key\0"
+   "Acolyte (blue)\0"
+   "Acolyte (light green)\0"
+   "Mauler key\0"
+   "Factory key\0"
+   "Mine key\0"
+   "Core key\0"
+   "Crossbow\0"
+   "Assault rifle\0"
+   "Mini-missile launcher\0"
+   "Mauler\0"
+   "Flamethrower\0"
+   "Standing assault rifle\0"
+   "Clip of bullets\0"
+   "Mini missiles\0"
+   "Med patch\0"
+   "Medical kit\0"
+   "Water bottle\0"
+   "Leather armor\0"
+   "Metal armor\0"
+   "Shadow armor\0"
+   "Environmental suit\0"
+   "Map\0"
+   "Scanner\0"
+   "Light globe\0"
+   "Crate of missiles\0"
+   "Energy pod\0"
+   "Box of bullets\0"
+   "Reaver\0"
+   "Acolyte (tan)\0"
+   "Templar\0"
+   "Peasant 1\0"
+   "Crusader\0"
+   "Sentinel\0";
+
+static const int strifeAttrs[NUM_THINGATTRS * 257] =
+{
+   // $hp
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0,
+   // $damage
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0,
+   // $health
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0,
+   // $armor
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0,
+};
+
+static const thinggame_t thinggames[] =
+{
+   { "boom", boomTypes, earrlen(boomTypes), boomNames, boomAttrs },
+   { "chex", chexTypes, earrlen(chexTypes), chexNames, chexAttrs },
+   { "doom", doomTypes, earrlen(doomTypes), doomNames, doomAttrs },
+   { "heretic", hereticTypes, earrlen(hereticTypes), hereticNames, hereticAttrs },
+   { "hexen", hexenTypes, earrlen(hexenTypes), hexenNames, hexenAttrs },
+   { "mbf", mbfTypes, earrlen(mbfTypes), mbfNames, mbfAttrs },
+   { "psx", psxTypes, earrlen(psxTypes), psxNames, psxAttrs },
+   { "strife", strifeTypes, earrlen(strifeTypes), strifeNames, strifeAttrs },
+};
+
+// EOF
+
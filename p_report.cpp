@@ -0,0 +1,816 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      thingcount report output formats
+//
+//-----------------------------------------------------------------------------
+
+#include "z_zone.h"
+#include "i_system.h"
+#include "m_textbuf.h"
+#include "p_report.h"
+#include "p_results.h"
+#include "p_rollup.h"
+#include "p_thingtypes.h"
+
+//
+// ReportFormatter::error
+//
+// By default, error messages go into the report itself.
+//
+void ReportFormatter::error(const char *message)
+{
+   out.addStr(message);
+}
+
+//=============================================================================
+//
+// Text Tables
+//
+
+static const char *PrettyGameType[NUM_GAME_TYPES] =
+{
+   "Single Player",
+   "Cooperative",
+   "Deathmatch"
+};
+
+static const char *PrettyPClasses[NUM_CLASSES] =
+{
+   "Fighter",
+   "Cleric",
+   "Mage"
+};
+
+static const char *PrettyAttrNames[NUM_THINGATTRS] =
+{
+   "Hit points",
+   "Ammo damage",
+   "Health",
+   "Armor"
+};
+
+static const char *PrettySkills[NUM_SKILLS] =
+{
+   "Easy",
+   "Norm.",
+   "Hard"
+};
+
+static const char *PrettyClassNames[CLASS_MAX] =
+{
+   "Unknown",
+   "Monsters",    // Monster (attacks/moves/respawns/etc)
+   "NPCs",        // Strife NPC or similar interactive but non-hostile
+   "Health",      // Health item
+   "Armor",       // Armor item
+   "Ammo",        // Ammunition
+   "Weapons",     // Weapon
+   "Keys",        // Key item
+   "Artifacts",   // Artifact (Heretic/Hexen/Strife)
+   "Powerups",    // Power-up item
+   "Quest items", // Quest item (Strife or Hexen)
+   "Decor",       // Decorative
+   "Hazards",     // Hazardous, but not an enemy
+   "Ambience",    // Ambient sound object
+   "Technical",   // Items like player spawns, teleman, deathmatch starts, etc.
+};
+
+//
+// TextFormatter
+//
+// The human-readable tables.
+//
+class TextFormatter : public ReportFormatter
+{
+protected:
+   bool instats;      // between beginStats and endStats
+   bool levelsdone;   // levels line printed for this statistics table
+   bool headerdone;   // header printed for this statistics class
+   int  statsclass;
+
+public:
+   TextFormatter(TextBuffer &pOut)
+      : ReportFormatter(pOut), instats(false), levelsdone(false),
+        headerdone(false), statsclass(0)
+   {
+   }
+
+   virtual void beginArchive(const char *filename, bool multiple)
+   {
+      if(multiple)
+         out.addStr("Archive: ").addStr(filename).addStr("\n\n");
+   }
+
+   virtual void beginLevel(const char *mapname)
+   {
+      out.addRepeated('=', 22).addStrMax(mapname, 8);
+      out.addRepeated('=', 22).addStr("\n\n");
+   }
+
+   virtual void beginRollup(int scope, const char *name)
+   {
+      out.addRepeated('=', 22).addStr("Total: ");
+      if(scope == ROLLUP_EPISODE)
+         out.addStr("episode ").addStr(name);
+      else if(scope == ROLLUP_ARCHIVE)
+         out.addStr("archive");
+      else
+         out.addStr("all archives");
+      out.addRepeated('=', 22).addStr("\n\n");
+   }
+
+   virtual void beginTable(int gametype, int pclass)
+   {
+      out.addStr("Game mode: ").addStr(PrettyGameType[gametype]).addChar('\n');
+      if(pclass >= 0)
+         out.addStr("Player class: ").addStr(PrettyPClasses[pclass]).addChar('\n');
+      levelsdone = false;
+   }
+
+   virtual void beginClass(int classtype)
+   {
+      // statistics headers wait for the first row, which has the level count
+      if(instats)
+      {
+         statsclass = classtype;
+         headerdone = false;
+         return;
+      }
+
+      out.addStr(PrettyClassNames[classtype]).addStr(":\n");
+      out.addStr("  DEN Type                      Easy Norm.  Hard\n");
+      out.addStr("================================================\n");
+   }
+
+   // same layout as "%5d %-24.24s %5d %5d %5d\n"
+   virtual void row(const reportrow_t &row)
+   {
+      out.addIntRight(row.doomednum, 5).addChar(' ');
+      out.addStrLeft(row.name, 24).addChar(' ');
+      out.addIntRight(row.counts[SKILL_EASY],   5).addChar(' ');
+      out.addIntRight(row.counts[SKILL_NORMAL], 5).addChar(' ');
+      out.addIntRight(row.counts[SKILL_HARD],   5).addChar('\n');
+   }
+
+   virtual void endClass() { out.addChar('\n'); }
+
+   // same layout as "  %-22.22s %10lld %10lld %10lld\n"
+   virtual void weightedSums(const reportsums_t &sums)
+   {
+      out.addStr("Weighted totals:\n");
+      out.addStr("  Attribute                    Easy      Norm.       Hard\n");
+      out.addRepeated('=', 57).addChar('\n');
+      for(int i = 0; i < NUM_THINGATTRS; i++)
+      {
+         out.addStr("  ").addStrLeft(PrettyAttrNames[i], 22);
+         for(int s = 0; s < NUM_SKILLS; s++)
+            out.addChar(' ').addInt64Right(sums.sums[i][s], 10);
+         out.addChar('\n');
+      }
+      out.addChar('\n');
+   }
+
+   virtual void endTable() { out.addChar('\n'); }
+
+   virtual void beginStats()
+   {
+      out.addRepeated('=', 22).addStr("Statistics");
+      out.addRepeated('=', 22).addStr("\n\n");
+      instats = true;
+   }
+
+   // same layout as "%5d %-24.24s %-5s %8.2f %5d %5d %5d %5d %5d\n", with the
+   // type only on the first skill's line
+   virtual void statsRow(const statsrow_t &row)
+   {
+      if(!headerdone)
+      {
+         if(!levelsdone)
+         {
+            out.addStr("Levels: ").addInt(static_cast<int>(row.numlevels)).addChar('\n');
+            levelsdone = true;
+         }
+         out.addStr(PrettyClassNames[statsclass]).addStr(":\n");
+         out.addStr("  DEN Type                     Skill     Mean   Min   Max   p50   p90   p99\n");
+         out.addRepeated('=', 75).addChar('\n');
+         headerdone = true;
+      }
+
+      for(int i = 0; i < NUM_SKILLS; i++)
+      {
+         const statsvalues_t &sv = row.skills[i];
+
+         if(i)
+            out.addRepeated(' ', 31);
+         else if(row.name)
+         {
+            out.addIntRight(row.doomednum, 5).addChar(' ');
+            out.addStrLeft(row.name, 24).addChar(' ');
+         }
+         else
+         {
+            out.addStr("    * All ");
+            out.addStrLeft(PrettyClassNames[row.classtype], 20).addChar(' ');
+         }
+         out.addStrLeft(PrettySkills[i], 5).addChar(' ');
+         out.addFixedRight(sv.mean, 2, 8).addChar(' ');
+         out.addIntRight(sv.min, 5).addChar(' ');
+         out.addIntRight(sv.max, 5).addChar(' ');
+         out.addIntRight(sv.p50, 5).addChar(' ');
+         out.addIntRight(sv.p90, 5).addChar(' ');
+         out.addIntRight(sv.p99, 5).addChar('\n');
+      }
+   }
+
+   virtual void endStats() { instats = false; }
+};
+
+//=============================================================================
+//
+// Machine-Readable Records
+//
+// These produce one record per thing type, per table. Modes and player classes
+// are named as on the command line, and thing classes as in thingtype scripts.
+// Rollup records use "*" as a wildcard: map "*" for an archive's totals,
+// "E1*" for an episode's, and archive "*" for the totals of all archives.
+// Statistics are over all archives, and have one record per skill level;
+// those for a whole thing class have no DoomEd number or type. Weighted
+// totals have one record per thingtype attribute.
+//
+
+static const char *GameTypeKeys[NUM_GAME_TYPES] = { "single", "coop", "dm" };
+static const char *PClassKeys[NUM_CLASSES] = { "fighter", "cleric", "mage" };
+static const char *SkillKeys[NUM_SKILLS]   = { "easy", "normal", "hard" };
+
+// Longest map field: an eight-character map name, or an episode's with "*"
+static const size_t MAPFIELDMAX = 9;
+
+//
+// RecordFormatter
+//
+// Keeps track of where in the report the current record belongs.
+//
+class RecordFormatter : public ReportFormatter
+{
+protected:
+   const char *archive;
+   const char *mapname;
+   int         gametype;
+   int         pclass;
+   char        rollupname[10]; // map name for rollup records
+   bool        instats;
+
+public:
+   RecordFormatter(TextBuffer &pOut)
+      : ReportFormatter(pOut), archive(""), mapname(""), gametype(0), pclass(-1),
+        instats(false)
+   {
+      rollupname[0] = '\0';
+   }
+
+   virtual void beginArchive(const char *filename, bool multiple)
+   {
+      archive = filename;
+   }
+   virtual void beginLevel(const char *pMapname) { mapname = pMapname; }
+   virtual void beginTable(int pGametype, int pPClass)
+   {
+      gametype = pGametype;
+      pclass   = pPClass;
+   }
+
+   // Rollups are recorded as levels with wildcard names
+   virtual void beginRollup(int scope, const char *name)
+   {
+      if(scope == ROLLUP_CORPUS)
+         beginArchive("*", true);
+
+      rollupname[0] = '\0';
+      if(scope == ROLLUP_EPISODE)
+      {
+         strncpy(rollupname, name, 8);
+         rollupname[8] = '\0';
+      }
+      strcat(rollupname, "*");
+      beginLevel(rollupname);
+   }
+
+   virtual void beginStats()
+   {
+      archive = "*";
+      mapname = "*";
+      instats = true;
+   }
+   virtual void endStats() { instats = false; }
+
+   // Records must stay parseable, so errors go to stderr
+   virtual void error(const char *message) { fputs(message, stderr); }
+};
+
+//
+// P_utf8SeqLen
+//
+// Length of the well-formed UTF-8 sequence at str, which has avail bytes
+// left, or 0 if it does not begin one. Overlong forms, surrogates, and code
+// points past U+10FFFF are not well-formed.
+//
+static size_t P_utf8SeqLen(const unsigned char *str, size_t avail)
+{
+   unsigned char c = str[0];
+   size_t        len;
+
+   if(c < 0x80)
+      return 1;
+   else if(c >= 0xC2 && c <= 0xDF)
+      len = 2;
+   else if(c >= 0xE0 && c <= 0xEF)
+      len = 3;
+   else if(c >= 0xF0 && c <= 0xF4)
+      len = 4;
+   else
+      return 0;
+
+   if(len > avail)
+      return 0;
+   for(size_t i = 1; i < len; i++)
+   {
+      if((str[i] & 0xC0) != 0x80)
+         return 0;
+   }
+
+   if((c == 0xE0 && str[1] < 0xA0) || (c == 0xED && str[1] >= 0xA0) ||
+      (c == 0xF0 && str[1] < 0x90) || (c == 0xF4 && str[1] >= 0x90))
+      return 0;
+
+   return len;
+}
+
+//
+// P_addUTF8Char
+//
+// Append the character at str[0], which has avail bytes left, and return
+// how many bytes it used. Well-formed UTF-8 passes through unchanged; any
+// other byte is taken as Latin-1, since wad names carry no encoding, so the
+// output is always valid UTF-8.
+//
+static size_t P_addUTF8Char(TextBuffer &out, const char *str, size_t avail)
+{
+   const unsigned char *ustr = reinterpret_cast<const unsigned char *>(str);
+   size_t len = P_utf8SeqLen(ustr, avail);
+
+   if(len)
+   {
+      out.addStr(str, len);
+      return len;
+   }
+
+   out.addChar(static_cast<char>(0xC0 | (ustr[0] >> 6)));
+   out.addChar(static_cast<char>(0x80 | (ustr[0] & 0x3F)));
+   return 1;
+}
+
+//
+// P_addJSONString
+//
+// Append a quoted JSON string. Characters outside of ASCII are written by
+// P_addUTF8Char.
+//
+static void P_addJSONString(TextBuffer &out, const char *str, size_t maxlen)
+{
+   static const char hexdigits[] = "0123456789abcdef";
+
+   size_t len = 0;
+   while(len < maxlen && str[len])
+      ++len;
+
+   out.addChar('"');
+
+   for(size_t i = 0; i < len; )
+   {
+      unsigned char c = static_cast<unsigned char>(str[i]);
+
+      if(c >= 0x80)
+      {
+         i += P_addUTF8Char(out, str + i, len - i);
+         continue;
+      }
+
+      switch(c)
+      {
+      case '"':  out.addStr("\\\"", 2); break;
+      case '\\': out.addStr("\\\\", 2); break;
+      case '\n': out.addStr("\\n",  2); break;
+      case '\r': out.addStr("\\r",  2); break;
+      case '\t': out.addStr("\\t",  2); break;
+      default:
+         if(c < 0x20)
+         {
+            out.addStr("\\u00", 4);
+            out.addChar(hexdigits[c >> 4]).addChar(hexdigits[c & 15]);
+         }
+         else
+            out.addChar(static_cast<char>(c));
+         break;
+      }
+      ++i;
+   }
+
+   out.addChar('"');
+}
+
+//
+// JSONLFormatter
+//
+// JSON Lines; one object per line.
+//
+class JSONLFormatter : public RecordFormatter
+{
+public:
+   JSONLFormatter(TextBuffer &pOut) : RecordFormatter(pOut) {}
+
+   virtual void row(const reportrow_t &row)
+   {
+      out.addStr("{\"archive\":");
+      P_addJSONString(out, archive, SIZE_MAX);
+      out.addStr(",\"map\":");
+      P_addJSONString(out, mapname, MAPFIELDMAX);
+      out.addStr(",\"mode\":\"").addStr(GameTypeKeys[gametype]);
+      out.addStr("\",\"pclass\":");
+      if(pclass >= 0)
+         out.addChar('"').addStr(PClassKeys[pclass]).addChar('"');
+      else
+         out.addStr("null");
+      out.addStr(",\"den\":").addInt(row.doomednum);
+      out.addStr(",\"type\":");
+      P_addJSONString(out, row.name, SIZE_MAX);
+      out.addStr(",\"class\":\"").addStr(P_NameForThingClass(row.classtype));
+      out.addStr("\",\"easy\":").addInt(row.counts[SKILL_EASY]);
+      out.addStr(",\"normal\":").addInt(row.counts[SKILL_NORMAL]);
+      out.addStr(",\"hard\":").addInt(row.counts[SKILL_HARD]);
+      out.addStr("}\n");
+   }
+
+   virtual void weightedSums(const reportsums_t &sums)
+   {
+      for(int i = 0; i < NUM_THINGATTRS; i++)
+      {
+         out.addStr("{\"archive\":");
+         P_addJSONString(out, archive, SIZE_MAX);
+         out.addStr(",\"map\":");
+         P_addJSONString(out, mapname, MAPFIELDMAX);
+         out.addStr(",\"mode\":\"").addStr(GameTypeKeys[gametype]);
+         out.addStr("\",\"pclass\":");
+         if(pclass >= 0)
+            out.addChar('"').addStr(PClassKeys[pclass]).addChar('"');
+         else
+            out.addStr("null");
+         out.addStr(",\"attribute\":\"").addStr(P_NameForThingAttr(i));
+         out.addStr("\",\"easy\":").addInt64(sums.sums[i][SKILL_EASY]);
+         out.addStr(",\"normal\":").addInt64(sums.sums[i][SKILL_NORMAL]);
+         out.addStr(",\"hard\":").addInt64(sums.sums[i][SKILL_HARD]);
+         out.addStr("}\n");
+      }
+   }
+
+   virtual void statsRow(const statsrow_t &row)
+   {
+      for(int i = 0; i < NUM_SKILLS; i++)
+      {
+         const statsvalues_t &sv = row.skills[i];
+
+         out.addStr("{\"archive\":\"*\",\"map\":\"*\",\"mode\":\"").addStr(GameTypeKeys[gametype]);
+         out.addStr("\",\"pclass\":");
+         if(pclass >= 0)
+            out.addChar('"').addStr(PClassKeys[pclass]).addChar('"');
+         else
+            out.addStr("null");
+         if(row.name)
+         {
+            out.addStr(",\"den\":").addInt(row.doomednum);
+            out.addStr(",\"type\":");
+            P_addJSONString(out, row.name, SIZE_MAX);
+         }
+         else
+            out.addStr(",\"den\":null,\"type\":null");
+         out.addStr(",\"class\":\"").addStr(P_NameForThingClass(row.classtype));
+         out.addStr("\",\"skill\":\"").addStr(SkillKeys[i]);
+         out.addStr("\",\"levels\":").addInt(static_cast<int>(row.numlevels));
+         out.addStr(",\"mean\":").addFixed(sv.mean, 2);
+         out.addStr(",\"min\":").addInt(sv.min);
+         out.addStr(",\"max\":").addInt(sv.max);
+         out.addStr(",\"p50\":").addInt(sv.p50);
+         out.addStr(",\"p90\":").addInt(sv.p90);
+         out.addStr(",\"p99\":").addInt(sv.p99);
+         out.addStr("}\n");
+      }
+   }
+};
+
+//
+// P_addCSVField
+//
+// Append a CSV field, quoting it per RFC 4180 only when it contains a
+// delimiter, quote, or line break. Characters outside of ASCII are written
+// by P_addUTF8Char, as in JSON strings.
+//
+static void P_addCSVField(TextBuffer &out, const char *str, size_t maxlen)
+{
+   size_t len = 0;
+   bool   quote = false;
+   bool   ascii = true;
+
+   for(; len < maxlen && str[len]; len++)
+   {
+      char c = str[len];
+      if(c == ',' || c == '"' || c == '\n' || c == '\r')
+         quote = true;
+      else if(static_cast<unsigned char>(c) >= 0x80)
+         ascii = false;
+   }
+
+   if(!quote && ascii)
+   {
+      out.addStr(str, len);
+      return;
+   }
+
+   if(quote)
+      out.addChar('"');
+   for(size_t i = 0; i < len; )
+   {
+      if(static_cast<unsigned char>(str[i]) >= 0x80)
+      {
+         i += P_addUTF8Char(out, str + i, len - i);
+         continue;
+      }
+      if(str[i] == '"')
+         out.addChar('"');
+      out.addChar(str[i]);
+      ++i;
+   }
+   if(quote)
+      out.addChar('"');
+}
+
+//
+// CSVFormatter
+//
+// Statistics have columns of their own, so they follow the counts as a
+// second table, after a blank line and a header of their own.
+//
+class CSVFormatter : public RecordFormatter
+{
+protected:
+   enum
+   {
+      CSV_NONE,   // no header yet
+      CSV_COUNTS,
+      CSV_STATS
+   };
+   int section;
+
+   void startSection(int newsection)
+   {
+      if(section == newsection)
+         return;
+      if(section != CSV_NONE)
+         out.addStr("\r\n");
+      if(newsection == CSV_COUNTS)
+         out.addStr("archive,map,mode,pclass,den,type,class,easy,normal,hard\r\n");
+      else
+      {
+         out.addStr("archive,map,mode,pclass,den,type,class,skill,levels,");
+         out.addStr("mean,min,max,p50,p90,p99\r\n");
+      }
+      section = newsection;
+   }
+
+public:
+   CSVFormatter(TextBuffer &pOut) : RecordFormatter(pOut), section(CSV_NONE) {}
+
+   virtual void beginOutput(bool tables)
+   {
+      startSection(tables ? CSV_COUNTS : CSV_STATS);
+   }
+
+   virtual void beginTable(int pGametype, int pPClass)
+   {
+      RecordFormatter::beginTable(pGametype, pPClass);
+      startSection(instats ? CSV_STATS : CSV_COUNTS);
+   }
+
+   virtual void row(const reportrow_t &row)
+   {
+      P_addCSVField(out, archive, SIZE_MAX);
+      out.addChar(',');
+      P_addCSVField(out, mapname, MAPFIELDMAX);
+      out.addChar(',').addStr(GameTypeKeys[gametype]).addChar(',');
+      if(pclass >= 0)
+         out.addStr(PClassKeys[pclass]);
+      out.addChar(',').addInt(row.doomednum).addChar(',');
+      P_addCSVField(out, row.name, SIZE_MAX);
+      out.addChar(',').addStr(P_NameForThingClass(row.classtype));
+      out.addChar(',').addInt(row.counts[SKILL_EASY]);
+      out.addChar(',').addInt(row.counts[SKILL_NORMAL]);
+      out.addChar(',').addInt(row.counts[SKILL_HARD]);
+      out.addStr("\r\n");
+   }
+
+   // Weighted totals go in the counts table, as rows with no DoomEd number
+   // or class, and the attribute's script name ("$hp") as their type
+   virtual void weightedSums(const reportsums_t &sums)
+   {
+      for(int i = 0; i < NUM_THINGATTRS; i++)
+      {
+         P_addCSVField(out, archive, SIZE_MAX);
+         out.addChar(',');
+         P_addCSVField(out, mapname, MAPFIELDMAX);
+         out.addChar(',').addStr(GameTypeKeys[gametype]).addChar(',');
+         if(pclass >= 0)
+            out.addStr(PClassKeys[pclass]);
+         out.addStr(",,$").addStr(P_NameForThingAttr(i)).addChar(',');
+         out.addChar(',').addInt64(sums.sums[i][SKILL_EASY]);
+         out.addChar(',').addInt64(sums.sums[i][SKILL_NORMAL]);
+         out.addChar(',').addInt64(sums.sums[i][SKILL_HARD]);
+         out.addStr("\r\n");
+      }
+   }
+
+   virtual void statsRow(const statsrow_t &row)
+   {
+      for(int i = 0; i < NUM_SKILLS; i++)
+      {
+         const statsvalues_t &sv = row.skills[i];
+
+         out.addStr("*,*,").addStr(GameTypeKeys[gametype]).addChar(',');
+         if(pclass >= 0)
+            out.addStr(PClassKeys[pclass]);
+         out.addChar(',');
+         if(row.name)
+         {
+            out.addInt(row.doomednum).addChar(',');
+            P_addCSVField(out, row.name, SIZE_MAX);
+         }
+         else
+            out.addChar(',');
+         out.addChar(',').addStr(P_NameForThingClass(row.classtype));
+         out.addChar(',').addStr(SkillKeys[i]);
+         out.addChar(',').addInt(static_cast<int>(row.numlevels));
+         out.addChar(',').addFixed(sv.mean, 2);
+         out.addChar(',').addInt(sv.min);
+         out.addChar(',').addInt(sv.max);
+         out.addChar(',').addInt(sv.p50);
+         out.addChar(',').addInt(sv.p90);
+         out.addChar(',').addInt(sv.p99);
+         out.addStr("\r\n");
+      }
+   }
+};
+
+//
+// ResultsFormatter
+//
+// Writes a columnar results file; see p_results.h. Statistics and weighted
+// totals have no place in it, and are left out.
+//
+class ResultsFormatter : public RecordFormatter
+{
+protected:
+   ResultsWriter writer;
+   int           archivenum;
+   int           mapnum;
+
+public:
+   ResultsFormatter(TextBuffer &pOut, OutBuffer &file)
+      : RecordFormatter(pOut), writer(), archivenum(0), mapnum(0)
+   {
+      if(!writer.open(file))
+         I_Error("Could not start results file\n");
+   }
+
+   virtual void beginArchive(const char *filename, bool multiple)
+   {
+      archivenum = writer.stringNum(filename);
+   }
+
+   virtual void beginLevel(const char *pMapname)
+   {
+      char name[MAPFIELDMAX + 1];
+
+      strncpy(name, pMapname, MAPFIELDMAX);
+      name[MAPFIELDMAX] = '\0';
+      mapnum = writer.stringNum(name);
+   }
+
+   virtual void row(const reportrow_t &row)
+   {
+      int32_t values[RC_NUMCOLUMNS];
+
+      values[RC_ARCHIVE] = archivenum;
+      values[RC_MAP]     = mapnum;
+      values[RC_MODE]    = gametype;
+      values[RC_PCLASS]  = pclass;
+      values[RC_DEN]     = row.doomednum;
+      values[RC_TYPE]    = writer.stringNum(row.name);
+      values[RC_CLASS]   = row.classtype;
+      values[RC_EASY]    = row.counts[SKILL_EASY];
+      values[RC_NORMAL]  = row.counts[SKILL_NORMAL];
+      values[RC_HARD]    = row.counts[SKILL_HARD];
+
+      writer.addRow(values);
+   }
+
+   virtual void endOutput()
+   {
+      if(!writer.close())
+         I_Error("Error writing results file\n");
+   }
+};
+
+//=============================================================================
+//
+// Formatter Selection
+//
+
+// Names of the formats, as given to -format
+enum
+{
+   FORMAT_TEXT,
+   FORMAT_JSONL,
+   FORMAT_CSV,
+   FORMAT_TCOL,
+   NUM_FORMATS
+};
+
+static const char *FormatNames[NUM_FORMATS] = { "text", "jsonl", "csv", "tcol" };
+
+//
+// Number of the named format, or -1 if there is no such format.
+//
+static int P_formatNum(const char *format)
+{
+   for(int i = 0; i < NUM_FORMATS; i++)
+   {
+      if(!strcasecmp(format, FormatNames[i]))
+         return i;
+   }
+
+   return -1;
+}
+
+//
+// ReportFormatter::IsFormat
+//
+// True if there is a format of this name, so that it can be checked before
+// any output file is opened for it.
+//
+bool ReportFormatter::IsFormat(const char *format)
+{
+   return P_formatNum(format) >= 0;
+}
+
+//
+// ReportFormatter::Create
+//
+// Create a formatter for the named format, or return NULL if there is no
+// such format. The report will be written to "file".
+//
+ReportFormatter *ReportFormatter::Create(const char *format, TextBuffer &out,
+                                         OutBuffer &file)
+{
+   switch(P_formatNum(format))
+   {
+   case FORMAT_TEXT:
+      return new TextFormatter(out);
+   case FORMAT_JSONL:
+      return new JSONLFormatter(out);
+   case FORMAT_CSV:
+      return new CSVFormatter(out);
+   case FORMAT_TCOL:
+      return new ResultsFormatter(out, file);
+   default:
+      return NULL;
+   }
+}
+
+// EOF
+
@@ -0,0 +1,198 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      thingcount report output formats
+//
+//-----------------------------------------------------------------------------
+
+#ifndef P_REPORT_H__
+#define P_REPORT_H__
+
+#include "p_thingtypes.h"
+
+class OutBuffer;
+class TextBuffer;
+
+// Game types
+enum
+{
+   GAME_TYPE_SINGLE,
+   GAME_TYPE_COOP,
+   GAME_TYPE_DM,
+   NUM_GAME_TYPES
+};
+
+// Skill levels
+enum
+{
+   SKILL_EASY,
+   SKILL_NORMAL,
+   SKILL_HARD,
+   NUM_SKILLS
+};
+
+// Hexen player classes
+enum
+{
+   CLASS_FIGHTER,
+   CLASS_CLERIC,
+   CLASS_MAGE,
+   NUM_CLASSES
+};
+
+// Count tables are numbered by game type, then player class; tables of levels
+// without player classes come first for each game type
+#define NUM_REPORT_TABLES (NUM_GAME_TYPES * (NUM_CLASSES + 1))
+
+inline int P_ReportTable(int gametype, int pclass)
+{
+   return gametype * (NUM_CLASSES + 1) + pclass + 1;
+}
+inline int P_TableGameType(int table) { return table / (NUM_CLASSES + 1);     }
+inline int P_TablePClass(int table)   { return table % (NUM_CLASSES + 1) - 1; }
+
+//
+// One line of a thing count table
+//
+struct reportrow_t
+{
+   int         doomednum;         // editor number
+   const char *name;              // type name, or "Unknown"
+   int         classtype;         // thing class, from p_thingtypes.h
+   int         counts[NUM_SKILLS]; // number present on each skill level
+};
+
+//
+// A table's thing counts weighted by each thingtype attribute: for example,
+// the hit points of all monsters present on each skill level
+//
+struct reportsums_t
+{
+   int64_t sums[NUM_THINGATTRS][NUM_SKILLS];
+};
+
+//
+// Statistics of one thing type's, or a whole thing class's, counts per level
+// on one skill level
+//
+struct statsvalues_t
+{
+   double mean;
+   int    min;
+   int    max;
+   int    p50;
+   int    p90;
+   int    p99;
+};
+
+//
+// One line of a statistics table
+//
+struct statsrow_t
+{
+   int           doomednum;  // editor number; unused for class totals
+   const char   *name;       // type name, "Unknown", or NULL for class totals
+   int           classtype;  // thing class, from p_thingtypes.h
+   unsigned int  numlevels;  // levels the statistics are taken over
+   statsvalues_t skills[NUM_SKILLS];
+};
+
+//
+// ReportFormatter
+//
+// Turns the thing count tables into output text. The tables are produced as
+// a stream of events, in this order:
+//
+//    beginOutput
+//    beginArchive
+//      beginLevel
+//        beginTable (once per game type, and player class for Hexen maps)
+//          beginClass, row..., endClass (for each thing class present)
+//          weightedSums (if asked for)
+//        endTable
+//      endLevel
+//      beginRollup, tables as above, endRollup (if totals were asked for)
+//    beginStats (if statistics were asked for)
+//      beginTable, beginClass, statsRow..., endClass, endTable
+//    endStats
+//    endOutput
+//
+// Rollups hold totals over several levels. Those for an episode or a whole
+// archive follow the archive's levels; the rollup for all archives comes
+// just before endOutput.
+//
+// Text formatters append to the TextBuffer they were created with, and never
+// build per-record strings of their own. Binary formatters write directly to
+// the output buffer instead.
+//
+class ReportFormatter
+{
+protected:
+   TextBuffer &out;
+
+public:
+   ReportFormatter(TextBuffer &pOut) : out(pOut) {}
+   virtual ~ReportFormatter() {}
+
+   // Once, before anything else is output. tables is false if the report
+   // will hold nothing but statistics.
+   virtual void beginOutput(bool tables) {}
+
+   // "multiple" is true if more than one archive is being processed
+   virtual void beginArchive(const char *filename, bool multiple) {}
+
+   virtual void beginLevel(const char *mapname) {}
+
+   // pclass is -1 for levels without player classes
+   virtual void beginTable(int gametype, int pclass) {}
+   virtual void beginClass(int classtype) {}
+   virtual void row(const reportrow_t &row) = 0;
+   virtual void endClass() {}
+   virtual void weightedSums(const reportsums_t &sums) {}
+   virtual void endTable() {}
+   virtual void endLevel() {}
+
+   // scope is a ROLLUP_* value from p_rollup.h; name is the episode name
+   // for ROLLUP_EPISODE, and otherwise unused
+   virtual void beginRollup(int scope, const char *name) {}
+   virtual void endRollup() {}
+
+   // Statistics over all archives. Each class's rows start with the class
+   // totals, followed by the thing types in it.
+   virtual void beginStats() {}
+   virtual void statsRow(const statsrow_t &row) {}
+   virtual void endStats() {}
+
+   // Once, after everything else
+   virtual void endOutput() {}
+
+   // Archives that fail to process are reported through here
+   virtual void error(const char *message);
+
+   static bool IsFormat(const char *format);
+   static ReportFormatter *Create(const char *format, TextBuffer &out,
+                                  OutBuffer &file);
+};
+
+#endif
+
+// EOF
+
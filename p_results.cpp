@@ -0,0 +1,669 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Columnar binary results files
+//
+//-----------------------------------------------------------------------------
+
+#include "z_zone.h"
+#include "d_io.h"
+#include "e_hash.h"
+#include "e_hashkeys.h"
+#include "m_binary.h"
+#include "m_collection.h"
+#include "m_dllist.h"
+#include "m_misc.h"
+#include "p_results.h"
+
+static const char resultsMagic[4] = { 'T', 'C', 'O', 'L' };
+
+// Size of fixed structures
+#define RESULTS_HEADERSIZE  16
+#define RESULTS_GROUPHDRSIZE (8 + 4 * RC_NUMCOLUMNS + 4 * (RC_NUMCOLUMNS & 1))
+#define RESULTS_BLOCKHDRSIZE 16
+#define RESULTS_TRAILERSIZE 48
+
+// Largest encoded column block: 32 bits per value, plus padding
+#define RESULTS_MAXBLOCKSIZE (RESULTS_BLOCKHDRSIZE + 4 * RESULTS_GROUPROWS + 8)
+
+//
+// RS_widthForRange
+//
+// Number of bits needed to hold values from 0 to range.
+//
+static int RS_widthForRange(uint64_t range)
+{
+   int width = 0;
+
+   while(range)
+   {
+      ++width;
+      range >>= 1;
+   }
+
+   return width;
+}
+
+//=============================================================================
+//
+// Writer
+//
+
+// One entry in the string dictionary
+struct resultstring_t
+{
+   DLListItem<resultstring_t> links;
+   const char *str;
+   int         num;
+};
+
+typedef EHashTable<resultstring_t, EStringHashKey,
+                   &resultstring_t::str, &resultstring_t::links> stringhash_t;
+
+//
+// ResultsWriterPimpl
+//
+class ResultsWriterPimpl : public ZoneObject
+{
+public:
+   stringhash_t                     stringhash;
+   PODCollection<resultstring_t *>  strings;     // in dictionary order
+   int32_t                         *columns[RC_NUMCOLUMNS];
+   PODCollection<uint64_t>          groupoffsets;
+   PODCollection<uint32_t>          grouprows;
+   byte                            *blocks;      // encoded column blocks
+
+   ResultsWriterPimpl()
+      : ZoneObject(), stringhash(), strings(), groupoffsets(), grouprows()
+   {
+      for(int i = 0; i < RC_NUMCOLUMNS; i++)
+         columns[i] = ecalloc(int32_t *, RESULTS_GROUPROWS, sizeof(int32_t));
+
+      blocks = ecalloc(byte *, RC_NUMCOLUMNS, RESULTS_MAXBLOCKSIZE);
+   }
+
+   ~ResultsWriterPimpl()
+   {
+      for(resultstring_t *rs : strings)
+      {
+         efree(const_cast<char *>(rs->str));
+         efree(rs);
+      }
+      stringhash.destroy();
+
+      for(int i = 0; i < RC_NUMCOLUMNS; i++)
+         efree(columns[i]);
+      efree(blocks);
+   }
+};
+
+//
+// ResultsWriter Constructor
+//
+ResultsWriter::ResultsWriter()
+   : file(NULL), pImpl(new ResultsWriterPimpl()), offset(0), totalrows(0),
+     numrows(0), ok(true)
+{
+}
+
+//
+// ResultsWriter Destructor
+//
+ResultsWriter::~ResultsWriter()
+{
+   delete pImpl;
+}
+
+//
+// ResultsWriter::writeBytes
+//
+void ResultsWriter::writeBytes(const void *data, size_t size)
+{
+   if(ok && !file->Write(data, size))
+      ok = false;
+   offset += size;
+}
+
+//
+// ResultsWriter::writeUint32
+//
+void ResultsWriter::writeUint32(uint32_t num)
+{
+   if(ok && !file->WriteUint32(num))
+      ok = false;
+   offset += 4;
+}
+
+//
+// ResultsWriter::writeUint64
+//
+void ResultsWriter::writeUint64(uint64_t num)
+{
+   writeUint32(static_cast<uint32_t>(num));
+   writeUint32(static_cast<uint32_t>(num >> 32));
+}
+
+//
+// ResultsWriter::writePadding
+//
+// Pad the file out to an 8-byte boundary.
+//
+void ResultsWriter::writePadding()
+{
+   static const byte zeroes[8] = { 0 };
+
+   if(offset & 7)
+      writeBytes(zeroes, 8 - (offset & 7));
+}
+
+//
+// RS_write32
+//
+static byte *RS_write32(byte *out, uint32_t num)
+{
+   out[0] = static_cast<byte>(num);
+   out[1] = static_cast<byte>(num >>  8);
+   out[2] = static_cast<byte>(num >> 16);
+   out[3] = static_cast<byte>(num >> 24);
+   return out + 4;
+}
+
+//
+// RS_encodeColumn
+//
+// Encode one column block into "out" and return its size, padding included.
+// Each block uses whichever of frame-of-reference or delta packing is
+// narrower for its values.
+//
+static size_t RS_encodeColumn(const int32_t *values, int count, byte *out)
+{
+   int64_t minval = values[0], maxval = values[0];
+   int64_t mindelta = 0, maxdelta = 0;
+
+   for(int i = 1; i < count; i++)
+   {
+      int64_t delta = static_cast<int64_t>(values[i]) - values[i - 1];
+
+      if(values[i] < minval)
+         minval = values[i];
+      if(values[i] > maxval)
+         maxval = values[i];
+
+      if(i == 1 || delta < mindelta)
+         mindelta = delta;
+      if(i == 1 || delta > maxdelta)
+         maxdelta = delta;
+   }
+
+   int     encoding   = RESULTS_ENC_FOR;
+   int     width      = RS_widthForRange(static_cast<uint64_t>(maxval - minval));
+   int     deltawidth = RS_widthForRange(static_cast<uint64_t>(maxdelta - mindelta));
+   int64_t reference  = minval;
+
+   if(count > 1 && deltawidth < width)
+   {
+      encoding  = RESULTS_ENC_DELTA;
+      width     = deltawidth;
+      reference = mindelta;
+   }
+
+   // pack the values, least significant bit first
+   byte    *start = out;
+   byte    *rover = out + RESULTS_BLOCKHDRSIZE;
+   uint64_t accum = 0;
+   int      bits  = 0;
+
+   if(width)
+   {
+      for(int i = (encoding == RESULTS_ENC_DELTA); i < count; i++)
+      {
+         int64_t value = values[i];
+         if(encoding == RESULTS_ENC_DELTA)
+            value -= values[i - 1];
+
+         accum |= static_cast<uint64_t>(value - reference) << bits;
+         bits  += width;
+         while(bits >= 8)
+         {
+            *rover++ = static_cast<byte>(accum);
+            accum  >>= 8;
+            bits    -= 8;
+         }
+      }
+      if(bits)
+         *rover++ = static_cast<byte>(accum);
+   }
+
+   uint32_t packedsize = static_cast<uint32_t>(rover - start - RESULTS_BLOCKHDRSIZE);
+
+   out[0] = static_cast<byte>(encoding);
+   out[1] = static_cast<byte>(width);
+   out[2] = out[3] = 0;
+   out = RS_write32(out + 4, static_cast<uint32_t>(values[0]));
+   out = RS_write32(out, static_cast<uint32_t>(static_cast<int32_t>(reference)));
+   RS_write32(out, packedsize);
+
+   while((rover - start) & 7)
+      *rover++ = 0;
+
+   return static_cast<size_t>(rover - start);
+}
+
+//
+// ResultsWriter::writeGroup
+//
+// Write out the current row group.
+//
+void ResultsWriter::writeGroup()
+{
+   if(!numrows)
+      return;
+
+   size_t blocksizes[RC_NUMCOLUMNS];
+   uint32_t coloffset = RESULTS_GROUPHDRSIZE;
+
+   pImpl->groupoffsets.add(offset);
+   pImpl->grouprows.add(numrows);
+
+   for(int i = 0; i < RC_NUMCOLUMNS; i++)
+   {
+      blocksizes[i] = RS_encodeColumn(pImpl->columns[i], numrows,
+                                      pImpl->blocks + i * RESULTS_MAXBLOCKSIZE);
+   }
+
+   writeUint32(numrows);
+   writeUint32(0);
+   for(int i = 0; i < RC_NUMCOLUMNS; i++)
+   {
+      writeUint32(coloffset);
+      coloffset += static_cast<uint32_t>(blocksizes[i]);
+   }
+   writePadding();
+
+   for(int i = 0; i < RC_NUMCOLUMNS; i++)
+      writeBytes(pImpl->blocks + i * RESULTS_MAXBLOCKSIZE, blocksizes[i]);
+
+   totalrows += numrows;
+   numrows    = 0;
+}
+
+//
+// ResultsWriter::open
+//
+// Start writing a results file to an output buffer.
+//
+bool ResultsWriter::open(OutBuffer &out)
+{
+   file = &out;
+
+   writeBytes(resultsMagic, sizeof(resultsMagic));
+   writeUint32(RESULTS_VERSION);
+   writeUint32(RC_NUMCOLUMNS);
+   writeUint32(0);
+
+   return ok;
+}
+
+//
+// ResultsWriter::stringNum
+//
+// Get the dictionary number for a string, adding it if it is new.
+//
+int ResultsWriter::stringNum(const char *str)
+{
+   resultstring_t *rs;
+
+   if(!(rs = pImpl->stringhash.objectForKey(str)))
+   {
+      rs = estructalloc(resultstring_t, 1);
+      rs->str = estrdup(str);
+      rs->num = static_cast<int>(pImpl->strings.getLength());
+      pImpl->strings.add(rs);
+      pImpl->stringhash.addObject(rs);
+
+      if(pImpl->stringhash.getLoadFactor() > 2.0f)
+         pImpl->stringhash.rebuild(pImpl->stringhash.getNumChains() * 2 + 1);
+   }
+
+   return rs->num;
+}
+
+//
+// ResultsWriter::addRow
+//
+void ResultsWriter::addRow(const int32_t values[RC_NUMCOLUMNS])
+{
+   for(int i = 0; i < RC_NUMCOLUMNS; i++)
+      pImpl->columns[i][numrows] = values[i];
+
+   if(++numrows == RESULTS_GROUPROWS)
+      writeGroup();
+}
+
+//
+// ResultsWriter::close
+//
+// Write out any remaining rows, the dictionary, and the indices. The output
+// buffer is left open. Returns false if anything failed to write.
+//
+bool ResultsWriter::close()
+{
+   uint32_t stringoffset = 0;
+
+   writeGroup();
+
+   // strings
+   uint64_t stringsstart = offset;
+   for(resultstring_t *rs : pImpl->strings)
+      writeBytes(rs->str, strlen(rs->str) + 1);
+   writePadding();
+
+   // string index
+   uint64_t stringidxstart = offset;
+   for(resultstring_t *rs : pImpl->strings)
+   {
+      writeUint32(stringoffset);
+      stringoffset += static_cast<uint32_t>(strlen(rs->str) + 1);
+   }
+   writePadding();
+
+   // group index
+   uint64_t groupidxstart = offset;
+   for(size_t i = 0; i < pImpl->groupoffsets.getLength(); i++)
+   {
+      writeUint64(pImpl->groupoffsets[i]);
+      writeUint32(pImpl->grouprows[i]);
+      writeUint32(0);
+   }
+
+   // trailer
+   writeUint64(stringsstart);
+   writeUint64(stringidxstart);
+   writeUint64(groupidxstart);
+   writeUint64(totalrows);
+   writeUint32(static_cast<uint32_t>(pImpl->strings.getLength()));
+   writeUint32(static_cast<uint32_t>(pImpl->groupoffsets.getLength()));
+   writeUint32(0);
+   writeBytes(resultsMagic, sizeof(resultsMagic));
+
+   if(!file->Flush())
+      ok = false;
+
+   return ok;
+}
+
+//=============================================================================
+//
+// Reader
+//
+
+#define RS_read32(p) read32_le((p), uint32_t)
+#define RS_read64(p) (RS_read32(p) | (static_cast<uint64_t>(RS_read32((p) + 4)) << 32))
+
+//
+// ResultsReader Constructor
+//
+ResultsReader::ResultsReader()
+   : file(), data(NULL), size(0), numstrings(0), numgroups(0),
+     numrows(0), strings(NULL), stringsize(0), stringidx(NULL), groupidx(NULL)
+{
+}
+
+//
+// ResultsReader Destructor
+//
+ResultsReader::~ResultsReader()
+{
+   close();
+}
+
+//
+// ResultsReader::validate
+//
+// Check the header and trailer, and that every index fits in the file.
+// Column blocks are checked when they are read.
+//
+bool ResultsReader::validate()
+{
+   if(size < RESULTS_HEADERSIZE + RESULTS_TRAILERSIZE ||
+      memcmp(data, resultsMagic, 4) ||
+      RS_read32(data + 4) != RESULTS_VERSION ||
+      RS_read32(data + 8) != RC_NUMCOLUMNS)
+      return false;
+
+   const byte *trailer = data + size - RESULTS_TRAILERSIZE;
+   uint64_t    limit   = size - RESULTS_TRAILERSIZE;
+
+   if(memcmp(trailer + 44, resultsMagic, 4))
+      return false;
+
+   uint64_t stringsstart   = RS_read64(trailer);
+   uint64_t stringidxstart = RS_read64(trailer + 8);
+   uint64_t groupidxstart  = RS_read64(trailer + 16);
+
+   numrows    = RS_read64(trailer + 24);
+   numstrings = RS_read32(trailer + 32);
+   numgroups  = RS_read32(trailer + 36);
+
+   if(stringsstart > stringidxstart || stringidxstart > groupidxstart ||
+      groupidxstart > limit ||
+      stringidxstart + 4 * static_cast<uint64_t>(numstrings) > groupidxstart ||
+      groupidxstart + 16 * static_cast<uint64_t>(numgroups) > limit)
+      return false;
+
+   strings    = data + stringsstart;
+   stringidx  = data + stringidxstart;
+   groupidx   = data + groupidxstart;
+
+   // strings must all be terminated within the strings block
+   stringsize = static_cast<size_t>(stringidxstart - stringsstart);
+   while(stringsize && strings[stringsize - 1])
+      --stringsize;
+   for(uint32_t i = 0; i < numstrings; i++)
+   {
+      if(RS_read32(stringidx + 4 * i) >= stringsize)
+         return false;
+   }
+
+   uint64_t rows = 0;
+   for(uint32_t i = 0; i < numgroups; i++)
+   {
+      uint64_t groupstart = RS_read64(groupidx + 16 * i);
+      uint32_t grouprows  = RS_read32(groupidx + 16 * i + 8);
+
+      if(groupstart + RESULTS_GROUPHDRSIZE > stringsstart ||
+         grouprows > RESULTS_GROUPROWS ||
+         RS_read32(data + groupstart) != grouprows)
+         return false;
+
+      rows += grouprows;
+   }
+
+   return rows == numrows;
+}
+
+//
+// ResultsReader::open
+//
+// Map a results file into memory. Returns false if the file cannot be read
+// or is not a valid results file.
+//
+bool ResultsReader::open(const char *filename)
+{
+   close();
+
+   if(!file.open(filename))
+      return false;
+
+   data = file.getData();
+   size = file.getSize();
+
+   if(!validate())
+   {
+      close();
+      return false;
+   }
+
+   return true;
+}
+
+//
+// ResultsReader::close
+//
+void ResultsReader::close()
+{
+   file.close();
+
+   data       = NULL;
+   size       = 0;
+   numstrings = numgroups = 0;
+   numrows    = 0;
+   strings    = stringidx = groupidx = NULL;
+   stringsize = 0;
+}
+
+//
+// ResultsReader::getGroupRows
+//
+int ResultsReader::getGroupRows(int group) const
+{
+   if(group < 0 || static_cast<uint32_t>(group) >= numgroups)
+      return 0;
+
+   return static_cast<int>(RS_read32(groupidx + 16 * group + 8));
+}
+
+//
+// ResultsReader::getString
+//
+// Look up a dictionary string. Returns null if there is no such string.
+//
+const char *ResultsReader::getString(int num) const
+{
+   if(num < 0 || static_cast<uint32_t>(num) >= numstrings)
+      return NULL;
+
+   return reinterpret_cast<const char *>(strings + RS_read32(stringidx + 4 * num));
+}
+
+//
+// RS_unpack
+//
+// Unpack "count" values of "width" bits. "avail" is the number of bytes that
+// may be read from "in"; when at least 8 bytes past the packed data are still
+// inside the file, whole words are loaded instead of single bytes.
+//
+static void RS_unpack(const byte *in, size_t avail, int width, uint32_t count,
+                      uint32_t *out)
+{
+   uint64_t mask = (static_cast<uint64_t>(1) << width) - 1;
+   uint64_t bitpos = 0;
+   uint32_t i = 0;
+
+   if(!width)
+   {
+      memset(out, 0, count * sizeof(*out));
+      return;
+   }
+
+   if((static_cast<uint64_t>(count) * width + 7) / 8 + 8 <= avail)
+   {
+      for(; i < count; i++, bitpos += width)
+      {
+         uint64_t word = RS_read64(in + (bitpos >> 3));
+         out[i] = static_cast<uint32_t>((word >> (bitpos & 7)) & mask);
+      }
+      return;
+   }
+
+   uint64_t accum = 0;
+   int      bits  = 0;
+
+   for(; i < count; i++)
+   {
+      while(bits < width)
+      {
+         accum |= static_cast<uint64_t>(*in++) << bits;
+         bits  += 8;
+      }
+      out[i]   = static_cast<uint32_t>(accum & mask);
+      accum  >>= width;
+      bits    -= width;
+   }
+}
+
+//
+// ResultsReader::readColumn
+//
+// Decode one column of a row group. Returns false if the column is damaged.
+//
+bool ResultsReader::readColumn(int group, int column, int32_t *values) const
+{
+   if(group < 0 || static_cast<uint32_t>(group) >= numgroups ||
+      column < 0 || column >= RC_NUMCOLUMNS)
+      return false;
+
+   uint64_t groupstart = RS_read64(groupidx + 16 * group);
+   uint32_t count      = RS_read32(data + groupstart);
+   uint64_t blockstart = groupstart + RS_read32(data + groupstart + 8 + 4 * column);
+
+   if(blockstart + RESULTS_BLOCKHDRSIZE > size)
+      return false;
+
+   const byte *block     = data + blockstart;
+   int         encoding  = block[0];
+   int         width     = block[1];
+   uint32_t    first     = RS_read32(block + 4);
+   uint32_t    reference = RS_read32(block + 8);
+   uint32_t    packedsize = RS_read32(block + 12);
+   uint32_t    numpacked = (encoding == RESULTS_ENC_DELTA) ? count - 1 : count;
+
+   if((encoding != RESULTS_ENC_FOR && encoding != RESULTS_ENC_DELTA) ||
+      width > 32 || !count ||
+      (static_cast<uint64_t>(numpacked) * width + 7) / 8 > packedsize ||
+      blockstart + RESULTS_BLOCKHDRSIZE + packedsize > size)
+      return false;
+
+   const byte *in     = block + RESULTS_BLOCKHDRSIZE;
+   uint32_t   *uvalues = reinterpret_cast<uint32_t *>(values);
+   uint32_t    i;
+
+   // values are rebuilt with wrapping unsigned arithmetic, which reverses
+   // the writer's 64-bit subtraction exactly
+   if(encoding == RESULTS_ENC_DELTA)
+   {
+      uvalues[0] = first;
+      RS_unpack(in, size - (in - data), width, numpacked, uvalues + 1);
+      for(i = 1; i < count; i++)
+         uvalues[i] += uvalues[i - 1] + reference;
+   }
+   else
+   {
+      RS_unpack(in, size - (in - data), width, numpacked, uvalues);
+      for(i = 0; i < count; i++)
+         uvalues[i] += reference;
+   }
+
+   return true;
+}
+
+// EOF
+
@@ -0,0 +1,160 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Columnar binary results files
+//
+//-----------------------------------------------------------------------------
+
+#ifndef P_RESULTS_H__
+#define P_RESULTS_H__
+
+#include "m_buffer.h"
+#include "m_mapfile.h"
+
+//
+// Results file layout
+//
+// All values are little-endian, and every structure begins on an 8-byte
+// boundary, so a mapped file can be read in place:
+//
+//    header        "TCOL", version, number of columns, 0
+//    row groups    up to RESULTS_GROUPROWS rows each
+//    strings       null-terminated dictionary strings, back to back
+//    string index  uint32 offset of each string within the strings block
+//    group index   per group: uint64 file offset, uint32 rows, uint32 0
+//    trailer       see below
+//
+// A row group starts with its row count, a reserved word, and the offset of
+// each column block from the start of the group. A column block holds the
+// values of one column for every row in the group:
+//
+//    uint8  encoding   RESULTS_ENC_*
+//    uint8  width      bits per packed value; 0 if all values are equal
+//    uint16 reserved
+//    int32  first      first value (delta encoding only)
+//    int32  reference  value (or delta) that packed values are relative to
+//    uint32 size       bytes of packed data that follow
+//
+// Packed values are stored least significant bit first.
+//
+
+// Columns. String columns hold an index into the string dictionary.
+enum
+{
+   RC_ARCHIVE, // archive name (string)
+   RC_MAP,     // map header name (string)
+   RC_MODE,    // game type
+   RC_PCLASS,  // Hexen player class, or -1
+   RC_DEN,     // DoomEd number
+   RC_TYPE,    // thing type name (string)
+   RC_CLASS,   // thing class
+   RC_EASY,    // count on easy skill
+   RC_NORMAL,  // count on normal skill
+   RC_HARD,    // count on hard skill
+   RC_NUMCOLUMNS
+};
+
+// Column block encodings
+enum
+{
+   RESULTS_ENC_FOR,   // value - reference
+   RESULTS_ENC_DELTA  // (value - previous value) - reference
+};
+
+#define RESULTS_VERSION   1
+#define RESULTS_GROUPROWS 65536
+
+class ResultsWriterPimpl;
+
+//
+// ResultsWriter
+//
+// Collects rows a group at a time and writes them out column by column. The
+// output buffer must be little-endian, and at the start of its file.
+//
+class ResultsWriter
+{
+protected:
+   OutBuffer          *file;
+   ResultsWriterPimpl *pImpl;
+   uint64_t            offset;    // bytes written so far
+   uint64_t            totalrows; // rows in finished groups
+   int                 numrows;   // rows in the current group
+   bool                ok;        // false once a write fails
+
+   void writeBytes(const void *data, size_t size);
+   void writeUint32(uint32_t num);
+   void writeUint64(uint64_t num);
+   void writePadding();
+   void writeGroup();
+
+public:
+   ResultsWriter();
+   ~ResultsWriter();
+
+   bool open(OutBuffer &out);
+   int  stringNum(const char *str);
+   void addRow(const int32_t values[RC_NUMCOLUMNS]);
+   bool close();
+};
+
+//
+// ResultsReader
+//
+// Reads a results file mapped into memory. Columns are decoded one row group
+// at a time into caller-provided arrays of RESULTS_GROUPROWS values.
+//
+class ResultsReader
+{
+protected:
+   MappedFile  file;
+   const byte *data;       // file contents
+   size_t      size;       // size of the file
+   uint32_t    numstrings;
+   uint32_t    numgroups;
+   uint64_t    numrows;
+   const byte *strings;    // strings block
+   size_t      stringsize;
+   const byte *stringidx;  // string index
+   const byte *groupidx;   // group index
+
+   bool validate();
+
+public:
+   ResultsReader();
+   ~ResultsReader();
+
+   bool open(const char *filename);
+   void close();
+
+   uint64_t getNumRows()    const { return numrows;    }
+   int      getNumGroups()  const { return numgroups;  }
+   int      getNumStrings() const { return numstrings; }
+
+   int         getGroupRows(int group) const;
+   const char *getString(int num) const;
+   bool        readColumn(int group, int column, int32_t *values) const;
+};
+
+#endif
+
+// EOF
+
@@ -0,0 +1,316 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Thing count totals over several levels
+//
+//-----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "z_zone.h"
+#include "i_system.h"
+#include "m_ctype.h"
+#include "p_rollup.h"
+
+// Bits of a key below the table number
+#define ROLLUP_TABLESHIFT 16
+
+// DoomEd numbers are 16-bit signed values; this offset makes them sort in
+// order as unsigned ones
+#define ROLLUP_DENBIAS 32768
+
+// Reductions of fewer entries than this are merged on the calling thread,
+// since they take less time than starting threads would
+#define ROLLUP_SERIALENTRIES 32768
+
+//
+// RollupTally Destructor
+//
+RollupTally::~RollupTally()
+{
+   free(entries);
+}
+
+//
+// RollupTally::add
+//
+// Add a thing type's counts from one table. Entries are added in any order;
+// call sort once all are in.
+//
+void RollupTally::add(int gametype, int pclass, int doomednum,
+                      const int counts[NUM_SKILLS])
+{
+   if(numentries == numalloc)
+   {
+      size_t newalloc = numalloc ? numalloc * 2 : 64;
+      rollupentry_t *newentries;
+
+      if(!(newentries = static_cast<rollupentry_t *>(realloc(entries, newalloc * sizeof(rollupentry_t)))))
+         I_Error("RollupTally::add: failed on allocation of %u entries\n",
+                 static_cast<unsigned int>(newalloc));
+      entries  = newentries;
+      numalloc = newalloc;
+   }
+
+   rollupentry_t &entry = entries[numentries++];
+   uint32_t table = static_cast<uint32_t>(P_ReportTable(gametype, pclass));
+
+   entry.key = (table << ROLLUP_TABLESHIFT) |
+               static_cast<uint32_t>((doomednum + ROLLUP_DENBIAS) & 0xffff);
+   for(int i = 0; i < NUM_SKILLS; i++)
+      entry.counts[i] = counts[i];
+}
+
+//
+// RollupTally::sort
+//
+void RollupTally::sort()
+{
+   std::sort(entries, entries + numentries,
+             [] (const rollupentry_t &a, const rollupentry_t &b) { return a.key < b.key; });
+}
+
+//
+// RollupTally::mergeFrom
+//
+// Add the counts of another sorted tally to this one, leaving the other
+// empty. Safe to call from worker threads, so long as no two calls share a
+// tally. Allocation failure cannot be reported from a worker, so it aborts.
+//
+void RollupTally::mergeFrom(RollupTally &other)
+{
+   size_t         total = numentries + other.numentries;
+   rollupentry_t *merged;
+
+   if(!other.numentries)
+      return;
+
+   if(!(merged = static_cast<rollupentry_t *>(malloc(total * sizeof(rollupentry_t)))))
+      abort();
+
+   size_t i = 0, j = 0, k = 0;
+   while(i < numentries && j < other.numentries)
+   {
+      const rollupentry_t &a = entries[i];
+      const rollupentry_t &b = other.entries[j];
+
+      if(a.key < b.key)
+      {
+         merged[k++] = a;
+         ++i;
+      }
+      else if(b.key < a.key)
+      {
+         merged[k++] = b;
+         ++j;
+      }
+      else
+      {
+         merged[k] = a;
+         for(int s = 0; s < NUM_SKILLS; s++)
+            merged[k].counts[s] += b.counts[s];
+         ++k;
+         ++i;
+         ++j;
+      }
+   }
+   while(i < numentries)
+      merged[k++] = entries[i++];
+   while(j < other.numentries)
+      merged[k++] = other.entries[j++];
+
+   free(entries);
+   entries    = merged;
+   numentries = k;
+   numalloc   = total;
+
+   free(other.entries);
+   other.entries    = NULL;
+   other.numentries = 0;
+   other.numalloc   = 0;
+}
+
+//
+// RollupTally::KeyTable
+//
+// Number of the table, for a game type and player class, that an entry
+// belongs to.
+//
+int RollupTally::KeyTable(uint32_t key)
+{
+   return static_cast<int>(key >> ROLLUP_TABLESHIFT);
+}
+
+//
+// RollupTally::KeyGameType
+//
+int RollupTally::KeyGameType(uint32_t key)
+{
+   return P_TableGameType(KeyTable(key));
+}
+
+//
+// RollupTally::KeyPClass
+//
+// Returns -1 for levels without player classes.
+//
+int RollupTally::KeyPClass(uint32_t key)
+{
+   return P_TablePClass(KeyTable(key));
+}
+
+//
+// RollupTally::KeyDoomEdNum
+//
+int RollupTally::KeyDoomEdNum(uint32_t key)
+{
+   return static_cast<int>(key & 0xffff) - ROLLUP_DENBIAS;
+}
+
+//
+// RollupBarrier
+//
+// Holds each of a fixed number of threads in wait until all of them have
+// reached it, so that they can go through the rounds of a reduction in step.
+//
+class RollupBarrier
+{
+protected:
+   std::mutex              mutex;
+   std::condition_variable released;
+   int                     numthreads;
+   int                     numwaiting;
+   unsigned int            generation; // number of times all have arrived
+
+public:
+   RollupBarrier(int pNumThreads)
+      : mutex(), released(), numthreads(pNumThreads), numwaiting(0),
+        generation(0)
+   {
+   }
+
+   void wait()
+   {
+      std::unique_lock<std::mutex> lock(mutex);
+      unsigned int gen = generation;
+
+      if(++numwaiting == numthreads)
+      {
+         numwaiting = 0;
+         ++generation;
+         released.notify_all();
+      }
+      else
+         released.wait(lock, [&] () { return generation != gen; });
+   }
+};
+
+//
+// P_ReduceTallies
+//
+// Merge a set of sorted tallies into the first one, as a tree: each round
+// merges pairs of tallies a stride apart. Up to numthreads threads are
+// started once, and share out the merges of every round, waiting for each
+// other between rounds. Small reductions are done on the calling thread
+// alone. The other tallies are left empty. Returns the first tally, or NULL
+// if there are none.
+//
+RollupTally *P_ReduceTallies(RollupTally **tallies, int numtallies, int numthreads)
+{
+   if(numtallies <= 0)
+      return NULL;
+
+   size_t numentries = 0;
+   for(int i = 0; i < numtallies; i++)
+      numentries += tallies[i]->getNumEntries();
+
+   // the first round has the most merges to share out
+   numthreads = std::min(numthreads, numtallies / 2);
+   if(numthreads < 1 || numentries < ROLLUP_SERIALENTRIES)
+      numthreads = 1;
+
+   RollupBarrier barrier(numthreads);
+
+   // thread number threadnum takes every numthreads'th pair of each round
+   auto reduce = [&] (int threadnum) {
+      for(int stride = 1; stride < numtallies; stride *= 2)
+      {
+         int numpairs = (numtallies - stride + 2 * stride - 1) / (2 * stride);
+
+         for(int pair = threadnum; pair < numpairs; pair += numthreads)
+         {
+            int i = pair * 2 * stride;
+            tallies[i]->mergeFrom(*tallies[i + stride]);
+         }
+
+         if(numthreads > 1)
+            barrier.wait();
+      }
+   };
+
+   int numworkers = numthreads - 1;
+   std::thread *workers = numworkers > 0 ? new std::thread[numworkers] : NULL;
+
+   // this thread takes a share too
+   for(int i = 0; i < numworkers; i++)
+      workers[i] = std::thread(reduce, i + 1);
+   reduce(0);
+   for(int i = 0; i < numworkers; i++)
+      workers[i].join();
+
+   delete [] workers;
+
+   return tallies[0];
+}
+
+//
+// P_EpisodeForMap
+//
+// Levels named ExMy are grouped by episode; any other name is grouped by
+// what is left after removing its level number, so MAP01 to MAP32 make up
+// one episode, "MAP", E1M1 to E1M9 make up "E1", and a full-length name
+// without a number, such as LEVELABC, is an episode of its own.
+//
+void P_EpisodeForMap(const char *mapname, char episode[9])
+{
+   size_t len = 0;
+
+   while(len < 8 && mapname[len])
+      ++len;
+
+   if(ectype::toUpper(mapname[0]) == 'E' && ectype::isDigit(mapname[1]) &&
+      ectype::toUpper(mapname[2]) == 'M' && ectype::isDigit(mapname[3]))
+      len = 2;
+   else
+   {
+      while(len > 1 && ectype::isDigit(mapname[len - 1]))
+         --len;
+   }
+
+   memcpy(episode, mapname, len);
+   episode[len] = '\0';
+}
+
+// EOF
+
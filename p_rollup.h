@@ -0,0 +1,87 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Thing count totals over several levels
+//
+//-----------------------------------------------------------------------------
+
+#ifndef P_ROLLUP_H__
+#define P_ROLLUP_H__
+
+#include "p_report.h"
+
+// Levels of aggregation, for -rollup
+enum
+{
+   ROLLUP_MAP     = 0x01, // each level's own tables
+   ROLLUP_EPISODE = 0x02, // levels of an archive sharing a name prefix
+   ROLLUP_ARCHIVE = 0x04, // all levels of an archive
+   ROLLUP_CORPUS  = 0x08  // all levels of all archives
+};
+
+//
+// One thing type's counts within one table. The key orders entries by game
+// type, then player class, then DoomEd number.
+//
+struct rollupentry_t
+{
+   uint32_t key;
+   int      counts[NUM_SKILLS];
+};
+
+//
+// RollupTally
+//
+// Thing counts for every table of one or more levels, kept as an array
+// sorted by key so that two tallies can be merged in a single pass. Storage
+// comes from malloc, not the zone, as merging is done by worker threads.
+//
+class RollupTally
+{
+protected:
+   rollupentry_t *entries;
+   size_t         numentries;
+   size_t         numalloc;
+
+public:
+   RollupTally() : entries(NULL), numentries(0), numalloc(0) {}
+   ~RollupTally();
+
+   void add(int gametype, int pclass, int doomednum, const int counts[NUM_SKILLS]);
+   void sort();
+   void mergeFrom(RollupTally &other);
+
+   size_t               getNumEntries() const { return numentries; }
+   const rollupentry_t &getEntry(size_t i) const { return entries[i]; }
+
+   static int KeyTable(uint32_t key);
+   static int KeyGameType(uint32_t key);
+   static int KeyPClass(uint32_t key);
+   static int KeyDoomEdNum(uint32_t key);
+};
+
+RollupTally *P_ReduceTallies(RollupTally **tallies, int numtallies, int numthreads);
+void P_EpisodeForMap(const char *mapname, char episode[9]);
+
+#endif
+
+// EOF
+
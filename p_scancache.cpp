@@ -0,0 +1,512 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Cache of the counts of unchanged archives
+//
+//-----------------------------------------------------------------------------
+
+#include <sys/stat.h>
+
+#include "z_zone.h"
+#include "m_binary.h"
+#include "m_buffer.h"
+#include "p_scancache.h"
+
+static const char scanMagic[4] = { 'T', 'C', 'S', 'C' };
+
+// Size of an entry without its path and tallies
+#define SCANCACHE_ENTRYSIZE (4 + 4 * 8 + 4)
+
+#define SC_read32(p) read32_le((p), uint32_t)
+#define SC_read64(p) (SC_read32(p) | (static_cast<uint64_t>(SC_read32((p) + 4)) << 32))
+
+//
+// P_ScanFileID
+//
+// Get the identity of an archive file. Returns false if it cannot be found.
+//
+bool P_ScanFileID(const char *filename, scanfileid_t &id)
+{
+   struct stat sbuf;
+   uint64_t    nsec = 0;
+
+   if(stat(filename, &sbuf))
+      return false;
+
+#ifdef __linux__
+   nsec = static_cast<uint64_t>(sbuf.st_mtim.tv_nsec);
+#endif
+   id.device = static_cast<uint64_t>(sbuf.st_dev);
+   id.inode  = static_cast<uint64_t>(sbuf.st_ino);
+   id.size   = static_cast<uint64_t>(sbuf.st_size);
+   id.mtime  = static_cast<uint64_t>(sbuf.st_mtime) * 1000000000 + nsec;
+   return true;
+}
+
+static bool P_sameFileID(const scanfileid_t &a, const scanfileid_t &b)
+{
+   return a.device == b.device && a.inode == b.inode && a.size == b.size &&
+          a.mtime == b.mtime;
+}
+
+//=============================================================================
+//
+// Recording Tallies
+//
+
+void ScanRecord::addVarint(uint64_t num)
+{
+   while(num >= 0x80)
+   {
+      data.add(static_cast<byte>(num | 0x80));
+      num >>= 7;
+   }
+   data.add(static_cast<byte>(num));
+}
+
+//
+// ScanRecord::beginLevel
+//
+void ScanRecord::beginLevel(const char *mapname)
+{
+   size_t len = strlen(mapname);
+
+   for(size_t i = 0; i < 8; i++)
+      data.add(i < len ? static_cast<byte>(mapname[i]) : 0);
+   inlevel = true;
+}
+
+//
+// ScanRecord::beginTable
+//
+// numtypes of addType must follow.
+//
+void ScanRecord::beginTable(int gametype, int pclass, int numtypes)
+{
+   addVarint(static_cast<uint64_t>(gametype + 1));
+   addVarint(static_cast<uint64_t>(pclass + 1));
+   addVarint(static_cast<uint64_t>(numtypes));
+}
+
+//
+// ScanRecord::addType
+//
+void ScanRecord::addType(int doomednum, const int counts[NUM_SKILLS])
+{
+   uint32_t den = static_cast<uint32_t>(doomednum);
+
+   addVarint((den << 1) ^ (doomednum < 0 ? 0xffffffffu : 0));
+   for(int s = 0; s < NUM_SKILLS; s++)
+      addVarint(static_cast<uint64_t>(counts[s]));
+}
+
+//
+// ScanRecord::endLevel
+//
+void ScanRecord::endLevel()
+{
+   if(inlevel)
+      data.add(0);
+   inlevel = false;
+}
+
+//=============================================================================
+//
+// Reading Tallies
+//
+
+uint64_t ScanReader::readVarint()
+{
+   uint64_t num   = 0;
+   int      shift = 0;
+
+   while(p < end && shift < 64)
+   {
+      byte b = *p++;
+      num |= static_cast<uint64_t>(b & 0x7f) << shift;
+      if(!(b & 0x80))
+         return num;
+      shift += 7;
+   }
+
+   // out of data, or too long; validate rules this out
+   p = end;
+   return 0;
+}
+
+//
+// ScanReader::validate
+//
+// Check that tallies can be read to the end without running out, and that
+// every value is in range.
+//
+bool ScanReader::validate(const byte *data, size_t size)
+{
+   ScanReader reader(data, size);
+
+   while(!reader.atEnd())
+   {
+      if(reader.end - reader.p < 8)
+         return false;
+      reader.p += 8;
+
+      for(;;)
+      {
+         if(reader.atEnd())
+            return false;
+
+         uint64_t gametype = reader.readVarint();
+         if(!gametype)
+            break;
+
+         uint64_t pclass   = reader.readVarint();
+         uint64_t numtypes = reader.readVarint();
+         if(gametype > NUM_GAME_TYPES || pclass > NUM_CLASSES ||
+            numtypes > static_cast<uint64_t>(reader.end - reader.p))
+            return false;
+
+         for(uint64_t i = 0; i < numtypes; i++)
+         {
+            if(reader.atEnd() || reader.readVarint() > 0xffffffffu)
+               return false;
+            for(int s = 0; s < NUM_SKILLS; s++)
+            {
+               if(reader.atEnd() || reader.readVarint() > INT_MAX)
+                  return false;
+            }
+         }
+      }
+   }
+
+   return true;
+}
+
+//
+// ScanReader::readLevel
+//
+void ScanReader::readLevel(char mapname[9])
+{
+   memcpy(mapname, p, 8);
+   mapname[8] = '\0';
+   p += 8;
+}
+
+//
+// ScanReader::readTable
+//
+// Returns false at the end of the level's tables.
+//
+bool ScanReader::readTable(int &gametype, int &pclass, int &numtypes)
+{
+   uint64_t value;
+
+   if(!(value = readVarint()))
+      return false;
+
+   gametype = static_cast<int>(value) - 1;
+   pclass   = static_cast<int>(readVarint()) - 1;
+   numtypes = static_cast<int>(readVarint());
+   return true;
+}
+
+//
+// ScanReader::readType
+//
+void ScanReader::readType(int &doomednum, int counts[NUM_SKILLS])
+{
+   uint32_t den = static_cast<uint32_t>(readVarint());
+
+   doomednum = static_cast<int>((den >> 1) ^ (0u - (den & 1)));
+   for(int s = 0; s < NUM_SKILLS; s++)
+      counts[s] = static_cast<int>(readVarint());
+}
+
+//=============================================================================
+//
+// The Cache
+//
+
+//
+// ScanCache::clear
+//
+// Forget every entry.
+//
+void ScanCache::clear()
+{
+   scanentry_t *entry;
+
+   while((entry = entries.tableIterator(static_cast<scanentry_t *>(NULL))))
+   {
+      entries.removeObject(entry);
+      efree(const_cast<char *>(entry->path));
+      if(entry->owned)
+         efree(entry->owned);
+      efree(entry);
+   }
+}
+
+//
+// ScanCache Destructor
+//
+ScanCache::~ScanCache()
+{
+   clear();
+   entries.destroy();
+}
+
+//
+// ScanCache::addEntry
+//
+void ScanCache::addEntry(const char *path, const scanfileid_t &id,
+                         const byte *data, size_t size)
+{
+   scanentry_t *entry;
+
+   if(!(entry = entries.objectForKey(path)))
+   {
+      entry = estructalloc(scanentry_t, 1);
+      entry->path = estrdup(path);
+      entries.addObject(entry);
+      if(entries.getLoadFactor() > 2.0f)
+         entries.rebuild(entries.getNumChains() * 2 + 1);
+   }
+   else if(entry->owned)
+   {
+      efree(entry->owned);
+      entry->owned = NULL;
+   }
+
+   entry->id   = id;
+   entry->data = data;
+   entry->size = size;
+}
+
+//
+// ScanCache::load
+//
+// Read the entries of the cache file. Returns false if it is not a cache
+// made with the same options, or is damaged; nothing is used from it then.
+//
+bool ScanCache::load()
+{
+   const byte *data = file.getData();
+   size_t      size = file.getSize();
+   size_t      optlen;
+   qstring     path;
+
+   if(size < 12 || memcmp(data, scanMagic, 4) ||
+      SC_read32(data + 4) != SCANCACHE_VERSION)
+      return false;
+
+   optlen = SC_read32(data + 8);
+   if(optlen != options.length() || size - 12 < optlen ||
+      memcmp(data + 12, options.constPtr(), optlen))
+      return false;
+
+   for(size_t pos = 12 + optlen; pos < size; )
+   {
+      size_t       pathlen, talliessize;
+      scanfileid_t id;
+
+      if(size - pos < SCANCACHE_ENTRYSIZE)
+         return false;
+      pathlen = SC_read32(data + pos);
+      if(!pathlen || size - pos - SCANCACHE_ENTRYSIZE < pathlen)
+         return false;
+      path.copy(reinterpret_cast<const char *>(data + pos + 4), pathlen);
+      pos += 4 + pathlen;
+
+      id.device   = SC_read64(data + pos);
+      id.inode    = SC_read64(data + pos + 8);
+      id.size     = SC_read64(data + pos + 16);
+      id.mtime    = SC_read64(data + pos + 24);
+      talliessize = SC_read32(data + pos + 32);
+      pos += 36;
+
+      if(size - pos < talliessize || path.length() != pathlen)
+         return false;
+
+      addEntry(path.constPtr(), id, data + pos, talliessize);
+      pos += talliessize;
+   }
+
+   return true;
+}
+
+//
+// ScanCache::open
+//
+// Use the cache file, which need not exist yet, for a run with the given
+// options. Entries are only used by a run with the same options.
+//
+void ScanCache::open(const char *pFilename, const char *pOptions)
+{
+   filename = pFilename;
+   options  = pOptions;
+   isopen   = true;
+
+   // a bad cache is started over, and replaced when it is saved
+   if(file.open(pFilename) && !load())
+   {
+      clear();
+      file.close();
+   }
+}
+
+//
+// ScanCache::close
+//
+// Forget the cache without saving it.
+//
+void ScanCache::close()
+{
+   clear();
+   file.close();
+   isopen = false;
+}
+
+//
+// ScanCache::find
+//
+// Get the tallies of an archive, if it has not changed since they were
+// recorded. Tallies should still be validated before they are used.
+//
+bool ScanCache::find(const char *path, const scanfileid_t &id, const byte *&data,
+                     size_t &size)
+{
+   scanentry_t *entry;
+
+   if(!(entry = entries.objectForKey(path)) || !P_sameFileID(entry->id, id))
+      return false;
+
+   entry->seen = true;
+   data = entry->data;
+   size = entry->size;
+   return true;
+}
+
+//
+// ScanCache::store
+//
+// Keep the tallies of an archive, which had the given identity before it
+// was read.
+//
+void ScanCache::store(const char *path, const scanfileid_t &id,
+                      const ScanRecord &record)
+{
+   size_t size  = record.getSize();
+   byte  *owned = emalloc(byte *, size ? size : 1);
+
+   if(size)
+      memcpy(owned, record.getData(), size);
+   addEntry(path, id, owned, size);
+
+   scanentry_t *entry = entries.objectForKey(path);
+   entry->owned = owned;
+   entry->seen  = true;
+}
+
+//
+// ScanCache::save
+//
+// Write the cache out. Archives not seen during this run are kept as long
+// as they are unchanged. The file is written under a temporary name and
+// then renamed, so that it is never left half written. The cache is closed
+// afterward. Returns false if it could not be written.
+//
+bool ScanCache::save()
+{
+   qstring   tempname;
+   OutBuffer out;
+   bool      ok = true;
+
+   tempname << filename << ".tmp";
+   if(!out.CreateFile(tempname.constPtr(), 64 * 1024, BufferedFileBase::LENDIAN))
+   {
+      close();
+      return false;
+   }
+
+   try
+   {
+      scanentry_t *entry = NULL;
+      scanfileid_t id;
+
+      out.setThrowing(true);
+
+      out.Write(scanMagic, sizeof(scanMagic));
+      out.WriteUint32(SCANCACHE_VERSION);
+      out.WriteUint32(static_cast<uint32_t>(options.length()));
+      out.Write(options.constPtr(), options.length());
+
+      while((entry = entries.tableIterator(entry)))
+      {
+         if(!entry->seen && (!P_ScanFileID(entry->path, id) ||
+                             !P_sameFileID(entry->id, id)))
+            continue;
+
+         size_t pathlen = strlen(entry->path);
+         out.WriteUint32(static_cast<uint32_t>(pathlen));
+         out.Write(entry->path, pathlen);
+         out.WriteUint32(static_cast<uint32_t>(entry->id.device));
+         out.WriteUint32(static_cast<uint32_t>(entry->id.device >> 32));
+         out.WriteUint32(static_cast<uint32_t>(entry->id.inode));
+         out.WriteUint32(static_cast<uint32_t>(entry->id.inode >> 32));
+         out.WriteUint32(static_cast<uint32_t>(entry->id.size));
+         out.WriteUint32(static_cast<uint32_t>(entry->id.size >> 32));
+         out.WriteUint32(static_cast<uint32_t>(entry->id.mtime));
+         out.WriteUint32(static_cast<uint32_t>(entry->id.mtime >> 32));
+         out.WriteUint32(static_cast<uint32_t>(entry->size));
+         if(entry->size)
+            out.Write(entry->data, entry->size);
+      }
+
+      out.Flush();
+      out.Close();
+   }
+   catch(const BufferedIOException &)
+   {
+      out.Close();
+      remove(tempname.constPtr());
+      ok = false;
+   }
+
+   // entries may point into the old file, which has to be closed before it
+   // is replaced
+   close();
+   if(!ok)
+      return false;
+
+   // rename does not replace an existing file everywhere
+   if(rename(tempname.constPtr(), filename.constPtr()))
+   {
+      remove(filename.constPtr());
+      if(rename(tempname.constPtr(), filename.constPtr()))
+      {
+         remove(tempname.constPtr());
+         return false;
+      }
+   }
+
+   return true;
+}
+
+// EOF
@@ -0,0 +1,175 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Cache of the counts of unchanged archives
+//
+//-----------------------------------------------------------------------------
+
+#ifndef P_SCANCACHE_H__
+#define P_SCANCACHE_H__
+
+#include "e_hash.h"
+#include "e_hashkeys.h"
+#include "m_collection.h"
+#include "m_dllist.h"
+#include "m_mapfile.h"
+#include "m_qstr.h"
+#include "p_report.h"
+
+//
+// Scan cache layout
+//
+// All values are little-endian:
+//
+//    header   "TCSC", version, length of the options, then the options text
+//    entries  one per archive, to the end of the file:
+//                uint32 length of the path, then the path
+//                uint64 device, inode, size, modification time in ns
+//                uint32 size of the tallies, then the tallies
+//
+// The tallies are the archive's levels in order. Each is an 8-byte map
+// name, then its tables, each of which is:
+//
+//    varint  game type + 1 (a 0 instead ends the level's tables)
+//    varint  player class + 1
+//    varint  number of thing types, then for each:
+//    varint  DoomEd number, zigzag-encoded
+//    varint  count on each skill
+//
+// Thing types are in the order the table was output in. Varints are stored
+// 7 bits at a time, least significant first, with the top bit set on all
+// but the last byte.
+//
+
+#define SCANCACHE_VERSION 1
+
+// Identity of an archive file; any change to it means it has to be read again
+struct scanfileid_t
+{
+   uint64_t device;
+   uint64_t inode;
+   uint64_t size;
+   uint64_t mtime; // in nanoseconds
+};
+
+bool P_ScanFileID(const char *filename, scanfileid_t &id);
+
+//
+// ScanRecord
+//
+// Builds the tallies of one archive as its levels are output.
+//
+class ScanRecord
+{
+protected:
+   PODCollection<byte> data;
+   bool                inlevel;
+
+   void addVarint(uint64_t num);
+
+public:
+   ScanRecord() : data(), inlevel(false) {}
+
+   void clear() { data.makeEmpty(); inlevel = false; }
+   void beginLevel(const char *mapname);
+   void beginTable(int gametype, int pclass, int numtypes);
+   void addType(int doomednum, const int counts[NUM_SKILLS]);
+   void endLevel();
+
+   const byte *getData() const { return data.getLength() ? &data[0] : NULL; }
+   size_t      getSize() const { return data.getLength(); }
+};
+
+//
+// ScanReader
+//
+// Reads tallies in the order they were recorded. Tallies should be
+// checked with validate before anything else is read from them.
+//
+class ScanReader
+{
+protected:
+   const byte *p;
+   const byte *end;
+
+   uint64_t readVarint();
+
+public:
+   ScanReader(const byte *data, size_t size) : p(data), end(data + size) {}
+
+   static bool validate(const byte *data, size_t size);
+
+   bool atEnd() const { return p == end; }
+   void readLevel(char mapname[9]);
+   bool readTable(int &gametype, int &pclass, int &numtypes);
+   void readType(int &doomednum, int counts[NUM_SKILLS]);
+};
+
+struct scanentry_t
+{
+   DLListItem<scanentry_t> links;
+   const char  *path;
+   scanfileid_t id;
+   const byte  *data;  // tallies, in the cache file or owned
+   size_t       size;
+   byte        *owned; // tallies recorded this run
+   bool         seen;  // found or stored this run
+};
+
+typedef EHashTable<scanentry_t, EStringHashKey,
+                   &scanentry_t::path, &scanentry_t::links> scanhash_t;
+
+//
+// ScanCache
+//
+// Tallies of archives by path, good for as long as the archive's identity
+// stays the same. A cache made with other options is not used.
+//
+class ScanCache
+{
+protected:
+   MappedFile  file;
+   scanhash_t  entries;
+   qstring     filename;
+   qstring     options;
+   bool        isopen;
+
+   void clear();
+   void addEntry(const char *path, const scanfileid_t &id, const byte *data,
+                 size_t size);
+   bool load();
+
+public:
+   ScanCache() : file(), entries(), filename(), options(), isopen(false) {}
+   ~ScanCache();
+
+   void open(const char *pFilename, const char *pOptions);
+   void close();
+   bool isOpen() const { return isopen; }
+   bool find(const char *path, const scanfileid_t &id, const byte *&data,
+             size_t &size);
+   void store(const char *path, const scanfileid_t &id, const ScanRecord &record);
+   bool save();
+};
+
+#endif
+
+// EOF
@@ -0,0 +1,304 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Statistics of thing counts per level
+//
+//-----------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "z_zone.h"
+#include "m_collection.h"
+#include "p_report.h"
+#include "p_stats.h"
+#include "p_thingtypes.h"
+
+// Bits of a key below the table number
+#define STATS_TABLESHIFT 16
+
+// DoomEd numbers are 16-bit signed values; this offset makes them sort in
+// order as unsigned ones
+#define STATS_DENBIAS 32768
+
+// Quantiles reported
+#define STATS_P50 0.50
+#define STATS_P90 0.90
+#define STATS_P99 0.99
+
+static int ST_keyForType(int table, int doomednum)
+{
+   return (table << STATS_TABLESHIFT) | ((doomednum + STATS_DENBIAS) & 0xffff);
+}
+
+static int ST_keyForClass(int table, int classtype)
+{
+   return (table << STATS_TABLESHIFT) | classtype;
+}
+
+//
+// ThingStats Constructor
+//
+ThingStats::ThingStats()
+   : types(), classes(), curtable(-1)
+{
+   memset(numlevels, 0, sizeof(numlevels));
+   memset(classcounts, 0, sizeof(classcounts));
+   memset(classpresent, 0, sizeof(classpresent));
+}
+
+//
+// ThingStats Destructor
+//
+ThingStats::~ThingStats()
+{
+   DestroyEntries(types);
+   DestroyEntries(classes);
+}
+
+//
+// ThingStats::EntryForKey
+//
+// Find or create an entry.
+//
+statsentry_t *ThingStats::EntryForKey(statshash_t &hash, int key, int doomednum,
+                                      int classtype)
+{
+   statsentry_t *entry;
+
+   if(!(entry = hash.objectForKey(key)))
+   {
+      entry = new statsentry_t;
+      entry->key       = key;
+      entry->doomednum = doomednum;
+      entry->classtype = classtype;
+      hash.addObject(entry);
+
+      if(hash.getLoadFactor() > 2.0f)
+         hash.rebuild(hash.getNumChains() * 2 + 1);
+   }
+
+   return entry;
+}
+
+//
+// ThingStats::DestroyEntries
+//
+void ThingStats::DestroyEntries(statshash_t &hash)
+{
+   PODCollection<statsentry_t *> entries;
+   statsentry_t *entry = NULL;
+
+   while((entry = hash.tableIterator(entry)))
+      entries.add(entry);
+   for(statsentry_t *e : entries)
+      delete e;
+   hash.destroy();
+}
+
+//
+// ThingStats::beginTable
+//
+// Start feeding in one table of a level.
+//
+void ThingStats::beginTable(int gametype, int pclass)
+{
+   curtable = P_ReportTable(gametype, pclass);
+   ++numlevels[curtable];
+
+   memset(classcounts, 0, sizeof(classcounts));
+   memset(classpresent, 0, sizeof(classpresent));
+}
+
+//
+// ThingStats::addCount
+//
+// Add the counts of one thing type in the current table.
+//
+void ThingStats::addCount(int doomednum, int classtype, const int counts[NUM_SKILLS])
+{
+   statsentry_t *entry = EntryForKey(types, ST_keyForType(curtable, doomednum),
+                                     doomednum, classtype);
+
+   for(int i = 0; i < NUM_SKILLS; i++)
+   {
+      entry->sketches[i].add(counts[i]);
+      classcounts[classtype][i] += counts[i];
+   }
+   classpresent[classtype] = true;
+}
+
+//
+// ThingStats::endTable
+//
+// Finish a table, adding up the counts of each thing class in it.
+//
+void ThingStats::endTable()
+{
+   for(int c = 0; c < CLASS_MAX; c++)
+   {
+      if(!classpresent[c])
+         continue;
+
+      statsentry_t *entry = EntryForKey(classes, ST_keyForClass(curtable, c), 0, c);
+      for(int i = 0; i < NUM_SKILLS; i++)
+         entry->sketches[i].add(classcounts[c][i]);
+   }
+
+   curtable = -1;
+}
+
+//
+// ThingStats::merge
+//
+// Add all the statistics from another set to this one. The other set is
+// unchanged.
+//
+void ThingStats::merge(ThingStats &other)
+{
+   statshash_t *hashes[2]  = { &other.types, &other.classes };
+   statshash_t *targets[2] = { &types, &classes };
+
+   for(int h = 0; h < 2; h++)
+   {
+      statsentry_t *entry = NULL;
+
+      while((entry = hashes[h]->tableIterator(entry)))
+      {
+         statsentry_t *mine = EntryForKey(*targets[h], entry->key,
+                                          entry->doomednum, entry->classtype);
+         for(int i = 0; i < NUM_SKILLS; i++)
+            mine->sketches[i].merge(entry->sketches[i]);
+      }
+   }
+
+   for(int t = 0; t < NUM_REPORT_TABLES; t++)
+      numlevels[t] += other.numlevels[t];
+}
+
+//
+// ThingStats::isEmpty
+//
+bool ThingStats::isEmpty() const
+{
+   for(int t = 0; t < NUM_REPORT_TABLES; t++)
+   {
+      if(numlevels[t])
+         return false;
+   }
+   return true;
+}
+
+//
+// ThingStats::outputEntry
+//
+// Levels where the entry's thing type or class was absent are counted as
+// zeroes first, so this can only be done once.
+//
+void ThingStats::outputEntry(ReportFormatter &formatter, statsentry_t &entry,
+                             bool isclass)
+{
+   unsigned int levels = numlevels[entry.key >> STATS_TABLESHIFT];
+   statsrow_t   row;
+
+   row.doomednum = entry.doomednum;
+   row.classtype = entry.classtype;
+   row.numlevels = levels;
+   row.name      = NULL;
+   if(!isclass)
+   {
+      const thingtype_t *type = P_ThingTypeForDEN(entry.doomednum);
+      row.name = type ? P_NameForThingType(type) : "Unknown";
+   }
+
+   for(int i = 0; i < NUM_SKILLS; i++)
+   {
+      QuantileSketch &sketch = entry.sketches[i];
+      statsvalues_t  &sv     = row.skills[i];
+
+      if(sketch.getCount() < levels)
+         sketch.add(0, levels - sketch.getCount());
+
+      sv.mean = sketch.getMean();
+      sv.min  = sketch.getMinimum();
+      sv.max  = sketch.getMaximum();
+      sv.p50  = sketch.quantile(STATS_P50);
+      sv.p90  = sketch.quantile(STATS_P90);
+      sv.p99  = sketch.quantile(STATS_P99);
+   }
+
+   formatter.statsRow(row);
+}
+
+//
+// ThingStats::output
+//
+// Output the statistics of every table any level had: for each thing class,
+// the class totals and then each thing type in it, in DoomEd number order.
+//
+void ThingStats::output(ReportFormatter &formatter)
+{
+   PODCollection<statsentry_t *> sorted;
+   statsentry_t *entry = NULL;
+
+   while((entry = types.tableIterator(entry)))
+      sorted.add(entry);
+   std::sort(sorted.begin(), sorted.end(),
+             [] (const statsentry_t *a, const statsentry_t *b) { return a->key < b->key; });
+
+   formatter.beginStats();
+
+   size_t first = 0; // first type in the current table
+   for(int t = 0; t < NUM_REPORT_TABLES; t++)
+   {
+      size_t end = first;
+      while(end < sorted.getLength() && (sorted[end]->key >> STATS_TABLESHIFT) == t)
+         ++end;
+
+      if(numlevels[t])
+      {
+         formatter.beginTable(P_TableGameType(t), P_TablePClass(t));
+         for(int c = 0; c < CLASS_MAX; c++)
+         {
+            statsentry_t *classentry;
+
+            if(!(classentry = classes.objectForKey(ST_keyForClass(t, c))))
+               continue;
+
+            formatter.beginClass(c);
+            outputEntry(formatter, *classentry, true);
+            for(size_t i = first; i < end; i++)
+            {
+               if(sorted[i]->classtype == c)
+                  outputEntry(formatter, *sorted[i], false);
+            }
+            formatter.endClass();
+         }
+         formatter.endTable();
+      }
+
+      first = end;
+   }
+
+   formatter.endStats();
+}
+
+// EOF
+
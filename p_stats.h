@@ -0,0 +1,99 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Statistics of thing counts per level
+//
+//-----------------------------------------------------------------------------
+
+#ifndef P_STATS_H__
+#define P_STATS_H__
+
+#include "e_hash.h"
+#include "e_hashkeys.h"
+#include "m_dllist.h"
+#include "m_sketch.h"
+#include "p_report.h"
+#include "p_thingtypes.h"
+
+class ReportFormatter;
+
+//
+// Sketches of the counts per level of one thing type, or of all things in
+// one class, in one table
+//
+struct statsentry_t
+{
+   DLListItem<statsentry_t> links;
+   int            key;       // table, and DoomEd number or thing class
+   int            doomednum;
+   int            classtype;
+   QuantileSketch sketches[NUM_SKILLS];
+};
+
+typedef EHashTable<statsentry_t, EIntHashKey,
+                   &statsentry_t::key, &statsentry_t::links> statshash_t;
+
+//
+// ThingStats
+//
+// Summarizes thing counts per level, per thing type and per thing class, on
+// each skill level. Each level's counts are fed in as it is tabulated, and
+// only the sketches are kept, so memory does not grow with the number of
+// levels. Sets of statistics from separate runs of levels can be merged.
+//
+// A level which has a table, but none of a thing type in it, counts as
+// having zero of that type.
+//
+class ThingStats
+{
+protected:
+   statshash_t  types;
+   statshash_t  classes;
+   unsigned int numlevels[NUM_REPORT_TABLES];
+
+   // the table being fed in
+   int  curtable;
+   int  classcounts[CLASS_MAX][NUM_SKILLS];
+   bool classpresent[CLASS_MAX];
+
+   static statsentry_t *EntryForKey(statshash_t &hash, int key, int doomednum,
+                                    int classtype);
+   static void          DestroyEntries(statshash_t &hash);
+   void                 outputEntry(ReportFormatter &formatter, statsentry_t &entry,
+                                    bool isclass);
+
+public:
+   ThingStats();
+   ~ThingStats();
+
+   void beginTable(int gametype, int pclass);
+   void addCount(int doomednum, int classtype, const int counts[NUM_SKILLS]);
+   void endTable();
+
+   void merge(ThingStats &other);
+   bool isEmpty() const;
+   void output(ReportFormatter &formatter);
+};
+
+#endif
+
+// EOF
+
@@ -23,45 +23,30 @@
 //
 //-----------------------------------------------------------------------------
 
+#include <thread>
+
 #include "z_zone.h"
 #include "z_auto.h"
 #include "e_hash.h"
 #include "e_hashkeys.h"
+#include "i_system.h"
+#include "m_asyncbuf.h"
+#include "m_gzbuf.h"
 #include "m_binary.h"
+#include "m_collection.h"
+#include "m_textbuf.h"
+#include "p_compat.h"
+#include "p_report.h"
+#include "p_results.h"
+#include "p_rollup.h"
+#include "p_scancache.h"
+#include "p_stats.h"
+#include "p_things.h"
 #include "p_thingtypes.h"
+#include "p_udmf.h"
 #include "w_levels.h"
 #include "w_wad.h"
 
-// DOOM mapthing flags
-#define MTF_EASY        1
-#define MTF_NORMAL      2
-#define MTF_HARD        4
-#define MTF_AMBUSH      8
-#define MTF_NOTSINGLE  16
-#define MTF_NOTDM      32
-#define MTF_NOTCOOP    64
-#define MTF_FRIEND    128
-#define MTF_RESERVED  256
-
-// PSX flags
-#define MTF_PSX_GHOST      32         // 50% transparent monster
-#define MTF_PSX_ADDITIVE  (32|64)     // 100% additive monster
-#define MTF_PSX_NIGHTMARE (32|128)    // subtractive w/2x spawn health
-#define MTF_PSX_SPECTRE   (32|64|128) // 25% additive monster
-
-// Hexen mapthing flags
-#define MTF_HX_EASY           1
-#define MTF_HX_NORMAL         2
-#define MTF_HX_HARD           4
-#define MTF_HX_AMBUSH         8
-#define MTF_HX_DORMANT       16
-#define MTF_HX_FIGHTER       32
-#define MTF_HX_CLERIC        64
-#define MTF_HX_MAGE         128
-#define MTF_HX_GSINGLE      256
-#define MTF_HX_GCOOP        512
-#define MTF_HX_GDEATHMATCH 1024
-
 struct mapthing_t
 {
    int16_t tid;     // scripting id
@@ -75,56 +60,127 @@ struct mapthing_t
    int     args[5]; // arguments for special
 };
 
-static mapthing_t *things;
-static int         numthings;
-static int         levelformat;
+// Things of the level being output
+static levelthings_t levelthings;
+
+// Each level's report is built here and written out in one piece
+static TextBuffer  reportbuf;
+
+// Selected output format, and where it goes
+static ReportFormatter *formatter;
+static FILE            *reportfile;
+static OutBuffer       *reportout;
+static bool             reportasync; // reportout has its own writer thread
+
+// Asynchronous output is split into this many buffers
+#define NUM_ASYNCBUFFERS 4
+
+// Most threads to compress gzip output with
+#define MAX_GZIPWORKERS 8
+
+// Levels of aggregation to output, and threads to merge tallies with
+static int rolluplevels = ROLLUP_MAP;
+static int rollupthreads = 1;
+
+// An episode of the current archive, and the tallies of its levels
+struct rollupepisode_t
+{
+   char                        name[9];
+   PODCollection<RollupTally *> *maps;
+};
+
+static RollupTally                   *maptally;       // level being tabulated
+static PODCollection<rollupepisode_t> episodes;       // of the current archive
+static PODCollection<RollupTally *>   archivetallies; // for ROLLUP_CORPUS
+static bool                           archivefailed;
+
+// Statistics of the current archive, and of all archives so far, for -stats
+static bool        wantstats;
+static ThingStats *archivestats;
+static ThingStats *corpusstats;
+
+// Counts of the table being output, by skill and dense thingtype index, for
+// weighting by thingtype attributes with -attributes
+static bool wantsums;
+static int *densecounts[NUM_SKILLS];
+static int  numdensecounts;
+
+// Where the tallies of the levels being output are recorded, if anywhere
+static ScanRecord *scanrecord;
+
+//
+// Make room in the dense counts for every thingtype index in use. DeHackEd
+// changes can add thingtypes.
+//
+static void P_reserveDenseCounts()
+{
+   int numtypes = P_NumThingTypes();
+
+   if(numtypes <= numdensecounts)
+      return;
+
+   for(int s = 0; s < NUM_SKILLS; s++)
+   {
+      densecounts[s] = erealloc(int *, densecounts[s], (numtypes + 1) * sizeof(int));
+      memset(densecounts[s] + numdensecounts, 0,
+             (numtypes + 1 - numdensecounts) * sizeof(int));
+   }
+   numdensecounts = numtypes;
+}
+
+//
+// Pass the report text built so far on to the output. Synchronous output is
+// written straight away, so that it stays in order with anything else
+// printed to the console.
+//
+static void P_writeReport()
+{
+   reportbuf.writeTo(*reportout);
+   if(!reportasync)
+      reportout->Flush();
+}
 
 //
 // Load DOOM things
 //
-static void P_loadDoomThings(wadlevel_t &wl)
+static void P_loadDoomThings(wadlevel_t &wl, levelthings_t &lt)
 {
    int lumpnum = wl.lumpnum + ML_THINGS;
    ZAutoBuffer thinglump;
    wl.dir->cacheLumpAuto(lumpnum, thinglump);
 
-   numthings = wl.dir->lumpLength(lumpnum) / 10;
-   things    = estructalloc(mapthing_t, numthings);
+   lt.numthings = wl.dir->lumpLength(lumpnum) / 10;
+   lt.things    = estructalloc(mapthing_t, lt.numthings);
 
    byte *rover = thinglump.getAs<byte *>();
-   for(int i = 0; i < numthings; i++)
+   for(int i = 0; i < lt.numthings; i++)
    {
-      mapthing_t *ft = &things[i];
+      mapthing_t *ft = &lt.things[i];
 
       ft->x       = GetBinaryWord(&rover);
       ft->y       = GetBinaryWord(&rover);
       ft->angle   = GetBinaryWord(&rover);
       ft->type    = GetBinaryWord(&rover);
       ft->options = GetBinaryWord(&rover);
-
-      // remove extended BOOM flags if MTF_RESERVED is set, due to
-      // Hellmaker levels
-      if(ft->options & MTF_RESERVED)
-         ft->options &= ~(MTF_NOTDM|MTF_NOTCOOP|MTF_FRIEND);
    }
 }
 
 //
 // Load Hexen things
 //
-static void P_loadHexenThings(wadlevel_t &wl)
+static void P_loadHexenThings(wadlevel_t &wl, levelthings_t &lt)
 {
    int lumpnum = wl.lumpnum + ML_THINGS;
    ZAutoBuffer thinglump;
    wl.dir->cacheLumpAuto(lumpnum, thinglump);
 
-   numthings = wl.dir->lumpLength(lumpnum) / 20;
-   things    = estructalloc(mapthing_t, numthings);
+   lt.numthings = wl.dir->lumpLength(lumpnum) / 20;
+   lt.things    = estructalloc(mapthing_t, lt.numthings);
 
    byte *rover = thinglump.getAs<byte *>();
-   for(int i = 0; i < numthings; i++)
+   for(int i = 0; i < lt.numthings; i++)
    {
-      mapthing_t *ft = &things[i];
+      mapthing_t *ft = &lt.things[i];
 
       ft->tid     = GetBinaryWord(&rover);
       ft->x       = GetBinaryWord(&rover);
@@ -140,186 +196,214 @@ static void P_loadHexenThings(wadlevel_t &wl)
 }
 
 //
-// Load the THINGS lump for a Doom engine map
+// Load UDMF things, translating their flags into options for the level's
+// compat profile
 //
-void P_LoadThings(wadlevel_t &wl)
+static void P_loadUDMFThings(wadlevel_t &wl, levelthings_t &lt)
 {
-   if(things)
+   udmfmap_t map;
+   P_ScanUDMFThings(wl, map);
+
+   lt.compat = P_CompatForUDMF(map.nspace);
+
+   lt.numthings = static_cast<int>(map.things.getLength());
+   lt.things    = estructalloc(mapthing_t, lt.numthings);
+
+   for(int i = 0; i < lt.numthings; i++)
    {
-      efree(things);
-      things = nullptr;
+      mapthing_t *ft = &lt.things[i];
+
+      ft->type    = map.things[i].type;
+      ft->options = P_CompatUDMFOptions(lt.compat, map.things[i].flags);
    }
+}
 
-   levelformat = wl.fmt;
+//
+// Load the THINGS lump for a Doom engine map into lt, replacing whatever was
+// loaded into it before. Unsupported formats leave it without things.
+//
+void P_LoadLevelThings(wadlevel_t &wl, levelthings_t &lt)
+{
+   P_FreeLevelThings(lt);
+
+   lt.compat = P_CompatForLevel(wl.fmt);
 
    switch(wl.fmt)
    {
    case LEVEL_FORMAT_DOOM:
    case LEVEL_FORMAT_PSX:
-      P_loadDoomThings(wl);
+      P_loadDoomThings(wl, lt);
       break;
    case LEVEL_FORMAT_HEXEN:
-      P_loadHexenThings(wl);
+      P_loadHexenThings(wl, lt);
+      break;
+   case LEVEL_FORMAT_UDMF:
+      P_loadUDMFThings(wl, lt);
       break;
    default:
       return; // not supported
    }
 }
 
-enum
-{
-   GAME_TYPE_SINGLE,
-   GAME_TYPE_COOP,
-   GAME_TYPE_DM,
-   NUM_GAME_TYPES
-};
-
-// For Hexen, the flag MUST be present
-static unsigned int HxFlagForGameType[NUM_GAME_TYPES] =
-{
-   MTF_HX_GSINGLE,
-   MTF_HX_GCOOP,
-   MTF_HX_GDEATHMATCH
-};
-
-// For Doom (with BOOM extensions enabled, the flag must NOT be present
-static unsigned int DoomFlagForGameType[NUM_GAME_TYPES] =
-{
-   MTF_NOTSINGLE,
-   MTF_NOTCOOP,
-   MTF_NOTDM
-};
-
-static const char *PrettyGameType[NUM_GAME_TYPES] =
-{
-   "Single Player",
-   "Cooperative",
-   "Deathmatch"
-};
-
 //
-// Check if the thing type is present for the given game type
+// Free the things loaded into lt.
 //
-static bool P_isInGameType(mapthing_t *thing, int gametype)
+void P_FreeLevelThings(levelthings_t &lt)
 {
-   switch(levelformat)
+   if(lt.things)
    {
-   case LEVEL_FORMAT_HEXEN:
-      return ((thing->options & HxFlagForGameType[gametype]) == HxFlagForGameType[gametype]);
-   default:
-      return ((thing->options & DoomFlagForGameType[gametype]) == 0);
+      efree(lt.things);
+      lt.things = nullptr;
    }
+   lt.numthings = 0;
 }
 
-enum
-{
-   SKILL_EASY,
-   SKILL_NORMAL,
-   SKILL_HARD,
-   NUM_SKILLS
-};
-
-// NB: Same between Doom and Hexen formats
-static unsigned int FlagsForSkill[NUM_SKILLS] =
-{
-   MTF_EASY,
-   MTF_NORMAL,
-   MTF_HARD
-};
-
 //
-// Check if the thing type is present for the given skill level
+// Load the things of the level to be output next
 //
-static bool P_isInSkill(mapthing_t *thing, int skill)
+void P_LoadThings(wadlevel_t &wl)
 {
-   return ((thing->options & FlagsForSkill[skill]) == FlagsForSkill[skill]);
-}
+   if(wantsums)
+      P_reserveDenseCounts();
 
-enum
-{
-   CLASS_FIGHTER,
-   CLASS_CLERIC,
-   CLASS_MAGE,
-   NUM_CLASSES
-};
+   P_LoadLevelThings(wl, levelthings);
+}
 
-static unsigned int FlagsForClass[NUM_CLASSES] =
+struct thingtally_t
 {
-   MTF_HX_FIGHTER,
-   MTF_HX_CLERIC,
-   MTF_HX_MAGE
+   DLListItem<thingtally_t> links;
+   const thingtype_t *type;
+   int          doomednum;
+   int          counts[NUM_SKILLS];
+   thingtally_t *classnext; // next of the same class, while being output
 };
 
-static const char *PrettyPClasses[NUM_CLASSES] =
-{
-   "Fighter",
-   "Cleric",
-   "Mage"
-};
+typedef EHashTable<thingtally_t, EIntHashKey,
+                   &thingtally_t::doomednum, &thingtally_t::links> tallyhash_t;
 
 //
-// Check if the thing type is present for the given player class
+// Add a thingtype's counts to the table's dense counts. Unknown things have
+// no attributes, and are left out.
 //
-static bool P_isInClassGame(mapthing_t *thing, int pclass)
+static void P_scatterCounts(const thingtype_t *type, const int counts[NUM_SKILLS])
 {
-   return ((thing->options & FlagsForClass[pclass]) == FlagsForClass[pclass]);
+   if(!type)
+      return;
+
+   for(int s = 0; s < NUM_SKILLS; s++)
+      densecounts[s][type->index] += counts[s];
 }
 
-struct thingtally_t
+//
+// Output the table's counts weighted by each attribute, which are the dot
+// products of the dense counts and the attribute vectors, and then clear
+// the dense counts for the next table.
+//
+static void P_outputSums(ReportFormatter &fmt)
 {
-   DLListItem<thingtally_t> links;
-   thingtype_t *type;
-   int          doomednum;
-   int          counts[NUM_SKILLS];
-};
+   int numtypes = P_NumThingTypes();
+   reportsums_t rs;
 
-static const char *PrettyClassNames[CLASS_MAX] =
-{
-   "Unknown",
-   "Monsters",    // Monster (attacks/moves/respawns/etc)
-   "NPCs",        // Strife NPC or similar interactive but non-hostile
-   "Health",      // Health item
-   "Armor",       // Armor item
-   "Ammo",        // Ammunition
-   "Weapons",     // Weapon
-   "Keys",        // Key item
-   "Artifacts",   // Artifact (Heretic/Hexen/Strife)
-   "Powerups",    // Power-up item
-   "Quest items", // Quest item (Strife or Hexen)
-   "Decor",       // Decorative
-   "Hazards",     // Hazardous, but not an enemy
-   "Ambience",    // Ambient sound object
-   "Technical",   // Items like player spawns, teleman, deathmatch starts, etc.
-};
+   for(int a = 0; a < NUM_THINGATTRS; a++)
+   {
+      const int *attrs = P_ThingAttrVector(a);
 
-typedef EHashTable<thingtally_t, EIntHashKey,
-                   &thingtally_t::doomednum, &thingtally_t::links> tallyhash_t;
+      for(int s = 0; s < NUM_SKILLS; s++)
+      {
+         const int *counts = densecounts[s];
+         int64_t    sum    = 0;
+
+         for(int i = 0; i < numtypes; i++)
+            sum += static_cast<int64_t>(counts[i]) * attrs[i];
+         rs.sums[a][s] = sum;
+      }
+   }
+
+   for(int s = 0; s < NUM_SKILLS; s++)
+      memset(densecounts[s], 0, numtypes * sizeof(int));
+
+   fmt.weightedSums(rs);
+}
 
 //
-// Tabulate things on the level:
-// * By game mode (single/coop/DM)
-// * By skill level
-// * By player class (if Hexen)
-// * By type
-// 
-static void P_TabulateThings(int mode, int classtype)
+// Output one level's tallied objects as a table, by class type. With sums,
+// the counts weighted by thingtype attributes follow.
+//
+static void P_outputTable(ReportFormatter &fmt, tallyhash_t &hash, int mode,
+                          int pclass, bool sums)
 {
-   if(!things)
-      return;
+   thingtally_t  *classes[CLASS_MAX];
+   thingtally_t **classtails[CLASS_MAX];
 
-   tallyhash_t hash;
+   fmt.beginTable(mode, pclass);
 
-   // gather up the things present in the given combination of game
-   // properties
-   for(int i = 0; i < numthings; i++)
+   // sort the tallied objects by class type in one pass, keeping them in
+   // hash table order within each class
+   for(int i = 0; i < CLASS_MAX; i++)
    {
-      mapthing_t *mt = &things[i];
+      classes[i]    = nullptr;
+      classtails[i] = &classes[i];
+   }
 
-      if(!P_isInGameType(mt, mode)) // check if in game type
+   thingtally_t *tt = nullptr;
+   while((tt = hash.tableIterator(tt)))
+   {
+      int classtype = tt->type ? tt->type->classtype : CLASS_NONE; // Unknown go into class NONE
+
+      if(classtype < 0 || classtype >= CLASS_MAX)
+         continue;
+
+      tt->classnext = nullptr;
+      *classtails[classtype] = tt;
+      classtails[classtype]  = &tt->classnext;
+   }
+
+   // output all tallied objects by class type, starting a class only when
+   // one of its objects is actually found in the level
+   for(int i = 0; i < CLASS_MAX; i++)
+   {
+      if(!classes[i])
          continue;
 
-      // if Hexen format, check if in class game
-      if(levelformat == LEVEL_FORMAT_HEXEN && !P_isInClassGame(mt, classtype))
+      fmt.beginClass(i);
+
+      for(tt = classes[i]; tt; tt = tt->classnext)
+      {
+         reportrow_t row;
+         row.doomednum = tt->doomednum;
+         row.name      = tt->type ? P_NameForThingType(tt->type) : "Unknown";
+         row.classtype = i;
+         memcpy(row.counts, tt->counts, sizeof(row.counts));
+         fmt.row(row);
+
+         if(sums)
+            P_scatterCounts(tt->type, tt->counts);
+      }
+
+      fmt.endClass();
+   }
+   if(sums)
+      P_outputSums(fmt);
+   fmt.endTable();
+}
+
+//
+// Gather up the things of a level present in the given combination of game
+// properties, by DoomEd number. tablepclass is -1 if the level's flags have
+// no player classes.
+//
+static void P_tallyThings(const levelthings_t &lt, int mode, int tablepclass,
+                          tallyhash_t &hash)
+{
+   const uint16_t *compat   = P_CompatTable(lt.compat);
+   unsigned int    tablebit = COMPAT_TABLEBIT(mode, tablepclass);
+
+   for(int i = 0; i < lt.numthings; i++)
+   {
+      mapthing_t  *mt   = &lt.things[i];
+      unsigned int bits = compat[static_cast<uint16_t>(mt->options)];
+
+      if(!(bits & tablebit)) // check if in game type and player class
          continue;
 
       // find or create a new tally object for this type
@@ -333,53 +417,17 @@ static void P_TabulateThings(int mode, int classtype)
          hash.addObject(tt);
       }
       // determine skill levels
-      if(P_isInSkill(mt, SKILL_EASY))
-         tt->counts[SKILL_EASY]++;
-      if(P_isInSkill(mt, SKILL_NORMAL))
-         tt->counts[SKILL_NORMAL]++;
-      if(P_isInSkill(mt, SKILL_HARD))
-         tt->counts[SKILL_HARD]++;
-   }
-
-   printf("Game mode: %s\n", PrettyGameType[mode]);
-   if(levelformat == LEVEL_FORMAT_HEXEN)
-      printf("Player class: %s\n", PrettyPClasses[classtype]);
-
-   // print all tallied objects by class type
-   for(int i = 0; i < CLASS_MAX; i++)
-   {
-      thingtally_t *tt = nullptr;
-      bool printedHeader = false;
-
-      while((tt = hash.tableIterator(tt)))
-      {
-         const char *name;
-         if(i != CLASS_NONE && !tt->type) // Unknown go into class NONE
-            continue;
-         if(tt->type && tt->type->classtype != i)
-            continue;
-
-         // don't print the header for this class of objects until one is
-         // actually found in the level.
-         if(!printedHeader)
-         {
-            printf("%s:\n", PrettyClassNames[i]);
-            printf("  DEN Type                      Easy Norm.  Hard\n");
-            printf("================================================\n");
-            printedHeader = true;
-         }
-
-         name = tt->type ? tt->type->name : "Unknown";
-         printf("%5d %-24.24s %5d %5d %5d\n", tt->doomednum, name, 
-                tt->counts[SKILL_EASY], tt->counts[SKILL_NORMAL],
-                tt->counts[SKILL_HARD]);
-      }
-      if(printedHeader)
-         printf("\n");
+      tt->counts[SKILL_EASY]   += (bits >> SKILL_EASY)   & 1;
+      tt->counts[SKILL_NORMAL] += (bits >> SKILL_NORMAL) & 1;
+      tt->counts[SKILL_HARD]   += (bits >> SKILL_HARD)   & 1;
    }
-   printf("\n");
+}
 
-   // destroy the tally objects
+//
+// Destroy the tally objects
+//
+static void P_freeTallies(tallyhash_t &hash)
+{
    thingtally_t *tt = nullptr;
    while((tt = hash.tableIterator(tt)))
    {
@@ -390,11 +438,13 @@ static void P_TabulateThings(int mode, int classtype)
 }
 
 //
-// Output the tables of thing counts for the indicated game types and/or
-// player classes. If the counts are passed as -1, all count tables will
-// be generated.
+// Call func(mode, pclass) for each table of a level with the given compat
+// profile: by game mode (single/coop/DM), and by player class if the
+// profile has them. theType and theClass limit the tables to one game type
+// or player class, unless they are -1.
 //
-void P_OutputThingCounts(wadlevel_t &wl, int theType, int theClass)
+template<typename F>
+static void P_forEachTable(int compat, int theType, int theClass, F func)
 {
    int starttype;
    int maxtype;
@@ -422,19 +472,758 @@ void P_OutputThingCounts(wadlevel_t &wl, int theType, int theClass)
       maxclass   = theClass + 1;
    }
 
-   printf("======================%.8s======================\n\n", wl.header);
-
    for(int type = starttype; type < maxtype; type++)
    {
-      if(levelformat == LEVEL_FORMAT_HEXEN)
+      if(P_CompatHasClasses(compat))
       {
          for(int pclass = startclass; pclass < maxclass; pclass++)
-            P_TabulateThings(type, pclass);
+            func(type, pclass);
       }
       else
-         P_TabulateThings(type, 0);
+         func(type, -1);
    }
 }
 
-// EOF
+//
+// Pass on the tallies of one table of the level being output: to the scan
+// record, the rollups and statistics, and the report.
+//
+static void P_outputTallies(tallyhash_t &hash, int mode, int tablepclass)
+{
+   if(scanrecord)
+   {
+      thingtally_t *tt = nullptr;
+
+      scanrecord->beginTable(mode, tablepclass, static_cast<int>(hash.getNumItems()));
+      while((tt = hash.tableIterator(tt)))
+         scanrecord->addType(tt->doomednum, tt->counts);
+   }
+
+   // keep the counts for rollups
+   if(maptally)
+   {
+      thingtally_t *tt = nullptr;
+      while((tt = hash.tableIterator(tt)))
+         maptally->add(mode, tablepclass, tt->doomednum, tt->counts);
+   }
+
+   if(archivestats)
+   {
+      thingtally_t *tt = nullptr;
+
+      archivestats->beginTable(mode, tablepclass);
+      while((tt = hash.tableIterator(tt)))
+      {
+         archivestats->addCount(tt->doomednum,
+                                tt->type ? tt->type->classtype : CLASS_NONE,
+                                tt->counts);
+      }
+      archivestats->endTable();
+   }
+
+   if(rolluplevels & ROLLUP_MAP)
+      P_outputTable(*formatter, hash, mode, tablepclass, wantsums);
+}
+
+//
+// Tabulate things on the level being output:
+// * By game mode (single/coop/DM)
+// * By skill level
+// * By player class (if Hexen)
+// * By type
+// tablepclass is -1 if the level's flags have no player classes.
+//
+static void P_TabulateThings(int mode, int tablepclass)
+{
+   if(!levelthings.things)
+      return;
+
+   tallyhash_t hash;
+   P_tallyThings(levelthings, mode, tablepclass, hash);
+   P_outputTallies(hash, mode, tablepclass);
+   P_freeTallies(hash);
+}
+
+//
+// Add a level's finished tally to its episode.
+//
+static void P_addMapTally(const char *mapname, RollupTally *tally)
+{
+   char   name[9];
+   size_t i;
+
+   tally->sort();
+
+   P_EpisodeForMap(mapname, name);
+   for(i = 0; i < episodes.getLength(); i++)
+   {
+      if(!strcasecmp(episodes[i].name, name))
+         break;
+   }
+   if(i == episodes.getLength())
+   {
+      rollupepisode_t ep;
+      strcpy(ep.name, name);
+      ep.maps = new PODCollection<RollupTally *>();
+      episodes.add(ep);
+   }
+
+   episodes[i].maps->add(tally);
+}
+
+//
+// Start the output of a level's tables.
+//
+static void P_beginLevelCounts(const char *mapname)
+{
+   if(rolluplevels & ~ROLLUP_MAP)
+      maptally = new RollupTally();
+
+   reportbuf.clear();
+   if(rolluplevels & ROLLUP_MAP)
+      formatter->beginLevel(mapname);
+
+   if(scanrecord)
+      scanrecord->beginLevel(mapname);
+}
+
+//
+// Finish the output of a level's tables.
+//
+static void P_endLevelCounts(const char *mapname)
+{
+   if(rolluplevels & ROLLUP_MAP)
+   {
+      formatter->endLevel();
+      P_writeReport();
+   }
+
+   if(maptally)
+   {
+      P_addMapTally(mapname, maptally);
+      maptally = NULL;
+   }
+
+   if(scanrecord)
+      scanrecord->endLevel();
+}
+
+//
+// Output the tables of thing counts for the indicated game types and/or
+// player classes. If the counts are passed as -1, all count tables will
+// be generated.
+//
+void P_OutputThingCounts(wadlevel_t &wl, int theType, int theClass)
+{
+   P_beginLevelCounts(wl.header);
+   P_forEachTable(levelthings.compat, theType, theClass, P_TabulateThings);
+   P_endLevelCounts(wl.header);
+}
+
+//
+// Record the tallies of the levels output from now on, or stop if record is
+// NULL.
+//
+void P_RecordThingCounts(ScanRecord *record)
+{
+   scanrecord = record;
+}
+
+//
+// Output the counts of levels from their recorded tallies, just as they were
+// output when they were recorded, but with the thingtypes now in use. Returns
+// false, having output nothing, if the tallies are damaged.
+//
+bool P_ReplayThingCounts(const void *data, size_t size)
+{
+   const byte *tallies = static_cast<const byte *>(data);
+
+   if(!ScanReader::validate(tallies, size))
+      return false;
 
+   if(wantsums)
+      P_reserveDenseCounts();
+
+   ScanReader reader(tallies, size);
+   while(!reader.atEnd())
+   {
+      char mapname[9];
+      int  mode, tablepclass, numtypes;
+
+      reader.readLevel(mapname);
+      P_beginLevelCounts(mapname);
+
+      while(reader.readTable(mode, tablepclass, numtypes))
+      {
+         tallyhash_t    hash;
+         thingtally_t **tts = NULL;
+
+         if(numtypes)
+            tts = ecalloc(thingtally_t **, numtypes, sizeof(thingtally_t *));
+         for(int i = 0; i < numtypes; i++)
+         {
+            tts[i] = estructalloc(thingtally_t, 1);
+            reader.readType(tts[i]->doomednum, tts[i]->counts);
+            tts[i]->type = P_ThingTypeForDEN(tts[i]->doomednum);
+         }
+
+         // hash chains put the newest object first, so adding the tallies in
+         // reverse puts them back in the order they were recorded in
+         for(int i = numtypes; i-- > 0; )
+            hash.addObject(tts[i]);
+         if(tts)
+            efree(tts);
+
+         P_outputTallies(hash, mode, tablepclass);
+         P_freeTallies(hash);
+      }
+
+      P_endLevelCounts(mapname);
+   }
+
+   return true;
+}
+
+//
+// Output the tables of thing counts of a level's things through fmt, for the
+// indicated game type and player class, or all of them if -1. Nothing is
+// kept for rollups or statistics, and no state is shared with the report
+// being output, so threads may count at once as long as the thingtypes are
+// not being changed meanwhile.
+//
+void P_CountLevelThings(const levelthings_t &lt, int theType, int theClass,
+                        ReportFormatter &fmt)
+{
+   if(!lt.things)
+      return;
+
+   P_forEachTable(lt.compat, theType, theClass, [&] (int mode, int pclass) {
+      tallyhash_t hash;
+      P_tallyThings(lt, mode, pclass, hash);
+      P_outputTable(fmt, hash, mode, pclass, false);
+      P_freeTallies(hash);
+   });
+}
+
+//=============================================================================
+//
+// Rollups
+//
+
+
+//
+// Output the tables of a rollup. Entries are sorted by table, so each run of
+// entries with the same game type and player class makes up one table.
+//
+static void P_outputRollup(int scope, const char *name, const RollupTally &tally)
+{
+   size_t numentries = tally.getNumEntries();
+
+   reportbuf.clear();
+   formatter->beginRollup(scope, name);
+
+   for(size_t start = 0, end; start < numentries; start = end)
+   {
+      uint32_t key   = tally.getEntry(start).key;
+      int      table = RollupTally::KeyTable(key);
+
+      for(end = start + 1; end < numentries; end++)
+      {
+         if(RollupTally::KeyTable(tally.getEntry(end).key) != table)
+            break;
+      }
+
+      formatter->beginTable(RollupTally::KeyGameType(key), RollupTally::KeyPClass(key));
+
+      for(int i = 0; i < CLASS_MAX; i++)
+      {
+         bool printedHeader = false;
+
+         for(size_t e = start; e < end; e++)
+         {
+            const rollupentry_t &entry = tally.getEntry(e);
+            int                  doomednum = RollupTally::KeyDoomEdNum(entry.key);
+            const thingtype_t   *type      = P_ThingTypeForDEN(doomednum);
+
+            if(i != CLASS_NONE && !type) // Unknown go into class NONE
+               continue;
+            if(type && type->classtype != i)
+               continue;
+
+            if(!printedHeader)
+            {
+               formatter->beginClass(i);
+               printedHeader = true;
+            }
+
+            reportrow_t row;
+            row.doomednum = doomednum;
+            row.name      = type ? P_NameForThingType(type) : "Unknown";
+            row.classtype = i;
+            memcpy(row.counts, entry.counts, sizeof(row.counts));
+            formatter->row(row);
+
+            if(wantsums)
+               P_scatterCounts(type, entry.counts);
+         }
+         if(printedHeader)
+            formatter->endClass();
+      }
+      if(wantsums)
+         P_outputSums(*formatter);
+      formatter->endTable();
+   }
+
+   formatter->endRollup();
+   P_writeReport();
+}
+
+//
+// Throw away the tallies of the current archive's levels.
+//
+static void P_clearEpisodes()
+{
+   for(size_t i = 0; i < episodes.getLength(); i++)
+   {
+      PODCollection<RollupTally *> &maps = *episodes[i].maps;
+      for(size_t m = 0; m < maps.getLength(); m++)
+         delete maps[m];
+      delete episodes[i].maps;
+   }
+   episodes.makeEmpty();
+}
+
+//
+// Select which levels of aggregation to output, as a mask of ROLLUP_*
+// values, and how many threads may be used to merge tallies.
+//
+void P_SetRollups(int levels, int numthreads)
+{
+   rolluplevels  = levels;
+   rollupthreads = numthreads;
+}
+
+//
+// Select whether to output statistics of the counts per level over all
+// archives.
+//
+void P_SetStats(bool enable)
+{
+   wantstats = enable;
+}
+
+//
+// Select whether to output each table's counts weighted by thingtype
+// attributes. Thingtypes must be loaded first.
+//
+void P_SetAttributes(bool enable)
+{
+   if((wantsums = enable))
+      P_reserveDenseCounts();
+}
+
+//
+// Finish the current archive. Tallies of its levels are merged into one per
+// episode, and those into one for the whole archive, which is kept for the
+// rollup of all archives. Nothing is added from an archive which failed.
+//
+void P_EndArchive()
+{
+   // an error part way through a level leaves its tally behind
+   delete maptally;
+   maptally = NULL;
+
+   if(archivestats)
+   {
+      if(!archivefailed)
+      {
+         if(!corpusstats)
+            corpusstats = new ThingStats();
+         corpusstats->merge(*archivestats);
+      }
+      delete archivestats;
+      archivestats = NULL;
+   }
+
+   if(archivefailed || !episodes.getLength())
+   {
+      P_clearEpisodes();
+      return;
+   }
+
+   PODCollection<RollupTally *> eptallies;
+
+   for(size_t i = 0; i < episodes.getLength(); i++)
+   {
+      PODCollection<RollupTally *> &maps = *episodes[i].maps;
+      RollupTally *tally = P_ReduceTallies(&maps[0], static_cast<int>(maps.getLength()),
+                                           rollupthreads);
+
+      if(rolluplevels & ROLLUP_EPISODE)
+         P_outputRollup(ROLLUP_EPISODE, episodes[i].name, *tally);
+
+      // the merged tally is handed on; the rest are empty now
+      maps[0] = NULL;
+      eptallies.add(tally);
+   }
+   P_clearEpisodes();
+
+   RollupTally *tally = P_ReduceTallies(&eptallies[0], static_cast<int>(eptallies.getLength()),
+                                        rollupthreads);
+   for(size_t i = 1; i < eptallies.getLength(); i++)
+      delete eptallies[i];
+
+   if(rolluplevels & ROLLUP_ARCHIVE)
+      P_outputRollup(ROLLUP_ARCHIVE, "", *tally);
+
+   if(rolluplevels & ROLLUP_CORPUS)
+      archivetallies.add(tally);
+   else
+      delete tally;
+}
+
+//=============================================================================
+//
+// Report Framing
+//
+
+//
+// P_closeReportOutput
+//
+// Write out everything and close the output. Returns false if any of the
+// report failed to write.
+//
+static bool P_closeReportOutput()
+{
+   bool ok = true;
+
+   if(!reportout)
+      return true;
+
+   if(reportasync)
+      ok = static_cast<AsyncOutBuffer *>(reportout)->Drain();
+   else
+      ok = reportout->Flush();
+
+   reportout->Close();
+   delete reportout;
+   reportout = NULL;
+
+   if(reportfile != stdout)
+   {
+      if(fclose(reportfile))
+         ok = false;
+   }
+   else if(fflush(stdout))
+      ok = false;
+   reportfile = NULL;
+
+   return ok;
+}
+
+//
+// P_exitReportOutput
+//
+// Exit handler, so that output still queued for the writer thread is not
+// lost when exiting on an error.
+//
+static void P_exitReportOutput()
+{
+   P_closeReportOutput();
+}
+
+//
+// True if output to this file should be gzip-compressed.
+//
+static bool P_isGzipName(const char *filename)
+{
+   size_t len;
+
+   if(!filename || (len = strlen(filename)) < 3)
+      return false;
+
+   return !strcasecmp(filename + len - 3, ".gz");
+}
+
+//
+// Select the output format by name, and the file to write the report to.
+// If filename is null, the report goes to stdout. Output to a file, or when
+// asyncmem is nonzero, is written by a separate thread with asyncmem bytes
+// of buffers, or DEFAULT_ASYNCMEM if it is zero. A filename ending in .gz
+// is gzip-compressed, by as many threads as there are spare cores. Returns
+// false if there is no such format, without touching the file.
+//
+bool P_SetReportFormat(const char *format, const char *filename, size_t asyncmem)
+{
+   FILE *f = stdout;
+
+   if(!ReportFormatter::IsFormat(format))
+      return false;
+
+   if(filename && !(f = fopen(filename, "wb")))
+      I_Error("Could not open output file '%s'\n", filename);
+
+   P_closeReportOutput();
+
+   reportfile  = f;
+   reportasync = (filename || asyncmem);
+   if(reportasync)
+   {
+      AsyncOutBuffer *ab;
+      int numworkers = 1;
+      int numbuffers = NUM_ASYNCBUFFERS;
+
+      if(!asyncmem)
+         asyncmem = DEFAULT_ASYNCMEM;
+
+      if(P_isGzipName(filename))
+      {
+         // leave a core for tabulating
+         numworkers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+         if(numworkers < 1)
+            numworkers = 1;
+         else if(numworkers > MAX_GZIPWORKERS)
+            numworkers = MAX_GZIPWORKERS;
+
+         // keep every worker busy, with one buffer left to fill
+         if(numbuffers < 2 * numworkers)
+            numbuffers = 2 * numworkers;
+         ab = new GzipOutBuffer();
+      }
+      else
+         ab = new AsyncOutBuffer();
+
+      ab->OpenAsync(f, asyncmem / numbuffers, numbuffers,
+                    BufferedFileBase::LENDIAN, numworkers);
+      reportout = ab;
+   }
+   else
+   {
+      reportout = new OutBuffer();
+      reportout->OpenExisting(f, 64 * 1024, BufferedFileBase::LENDIAN);
+   }
+
+   static bool registered;
+   if(!registered)
+   {
+      atexit(P_exitReportOutput);
+      registered = true;
+   }
+
+   delete formatter;
+   return (formatter = ReportFormatter::Create(format, reportbuf, *reportout)) != NULL;
+}
+
+//
+// Output anything the format needs before the first archive.
+//
+void P_BeginReport()
+{
+   formatter->beginOutput(rolluplevels != 0);
+   P_writeReport();
+}
+
+//
+// Note the start of a new archive in the report.
+//
+void P_BeginArchive(const char *filename, bool multiple)
+{
+   archivefailed = false;
+   if(wantstats)
+   {
+      delete archivestats;
+      archivestats = new ThingStats();
+   }
+   formatter->beginArchive(filename, multiple);
+   P_writeReport();
+}
+
+//
+// Report an archive that could not be processed.
+//
+void P_ReportError(const char *message)
+{
+   archivefailed = true;
+   formatter->error(message);
+   P_writeReport();
+}
+
+//
+// Finish the report, with the rollup of and statistics over all archives if
+// they were asked for, and close the output.
+//
+void P_EndReport()
+{
+   if(archivetallies.getLength())
+   {
+      RollupTally *tally = P_ReduceTallies(&archivetallies[0],
+                                           static_cast<int>(archivetallies.getLength()),
+                                           rollupthreads);
+      P_outputRollup(ROLLUP_CORPUS, "", *tally);
+
+      for(size_t i = 0; i < archivetallies.getLength(); i++)
+         delete archivetallies[i];
+      archivetallies.makeEmpty();
+   }
+
+   if(corpusstats)
+   {
+      if(!corpusstats->isEmpty())
+      {
+         reportbuf.clear();
+         corpusstats->output(*formatter);
+         P_writeReport();
+      }
+      delete corpusstats;
+      corpusstats = NULL;
+   }
+
+   formatter->endOutput();
+   P_writeReport();
+
+   if(!P_closeReportOutput())
+      I_Error("Error writing output file\n");
+}
+
+//
+// Output the contents of a results file as a report in the selected format.
+// Tables are reconstructed from the recorded rows, so any table which had no
+// things in it is left out. Returns false if the file cannot be read.
+//
+bool P_DumpResults(const char *filename)
+{
+   ResultsReader reader;
+
+   if(!reader.open(filename))
+      return false;
+
+   int32_t *columns[RC_NUMCOLUMNS];
+   for(int i = 0; i < RC_NUMCOLUMNS; i++)
+      columns[i] = ecalloc(int32_t *, RESULTS_GROUPROWS, sizeof(int32_t));
+
+   // archives are numbered in the order they were first seen
+   bool multiple = false;
+   int  numgroups = reader.getNumGroups();
+   if(numgroups)
+   {
+      int32_t firstarchive;
+      reader.readColumn(0, RC_ARCHIVE, columns[RC_ARCHIVE]);
+      firstarchive = columns[RC_ARCHIVE][0];
+      reader.readColumn(numgroups - 1, RC_ARCHIVE, columns[RC_ARCHIVE]);
+      multiple = (columns[RC_ARCHIVE][reader.getGroupRows(numgroups - 1) - 1] != firstarchive);
+   }
+
+   int  archive = -1, map = -1, mode = -1, pclass = -1, classtype = -1;
+   bool intable = false, inclass = false;
+   bool ok = true;
+
+   // the file holds tables, whatever -rollup and -stats asked for
+   rolluplevels |= ROLLUP_MAP;
+
+   P_BeginReport();
+
+   for(int group = 0; ok && group < numgroups; group++)
+   {
+      int numrows = reader.getGroupRows(group);
+
+      for(int i = 0; i < RC_NUMCOLUMNS; i++)
+      {
+         if(!reader.readColumn(group, i, columns[i]))
+            ok = false;
+      }
+
+      for(int r = 0; ok && r < numrows; r++)
+      {
+         const char *archivename = reader.getString(columns[RC_ARCHIVE][r]);
+         const char *mapname     = reader.getString(columns[RC_MAP][r]);
+         bool newarchive = (columns[RC_ARCHIVE][r] != archive);
+         bool newlevel   = (newarchive || columns[RC_MAP][r] != map);
+         bool newtable   = (newlevel || columns[RC_MODE][r] != mode ||
+                            columns[RC_PCLASS][r] != pclass);
+         reportrow_t row;
+
+         if(!archivename || !mapname ||
+            columns[RC_MODE][r] < 0 || columns[RC_MODE][r] >= NUM_GAME_TYPES ||
+            columns[RC_PCLASS][r] < -1 || columns[RC_PCLASS][r] >= NUM_CLASSES ||
+            columns[RC_CLASS][r] < 0 || columns[RC_CLASS][r] >= CLASS_MAX ||
+            !(row.name = reader.getString(columns[RC_TYPE][r])))
+         {
+            ok = false;
+            break;
+         }
+
+         if(inclass && (newtable || columns[RC_CLASS][r] != classtype))
+         {
+            formatter->endClass();
+            inclass = false;
+         }
+         if(intable && newtable)
+         {
+            if(wantsums)
+               P_outputSums(*formatter);
+            formatter->endTable();
+            intable = false;
+         }
+         if(newlevel && map >= 0)
+         {
+            formatter->endLevel();
+            P_writeReport();
+         }
+
+         if(newarchive)
+         {
+            archive = columns[RC_ARCHIVE][r];
+            formatter->beginArchive(archivename, multiple);
+         }
+         if(newlevel)
+         {
+            map = columns[RC_MAP][r];
+            formatter->beginLevel(mapname);
+         }
+         if(newtable)
+         {
+            mode   = columns[RC_MODE][r];
+            pclass = columns[RC_PCLASS][r];
+            formatter->beginTable(mode, pclass);
+            intable = true;
+         }
+         if(!inclass)
+         {
+            classtype = columns[RC_CLASS][r];
+            formatter->beginClass(classtype);
+            inclass = true;
+         }
+
+         row.doomednum = columns[RC_DEN][r];
+         row.classtype = classtype;
+         row.counts[SKILL_EASY]   = columns[RC_EASY][r];
+         row.counts[SKILL_NORMAL] = columns[RC_NORMAL][r];
+         row.counts[SKILL_HARD]   = columns[RC_HARD][r];
+         formatter->row(row);
+
+         // attributes come from the loaded thingtypes
+         if(wantsums)
+            P_scatterCounts(P_ThingTypeForDEN(row.doomednum), row.counts);
+      }
+   }
+
+   if(inclass)
+      formatter->endClass();
+   if(intable)
+   {
+      if(wantsums)
+         P_outputSums(*formatter);
+      formatter->endTable();
+   }
+   if(map >= 0)
+      formatter->endLevel();
+
+   P_EndReport();
+
+   for(int i = 0; i < RC_NUMCOLUMNS; i++)
+      efree(columns[i]);
+
+   return ok;
+}
+
+// EOF
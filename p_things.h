@@ -26,10 +26,45 @@
 #ifndef P_THINGS_H__
 #define P_THINGS_H__
 
+class  ReportFormatter;
+class  ScanRecord;
+struct mapthing_t;
 struct wadlevel_t;
 
+//
+// The things of one level, as loaded by P_LoadLevelThings. Zero-initialize
+// before the first load.
+//
+struct levelthings_t
+{
+   mapthing_t *things;
+   int         numthings;
+   int         compat;    // compat profile for the level's flags
+};
+
+void P_LoadLevelThings(wadlevel_t &wl, levelthings_t &lt);
+void P_FreeLevelThings(levelthings_t &lt);
+void P_CountLevelThings(const levelthings_t &lt, int theType, int theClass,
+                        ReportFormatter &fmt);
+
 void P_LoadThings(wadlevel_t &wl);
 void P_OutputThingCounts(wadlevel_t &wl, int theType, int theClass);
+void P_RecordThingCounts(ScanRecord *record);
+bool P_ReplayThingCounts(const void *data, size_t size);
+
+// Default size of asynchronous output buffers
+#define DEFAULT_ASYNCMEM (1024 * 1024)
+
+bool P_SetReportFormat(const char *format, const char *filename, size_t asyncmem);
+void P_BeginReport();
+void P_SetRollups(int levels, int numthreads);
+void P_SetStats(bool enable);
+void P_SetAttributes(bool enable);
+void P_BeginArchive(const char *filename, bool multiple);
+void P_EndArchive();
+void P_ReportError(const char *message);
+void P_EndReport();
+bool P_DumpResults(const char *filename);
 
 #endif
 
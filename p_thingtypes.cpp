@@ -23,10 +23,18 @@
 //
 //-----------------------------------------------------------------------------
 
+#include <algorithm>
+
 #include "z_zone.h"
-#include "e_hash.h"
-#include "e_hashkeys.h"
-#include "m_misc.h"
+#include "i_system.h"
+#include "m_binary.h"
+#include "m_buffer.h"
+#include "m_collection.h"
+#include "m_mapfile.h"
+#include "m_qstr.h"
+#include "m_swap.h"
+#include "d_deh.h"
+#include "d_dehtbl.h"
 #include "p_thingtypes.h"
 #include "xl_scripts.h"
 
@@ -35,10 +43,77 @@
 // Data store
 //
 
-typedef EHashTable<thingtype_t, EIntHashKey, 
-                   &thingtype_t::doomednum, &thingtype_t::links> thingtable_t;
+//
+// A set of thingtype tables: thingtypes sorted by DoomEd number, their names,
+// and the value of each attribute for every thingtype, by dense index
+//
+struct thingtables_t
+{
+   const thingtype_t *types;
+   int                numtypes;
+   int                numindices; // length of the attribute vectors
+   const char        *names;
+   const int         *attrs;      // NUM_THINGATTRS vectors of numindices
+   const uint32_t    *lookup;     // see below
+};
+
+// Tables from the script or built-in game, and those in use, which have any
+// DeHackEd changes merged in
+static thingtables_t basetables;
+static thingtables_t thingtables;
+
+// Each set of tables has a lookup table, giving the position in types, plus
+// 1, of every DoomEd number a map can hold, from DENLOOKUP_MIN; or 0 if there
+// is no thingtype for it. Classifying a thing is then a single load.
+#define DENLOOKUP_MIN  -32768
+#define DENLOOKUP_SIZE 65536
+
+// Lookup tables built for base tables which did not come with one, and for
+// an archive's tables
+static uint32_t *baselookup;
+static uint32_t *archlookup;
+
+// Compiled registry which the base tables are in, if any
+static MappedFile registry;
+
+// Tables loaded from a script, rather than built in
+static thingtype_t *scripttypes;
+static char        *scriptnames;
+static int         *scriptattrs;
+
+// Tables with an archive's DeHackEd changes and thing definitions merged in
+static thingtype_t *archtypes;
+static char        *archnames;
+static int         *archattrs;
+
+//
+// A built-in game's thingtypes, as generated into p_gamedefs.h
+//
+struct thinggame_t
+{
+   const char        *name;     // for -game
+   const thingtype_t *types;
+   int                numtypes;
+   const char        *names;
+   const int         *attrs;
+};
+
+#include "p_gamedefs.h"
+
+//
+// A thingtype as defined by a script. The name points into the script, which
+// stays loaded until its tables have been built.
+//
+struct scripttype_t
+{
+   int         doomednum;
+   int         classtype;
+   const char *name;
+   size_t      namelen;
+   int         attributes[NUM_THINGATTRS]; // 0 unless given by the script
+};
 
-static thingtable_t thingtable;
+static PODCollection<scripttype_t> scriptdefs;
 
 //=============================================================================
 //
@@ -56,18 +131,21 @@ protected:
    {
       STATE_EXPECTDEN,   // expect doomednum
       STATE_EXPECTCLASS, // expect class
-      STATE_EXPECTNAME   // expect name
+      STATE_EXPECTNAME,  // expect name
+      STATE_EXPECTVALUE  // expect attribute value
    };
 
    // state handlers
    bool doStateExpectDEN(XLTokenizer &);
    bool doStateExpectClass(XLTokenizer &);
    bool doStateExpectName(XLTokenizer &);
+   bool doStateExpectValue(XLTokenizer &);
 
    // parser state data
    int state;
    int den;
    int classtype;
+   int attr;              // attribute being given a value
 
    virtual bool doToken(XLTokenizer &token);
    virtual void startLump();
@@ -76,7 +154,8 @@ protected:
 
 public:
    XLThingScript()
-      : XLParser(""), state(STATE_EXPECTDEN), den(0), classtype(CLASS_NONE)
+      : XLParser(""), state(STATE_EXPECTDEN), den(0), classtype(CLASS_NONE),
+        attr(NUM_THINGATTRS)
    {
    }
 };
@@ -86,7 +165,8 @@ bool (XLThingScript::* XLThingScript::States[])(XLTokenizer &) =
 {
    &XLThingScript::doStateExpectDEN,
    &XLThingScript::doStateExpectClass,
-   &XLThingScript::doStateExpectName
+   &XLThingScript::doStateExpectName,
+   &XLThingScript::doStateExpectValue
 };
 
 // Dispatch token to appropriate state handler
@@ -101,6 +181,7 @@ void XLThingScript::startLump()
    state     = STATE_EXPECTDEN;
    den       = 0;
    classtype = CLASS_NONE;
+   attr      = NUM_THINGATTRS;
 }
 
 // Setup tokenizer before parsing begins
@@ -115,10 +196,26 @@ void XLThingScript::onEOF(bool early)
    // TODO: ?
 }
 
-// Expecting doomednum
+static const char *attrnames[NUM_THINGATTRS] =
+{
+   "$hp",
+   "$damage",
+   "$health",
+   "$armor"
+};
+
+// Expecting doomednum, or an attribute of the previous thingtype
 bool XLThingScript::doStateExpectDEN(XLTokenizer &token)
 {
-   den = token.getToken().toInt();
+   if(token.getTokenType() == XLTokenizer::TOKEN_KEYWORD)
+   {
+      // unknown attributes are skipped, along with their value
+      attr  = token.tokenToNum(attrnames, NUM_THINGATTRS);
+      state = STATE_EXPECTVALUE;
+      return true;
+   }
+
+   den = token.tokenToInt();
    state = STATE_EXPECTCLASS;
    return true;
 }
@@ -145,7 +242,7 @@ static const char *classnames[CLASS_MAX] =
 // Expecting class
 bool XLThingScript::doStateExpectClass(XLTokenizer &token)
 {
-   classtype = M_StrToNumLinear(classnames, CLASS_MAX, token.getToken().constPtr());
+   classtype = token.tokenToNum(classnames, CLASS_MAX);
    if(classtype == CLASS_MAX)
       classtype = CLASS_NONE;
    state = STATE_EXPECTNAME;
@@ -155,11 +252,21 @@ bool XLThingScript::doStateExpectClass(XLTokenizer &token)
 // Expecting name
 bool XLThingScript::doStateExpectName(XLTokenizer &token)
 {
-   thingtype_t *tt = estructalloc(thingtype_t, 1);
-   tt->classtype = classtype;
-   tt->doomednum = den;
-   tt->name      = token.getToken().duplicate();
-   thingtable.addObject(tt);
+   scripttype_t &st = scriptdefs.addNew();
+   st.classtype = classtype;
+   st.doomednum = den;
+   st.name      = token.getTokenPtr();
+   st.namelen   = token.getTokenLength();
+   state = STATE_EXPECTDEN;
+   return true;
+}
+
+// Expecting an attribute value
+bool XLThingScript::doStateExpectValue(XLTokenizer &token)
+{
+   // attributes apply to the last thingtype defined
+   if(!scriptdefs.isEmpty() && attr != NUM_THINGATTRS)
+      scriptdefs[scriptdefs.getLength() - 1].attributes[attr] = token.tokenToInt();
    state = STATE_EXPECTDEN;
    return true;
 }
@@ -170,20 +277,696 @@ bool XLThingScript::doStateExpectName(XLTokenizer &token)
 //
 
 //
-// Load the specified thingtype script
+// Binary search a set of tables for the thingtype of a DoomEd number.
+//
+static const thingtype_t *P_searchThingType(const thingtables_t &tables,
+                                            int doomednum)
+{
+   int lo = 0, hi = tables.numtypes;
+   while(lo < hi)
+   {
+      int mid = (lo + hi) / 2;
+
+      if(tables.types[mid].doomednum < doomednum)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+   return (lo < tables.numtypes && tables.types[lo].doomednum == doomednum) ?
+      &tables.types[lo] : NULL;
+}
+
+//
+// Fill in a lookup table for a set of tables, allocating it if needed.
+//
+static const uint32_t *P_buildLookup(uint32_t *&lookup, const thingtables_t &tables)
+{
+   if(!lookup)
+      lookup = ecalloc(uint32_t *, DENLOOKUP_SIZE, sizeof(uint32_t));
+   else
+      memset(lookup, 0, DENLOOKUP_SIZE * sizeof(uint32_t));
+
+   for(int i = 0; i < tables.numtypes; i++)
+   {
+      unsigned int slot = static_cast<unsigned int>(tables.types[i].doomednum) - 
+                          static_cast<unsigned int>(DENLOOKUP_MIN);
+      if(slot < DENLOOKUP_SIZE)
+         lookup[slot] = static_cast<uint32_t>(i + 1);
+   }
+
+   return lookup;
+}
+
+//
+// Free the tables made for an archive.
+//
+static void P_freeArchiveTables()
+{
+   if(archtypes)
+   {
+      efree(archtypes);
+      efree(archnames);
+      efree(archattrs);
+      archtypes = NULL;
+      archnames = NULL;
+      archattrs = NULL;
+   }
+}
+
+//
+// Make and use tables for an archive, from the thingtypes of a set of tables
+// with changes. Each type's source is the index in those tables whose
+// attributes it keeps, or -1 if it is new: its name is then at nameofs in
+// newnames, where names end with line breaks, and its attributes are 0.
+// Types are ordered by DoomEd number, and where two have the same number,
+// the first one wins.
+//
+static void P_buildArchiveTables(const thingtables_t &from,
+                                 const PODCollection<thingtype_t> &types,
+                                 const PODCollection<int> &sources,
+                                 const qstring &newnames, int numindices)
+{
+   size_t numtypes = types.getLength();
+   int   *order    = ecalloc(int *, numtypes + 1, sizeof(int));
+   for(size_t i = 0; i < numtypes; i++)
+      order[i] = static_cast<int>(i);
+   std::stable_sort(order, order + numtypes, [&types] (int a, int b) {
+      return types[a].doomednum < types[b].doomednum;
+   });
+
+   // the existing names stay where they were, and new ones follow
+   size_t oldnamesize = 0;
+   for(int i = 0; i < from.numtypes; i++)
+   {
+      const thingtype_t &tt = from.types[i];
+      size_t end = tt.nameofs + strlen(from.names + tt.nameofs) + 1;
+      if(end > oldnamesize)
+         oldnamesize = end;
+   }
+
+   thingtype_t *newtypes = estructalloc(thingtype_t, numtypes + 1);
+   char        *newblock = ecalloc(char *, oldnamesize + newnames.length() + 1, 1);
+   int         *newattrs = ecalloc(int *, NUM_THINGATTRS * numindices + 1, sizeof(int));
+
+   memcpy(newblock, from.names, oldnamesize);
+   memcpy(newblock + oldnamesize, newnames.constPtr(), newnames.length());
+   for(size_t i = oldnamesize; i < oldnamesize + newnames.length(); i++)
+   {
+      if(newblock[i] == '\n')
+         newblock[i] = '\0';
+   }
+
+   int count = 0;
+   for(size_t i = 0; i < numtypes; i++)
+   {
+      const thingtype_t &tt = types[order[i]];
+      int source = sources[order[i]];
+
+      if(count && newtypes[count - 1].doomednum == tt.doomednum)
+         continue;
+
+      newtypes[count] = tt;
+      if(source < 0)
+         newtypes[count].nameofs += static_cast<int>(oldnamesize);
+      else
+      {
+         for(int a = 0; a < NUM_THINGATTRS; a++)
+            newattrs[a * numindices + tt.index] = from.attrs[a * from.numindices + source];
+      }
+      ++count;
+   }
+   efree(order);
+
+   // the old tables may be those being replaced
+   P_freeArchiveTables();
+   archtypes = newtypes;
+   archnames = newblock;
+   archattrs = newattrs;
+
+   thingtables_t tables = { archtypes, count, numindices, archnames, archattrs, NULL };
+   tables.lookup = P_buildLookup(archlookup, tables);
+   thingtables   = tables;
+}
+
+//
+// Use new base tables, without any archive's changes.
+//
+static void P_useBaseTables(const thingtables_t &tables)
+{
+   basetables = tables;
+   if(!basetables.lookup)
+      basetables.lookup = P_buildLookup(baselookup, basetables);
+   thingtables = basetables;
+   P_freeArchiveTables();
+}
+
+//
+// Free the tables of a previously loaded script.
+//
+static void P_freeScriptTables()
+{
+   if(scripttypes)
+   {
+      efree(scripttypes);
+      efree(scriptnames);
+      efree(scriptattrs);
+      scripttypes = NULL;
+      scriptnames = NULL;
+      scriptattrs = NULL;
+   }
+}
+
+//
+// Compiled registries
+//
+// A registry holds a set of base tables in the form they are used in, so that
+// it can be mapped into memory and used in place. Values are little-endian,
+// and every section starts on a 16-byte boundary:
+//
+//    header   "TCRG", then uint32s: version, number of thingtypes, number of
+//             attributes, DENLOOKUP_MIN, DENLOOKUP_SIZE, and the offsets of
+//             the sections below, then the size of the names, and 0
+//    types    thingtype_t for each thingtype, as int32s
+//    attrs    the attribute vectors, as int32s
+//    lookup   the lookup table, as uint32s
+//    names    the names block
+//
+
+static const char registryMagic[4] = { 'T', 'C', 'R', 'G' };
+
+#define REGISTRY_VERSION    1
+#define REGISTRY_HEADERSIZE 48
+
+#define TR_read32(p) read32_le((p), uint32_t)
+
+//
+// Check a mapped registry and use its tables. Everything is checked, so that
+// the tables can be trusted once in use. The tables are used in place, unless
+// this is a big-endian machine; they are then copied into script tables.
+//
+static bool P_useRegistry(const byte *data, size_t size)
+{
+   if(size < REGISTRY_HEADERSIZE || memcmp(data, registryMagic, 4) ||
+      TR_read32(data + 4) != REGISTRY_VERSION ||
+      TR_read32(data + 12) != NUM_THINGATTRS ||
+      static_cast<int32_t>(TR_read32(data + 16)) != DENLOOKUP_MIN ||
+      TR_read32(data + 20) != DENLOOKUP_SIZE)
+      return false;
+
+   uint64_t numtypes  = TR_read32(data + 8);
+   uint64_t typesofs  = TR_read32(data + 24);
+   uint64_t attrsofs  = TR_read32(data + 28);
+   uint64_t lookupofs = TR_read32(data + 32);
+   uint64_t namesofs  = TR_read32(data + 36);
+   uint64_t namesize  = TR_read32(data + 40);
+
+   if(((typesofs | attrsofs | lookupofs | namesofs) & 15) ||
+      typesofs  < REGISTRY_HEADERSIZE ||
+      typesofs  + numtypes * sizeof(thingtype_t) > attrsofs ||
+      attrsofs  + numtypes * NUM_THINGATTRS * sizeof(int32_t) > lookupofs ||
+      lookupofs + DENLOOKUP_SIZE * sizeof(uint32_t) > namesofs ||
+      namesofs  + namesize > size || !namesize || data[namesofs + namesize - 1])
+      return false;
+
+   const byte *types  = data + typesofs;
+   const byte *lookup = data + lookupofs;
+   for(uint64_t i = 0; i < numtypes; i++)
+   {
+      const byte *tt = types + i * sizeof(thingtype_t);
+
+      if((i && static_cast<int32_t>(TR_read32(tt)) <= 
+               static_cast<int32_t>(TR_read32(tt - sizeof(thingtype_t)))) ||
+         TR_read32(tt + 4) >= CLASS_MAX || TR_read32(tt + 8) >= namesize ||
+         TR_read32(tt + 12) != i)
+         return false;
+   }
+   for(int slot = 0; slot < DENLOOKUP_SIZE; slot++)
+   {
+      uint32_t pos = TR_read32(lookup + 4 * slot);
+
+      if(pos > numtypes ||
+         (pos && static_cast<int32_t>(TR_read32(types + (pos - 1) * sizeof(thingtype_t))) != 
+                 slot + DENLOOKUP_MIN))
+         return false;
+   }
+
+   int count = static_cast<int>(numtypes);
+   thingtables_t tables;
+
+   if(SwapLong(1) == 1)
+   {
+      // little-endian: use the tables where they are
+      tables.types  = reinterpret_cast<const thingtype_t *>(types);
+      tables.names  = reinterpret_cast<const char *>(data + namesofs);
+      tables.attrs  = reinterpret_cast<const int *>(data + attrsofs);
+      tables.lookup = reinterpret_cast<const uint32_t *>(lookup);
+   }
+   else
+   {
+      P_freeScriptTables();
+      scripttypes = estructalloc(thingtype_t, count + 1);
+      scriptnames = ecalloc(char *, namesize, 1);
+      scriptattrs = ecalloc(int *, NUM_THINGATTRS * count + 1, sizeof(int));
+
+      int *dest = reinterpret_cast<int *>(scripttypes);
+      for(int i = 0; i < 4 * count; i++)
+         dest[i] = static_cast<int>(TR_read32(types + 4 * i));
+      for(int i = 0; i < NUM_THINGATTRS * count; i++)
+         scriptattrs[i] = static_cast<int>(TR_read32(data + attrsofs + 4 * i));
+      memcpy(scriptnames, data + namesofs, namesize);
+
+      tables.types  = scripttypes;
+      tables.names  = scriptnames;
+      tables.attrs  = scriptattrs;
+      tables.lookup = NULL;
+   }
+   tables.numtypes   = count;
+   tables.numindices = count;
+
+   P_useBaseTables(tables);
+   return true;
+}
+
+//
+// Map a compiled registry. Returns false if the file is not one, so that it
+// can be parsed as a script instead.
+//
+static bool P_loadRegistry(const char *filename)
+{
+   MappedFile file;
+
+   if(!file.open(filename) || file.getSize() < sizeof(registryMagic) ||
+      memcmp(file.getData(), registryMagic, sizeof(registryMagic)))
+      return false;
+
+   // the tables in use may be in the registry being replaced
+   registry.close();
+   if(!P_useRegistry(file.getData(), file.getSize()))
+      I_Error("'%s' is not a valid thingtype registry\n", filename);
+   if(SwapLong(1) == 1)
+      registry.swap(file); // keep the tables mapped
+   return true;
+}
+
+//
+// Write the base tables out as a compiled registry. Returns false if the
+// file could not be written.
+//
+bool P_WriteThingRegistry(const char *filename)
+{
+   OutBuffer out;
+   uint32_t  numtypes = static_cast<uint32_t>(basetables.numtypes);
+   uint32_t  namesize = 0;
+
+   for(int i = 0; i < basetables.numtypes; i++)
+   {
+      const thingtype_t &tt = basetables.types[i];
+      uint32_t end = static_cast<uint32_t>(tt.nameofs + strlen(basetables.names + tt.nameofs) + 1);
+      if(end > namesize)
+         namesize = end;
+   }
+   if(!namesize)
+      namesize = 1; // an empty name, so the block is never empty
+
+   // the sections are all whole multiples of 16 bytes, but for the names
+   uint32_t typesofs  = REGISTRY_HEADERSIZE;
+   uint32_t attrsofs  = typesofs  + numtypes * sizeof(thingtype_t);
+   uint32_t lookupofs = attrsofs  + numtypes * NUM_THINGATTRS * sizeof(int32_t);
+   uint32_t namesofs  = lookupofs + DENLOOKUP_SIZE * sizeof(uint32_t);
+
+   if(!out.CreateFile(filename, 64 * 1024, BufferedFileBase::LENDIAN))
+      return false;
+
+   try
+   {
+      out.setThrowing(true);
+
+      out.Write(registryMagic, sizeof(registryMagic));
+      out.WriteUint32(REGISTRY_VERSION);
+      out.WriteUint32(numtypes);
+      out.WriteUint32(NUM_THINGATTRS);
+      out.WriteSint32(DENLOOKUP_MIN);
+      out.WriteUint32(DENLOOKUP_SIZE);
+      out.WriteUint32(typesofs);
+      out.WriteUint32(attrsofs);
+      out.WriteUint32(lookupofs);
+      out.WriteUint32(namesofs);
+      out.WriteUint32(namesize);
+      out.WriteUint32(0);
+
+      for(int i = 0; i < basetables.numtypes; i++)
+      {
+         const thingtype_t &tt = basetables.types[i];
+         out.WriteSint32(tt.doomednum);
+         out.WriteSint32(tt.classtype);
+         out.WriteSint32(tt.nameofs);
+         out.WriteSint32(i);
+      }
+      for(int a = 0; a < NUM_THINGATTRS; a++)
+      {
+         for(int i = 0; i < basetables.numtypes; i++)
+         {
+            int index = basetables.types[i].index;
+            out.WriteSint32(basetables.attrs[a * basetables.numindices + index]);
+         }
+      }
+      for(int slot = 0; slot < DENLOOKUP_SIZE; slot++)
+         out.WriteUint32(basetables.lookup[slot]);
+      if(basetables.numtypes)
+         out.Write(basetables.names, namesize);
+      else
+         out.WriteUint8(0);
+
+      out.Flush();
+      out.Close();
+   }
+   catch(const BufferedIOException &)
+   {
+      out.Close();
+      return false;
+   }
+
+   return true;
+}
+
+//
+// Load the specified thingtype script, or compiled registry
 //
 void P_LoadThingTypes(const char *filename)
 {
-   XLThingScript().parseFile(filename);
+   if(P_loadRegistry(filename))
+      return;
+
+   XLThingScript script;
+   script.parseFile(filename);
+
+   // order by DoomEd number; a later definition replaces an earlier one
+   std::stable_sort(scriptdefs.begin(), scriptdefs.end(),
+                    [] (const scripttype_t &a, const scripttype_t &b) {
+                       return a.doomednum < b.doomednum;
+                    });
+
+   size_t numdefs  = scriptdefs.getLength();
+   size_t numtypes = 0;
+   size_t namesize = 0;
+   for(size_t i = 0; i < numdefs; i++)
+   {
+      if(i + 1 < numdefs && scriptdefs[i + 1].doomednum == scriptdefs[i].doomednum)
+         continue;
+      ++numtypes;
+      namesize += scriptdefs[i].namelen + 1;
+   }
+
+   P_freeScriptTables();
+   scripttypes = estructalloc(thingtype_t, numtypes + 1);
+   scriptnames = ecalloc(char *, namesize + 1, 1);
+   scriptattrs = ecalloc(int *, NUM_THINGATTRS * numtypes + 1, sizeof(int));
+
+   int    index   = 0;
+   size_t nameofs = 0;
+   for(size_t i = 0; i < numdefs; i++)
+   {
+      scripttype_t &st = scriptdefs[i];
+
+      if(i + 1 == numdefs || scriptdefs[i + 1].doomednum != st.doomednum)
+      {
+         thingtype_t &tt = scripttypes[index];
+         tt.doomednum = st.doomednum;
+         tt.classtype = st.classtype;
+         tt.nameofs   = static_cast<int>(nameofs);
+         tt.index     = index;
+
+         memcpy(scriptnames + nameofs, st.name, st.namelen);
+         nameofs += st.namelen + 1;
+
+         for(int a = 0; a < NUM_THINGATTRS; a++)
+            scriptattrs[a * numtypes + index] = st.attributes[a];
+         ++index;
+      }
+   }
+   scriptdefs.makeEmpty();
+
+   thingtables_t tables = { scripttypes, index, index, scriptnames, scriptattrs, NULL };
+   P_useBaseTables(tables);
+   registry.close();
+}
+
+//
+// Use the built-in thingtypes of the named game. Returns false if there is
+// no such game.
+//
+bool P_UseBuiltinThingTypes(const char *game)
+{
+   for(size_t i = 0; i < earrlen(thinggames); i++)
+   {
+      const thinggame_t &tg = thinggames[i];
+
+      if(!strcasecmp(tg.name, game))
+      {
+         thingtables_t tables = { tg.types, tg.numtypes, tg.numtypes, tg.names,
+                                  tg.attrs, NULL };
+         P_useBaseTables(tables);
+         P_freeScriptTables();
+         registry.close();
+         return true;
+      }
+   }
+
+   return false;
+}
+
+//
+// Get the names of the built-in games, separated by |, for usage messages.
+//
+const char *P_BuiltinThingTypesNames()
+{
+   static qstring names;
+
+   if(names.empty())
+   {
+      for(size_t i = 0; i < earrlen(thinggames); i++)
+      {
+         if(i)
+            names += '|';
+         names += thinggames[i].name;
+      }
+   }
+
+   return names.constPtr();
+}
+
+//
+// Go back to the base tables, without any archive's changes.
+//
+void P_ResetThingTypes()
+{
+   if(thingtables.types != basetables.types)
+   {
+      thingtables = basetables;
+      P_freeArchiveTables();
+   }
+}
+
+//
+// Merge DeHackEd thing changes into the base tables. A changed DoomEd number
+// moves the mobjinfo entry's base thingtype to the new number, and changed
+// Bits can make it a monster, or no longer one. Mobjinfo entries without a
+// base thingtype get a new one when changed, named after the DeHackEd thing.
+// With no changes, the base tables are used as they are.
+//
+void P_SetDEHThings(const dehthing_t *edits, size_t numedits)
+{
+   if(!numedits)
+   {
+      P_ResetThingTypes();
+      return;
+   }
+
+   // find each mobjinfo entry's final DoomEd number and its changes
+   const dehthing_t **mobjedits = 
+      ecalloc(const dehthing_t **, deh_nummobjinfo, sizeof(dehthing_t *));
+   for(size_t i = 0; i < numedits; i++)
+   {
+      if(edits[i].mobjnum >= 1 && edits[i].mobjnum <= deh_nummobjinfo)
+         mobjedits[edits[i].mobjnum - 1] = &edits[i];
+   }
+
+   // base thingtypes of DoomEd numbers no mobjinfo entry has come first, so
+   // that they win over an entry moved onto the same number
+   PODCollection<thingtype_t> types;
+   PODCollection<int>         sources; // base index each type was made from
+   qstring                    newnames;
+
+   for(int i = 0; i < basetables.numtypes; i++)
+   {
+      int  den     = basetables.types[i].doomednum;
+      bool claimed = false;
+
+      for(int m = 0; m < deh_nummobjinfo && !claimed; m++)
+      {
+         if(deh_mobjdoomednums[m] == den)
+            claimed = true;
+      }
+      if(!claimed)
+      {
+         types.add(basetables.types[i]);
+         sources.add(basetables.types[i].index);
+      }
+   }
+
+   int numindices = basetables.numindices;
+   for(int m = 0; m < deh_nummobjinfo; m++)
+   {
+      const dehthing_t  *edit = mobjedits[m];
+      int                den  = deh_mobjdoomednums[m];
+      const thingtype_t *base = den >= 0 ? P_searchThingType(basetables, den) : NULL;
+      thingtype_t        tt;
+
+      if(edit && (edit->fields & DEH_THING_ID))
+         den = edit->doomednum;
+      if(den < 0)
+         continue;
+
+      if(base)
+      {
+         tt = *base;
+         sources.add(base->index);
+      }
+      else if(edit)
+      {
+         // a new thingtype, named after the DeHackEd thing
+         tt.doomednum = den;
+         tt.classtype = CLASS_NONE;
+         tt.nameofs   = static_cast<int>(newnames.length());
+         tt.index     = numindices++;
+         if(edit->name[0])
+            newnames += edit->name;
+         else
+         {
+            qstring name;
+            name.Printf(0, "Thing %d", edit->mobjnum);
+            newnames += name;
+         }
+         newnames += '\n';
+         sources.add(-1);
+      }
+      else
+         continue;
+
+      tt.doomednum = den;
+      if(edit && (edit->fields & DEH_THING_BITS))
+      {
+         if(edit->bits & DEH_MF_COUNTKILL)
+            tt.classtype = CLASS_MONSTER;
+         else if(tt.classtype == CLASS_MONSTER && !(edit->bits & DEH_MF_SHOOTABLE))
+            tt.classtype = CLASS_DECOR;
+      }
+      types.add(tt);
+   }
+   efree(mobjedits);
+
+   P_buildArchiveTables(basetables, types, sources, newnames, numindices);
+}
+
+//
+// Merge thingtypes defined by an archive into the tables in use. Each
+// replaces any thingtype with its DoomEd number, keeping that one's class if
+// it has none of its own. Later definitions of a number replace earlier
+// ones. Their attributes are 0.
+//
+void P_AddThingDefs(const thingdef_t *defs, size_t numdefs)
+{
+   if(!numdefs)
+      return;
+
+   PODCollection<thingtype_t> types;
+   PODCollection<int>         sources; // index each type was made from
+   qstring                    newnames;
+   int                        numindices = thingtables.numindices;
+
+   // definitions come first, the last of each number before the others
+   for(size_t i = numdefs; i-- > 0; )
+   {
+      const thingdef_t  &def = defs[i];
+      const thingtype_t *old = P_ThingTypeForDEN(def.doomednum);
+      thingtype_t        tt;
+
+      tt.doomednum = def.doomednum;
+      tt.classtype = (def.classtype == CLASS_NONE && old) ? old->classtype : def.classtype;
+      tt.nameofs   = static_cast<int>(newnames.length());
+      tt.index     = numindices++;
+      newnames += def.name;
+      newnames += '\n';
+      types.add(tt);
+      sources.add(-1);
+   }
+
+   for(int i = 0; i < thingtables.numtypes; i++)
+   {
+      types.add(thingtables.types[i]);
+      sources.add(thingtables.types[i].index);
+   }
+
+   P_buildArchiveTables(thingtables, types, sources, newnames, numindices);
 }
 
 //
 // Find a thingtype definition for the given DoomEd number. Returns null if not
 // defined by the loaded game configuration.
 //
-thingtype_t *P_ThingTypeForDEN(int doomednum)
+const thingtype_t *P_ThingTypeForDEN(int doomednum)
+{
+   unsigned int slot = static_cast<unsigned int>(doomednum) - 
+                       static_cast<unsigned int>(DENLOOKUP_MIN);
+
+   if(slot < DENLOOKUP_SIZE)
+   {
+      uint32_t pos = thingtables.lookup[slot];
+      return pos ? &thingtables.types[pos - 1] : NULL;
+   }
+
+   return P_searchThingType(thingtables, doomednum);
+}
+
+//
+// Get the name of a thingtype.
+//
+const char *P_NameForThingType(const thingtype_t *tt)
+{
+   return thingtables.names + tt->nameofs;
+}
+
+//
+// Get the script keyword for a thingtype class.
+//
+const char *P_NameForThingClass(int classtype)
+{
+   return (classtype >= 0 && classtype < CLASS_MAX) ? classnames[classtype] : classnames[CLASS_NONE];
+}
+
+//
+// Get the script keyword for a thingtype attribute, without its $.
+//
+const char *P_NameForThingAttr(int attr)
+{
+   return (attr >= 0 && attr < NUM_THINGATTRS) ? attrnames[attr] + 1 : "";
+}
+
+//
+// Number of dense thingtype indices; they run from 0 to one less than this.
+// DeHackEd changes can leave some unused, or add more.
+//
+int P_NumThingTypes()
+{
+   return thingtables.numindices;
+}
+
+//
+// Get the value of an attribute for every thingtype, by dense index.
+//
+const int *P_ThingAttrVector(int attr)
 {
-   return thingtable.objectForKey(doomednum);
+   return thingtables.attrs + attr * thingtables.numindices;
 }
 
 // EOF
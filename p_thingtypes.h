@@ -26,7 +26,6 @@
 #ifndef P_THINGTYPES_H__
 #define P_THINGTYPES_H__
 
-#include "m_dllist.h"
 
 // thingtype classes for output purposes
 enum
@@ -49,16 +48,54 @@ enum
    CLASS_MAX
 };
 
+// Numeric thingtype attributes, which counts can be weighted by
+enum
+{
+   THINGATTR_HP,     // hit points ($hp)
+   THINGATTR_DAMAGE, // damage the ammo it gives can deal ($damage)
+   THINGATTR_HEALTH, // health it gives ($health)
+   THINGATTR_ARMOR,  // armor points it gives ($armor)
+   NUM_THINGATTRS
+};
+
+//
+// Thingtypes are kept in arrays sorted by DoomEd number, so the built-in
+// tables can be constant data. Names are kept back to back in one block.
+//
 struct thingtype_t
 {
-   DLListItem<thingtype_t> links;
    int doomednum;
    int classtype;
+   int nameofs; // offset of the name; see P_NameForThingType
+   int index;   // dense index, in order of DoomEd number
+};
+
+//
+// A thingtype an archive defines, such as a DECORATE actor
+//
+struct thingdef_t
+{
+   int         doomednum;
+   int         classtype; // CLASS_NONE if not known
    const char *name;
 };
 
+struct dehthing_t;
+
 void P_LoadThingTypes(const char *filename);
-thingtype_t *P_ThingTypeForDEN(int doomednum);
+bool P_UseBuiltinThingTypes(const char *game);
+const char *P_BuiltinThingTypesNames();
+bool P_WriteThingRegistry(const char *filename);
+void P_SetDEHThings(const dehthing_t *edits, size_t numedits);
+void P_AddThingDefs(const thingdef_t *defs, size_t numdefs);
+void P_ResetThingTypes();
+
+const thingtype_t *P_ThingTypeForDEN(int doomednum);
+const char  *P_NameForThingType(const thingtype_t *tt);
+const char  *P_NameForThingClass(int classtype);
+const char  *P_NameForThingAttr(int attr);
+int          P_NumThingTypes();
+const int   *P_ThingAttrVector(int attr);
 
 #endif
 
@@ -0,0 +1,526 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Thing extraction from UDMF maps.
+//
+//      The TEXTMAP lump is streamed through a scanner which only parses
+//      thing blocks; every other block is skipped by searching for its
+//      closing brace, stepping over strings and comments on the way.
+//
+//-----------------------------------------------------------------------------
+
+#include "z_zone.h"
+#include "i_system.h"
+#include "m_collection.h"
+#include "m_ctype.h"
+#include "p_udmf.h"
+#include "w_levels.h"
+#include "w_wad.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UDMF_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Index of the lowest set bit of a nonzero mask
+static inline int P_lowestBit(unsigned int mask)
+{
+#ifdef _MSC_VER
+   unsigned long bit;
+   _BitScanForward(&bit, mask);
+   return static_cast<int>(bit);
+#else
+   return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+//
+// P_findChar3
+//
+// Find the first of three characters, or end if there is none. This is
+// where the scanner spends nearly all of its time, so it looks at 16 bytes
+// at once where it can.
+//
+static const char *P_findChar3(const char *p, const char *end, char a, char b, char c)
+{
+#ifdef UDMF_SSE2
+   const __m128i as = _mm_set1_epi8(a);
+   const __m128i bs = _mm_set1_epi8(b);
+   const __m128i cs = _mm_set1_epi8(c);
+
+   for(; end - p >= 16; p += 16)
+   {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+      __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, as),
+                                                _mm_cmpeq_epi8(block, bs)),
+                                   _mm_cmpeq_epi8(block, cs));
+      unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(found));
+      if(mask)
+         return p + P_lowestBit(mask);
+   }
+#endif
+   for(; p != end; ++p)
+   {
+      if(*p == a || *p == b || *p == c)
+         break;
+   }
+   return p;
+}
+
+//
+// P_skipString
+//
+// p is just past the opening quote of a string. Returns the position after
+// the closing quote, or NULL if the string does not end before end.
+//
+static const char *P_skipString(const char *p, const char *end)
+{
+   for(;;)
+   {
+      if((p = P_findChar3(p, end, '"', '\\', '"')) == end)
+         return NULL;
+      if(*p == '"')
+         return p + 1;
+      if((p += 2) >= end) // escaped character
+         return NULL;
+   }
+}
+
+//
+// P_skipComment
+//
+// p is at a '/'. If it starts a comment, returns the position after it, or
+// NULL if the comment does not end before end; otherwise returns p + 1.
+//
+static const char *P_skipComment(const char *p, const char *end)
+{
+   if(p + 1 == end)
+      return NULL;
+
+   if(p[1] == '/')
+   {
+      const void *nl = memchr(p + 2, '\n', end - p - 2);
+      return nl ? static_cast<const char *>(nl) + 1 : NULL;
+   }
+
+   if(p[1] == '*')
+   {
+      for(p += 2; (p = static_cast<const char *>(memchr(p, '*', end - p))); ++p)
+      {
+         if(p + 1 == end)
+            return NULL;
+         if(p[1] == '/')
+            return p + 2;
+      }
+      return NULL;
+   }
+
+   return p + 1;
+}
+
+//
+// P_skipSpace
+//
+// Skip whitespace and comments. If a comment does not end before end, more
+// is set, and the start of the comment is returned.
+//
+static inline const char *P_skipSpace(const char *p, const char *end, bool &more)
+{
+   more = false;
+
+   // usually there is nothing to skip, or a single space
+   if(p != end && *p == ' ')
+      ++p;
+   if(p != end && *p > ' ' && *p != '/')
+      return p;
+
+   for(;;)
+   {
+      while(p != end && ectype::isSpace(*p))
+         ++p;
+      if(p == end || *p != '/')
+         return p;
+
+      const char *next = P_skipComment(p, end);
+      if(!next)
+      {
+         more = true;
+         return p;
+      }
+      if(next == p + 1) // not a comment
+         return p;
+      p = next;
+   }
+}
+
+//
+// P_findBlockEnd
+//
+// p is inside a block. Returns the position of the brace closing it, or NULL
+// if it does not end before end; resume is then the position from which
+// the search can carry on once more data is available.
+//
+static const char *P_findBlockEnd(const char *p, const char *end, const char *&resume)
+{
+   for(;;)
+   {
+      if((p = P_findChar3(p, end, '}', '"', '/')) == end)
+      {
+         resume = end;
+         return NULL;
+      }
+
+      const char *next;
+      if(*p == '}')
+         return p;
+      else if(*p == '"')
+         next = P_skipString(p + 1, end);
+      else
+         next = P_skipComment(p, end);
+
+      if(!next)
+      {
+         resume = p;
+         return NULL;
+      }
+      p = next;
+   }
+}
+
+static inline bool P_isIdentStart(char c)
+{
+   return ectype::isAlpha(c) || c == '_';
+}
+
+static inline bool P_isIdent(char c)
+{
+   return ectype::isAlnum(c) || c == '_';
+}
+
+//
+// P_parseAssignment
+//
+// Parse "key = value;" starting at p, which must be at the key. Strings are
+// returned without their quotes. Returns the position after the ';', or
+// NULL if the assignment is malformed or does not end before end.
+//
+static const char *P_parseAssignment(const char *p, const char *end,
+                                     const char *&key,   size_t &keylen,
+                                     const char *&value, size_t &valuelen,
+                                     bool &isstring)
+{
+   bool more;
+
+   key = p;
+   while(p != end && P_isIdent(*p))
+      ++p;
+   keylen = p - key;
+
+   p = P_skipSpace(p, end, more);
+   if(p == end || *p != '=')
+      return NULL;
+
+   p = P_skipSpace(p + 1, end, more);
+   if(p == end)
+      return NULL;
+
+   if((isstring = (*p == '"')))
+   {
+      value = p + 1;
+      if(!(p = P_skipString(value, end)))
+         return NULL;
+      valuelen = p - value - 1;
+   }
+   else
+   {
+      value = p;
+      while(p != end && *p != ';' && *p != '/' && !ectype::isSpace(*p))
+         ++p;
+      valuelen = p - value;
+   }
+
+   p = P_skipSpace(p, end, more);
+   if(p == end || *p != ';')
+      return NULL;
+
+   return p + 1;
+}
+
+//
+// Get the UDMF_ flag set by a key, if any.
+//
+static unsigned int P_flagForKey(const char *key, size_t keylen)
+{
+   switch(keylen)
+   {
+   case 2:
+      if(!strncasecmp(key, "dm", 2))
+         return UDMF_DM;
+      break;
+   case 4:
+      if(!strncasecmp(key, "coop", 4))
+         return UDMF_COOP;
+      break;
+   case 6:
+      if(!strncasecmp(key, "single", 6))
+         return UDMF_SINGLE;
+      if(key[5] >= '1' && key[5] <= '5' && !strncasecmp(key, "skill", 5))
+         return UDMF_SKILL1 << (key[5] - '1');
+      if(key[5] >= '1' && key[5] <= '3' && !strncasecmp(key, "class", 5))
+         return UDMF_CLASS1 << (key[5] - '1');
+      break;
+   default:
+      break;
+   }
+
+   return 0;
+}
+
+//
+// P_parseThing
+//
+// Parse the body of a thing block, from just after its opening brace up to
+// its closing brace. Returns false if it is malformed.
+//
+static bool P_parseThing(const char *p, const char *end, udmfmap_t &map)
+{
+   udmfthing_t thing = { 0, 0 };
+   bool more;
+
+   while((p = P_skipSpace(p, end, more)) != end)
+   {
+      const char *key, *value;
+      size_t keylen, valuelen;
+      bool isstring;
+
+      if(!P_isIdentStart(*p) ||
+         !(p = P_parseAssignment(p, end, key, keylen, value, valuelen, isstring)))
+         return false;
+
+      unsigned int flag;
+      if(keylen == 4 && !strncasecmp(key, "type", 4))
+      {
+         // the value is followed by at least the ';', so strtol stops in time
+         thing.type = static_cast<int>(strtol(value, NULL, 0));
+      }
+      else if((flag = P_flagForKey(key, keylen)))
+      {
+         if(valuelen == 4 && !strncasecmp(value, "true", 4))
+            thing.flags |= flag;
+         else
+            thing.flags &= ~flag;
+      }
+   }
+
+   map.things.add(thing);
+   return true;
+}
+
+//
+// UDMFThingScanner
+//
+// Receives a TEXTMAP lump from WadDirectory::streamLump. Anything which has
+// to be looked at in one piece - a thing block, a global assignment, or the
+// start of a block - is left unused until all of it is available; other
+// blocks are skipped as data arrives.
+//
+class UDMFThingScanner : public WadLumpStreamer
+{
+protected:
+   udmfmap_t  &map;
+   bool        inblock;     // inside a block which is being skipped
+   bool        failed;      // the lump is malformed
+   size_t      offset;      // lump offset of the data being consumed
+   size_t      erroroffset; // lump offset of the problem, if failed
+   const char *base;        // start of the data being consumed
+
+   //
+   // Record the value of a global assignment
+   //
+   void setGlobal(const char *key, size_t keylen, const char *value,
+                  size_t valuelen, bool isstring)
+   {
+      if(keylen == 9 && isstring && !strncasecmp(key, "namespace", 9))
+      {
+         if(valuelen >= sizeof(map.nspace))
+            valuelen = sizeof(map.nspace) - 1;
+         for(size_t i = 0; i < valuelen; i++)
+            map.nspace[i] = static_cast<char>(ectype::toLower(value[i]));
+         map.nspace[valuelen] = '\0';
+      }
+   }
+
+   //
+   // Parse everything at the top level, ie. outside any block, from p.
+   // Returns the position parsing stopped at: just inside a block to skip,
+   // at the start of something which needs more data, or at the end.
+   //
+   const char *scanTopLevel(const char *p, const char *end, bool last)
+   {
+      bool more;
+
+      while(!inblock)
+      {
+         const char *unit = p = P_skipSpace(p, end, more);
+
+         if(p == end || more) // a comment running to the end of the lump is fine
+            return last ? end : p;
+
+         if(!P_isIdentStart(*p))
+            return fail(p);
+
+         const char *name = p;
+         while(p != end && P_isIdent(*p))
+            ++p;
+         size_t namelen = p - name;
+
+         p = P_skipSpace(p, end, more);
+         if(p == end || more)
+            return last ? fail(p) : unit;
+
+         if(*p == '{')
+         {
+            if(namelen == 5 && !strncasecmp(name, "thing", 5))
+            {
+               const char *resume;
+               const char *close = P_findBlockEnd(p + 1, end, resume);
+
+               if(!close)
+                  return last ? fail(p) : unit;
+               if(!P_parseThing(p + 1, close, map))
+                  return fail(p);
+               p = close + 1;
+            }
+            else
+            {
+               inblock = true;
+               ++p;
+            }
+         }
+         else if(*p == '=')
+         {
+            const char *key, *value;
+            size_t keylen, valuelen;
+            bool isstring;
+
+            if(!(p = P_parseAssignment(name, end, key, keylen, value, valuelen,
+                                       isstring)))
+               return last ? fail(unit) : unit;
+            setGlobal(key, keylen, value, valuelen, isstring);
+         }
+         else
+            return fail(p);
+      }
+
+      return p;
+   }
+
+   //
+   // Note that the lump is malformed at p, and stop.
+   //
+   const char *fail(const char *p)
+   {
+      failed      = true;
+      erroroffset = p - base;
+      return p;
+   }
+
+public:
+   UDMFThingScanner(udmfmap_t &pMap)
+      : WadLumpStreamer(), map(pMap), inblock(false), failed(false), offset(0),
+        erroroffset(0), base(NULL)
+   {
+   }
+
+   virtual size_t consume(const byte *data, size_t size, bool last)
+   {
+      if(failed) // ignore the rest of the lump
+         return size;
+
+      const char *p   = base = reinterpret_cast<const char *>(data);
+      const char *end = p + size;
+
+      for(;;)
+      {
+         if(inblock)
+         {
+            const char *resume;
+            const char *close = P_findBlockEnd(p, end, resume);
+            if(!close)
+            {
+               p = resume;
+               break;
+            }
+            p = close + 1;
+            inblock = false;
+         }
+
+         // this returns early only at the start of a block to skip
+         p = scanTopLevel(p, end, last);
+         if(failed || !inblock)
+            break;
+      }
+
+      if(failed)
+      {
+         erroroffset += offset;
+         return size;
+      }
+
+      if(last && inblock)
+      {
+         failed      = true;
+         erroroffset = offset + size;
+      }
+
+      offset += p - base;
+      return p - base;
+   }
+
+   bool   hasFailed()      const { return failed;      }
+   size_t getErrorOffset() const { return erroroffset; }
+};
+
+//
+// P_ScanUDMFThings
+//
+// Extract the namespace and things of a UDMF level.
+//
+void P_ScanUDMFThings(wadlevel_t &wl, udmfmap_t &map)
+{
+   UDMFThingScanner scanner(map);
+
+   memset(map.nspace, 0, sizeof(map.nspace));
+   map.things.makeEmpty();
+
+   wl.dir->streamLump(wl.lumpnum + ML_TEXTMAP, scanner);
+
+   if(scanner.hasFailed())
+   {
+      I_Error("P_ScanUDMFThings: TEXTMAP of %s is malformed at offset %d\n",
+              wl.header, (int)scanner.getErrorOffset());
+   }
+}
+
+// EOF
@@ -0,0 +1,66 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Thing extraction from UDMF maps
+//
+//-----------------------------------------------------------------------------
+
+#ifndef P_UDMF_H__
+#define P_UDMF_H__
+
+#include "m_collection.h"
+
+struct wadlevel_t;
+
+// Flags of a UDMF thing; each is set if its key is true
+enum
+{
+   UDMF_SKILL1 = 0x0001,
+   UDMF_SKILL2 = 0x0002,
+   UDMF_SKILL3 = 0x0004,
+   UDMF_SKILL4 = 0x0008,
+   UDMF_SKILL5 = 0x0010,
+   UDMF_SINGLE = 0x0020,
+   UDMF_COOP   = 0x0040,
+   UDMF_DM     = 0x0080,
+   UDMF_CLASS1 = 0x0100,
+   UDMF_CLASS2 = 0x0200,
+   UDMF_CLASS3 = 0x0400
+};
+
+struct udmfthing_t
+{
+   int          type;  // doomednum
+   unsigned int flags; // UDMF_ flags
+};
+
+struct udmfmap_t
+{
+   char nspace[32];                   // namespace, in lower case
+   PODCollection<udmfthing_t> things; // in the order they are defined
+};
+
+void P_ScanUDMFThings(wadlevel_t &wl, udmfmap_t &map);
+
+#endif
+
+// EOF
+
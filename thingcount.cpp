@@ -0,0 +1,505 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      libthingcount: counting things from other programs
+//
+//   Archives are loaded and levels counted without touching any of the
+//   state the command line program uses for its report. The one thing
+//   every thread shares is the thingtypes, which archives with DeHackEd or
+//   thingtype definition lumps change for as long as they are being
+//   counted; see TCThingTypesLock.
+//
+//-----------------------------------------------------------------------------
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "z_zone.h"
+#include "d_deh.h"
+#include "i_system.h"
+#include "m_textbuf.h"
+#include "p_compat.h"
+#include "p_report.h"
+#include "p_things.h"
+#include "p_thingtypes.h"
+#include "thingcount.h"
+#include "w_levels.h"
+#include "w_wad.h"
+#include "xl_ednums.h"
+
+static_assert(static_cast<int>(TC_GAMETYPE_SINGLE) == GAME_TYPE_SINGLE &&
+              static_cast<int>(TC_GAMETYPE_COOP)   == GAME_TYPE_COOP   &&
+              static_cast<int>(TC_GAMETYPE_DM)     == GAME_TYPE_DM,
+              "game types differ from p_report.h");
+static_assert(static_cast<int>(TC_PCLASS_FIGHTER) == CLASS_FIGHTER &&
+              static_cast<int>(TC_PCLASS_CLERIC)  == CLASS_CLERIC  &&
+              static_cast<int>(TC_PCLASS_MAGE)    == CLASS_MAGE,
+              "player classes differ from p_report.h");
+static_assert(static_cast<int>(TC_FORMAT_DOOM)   == LEVEL_FORMAT_DOOM   &&
+              static_cast<int>(TC_FORMAT_HEXEN)  == LEVEL_FORMAT_HEXEN  &&
+              static_cast<int>(TC_FORMAT_PSX)    == LEVEL_FORMAT_PSX    &&
+              static_cast<int>(TC_FORMAT_DOOM64) == LEVEL_FORMAT_DOOM64 &&
+              static_cast<int>(TC_FORMAT_UDMF)   == LEVEL_FORMAT_UDMF,
+              "level formats differ from w_levels.h");
+
+//=============================================================================
+//
+// Thingtypes
+//
+
+//
+// TCThingTypesLock
+//
+// Counting only reads the thingtypes, so any number of threads may count at
+// once. Applying an archive's changes needs them to itself, until they are
+// reset again once the archive has been counted.
+//
+class TCThingTypesLock
+{
+protected:
+   std::mutex              lock;
+   std::condition_variable released;
+   int                     readers;
+   bool                    writer;
+
+public:
+   TCThingTypesLock() : lock(), released(), readers(0), writer(false) {}
+
+   void lockShared()
+   {
+      std::unique_lock<std::mutex> guard(lock);
+      while(writer)
+         released.wait(guard);
+      ++readers;
+   }
+
+   void unlockShared()
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      if(!--readers)
+         released.notify_all();
+   }
+
+   void lockExclusive()
+   {
+      std::unique_lock<std::mutex> guard(lock);
+      while(writer || readers)
+         released.wait(guard);
+      writer = true;
+   }
+
+   void unlockExclusive()
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      writer = false;
+      released.notify_all();
+   }
+};
+
+static TCThingTypesLock thingtypeslock;
+
+// set once tc_init has succeeded
+static std::atomic<bool> initialized;
+
+//=============================================================================
+//
+// Archives
+//
+
+struct tc_archive
+{
+   WadDirectory  dir;
+   wadlevel_t   *levels;       // terminated by one without a directory
+   int           numlevels;
+   bool          usedeh;       // apply DEHACKED lumps
+   bool          usedefs;      // add DECORATE, ZSCRIPT and MAPINFO thingtypes
+   bool          changestypes; // either of those changes the thingtypes
+   levelthings_t things;       // of the level being counted
+};
+
+//
+// TCThingTypesScope
+//
+// Holds the thingtypes for as long as an archive is being counted, with the
+// archive's own changes applied if it has any.
+//
+class TCThingTypesScope
+{
+protected:
+   bool exclusive;
+
+public:
+   TCThingTypesScope(tc_archive &archive) : exclusive(archive.changestypes)
+   {
+      if(!exclusive)
+      {
+         thingtypeslock.lockShared();
+         return;
+      }
+
+      thingtypeslock.lockExclusive();
+      try
+      {
+         D_ApplyDEH(archive.dir, archive.usedeh);
+         if(archive.usedefs)
+            XL_HarvestThingDefs(archive.dir);
+      }
+      catch(...)
+      {
+         P_ResetThingTypes();
+         thingtypeslock.unlockExclusive();
+         throw;
+      }
+   }
+
+   ~TCThingTypesScope()
+   {
+      if(exclusive)
+      {
+         P_ResetThingTypes();
+         thingtypeslock.unlockExclusive();
+      }
+      else
+         thingtypeslock.unlockShared();
+   }
+};
+
+//
+// TCRowFormatter
+//
+// Passes each row of the tables output for a level to the callback, until
+// it asks to stop.
+//
+class TCRowFormatter : public ReportFormatter
+{
+protected:
+   TextBuffer      text; // unused; rows are never formatted
+   tc_row          current;
+   tc_row_callback callback;
+   void           *context;
+   bool            stopped;
+
+public:
+   TCRowFormatter(tc_row_callback pCallback, void *pContext)
+      : ReportFormatter(text), text(), current(), callback(pCallback),
+        context(pContext), stopped(false)
+   {
+   }
+
+   bool isStopped() const { return stopped; }
+
+   virtual void beginLevel(const char *mapname)
+   {
+      current.map = mapname;
+   }
+
+   virtual void beginTable(int gametype, int pclass)
+   {
+      current.gametype = gametype;
+      current.pclass   = pclass;
+   }
+
+   virtual void row(const reportrow_t &row)
+   {
+      if(stopped)
+         return;
+
+      current.doomednum = row.doomednum;
+      current.name      = row.name;
+      current.classtype = row.classtype;
+      current.classname = P_NameForThingClass(row.classtype);
+      memcpy(current.counts, row.counts, sizeof(current.counts));
+
+      if(callback(context, &current))
+         stopped = true;
+   }
+};
+
+// Message of the last error on each thread
+static THREADLOCAL char lasterror[1024];
+
+//
+// Keep an error message for tc_error, without the line break I_Error
+// messages end with.
+//
+static void TC_setError(const char *message)
+{
+   size_t len = strlen(message);
+
+   while(len && (message[len - 1] == '\n' || message[len - 1] == '\r'))
+      --len;
+   if(len >= sizeof(lasterror))
+      len = sizeof(lasterror) - 1;
+
+   memcpy(lasterror, message, len);
+   lasterror[len] = '\0';
+}
+
+//
+// Find the levels of a newly loaded archive, and whether it changes the
+// thingtypes.
+//
+static void TC_initArchive(tc_archive &archive, unsigned int flags)
+{
+   archive.levels    = W_FindAllMapsInLevelWad(&archive.dir);
+   archive.numlevels = 0;
+   while(archive.levels[archive.numlevels].dir)
+      ++archive.numlevels;
+
+   archive.usedeh       = !(flags & TC_OPEN_NODEH);
+   archive.usedefs      = !(flags & TC_OPEN_NODEFS);
+   archive.changestypes = D_ChangesThingTypes(archive.dir, archive.usedeh) ||
+                          (archive.usedefs && XL_HasThingDefs(archive.dir));
+}
+
+//
+// Load an archive from a file, or from memory if data is not NULL.
+//
+static tc_archive *TC_openArchive(const char *path, const void *data, size_t size,
+                                  unsigned int flags)
+{
+   if(!initialized)
+   {
+      TC_setError("tc_init has not been called");
+      return NULL;
+   }
+
+   tc_archive *archive = new tc_archive();
+
+   try
+   {
+      IRecoverableScope scope;
+      bool loaded;
+
+      if(data)
+      {
+         loaded = archive->dir.addNewPrivateMemoryFile(const_cast<void *>(data), size,
+                                                       WFA_OPENFAILFATAL);
+      }
+      else
+         loaded = archive->dir.addNewPrivateFile(path, WFA_OPENFAILFATAL);
+
+      if(!loaded)
+         I_Error("Could not load input file '%s'\n", data ? "memory" : path);
+
+      TC_initArchive(*archive, flags);
+   }
+   catch(const I_ErrorException &err)
+   {
+      TC_setError(err.GetMessage());
+      tc_close(archive);
+      archive = NULL;
+   }
+
+   Z_FreeAlloca();
+
+   return archive;
+}
+
+//
+// Count the things of a range of levels. Returns 0 when done, 1 if the
+// callback stopped it, or -1 on error.
+//
+static int TC_countLevels(tc_archive *archive, int first, int last, int gametype,
+                          int pclass, tc_row_callback callback, void *context)
+{
+   if(gametype < -1 || gametype >= NUM_GAME_TYPES)
+   {
+      TC_setError("Unknown game type");
+      return -1;
+   }
+   if(pclass < -1 || pclass >= NUM_CLASSES)
+   {
+      TC_setError("Unknown player class");
+      return -1;
+   }
+   if(!callback)
+   {
+      TC_setError("No callback to count with");
+      return -1;
+   }
+
+   TCRowFormatter fmt(callback, context);
+   int result = 0;
+
+   try
+   {
+      IRecoverableScope  scope;
+      TCThingTypesScope  types(*archive);
+
+      for(int i = first; i < last && !fmt.isStopped(); i++)
+      {
+         wadlevel_t &wl = archive->levels[i];
+
+         P_LoadLevelThings(wl, archive->things);
+         fmt.beginLevel(wl.header);
+         P_CountLevelThings(archive->things, gametype, pclass, fmt);
+         fmt.endLevel();
+      }
+      if(fmt.isStopped())
+         result = 1;
+   }
+   catch(const I_ErrorException &err)
+   {
+      TC_setError(err.GetMessage());
+      result = -1;
+   }
+
+   P_FreeLevelThings(archive->things);
+   Z_FreeAlloca();
+
+   return result;
+}
+
+//=============================================================================
+//
+// Library interface
+//
+
+//
+// Set up the thingtypes to count with. Returns 0 on success, or -1 on error.
+//
+int tc_init(const char *game, const char *script)
+{
+   static bool zoneinit;
+   int result = 0;
+
+   thingtypeslock.lockExclusive();
+
+   if(!zoneinit)
+   {
+      Z_Init();
+      zoneinit = true;
+   }
+
+   try
+   {
+      IRecoverableScope scope;
+
+      if(script)
+         P_LoadThingTypes(script);
+      else if(!P_UseBuiltinThingTypes(game ? game : "doom"))
+      {
+         I_Error("Unknown game '%s'; built-in games are %s\n", game,
+                 P_BuiltinThingTypesNames());
+      }
+      P_SetCompat(COMPAT_AUTO);
+      initialized = true;
+   }
+   catch(const I_ErrorException &err)
+   {
+      TC_setError(err.GetMessage());
+      result = -1;
+   }
+
+   thingtypeslock.unlockExclusive();
+   Z_FreeAlloca();
+
+   return result;
+}
+
+//
+// The message of the last error on the calling thread
+//
+const char *tc_error(void)
+{
+   return lasterror;
+}
+
+tc_archive *tc_open_file(const char *path, unsigned int flags)
+{
+   if(!path)
+   {
+      TC_setError("No file to open");
+      return NULL;
+   }
+   return TC_openArchive(path, NULL, 0, flags);
+}
+
+tc_archive *tc_open_memory(const void *data, size_t size, unsigned int flags)
+{
+   if(!data)
+   {
+      TC_setError("No buffer to open");
+      return NULL;
+   }
+   return TC_openArchive(NULL, data, size, flags);
+}
+
+void tc_close(tc_archive *archive)
+{
+   if(!archive)
+      return;
+
+   P_FreeLevelThings(archive->things);
+   if(archive->levels)
+      efree(archive->levels);
+   archive->dir.close();
+   delete archive;
+}
+
+int tc_num_levels(const tc_archive *archive)
+{
+   return archive->numlevels;
+}
+
+//
+// Header lump name of a level, or NULL if there is no such level
+//
+const char *tc_level_name(const tc_archive *archive, int level)
+{
+   if(level < 0 || level >= archive->numlevels)
+      return NULL;
+   return archive->levels[level].header;
+}
+
+//
+// TC_FORMAT_* value of a level, or -1 if there is no such level
+//
+int tc_level_format(const tc_archive *archive, int level)
+{
+   if(level < 0 || level >= archive->numlevels)
+      return -1;
+   return archive->levels[level].fmt;
+}
+
+int tc_count_level(tc_archive *archive, int level, int gametype, int pclass,
+                   tc_row_callback callback, void *context)
+{
+   if(level < 0 || level >= archive->numlevels)
+   {
+      TC_setError("No such level");
+      return -1;
+   }
+   return TC_countLevels(archive, level, level + 1, gametype, pclass, callback,
+                         context);
+}
+
+int tc_count_archive(tc_archive *archive, int gametype, int pclass,
+                     tc_row_callback callback, void *context)
+{
+   return TC_countLevels(archive, 0, archive->numlevels, gametype, pclass,
+                         callback, context);
+}
+
+// EOF
+
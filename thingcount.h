@@ -0,0 +1,141 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      libthingcount: counting things from other programs
+//
+//-----------------------------------------------------------------------------
+
+#ifndef THINGCOUNT_H__
+#define THINGCOUNT_H__
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The shared library exports nothing else
+#if defined(__GNUC__) && !defined(_WIN32)
+#define TC_API __attribute__((visibility("default")))
+#else
+#define TC_API
+#endif
+
+//
+// Library interface
+//
+// Call tc_init before anything else. After that, any number of threads may
+// open and count archives at once, but an archive must be counted and closed
+// on the thread that opened it. Nothing is printed, and results are only
+// ever passed to the callback given to the count functions, a row at a time.
+//
+// Functions that can fail return a negative number or NULL, and leave a
+// message for tc_error on the calling thread.
+//
+
+// Game types
+enum
+{
+   TC_GAMETYPE_SINGLE,
+   TC_GAMETYPE_COOP,
+   TC_GAMETYPE_DM
+};
+
+// Hexen player classes
+enum
+{
+   TC_PCLASS_FIGHTER,
+   TC_PCLASS_CLERIC,
+   TC_PCLASS_MAGE
+};
+
+// Level formats
+enum
+{
+   TC_FORMAT_DOOM = 1,
+   TC_FORMAT_HEXEN,
+   TC_FORMAT_PSX,
+   TC_FORMAT_DOOM64,
+   TC_FORMAT_UDMF
+};
+
+// Flags for tc_open_file and tc_open_memory
+enum
+{
+   TC_OPEN_NODEH  = 0x01, // ignore DEHACKED lumps
+   TC_OPEN_NODEFS = 0x02  // ignore DECORATE, ZSCRIPT and MAPINFO thingtypes
+};
+
+//
+// One thingtype present in one table of a level. Tables are output by game
+// type, and by player class on levels that have them; rows of a table come
+// grouped by thing class. The strings are only valid during the callback.
+//
+typedef struct tc_row
+{
+   const char *map;       // header lump name of the level
+   int         gametype;  // TC_GAMETYPE_*
+   int         pclass;    // TC_PCLASS_*, or -1 if the level has no classes
+   int         doomednum;
+   const char *name;      // thingtype name, or "Unknown"
+   int         classtype; // thing class
+   const char *classname; // name of the thing class
+   int         counts[3]; // number present on easy, normal and hard skill
+} tc_row;
+
+// Return nonzero to stop counting; no more rows are passed after that
+typedef int (*tc_row_callback)(void *context, const tc_row *row);
+
+typedef struct tc_archive tc_archive;
+
+// game is the name of a built-in game, or NULL for "doom". If script is not
+// NULL, the thingtypes are loaded from that script or compiled registry
+// instead.
+TC_API int         tc_init(const char *game, const char *script);
+TC_API const char *tc_error(void);
+
+// The buffer given to tc_open_memory must stay unchanged until the archive
+// is closed. WAD files are read in place.
+TC_API tc_archive *tc_open_file(const char *path, unsigned int flags);
+TC_API tc_archive *tc_open_memory(const void *data, size_t size, unsigned int flags);
+TC_API void        tc_close(tc_archive *archive);
+
+TC_API int         tc_num_levels(const tc_archive *archive);
+TC_API const char *tc_level_name(const tc_archive *archive, int level);
+TC_API int         tc_level_format(const tc_archive *archive, int level);
+
+// Count the things of one level, or of all of them. gametype and pclass
+// limit the tables output to one game type or player class, unless they are
+// -1. Returns 0 when done, 1 if the callback stopped it, or -1 on error.
+// The callback must not count archives itself.
+TC_API int tc_count_level(tc_archive *archive, int level, int gametype, int pclass,
+                          tc_row_callback callback, void *context);
+TC_API int tc_count_archive(tc_archive *archive, int gametype, int pclass,
+                            tc_row_callback callback, void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+// EOF
+
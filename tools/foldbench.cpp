@@ -0,0 +1,344 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Microbenchmarks for the m_casefold kernels
+//
+//   Runs each kernel over 50,001 generated pk3 paths and their lump names,
+//   in mixed case, next to a plain scalar version of the same operation.
+//   The best time of many runs is reported for each. Every pair must also
+//   produce the same result, or the benchmark fails.
+//
+//   Usage: tools/foldbench [-runs n]
+//
+//-----------------------------------------------------------------------------
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../z_zone.h"
+#include "../m_casefold.h"
+#include "../m_ctype.h"
+#include "../m_strcasestr.h"
+
+static const int NUMNAMES = 50001;
+
+static const char *prefixes[] =
+{
+   "flats/", "graphics/", "music/", "sounds/", "sprites/", "textures/", NULL
+};
+
+static int runs = 200;
+
+//
+// FB_generateNames
+//
+// Paths like those of a large pk3: mostly under namespace directories, with
+// 8-character lump names and the case of each letter chosen at random.
+//
+static void FB_generateNames(std::vector<std::string> &paths,
+                             std::vector<std::string> &lumps)
+{
+   static const char *dirs[] =
+   {
+      "", "acs/", "flats/", "graphics/", "maps/", "music/", "sounds/",
+      "sprites/", "textures/"
+   };
+   static const char *stems[] = { "snd_", "TROO", "flat", "wall" };
+   static const char *exts[]  = { ".lmp", ".png", ".txt", ".wad" };
+   unsigned int seed = 7;
+   char buf[64];
+
+   for(int i = 0; i < NUMNAMES; i++)
+   {
+      seed = seed * 1103515245 + 12345;
+      unsigned int r = seed >> 8;
+      psnprintf(buf, sizeof(buf), "%s%s%04d%s", dirs[r % earrlen(dirs)],
+                stems[(r / 16) % earrlen(stems)], i % 10000,
+                exts[(r / 64) % earrlen(exts)]);
+
+      std::string path(buf);
+      for(size_t c = 0; c < path.size(); c++)
+      {
+         seed = seed * 1103515245 + 12345;
+         if((seed >> 16) & 1)
+            path[c] = ectype::toUpper(path[c]);
+      }
+      paths.push_back(path);
+
+      const char *slash = strrchr(buf, '/');
+      std::string lump(slash ? slash + 1 : buf);
+      lump = lump.substr(0, lump.find('.')).substr(0, 8);
+      lump.resize(9, '\0');
+      lumps.push_back(lump);
+   }
+}
+
+//=============================================================================
+//
+// Scalar References
+//
+
+static void FB_lower(char *s, size_t n)
+{
+   for(size_t i = 0; i < n; i++)
+      s[i] = ectype::toLower(s[i]);
+}
+
+static uint64_t FB_key(const char *s)
+{
+   uint64_t key = 0;
+
+   for(int i = 0; i < 8 && s[i]; i++)
+      key |= static_cast<uint64_t>(ectype::toUpper(s[i])) << (i * 8);
+
+   return key;
+}
+
+//
+// Lee Killough's lump name hash, as W_LumpNameHash computed it before the
+// packed key: the eighth character is always added once the seventh is.
+//
+static unsigned int FB_hash(const char *s)
+{
+   unsigned int hash = ectype::toUpper(s[0]);
+
+   for(int i = 1; i < 8 && (s[i] || i == 7); i++)
+      hash = hash * (i == 1 ? 3 : 2) + ectype::toUpper(s[i]);
+
+   return hash;
+}
+
+static const char *FB_strCaseStr(const char *haystack, const char *needle)
+{
+   for(; *haystack; haystack++)
+   {
+      size_t i = 0;
+      while(needle[i] &&
+            ectype::toLower(haystack[i]) == ectype::toLower(needle[i]))
+         ++i;
+      if(!needle[i])
+         return haystack;
+   }
+
+   return *needle ? NULL : haystack;
+}
+
+//=============================================================================
+//
+// Benchmarks
+//
+
+//
+// FB_time
+//
+// Print the best time of body over all runs, and return its result.
+//
+template<typename T> static unsigned long FB_time(const char *label, T body)
+{
+   typedef std::chrono::steady_clock clock;
+   double best = -1.0;
+   unsigned long result = 0;
+
+   for(int r = 0; r < runs; r++)
+   {
+      clock::time_point start = clock::now();
+      result = body();
+      double ms = std::chrono::duration<double, std::milli>(clock::now() -
+                                                            start).count();
+      if(best < 0.0 || ms < best)
+         best = ms;
+   }
+
+   printf("%-32s %9.3f ms\n", label, best);
+   return result;
+}
+
+static bool FB_check(const char *what, unsigned long scalar,
+                     unsigned long kernel)
+{
+   if(scalar == kernel)
+      return true;
+
+   printf("foldbench: %s results differ (%lu, %lu)\n", what, scalar, kernel);
+   return false;
+}
+
+int main(int argc, char **argv)
+{
+   for(int i = 1; i < argc; i++)
+   {
+      if(!strcmp(argv[i], "-runs") && i + 1 < argc)
+         runs = atoi(argv[++i]);
+   }
+   if(runs < 1)
+      runs = 1;
+
+   Z_Init();
+
+   std::vector<std::string> paths, lumps;
+   FB_generateNames(paths, lumps);
+
+   std::vector<std::string> work(paths);
+   std::string joined;
+   for(size_t i = 0; i < paths.size(); i++)
+      joined += paths[i] + '\n';
+
+   const size_t n = paths.size();
+   bool ok = true;
+   unsigned long scalar, kernel;
+
+   printf("foldbench: %lu paths, %lu bytes joined, best of %d runs\n",
+          static_cast<unsigned long>(n),
+          static_cast<unsigned long>(joined.size()), runs);
+
+   scalar = FB_time("lowercase (scalar)", [&] () {
+      unsigned long sum = 0;
+      for(size_t i = 0; i < n; i++)
+      {
+         work[i] = paths[i];
+         FB_lower(&work[i][0], work[i].size());
+         sum += static_cast<unsigned char>(work[i][0]);
+      }
+      return sum;
+   });
+   kernel = FB_time("lowercase (M_FoldLower)", [&] () {
+      unsigned long sum = 0;
+      for(size_t i = 0; i < n; i++)
+      {
+         work[i] = paths[i];
+         M_FoldLower(&work[i][0], work[i].size());
+         sum += static_cast<unsigned char>(work[i][0]);
+      }
+      return sum;
+   });
+   ok &= FB_check("lowercase", scalar, kernel);
+
+   // namespaces are matched against lowercased paths, as zip names are
+   scalar = FB_time("namespace prefix (strncmp)", [&] () {
+      unsigned long sum = 0;
+      for(size_t i = 0; i < n; i++)
+      {
+         for(const char **p = prefixes; *p; p++)
+         {
+            if(!strncmp(work[i].c_str(), *p, strlen(*p)))
+            {
+               sum += p - prefixes + 1;
+               break;
+            }
+         }
+      }
+      return sum;
+   });
+   kernel = FB_time("namespace prefix (M_FoldPrefix)", [&] () {
+      unsigned long sum = 0;
+      for(size_t i = 0; i < n; i++)
+      {
+         for(const char **p = prefixes; *p; p++)
+         {
+            if(M_FoldPrefix(work[i].c_str(), *p))
+            {
+               sum += p - prefixes + 1;
+               break;
+            }
+         }
+      }
+      return sum;
+   });
+   ok &= FB_check("namespace prefix", scalar, kernel);
+
+   scalar = FB_time("key and hash (two passes)", [&] () {
+      unsigned long sum = 0;
+      for(size_t i = 0; i < n; i++)
+         sum += static_cast<unsigned long>(FB_key(lumps[i].c_str()) ^
+                                           FB_hash(lumps[i].c_str()));
+      return sum;
+   });
+   kernel = FB_time("key and hash (M_FoldKey)", [&] () {
+      unsigned long sum = 0;
+      for(size_t i = 0; i < n; i++)
+      {
+         uint64_t key = M_FoldKey(lumps[i].c_str());
+         sum += static_cast<unsigned long>(key ^ M_FoldKeyHash(key));
+      }
+      return sum;
+   });
+   ok &= FB_check("key and hash", scalar, kernel);
+
+   scalar = FB_time("compare lumps (strncasecmp)", [&] () {
+      unsigned long sum = 0;
+      for(size_t i = 1; i < n; i++)
+         sum += strncasecmp(lumps[i].c_str(), lumps[i - 1].c_str(), 9) < 0;
+      return sum;
+   });
+   kernel = FB_time("compare lumps (M_FoldCompare)", [&] () {
+      unsigned long sum = 0;
+      for(size_t i = 1; i < n; i++)
+         sum += M_FoldCompare(lumps[i].c_str(), lumps[i - 1].c_str(), 9) < 0;
+      return sum;
+   });
+   ok &= FB_check("compare lumps", scalar, kernel);
+
+   scalar = FB_time("compare paths (strncasecmp)", [&] () {
+      unsigned long sum = 0;
+      for(size_t i = 1; i < n; i++)
+         sum += strncasecmp(paths[i].c_str(), paths[i - 1].c_str(), 256) < 0;
+      return sum;
+   });
+   kernel = FB_time("compare paths (M_FoldCompare)", [&] () {
+      unsigned long sum = 0;
+      for(size_t i = 1; i < n; i++)
+         sum += M_FoldCompare(paths[i].c_str(), paths[i - 1].c_str(), 256) < 0;
+      return sum;
+   });
+   ok &= FB_check("compare paths", scalar, kernel);
+
+   // a name which is not there, so that the whole list is searched
+   scalar = FB_time("find name (scalar)", [&] () {
+      const char *found = FB_strCaseStr(joined.c_str(), "ZSCRIPT.TXT");
+      return found ? static_cast<unsigned long>(found - joined.c_str()) : 0UL;
+   });
+   kernel = FB_time("find name (M_StrCaseStr)", [&] () {
+      const char *found = M_StrCaseStr(joined.c_str(), "ZSCRIPT.TXT");
+      return found ? static_cast<unsigned long>(found - joined.c_str()) : 0UL;
+   });
+   ok &= FB_check("find name", scalar, kernel);
+
+   scalar = FB_time("find late name (scalar)", [&] () {
+      const char *found = FB_strCaseStr(joined.c_str(), paths[n - 1].c_str());
+      return found ? static_cast<unsigned long>(found - joined.c_str()) : 0UL;
+   });
+   kernel = FB_time("find late name (M_StrCaseStr)", [&] () {
+      const char *found = M_StrCaseStr(joined.c_str(), paths[n - 1].c_str());
+      return found ? static_cast<unsigned long>(found - joined.c_str()) : 0UL;
+   });
+   ok &= FB_check("find late name", scalar, kernel);
+
+   if(!ok)
+   {
+      printf("foldbench: FAILED\n");
+      return 1;
+   }
+
+   return 0;
+}
+
+// EOF
@@ -0,0 +1,422 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Leak check for reusing one WadDirectory across many archives
+//
+//   Opens, scans, caches, and resets each archive 10,000 times through one
+//   directory, as -file does with several archives. Afterward, the number of
+//   descriptors open must be what it was at the start. Under glibc, the heap
+//   in use must also not have grown since the warm-up iterations. Archives
+//   may be given on the command line; by default a WAD and a PK3 holding a
+//   stored and a deflated embedded WAD are generated in a temporary
+//   directory.
+//
+//   Usage: tools/leakcheck [-iterations n] [archive ...]
+//
+//-----------------------------------------------------------------------------
+
+#include <dirent.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+#include "../z_zone.h"
+#include "../z_auto.h"
+#include "../w_levels.h"
+#include "../w_wad.h"
+
+static const int WARMUPITERATIONS = 2000;
+
+//=============================================================================
+//
+// Test Archives
+//
+
+//
+// Little-endian output into a growing byte vector
+//
+static void LC_put16(std::vector<byte> &out, unsigned int value)
+{
+   out.push_back(static_cast<byte>(value));
+   out.push_back(static_cast<byte>(value >> 8));
+}
+
+static void LC_put32(std::vector<byte> &out, uint32_t value)
+{
+   LC_put16(out, value & 0xFFFF);
+   LC_put16(out, value >> 16);
+}
+
+static void LC_putBytes(std::vector<byte> &out, const void *data, size_t len)
+{
+   const byte *bytes = static_cast<const byte *>(data);
+   out.insert(out.end(), bytes, bytes + len);
+}
+
+//
+// LC_makeWad
+//
+// A PWAD holding a Doom-format map of a few things, and a UDMF map.
+//
+static std::vector<byte> LC_makeWad()
+{
+   static const char *maplumps[] =
+   {
+      "MAP01", "THINGS", "LINEDEFS", "SIDEDEFS", "VERTEXES", "SEGS",
+      "SSECTORS", "NODES", "SECTORS", "REJECT", "BLOCKMAP"
+   };
+   static const char textmap[] =
+      "namespace = \"zdoom\";\n"
+      "thing { x = 0.0; y = 0.0; type = 1; skill2 = true; single = true; }\n"
+      "thing { x = 64.0; y = 0.0; type = 3004; skill2 = true; single = true; }\n";
+
+   struct lump_t { std::string name; std::vector<byte> data; };
+   std::vector<lump_t> lumps;
+
+   for(size_t i = 0; i < earrlen(maplumps); i++)
+   {
+      lump_t lump;
+      lump.name = maplumps[i];
+      if(i == 1)
+      {
+         // x, y, angle, type, and options of each thing
+         static const int things[][5] =
+         {
+            { 0, 0, 90, 1, 7 }, { 64, 0, 0, 3004, 7 }, { 128, 0, 0, 2001, 6 }
+         };
+         for(size_t t = 0; t < earrlen(things); t++)
+         {
+            for(int f = 0; f < 5; f++)
+               LC_put16(lump.data, things[t][f] & 0xFFFF);
+         }
+      }
+      lumps.push_back(lump);
+   }
+
+   static const char *udmflumps[] = { "MAP02", "TEXTMAP", "ENDMAP" };
+   for(size_t i = 0; i < earrlen(udmflumps); i++)
+   {
+      lump_t lump;
+      lump.name = udmflumps[i];
+      if(i == 1)
+         LC_putBytes(lump.data, textmap, sizeof(textmap) - 1);
+      lumps.push_back(lump);
+   }
+
+   std::vector<byte> wad;
+   LC_putBytes(wad, "PWAD", 4);
+   LC_put32(wad, static_cast<uint32_t>(lumps.size()));
+   LC_put32(wad, 0); // directory offset, filled in below
+
+   std::vector<byte> directory;
+   for(size_t i = 0; i < lumps.size(); i++)
+   {
+      char name[8] = { 0 };
+      strncpy(name, lumps[i].name.c_str(), sizeof(name));
+      LC_put32(directory, static_cast<uint32_t>(wad.size()));
+      LC_put32(directory, static_cast<uint32_t>(lumps[i].data.size()));
+      LC_putBytes(directory, name, sizeof(name));
+      wad.insert(wad.end(), lumps[i].data.begin(), lumps[i].data.end());
+   }
+
+   uint32_t diroffset = static_cast<uint32_t>(wad.size());
+   for(int b = 0; b < 4; b++)
+      wad[8 + b] = static_cast<byte>(diroffset >> (b * 8));
+   wad.insert(wad.end(), directory.begin(), directory.end());
+
+   return wad;
+}
+
+//
+// LC_deflate
+//
+// Raw deflate, as zip entries of method 8 hold.
+//
+static std::vector<byte> LC_deflate(const std::vector<byte> &in)
+{
+   z_stream zs;
+   memset(&zs, 0, sizeof(zs));
+   deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                Z_DEFAULT_STRATEGY);
+
+   std::vector<byte> out(deflateBound(&zs, static_cast<uLong>(in.size())));
+   zs.next_in   = const_cast<Bytef *>(&in[0]);
+   zs.avail_in  = static_cast<uInt>(in.size());
+   zs.next_out  = &out[0];
+   zs.avail_out = static_cast<uInt>(out.size());
+   deflate(&zs, Z_FINISH);
+   out.resize(zs.total_out);
+   deflateEnd(&zs);
+
+   return out;
+}
+
+//
+// LC_makePK3
+//
+// A zip holding the test WAD twice as maps/, once stored and once
+// deflated, so that both embedded WAD paths are taken.
+//
+static std::vector<byte> LC_makePK3(const std::vector<byte> &wad)
+{
+   struct entry_t { const char *name; int method; uint32_t offset; };
+   entry_t entries[] =
+   {
+      { "maps/stored.wad",   0, 0 },
+      { "maps/deflated.wad", 8, 0 }
+   };
+
+   uint32_t crc = crc32(0L, &wad[0], static_cast<uInt>(wad.size()));
+   std::vector<byte> deflated = LC_deflate(wad);
+   std::vector<byte> zip, central;
+
+   for(size_t i = 0; i < earrlen(entries); i++)
+   {
+      entry_t &e = entries[i];
+      const std::vector<byte> &data = e.method ? deflated : wad;
+      uint16_t namelen = static_cast<uint16_t>(strlen(e.name));
+
+      e.offset = static_cast<uint32_t>(zip.size());
+      LC_put32(zip, 0x04034b50);
+      LC_put16(zip, 20);       // version needed
+      LC_put16(zip, 0);        // flags
+      LC_put16(zip, e.method);
+      LC_put32(zip, 0);        // time and date
+      LC_put32(zip, crc);
+      LC_put32(zip, static_cast<uint32_t>(data.size()));
+      LC_put32(zip, static_cast<uint32_t>(wad.size()));
+      LC_put16(zip, namelen);
+      LC_put16(zip, 0);        // extra field length
+      LC_putBytes(zip, e.name, namelen);
+      zip.insert(zip.end(), data.begin(), data.end());
+
+      LC_put32(central, 0x02014b50);
+      LC_put16(central, 20);   // version made by
+      LC_put16(central, 20);   // version needed
+      LC_put16(central, 0);
+      LC_put16(central, e.method);
+      LC_put32(central, 0);
+      LC_put32(central, crc);
+      LC_put32(central, static_cast<uint32_t>(data.size()));
+      LC_put32(central, static_cast<uint32_t>(wad.size()));
+      LC_put16(central, namelen);
+      LC_put16(central, 0);    // extra field length
+      LC_put16(central, 0);    // comment length
+      LC_put16(central, 0);    // disk number
+      LC_put16(central, 0);    // internal attributes
+      LC_put32(central, 0);    // external attributes
+      LC_put32(central, e.offset);
+      LC_putBytes(central, e.name, namelen);
+   }
+
+   uint32_t centraloffset = static_cast<uint32_t>(zip.size());
+   zip.insert(zip.end(), central.begin(), central.end());
+   LC_put32(zip, 0x06054b50);
+   LC_put16(zip, 0);           // disk number
+   LC_put16(zip, 0);           // disk with the central directory
+   LC_put16(zip, static_cast<unsigned int>(earrlen(entries)));
+   LC_put16(zip, static_cast<unsigned int>(earrlen(entries)));
+   LC_put32(zip, static_cast<uint32_t>(central.size()));
+   LC_put32(zip, centraloffset);
+   LC_put16(zip, 0);           // comment length
+
+   return zip;
+}
+
+static bool LC_writeFile(const std::string &path, const std::vector<byte> &data)
+{
+   FILE *f = fopen(path.c_str(), "wb");
+   if(!f)
+      return false;
+   bool ok = fwrite(&data[0], 1, data.size(), f) == data.size();
+   return fclose(f) == 0 && ok;
+}
+
+//=============================================================================
+//
+// Checks
+//
+
+//
+// Count the descriptors this process has open.
+//
+static int LC_openDescriptors()
+{
+   DIR *dir = opendir("/proc/self/fd");
+   int  count = 0;
+
+   if(!dir)
+      return -1;
+   while(readdir(dir))
+      ++count;
+   closedir(dir);
+
+   return count;
+}
+
+//
+// Bytes of heap in use, or 0 where it cannot be measured.
+//
+static size_t LC_heapInUse()
+{
+#ifdef __GLIBC__
+#if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)
+   return mallinfo2().uordblks;
+#else
+   return static_cast<size_t>(mallinfo().uordblks);
+#endif
+#else
+   return 0;
+#endif
+}
+
+//
+// LC_scanArchive
+//
+// Load one archive into dir, then do what counting it does: find its maps
+// and read their things, through both the zone cache and an auto buffer.
+//
+static bool LC_scanArchive(WadDirectory &dir, const char *path, int &nummaps)
+{
+   if(!dir.addNewPrivateFile(path))
+      return false;
+
+   wadlevel_t *levels = W_FindAllMapsInLevelWad(&dir);
+
+   nummaps = 0;
+   for(wadlevel_t *level = levels; level->dir; level++)
+   {
+      ZAutoBuffer buffer;
+      dir.cacheLumpAuto(level->lumpnum + 1, buffer);
+      dir.cacheLumpNum(level->lumpnum + 1, PU_CACHE);
+      ++nummaps;
+   }
+
+   efree(levels);
+   dir.reset();
+   Z_FreeAlloca();
+
+   return true;
+}
+
+int main(int argc, char **argv)
+{
+   std::vector<std::string> archives;
+   std::string tempdir;
+   int iterations = 10000;
+
+   for(int i = 1; i < argc; i++)
+   {
+      if(!strcmp(argv[i], "-iterations") && i + 1 < argc)
+         iterations = atoi(argv[++i]);
+      else
+         archives.push_back(argv[i]);
+   }
+   if(iterations <= WARMUPITERATIONS)
+      iterations = WARMUPITERATIONS + 1;
+
+   Z_Init();
+
+   if(archives.empty())
+   {
+      const char *tmp = getenv("TMPDIR");
+      std::string pattern = std::string(tmp && *tmp ? tmp : "/tmp") +
+                            "/leakcheckXXXXXX";
+      std::vector<char> buf(pattern.begin(), pattern.end());
+      buf.push_back('\0');
+      if(!mkdtemp(&buf[0]))
+      {
+         perror("leakcheck: mkdtemp");
+         return 1;
+      }
+      tempdir = &buf[0];
+
+      std::vector<byte> wad = LC_makeWad();
+      archives.push_back(tempdir + "/test.wad");
+      archives.push_back(tempdir + "/test.pk3");
+      if(!LC_writeFile(archives[0], wad) ||
+         !LC_writeFile(archives[1], LC_makePK3(wad)))
+      {
+         perror("leakcheck: writing test archives");
+         return 1;
+      }
+   }
+
+   WadDirectory dir;
+   int    fds     = LC_openDescriptors();
+   size_t warmup  = 0;
+   int    nummaps = 0;
+   bool   ok      = true;
+
+   for(int i = 0; i < iterations && ok; i++)
+   {
+      for(size_t a = 0; a < archives.size(); a++)
+      {
+         int maps;
+         if(!LC_scanArchive(dir, archives[a].c_str(), maps))
+         {
+            fprintf(stderr, "leakcheck: cannot load %s\n", archives[a].c_str());
+            ok = false;
+            break;
+         }
+         if(!i)
+            nummaps += maps;
+      }
+      if(i == WARMUPITERATIONS)
+         warmup = LC_heapInUse();
+   }
+   dir.close();
+
+   size_t heap = LC_heapInUse();
+   int    endfds = LC_openDescriptors();
+
+   if(!tempdir.empty())
+   {
+      for(size_t a = 0; a < archives.size(); a++)
+         remove(archives[a].c_str());
+      rmdir(tempdir.c_str());
+   }
+
+   if(!ok)
+      return 1;
+
+   printf("leakcheck: %d iterations of %d archives, %d maps each time\n",
+          iterations, static_cast<int>(archives.size()), nummaps);
+   printf("leakcheck: heap in use %lu bytes after warm-up, %lu at the end\n",
+          static_cast<unsigned long>(warmup), static_cast<unsigned long>(heap));
+   printf("leakcheck: %d descriptors open at the start, %d at the end\n",
+          fds, endfds);
+
+   if(heap > warmup || endfds != fds)
+   {
+      printf("leakcheck: FAILED\n");
+      return 1;
+   }
+
+   printf("leakcheck: passed\n");
+   return 0;
+}
+
+// EOF
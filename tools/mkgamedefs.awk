@@ -0,0 +1,213 @@
+#!/usr/bin/awk -f
+#
+# mkgamedefs.awk
+#
+# Compile thingtype scripts into p_gamedefs.h, the built-in thingtype tables
+# selected with -game. Usage:
+#
+#    awk -f tools/mkgamedefs.awk scripts/*.cfg > p_gamedefs.h
+#
+# Each script becomes a game named after its file. The grammar is the one
+# XLThingScript parses: a DoomEd number, class, and quoted name per
+# thingtype, each optionally followed by $attribute value pairs. Comments
+# start with ; or //. A later definition of a DoomEd number replaces an
+# earlier one.
+#
+
+BEGIN {
+   nclasses = split("NONE MONSTER NPC HEALTH ARMOR AMMO WEAPON KEY ARTIFACT " \
+                    "POWERUP QUEST DECOR HAZARD AMBIENT TECHNICAL", classes, " ")
+   nattrs = split("$hp $damage $health $armor", attrs, " ")
+   ngames = 0
+
+   print "// Emacs style mode select   -*- C++ -*-"
+   print "//-----------------------------------------------------------------------------"
+   print "//"
+   print "// DESCRIPTION:"
+   print "//      Built-in thingtype tables."
+   print "//      Generated from scripts/*.cfg by tools/mkgamedefs.awk; do not edit."
+   print "//"
+   print "//-----------------------------------------------------------------------------"
+}
+
+# start a new game at the first line of each script
+FNR == 1 {
+   if(ngames)
+      endgame()
+   game = FILENAME
+   sub(/^.*\//, "", game)
+   sub(/\.[^.]*$/, "", game)
+   gamenames[ngames++] = game
+   ntypes = 0
+   state = "den"
+   split("", bydoomednum)
+}
+
+{
+   line = $0
+   sub(/\r$/, "", line)
+
+   while(line != "")
+   {
+      # skip whitespace and comments
+      if(match(line, /^[ \t]+/))
+      {
+         line = substr(line, RLENGTH + 1)
+         continue
+      }
+      if(substr(line, 1, 1) == ";" || substr(line, 1, 2) == "//")
+         break
+
+      if(substr(line, 1, 1) == "\"")
+      {
+         end = index(substr(line, 2), "\"")
+         if(!end)
+            end = length(line)
+         token = substr(line, 2, end - 1)
+         line  = substr(line, end + 2)
+      }
+      else
+      {
+         match(line, /^[^ \t;"]+/)
+         token = substr(line, 1, RLENGTH)
+         line  = substr(line, RLENGTH + 1)
+         if((cut = index(token, "//")))
+         {
+            line  = substr(token, cut) line
+            token = substr(token, 1, cut - 1)
+         }
+      }
+
+      dotoken(token)
+   }
+}
+
+END {
+   if(ngames)
+      endgame()
+
+   print ""
+   print "static const thinggame_t thinggames[] ="
+   print "{"
+   for(g = 0; g < ngames; g++)
+   {
+      id = ident(gamenames[g])
+      printf "   { \"%s\", %sTypes, earrlen(%sTypes), %sNames, %sAttrs },\n",
+             gamenames[g], id, id, id, id
+   }
+   print "};"
+   print ""
+   print "// EOF"
+   print ""
+}
+
+function dotoken(token,    i)
+{
+   if(state == "den")
+   {
+      if(substr(token, 1, 1) == "$")
+      {
+         # unknown attributes are skipped, along with their value
+         attr = 0
+         for(i = 1; i <= nattrs; i++)
+         {
+            if(tolower(token) == attrs[i])
+               attr = i
+         }
+         state = "value"
+         return
+      }
+      den   = int(token)
+      state = "class"
+   }
+   else if(state == "class")
+   {
+      classname = "NONE"
+      for(i = 1; i <= nclasses; i++)
+      {
+         if(toupper(token) == classes[i])
+            classname = classes[i]
+      }
+      state = "name"
+   }
+   else if(state == "name")
+   {
+      if(!(den in bydoomednum))
+      {
+         bydoomednum[den] = ntypes
+         dens[ntypes++] = den
+      }
+      last = bydoomednum[den]
+      typeclass[last] = classname
+      typename[last]  = token
+      for(i = 1; i <= nattrs; i++)
+         typeattr[last, i] = 0
+      state = "den"
+   }
+   else
+   {
+      if(attr && ntypes)
+         typeattr[last, attr] = int(token)
+      state = "den"
+   }
+}
+
+function ident(name)
+{
+   gsub(/[^A-Za-z0-9_]/, "_", name)
+   return name
+}
+
+function cstring(str)
+{
+   gsub(/\\/, "\\\\", str)
+   gsub(/"/, "\\\"", str)
+   return str
+}
+
+# output the tables of the game just read, in order of DoomEd number
+function endgame(    i, j, t, id, ofs, order, sep)
+{
+   for(i = 0; i < ntypes; i++)
+      order[i] = i
+   for(i = 1; i < ntypes; i++)
+   {
+      t = order[i]
+      for(j = i - 1; j >= 0 && dens[order[j]] > dens[t]; j--)
+         order[j + 1] = order[j]
+      order[j + 1] = t
+   }
+
+   id = ident(game)
+
+   print ""
+   print "// " game
+   print ""
+   printf "static const thingtype_t %sTypes[] =\n{\n", id
+   ofs = 0
+   for(i = 0; i < ntypes; i++)
+   {
+      t = order[i]
+      printf "   { %5d, %-16s %5d, %3d },\n", dens[t], "CLASS_" typeclass[t] ",", ofs, i
+      ofs += length(typename[t]) + 1
+   }
+   print "};"
+   print ""
+   printf "static const char %sNames[] =\n", id
+   for(i = 0; i < ntypes; i++)
+      printf "   \"%s\\0\"%s\n", cstring(typename[order[i]]), (i == ntypes - 1 ? ";" : "")
+   print ""
+   printf "static const int %sAttrs[NUM_THINGATTRS * %d] =\n{\n", id, ntypes
+   for(j = 1; j <= nattrs; j++)
+   {
+      printf "   // %s\n  ", attrs[j]
+      for(i = 0; i < ntypes; i++)
+      {
+         printf " %d,", typeattr[order[i], j]
+         if(i % 16 == 15 && i != ntypes - 1)
+            printf "\n  "
+      }
+      printf "\n"
+   }
+   print "};"
+}
@@ -0,0 +1,157 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Throughput benchmark for XLTokenizer
+//
+//   Tokenizes a text file, or by default about 25 MB of generated input:
+//   thingtype script lines, and DECORATE-style actors with comments. The
+//   best of several runs is reported in MB/s, along with the number of
+//   tokens and token characters seen, which must not change between
+//   versions of the tokenizer.
+//
+//   Usage: tools/tokbench [-runs n] [file]
+//
+//-----------------------------------------------------------------------------
+
+#include <chrono>
+#include <string>
+
+#include "../z_zone.h"
+#include "../xl_scripts.h"
+
+//
+// TB_generateInput
+//
+// Input resembling what XLThingScript and XLParser subclasses see.
+//
+static std::string TB_generateInput()
+{
+   static const char *classes[] =
+   {
+      "MONSTER", "HEALTH", "AMMO", "WEAPON", "DECOR", "TECHNICAL"
+   };
+   std::string text;
+   char line[512];
+   unsigned int seed = 7;
+
+   // thingtype scripts
+   for(int i = 0; i < 40000; i++)
+   {
+      psnprintf(line, sizeof(line),
+                "%5d %-9s \"Thing number %d\"   $hp %d ; comment %d\n",
+                i, classes[i % earrlen(classes)], i, i % 4000, i);
+      text += line;
+   }
+
+   // DECORATE-style actors
+   for(int i = 0; i < 150000; i++)
+   {
+      seed = seed * 1103515245 + 12345;
+      psnprintf(line, sizeof(line),
+                "actor Thing%d : Base%d %d\n{\n   Health %u\n   Radius 20\n"
+                "   // a comment about it\n   States\n   {\n   Spawn:\n"
+                "      TROO AB 10 A_Look\n      Loop\n   }\n}\n\n",
+                i, i % 50, 20000 + i, (seed >> 16) % 4000 + 1);
+      text += line;
+   }
+
+   return text;
+}
+
+static bool TB_readFile(const char *path, std::string &text)
+{
+   FILE *f = fopen(path, "rb");
+   char  buf[65536];
+   size_t len;
+
+   if(!f)
+      return false;
+   while((len = fread(buf, 1, sizeof(buf), f)) > 0)
+      text.append(buf, len);
+   fclose(f);
+
+   return true;
+}
+
+int main(int argc, char **argv)
+{
+   typedef std::chrono::steady_clock clock;
+
+   const char *path = NULL;
+   int runs = 5;
+
+   for(int i = 1; i < argc; i++)
+   {
+      if(!strcmp(argv[i], "-runs") && i + 1 < argc)
+         runs = atoi(argv[++i]);
+      else
+         path = argv[i];
+   }
+   if(runs < 1)
+      runs = 1;
+
+   Z_Init();
+
+   std::string text;
+   if(path)
+   {
+      if(!TB_readFile(path, text))
+      {
+         perror(path);
+         return 1;
+      }
+   }
+   else
+      text = TB_generateInput();
+
+   double best   = -1.0;
+   size_t tokens = 0, chars = 0;
+
+   for(int r = 0; r < runs; r++)
+   {
+      clock::time_point start = clock::now();
+
+      XLTokenizer tokenizer(text.c_str());
+      tokenizer.setTokenFlags(XLTokenizer::TF_SLASHCOMMENTS |
+                              XLTokenizer::TF_HASHCOMMENTS);
+      tokens = chars = 0;
+      while(tokenizer.getNextToken() != XLTokenizer::TOKEN_EOF)
+      {
+         ++tokens;
+         chars += tokenizer.getTokenLength();
+      }
+
+      double seconds =
+         std::chrono::duration<double>(clock::now() - start).count();
+      if(best < 0.0 || seconds < best)
+         best = seconds;
+   }
+
+   printf("tokbench: %lu bytes, %lu tokens, %lu token characters\n",
+          static_cast<unsigned long>(text.size()),
+          static_cast<unsigned long>(tokens), static_cast<unsigned long>(chars));
+   printf("tokbench: best of %d runs %.3f s, %.0f MB/s\n", runs, best,
+          best > 0.0 ? text.size() / best / 1e6 : 0.0);
+
+   return 0;
+}
+
+// EOF
@@ -26,6 +26,7 @@
 
 #include "z_zone.h"
 
+#include "m_casefold.h"
 #include "m_misc.h"
 #include "m_qstr.h"
 #include "w_formats.h"
@@ -223,7 +224,7 @@ int W_NamespaceForFilePath(const char *path)
 
    while(matcher->prefix)
    {
-      if(!strncmp(path, matcher->prefix, strlen(matcher->prefix)))
+      if(M_FoldPrefix(path, matcher->prefix))
       {
          li_namespace = matcher->li_namespace;
          break;
@@ -24,6 +24,7 @@
 //-----------------------------------------------------------------------------
 
 #include "z_zone.h"
+#include "m_casefold.h"
 #include "w_levels.h"
 #include "w_wad.h"
 
@@ -58,19 +59,56 @@ static const char *consolelumps[] =
    "MACROS"
 };
 
+//
+// Lumps that delimit UDMF maps
+//
+static const char *udmflumps[] =
+{
+   "TEXTMAP",
+   "ENDMAP"
+};
+
+//
+// Packed name keys for the above tables, so that map lumps can be checked
+// against the directory's key array without touching each lumpinfo_t.
+//
+struct levellumpkeys_t
+{
+   uint64_t level[earrlen(levellumps)];
+   uint64_t console[earrlen(consolelumps)];
+   uint64_t udmf[earrlen(udmflumps)];
+
+   levellumpkeys_t()
+   {
+      for(size_t i = 0; i < earrlen(levellumps); i++)
+         level[i] = WadDirectory::LumpNameKey(levellumps[i]);
+      for(size_t i = 0; i < earrlen(consolelumps); i++)
+         console[i] = WadDirectory::LumpNameKey(consolelumps[i]);
+      for(size_t i = 0; i < earrlen(udmflumps); i++)
+         udmf[i] = WadDirectory::LumpNameKey(udmflumps[i]);
+   }
+};
+
+// Built on first use; safe to reach from several threads at once.
+static const levellumpkeys_t &W_levelLumpKeys()
+{
+   static const levellumpkeys_t keys;
+   return keys;
+}
+
 //
 // haleyjd 12/12/13: Check for supported console map formats
 //
 static int W_checkConsoleFormat(WadDirectory *dir, int lumpnum)
 {
-   int          numlumps = dir->getNumLumps();
-   lumpinfo_t **lumpinfo = dir->getLumpInfo();
+   int numlumps = dir->getNumLumps();
+   const levellumpkeys_t &keys = W_levelLumpKeys();
 
    for(int i = ML_LEAFS; i <= ML_MACROS; i++)
    {
       int ln = lumpnum + i;
       if(ln >= numlumps ||     // past the last lump?
-         strncmp(lumpinfo[ln]->name, consolelumps[i - ML_LEAFS], 8))
+         dir->getLumpKey(ln) != keys.console[i - ML_LEAFS])
       {
          if(i == ML_LIGHTS)
             return LEVEL_FORMAT_PSX; // PSX
@@ -83,20 +121,47 @@ static int W_checkConsoleFormat(WadDirectory *dir, int lumpnum)
    return LEVEL_FORMAT_INVALID; //LEVEL_FORMAT_DOOM64;
 }
 
+//
+// Find the ENDMAP lump closing a UDMF map whose header is at lumpnum.
+// Returns -1 if there is none.
+//
+static int W_findEndMap(WadDirectory *dir, int lumpnum)
+{
+   int numlumps = dir->getNumLumps();
+   uint64_t endmap = W_levelLumpKeys().udmf[1];
+
+   for(int ln = lumpnum + ML_TEXTMAP + 1; ln < numlumps; ln++)
+   {
+      if(dir->getLumpKey(ln) == endmap)
+         return ln;
+   }
+
+   return -1;
+}
+
 //
 // sf 11/9/99: We need to do this now because we no longer have to conform to
 // the MAPxy or ExMy standard previously imposed.
 //
 int W_CheckLevel(WadDirectory *dir, int lumpnum)
 {
-   int          numlumps = dir->getNumLumps();
-   lumpinfo_t **lumpinfo = dir->getLumpInfo();
+   int numlumps = dir->getNumLumps();
+   const levellumpkeys_t &keys = W_levelLumpKeys();
+
+   // A TEXTMAP lump after the header makes it a UDMF map, which runs to the
+   // next ENDMAP
+   if(lumpnum + ML_TEXTMAP < numlumps &&
+      dir->getLumpKey(lumpnum + ML_TEXTMAP) == keys.udmf[0])
+   {
+      return W_findEndMap(dir, lumpnum) >= 0 ? LEVEL_FORMAT_UDMF
+                                             : LEVEL_FORMAT_INVALID;
+   }
    
    for(int i = ML_THINGS; i <= ML_BEHAVIOR; i++)
    {
       int ln = lumpnum + i;
       if(ln >= numlumps ||     // past the last lump?
-         strncmp(lumpinfo[ln]->name, levellumps[i], 8))
+         dir->getLumpKey(ln) != keys.level[i])
       {
          // If "BEHAVIOR" wasn't found, we assume we are dealing with
          // a DOOM-format map, and it is not an error; any other missing
@@ -105,7 +170,7 @@ int W_CheckLevel(WadDirectory *dir, int lumpnum)
          if(i == ML_BEHAVIOR)
          {
             // If the current lump is named LEAFS, it's a console map
-            if(ln < numlumps && !strncmp(lumpinfo[ln]->name, "LEAFS", 8))
+            if(ln < numlumps && dir->getLumpKey(ln) == keys.console[0])
                return W_checkConsoleFormat(dir, lumpnum);
             else
                return LEVEL_FORMAT_DOOM;
@@ -127,7 +192,7 @@ static int W_sortLevels(const void *first, const void *second)
    wadlevel_t *firstLevel  = (wadlevel_t *)first;
    wadlevel_t *secondLevel = (wadlevel_t *)second;
 
-   return strncasecmp(firstLevel->header, secondLevel->header, 9);
+   return M_FoldCompare(firstLevel->header, secondLevel->header, 9);
 }
 
 //
@@ -167,7 +232,10 @@ wadlevel_t *W_FindAllMapsInLevelWad(WadDirectory *dir)
          ++numlevels;
 
          // skip past the level's directory entries
-         i += (format == LEVEL_FORMAT_HEXEN ? 11 : 10);
+         if(format == LEVEL_FORMAT_UDMF)
+            i = W_findEndMap(dir, i);
+         else
+            i += (format == LEVEL_FORMAT_HEXEN ? 11 : 10);
       }
    }
 
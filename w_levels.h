@@ -33,7 +33,8 @@ enum
    LEVEL_FORMAT_DOOM,
    LEVEL_FORMAT_HEXEN,
    LEVEL_FORMAT_PSX,
-   LEVEL_FORMAT_DOOM64
+   LEVEL_FORMAT_DOOM64,
+   LEVEL_FORMAT_UDMF
 };
 
 // Lump order in a map WAD: each map needs a couple of lumps
@@ -58,7 +59,10 @@ enum
 
   // Doom 64
   ML_LIGHTS,
-  ML_MACROS
+  ML_MACROS,
+
+  // UDMF
+  ML_TEXTMAP = ML_THINGS // textual map data; ENDMAP closes the map
 };
 
 class WadDirectory;
@@ -40,6 +40,7 @@
 
 #include "d_dehtbl.h"
 #include "m_argv.h"
+#include "m_casefold.h"
 #include "m_collection.h"
 #include "m_dllist.h"
 #include "m_misc.h"
@@ -57,9 +58,6 @@
 // Location of each lump on disk.
 WadDirectory wGlobalDir;
 
-int WadDirectory::source;            // haleyjd 03/18/10: next source ID# to use
-int WadDirectory::IWADSource   = -1; // sf: the handle of the main iwad
-int WadDirectory::ResWADSource = -1; // haleyjd: track handle of first wad added
 
 //
 // haleyjd 07/12/07: structure for transparently manipulating lumps of
@@ -105,6 +103,38 @@ static lumptype_t LumpHandlers[lumpinfo_t::lump_numtypes] =
    },
 };
 
+//
+// Lump cache slots, one per cache format. These are only allocated for lumps
+// that are actually cached, so that the bulk of a large directory does not
+// pay for them.
+//
+struct lumpcache_t
+{
+   void  *data[lumpinfo_t::fmt_maxfmts];
+   size_t bytes;      // bytes counted against the directory's cache budget
+   bool   referenced; // used since the clock hand last passed
+   bool   inclock;    // present in the directory's clock ring
+};
+
+//
+// lumpinfo_t::getLFN
+//
+// Long file names are not stored separately; they are the same strings that
+// the physical lump data already refers to.
+//
+const char *lumpinfo_t::getLFN() const
+{
+   switch(type)
+   {
+   case lump_zip:
+      return zip.zipLump->name;
+   case lump_file:
+      return file.path;
+   default:
+      return NULL;
+   }
+}
+
 //=============================================================================
 //
 // WadDirectoryPimpl
@@ -117,40 +147,75 @@ static lumptype_t LumpHandlers[lumpinfo_t::lump_numtypes] =
 class WadDirectoryPimpl : public ZoneObject
 {
 public:
-   // Static collection of source filenames
    static qstring FnPrototype;
-   static Collection<qstring> SourceFileNames;
+
+   Collection<qstring> sourceFileNames; // filenames, by source number
 
    //
    // Add a source filename
    //
-   static void AddFileName(const char *fn)
+   void addFileName(const char *fn)
    {
-      SourceFileNames.setPrototype(&FnPrototype);
-      SourceFileNames.addNew() << fn;
+      sourceFileNames.addNew() << fn;
    }
 
    //
    // Get a filename for a source number
    //
-   static const char *FileNameForSource(size_t source)
+   const char *fileNameForSource(size_t source)
    {
-      if(source >= SourceFileNames.getLength())
+      if(source >= sourceFileNames.getLength())
          return NULL;
-      return SourceFileNames[source].constPtr();
+      return sourceFileNames[source].constPtr();
+   }
+
+   //
+   // Destroy all zip files attached to the directory
+   //
+   void deleteZipFiles()
+   {
+      DLListItem<ZipFile> *rover = zipFiles;
+
+      while(rover)
+      {
+         ZipFile *zip = rover->dllObject;
+         rover = rover->dllNext;
+         delete zip;
+      }
+      zipFiles = NULL;
    }
 
-   PODCollection<lumpinfo_t *>  infoptrs; // lumpinfo_t allocations
-   DLListItem<ZipFile>         *zipFiles; // zip files attached to this waddir
+   // Lump cache state
+   PODCollection<int>           clockring;   // lumps with cached data
+   size_t                       clockhand;   // next clockring entry to examine
+   size_t                       cachebytes;  // bytes held in lump caches
+   size_t                       cachebudget; // byte budget; 0 is unlimited
+   WadDirectory::cachestats_t   cachestats;
+
+   PODCollection<lumpinfo_t *>  infoptrs;  // lumpinfo_t allocations
+   PODCollection<int>           infosizes; // sizes of lumpinfo_t allocations
+   size_t                       nextinfo;  // next allocation to reuse
+   int                          lumpinfoalloc; // capacity of lumpinfo array
+   int                          lumpkeysalloc; // capacity of lumpkeys array
+   DLListItem<ZipFile>         *zipFiles;  // zip files attached to this waddir
 
    WadDirectoryPimpl()
-      : ZoneObject(), infoptrs(), zipFiles(NULL)
+      : ZoneObject(), sourceFileNames(), clockring(), clockhand(0),
+        cachebytes(0), cachebudget(WadDirectory::DEFAULT_CACHE_BUDGET),
+        infoptrs(), infosizes(), nextinfo(0), lumpinfoalloc(0),
+        lumpkeysalloc(0), zipFiles(NULL)
    {
+      sourceFileNames.setPrototype(&FnPrototype);
+      memset(&cachestats, 0, sizeof(cachestats));
+   }
+
+   ~WadDirectoryPimpl()
+   {
+      deleteZipFiles();
    }
 };
 
-qstring             WadDirectoryPimpl::FnPrototype;
-Collection<qstring> WadDirectoryPimpl::SourceFileNames;
+qstring WadDirectoryPimpl::FnPrototype;
 
 //=============================================================================
 //
@@ -163,7 +228,8 @@ Collection<qstring> WadDirectoryPimpl::SourceFileNames;
 // WadDirectory Constructor
 //
 WadDirectory::WadDirectory()
- : ZoneObject(), lumpinfo(NULL), numlumps(0), ispublic(false), type(0)
+ : ZoneObject(), source(0), iwadsource(-1), reswadsource(-1), lumpinfo(NULL),
+   lumpkeys(NULL), numlumps(0), ispublic(false), type(0)
 {
    pImpl = new WadDirectoryPimpl;
    memset(m_namespaces, 0, sizeof(m_namespaces));
@@ -182,26 +248,70 @@ WadDirectory::~WadDirectory()
 }
 
 //
-// W_addInfoPtr
+// WadDirectory::allocInfoBlock
 //
 // haleyjd 06/06/10: I need to track all lumpinfo_t allocations that are
 // added to a waddir_t's lumpinfo directory, or else these allocations get
 // orphaned when freeing a private wad directory. Oops! ;)
 //
-void WadDirectory::addInfoPtr(lumpinfo_t *infoptr)
+// Allocations left over from before the last reset are handed out again
+// in the same order, when they are large enough.
+//
+lumpinfo_t *WadDirectory::allocInfoBlock(int count)
 {
-   pImpl->infoptrs.add(infoptr);
+   WadDirectoryPimpl &impl = *pImpl;
+   lumpinfo_t *block;
+
+   if(impl.nextinfo < impl.infoptrs.getLength())
+   {
+      if(impl.infosizes[impl.nextinfo] >= count)
+      {
+         block = impl.infoptrs[impl.nextinfo];
+         memset(block, 0, count * sizeof(lumpinfo_t));
+      }
+      else
+      {
+         // too small to reuse; replace it
+         efree(impl.infoptrs[impl.nextinfo]);
+         block = estructalloc(lumpinfo_t, count);
+         impl.infoptrs[impl.nextinfo]  = block;
+         impl.infosizes[impl.nextinfo] = count;
+      }
+   }
+   else
+   {
+      block = estructalloc(lumpinfo_t, count);
+      impl.infoptrs.add(block);
+      impl.infosizes.add(count);
+   }
+
+   ++impl.nextinfo;
+   return block;
+}
+
+//
+// WadDirectory::growLumpInfo
+//
+// Make sure the lumpinfo array can hold numlumps pointers.
+//
+void WadDirectory::growLumpInfo()
+{
+   if(numlumps > pImpl->lumpinfoalloc)
+   {
+      lumpinfo = erealloc(lumpinfo_t **, lumpinfo, numlumps * sizeof(lumpinfo_t *));
+      pImpl->lumpinfoalloc = numlumps;
+   }
 }
 
 //
 // WadDirectory::incrementSource
 //
-// Add the source filename and increment the static source counter.
+// Add the source filename and increment the source counter.
 //
 void WadDirectory::incrementSource(openwad_t &openData)
 {
    // haleyjd: push source filename
-   WadDirectoryPimpl::AddFileName(openData.filename);
+   pImpl->addFileName(openData.filename);
 
    // haleyjd: increment source
    ++source;
@@ -276,13 +386,10 @@ lumpinfo_t *WadDirectory::reAllocLumpInfo(int numnew, int startlump)
    numlumps += numnew;
 
    // Fill in lumpinfo
-   lumpinfo = erealloc(lumpinfo_t **, lumpinfo, numlumps * sizeof(lumpinfo_t *));
+   growLumpInfo();
 
    // space for new lumps
-   newlumps = estructalloc(lumpinfo_t, numlumps - startlump);
-
-   // haleyjd: keep track of this allocation of lumps
-   addInfoPtr(newlumps);
+   newlumps = allocInfoBlock(numlumps - startlump);
 
    // haleyjd: fill in new pointers here, instead of everywhere this is used.
    for(int i = startlump; i < numlumps; i++)
@@ -325,6 +432,29 @@ bool WadDirectory::addSingleFile(openwad_t &openData, wfileadd_t &addInfo,
    return true;
 }
 
+//
+// W_MemoryLumpsFit
+//
+// Check that every lump of a wad directory in memory lies within the wad's
+// buffer of size bytes.
+//
+static bool W_MemoryLumpsFit(const byte *directory, int numlumps, size_t size)
+{
+   for(int i = 0; i < numlumps; i++, directory += sizeof(filelump_t))
+   {
+      filelump_t lump;
+      memcpy(&lump, directory, sizeof(lump));
+
+      int filepos  = SwapLong(lump.filepos);
+      int lumpsize = SwapLong(lump.size);
+
+      if(filepos < 0 || lumpsize < 0 || static_cast<size_t>(filepos) > size ||
+         static_cast<size_t>(lumpsize) > size - static_cast<size_t>(filepos))
+         return false;
+   }
+   return true;
+}
+
 //
 // WadDirectory::addMemoryWad
 //
@@ -342,21 +472,22 @@ bool WadDirectory::addMemoryWad(openwad_t &openData, wfileadd_t &addInfo,
    lumpinfo_t  *lump_p;
 
    // Read in the header
-   memcpy(&header, openData.base, sizeof(header));
-
-   header.numlumps     = SwapLong(header.numlumps);
-   header.infotableofs = SwapLong(header.infotableofs);
-
-   // allocate enough fileinfo_t's to hold the wad directory
-   length = header.numlumps * sizeof(filelump_t);
-  
-   fileinfo2free.alloc(length, true);              // killough
-   fileinfo = fileinfo2free.getAs<filelump_t *>();
+   if(openData.size < sizeof(header))
+      header.numlumps = -1;
+   else
+   {
+      memcpy(&header, openData.base, sizeof(header));
 
-   info_offset = static_cast<size_t>(header.infotableofs);
+      header.numlumps     = SwapLong(header.numlumps);
+      header.infotableofs = SwapLong(header.infotableofs);
+   }
 
-   // seek to the directory
-   if(info_offset + header.numlumps * sizeof(filelump_t)  > openData.size)
+   // seek to the directory; it and every lump must be inside the buffer
+   info_offset = header.numlumps >= 0 ? static_cast<size_t>(header.infotableofs) : 0;
+   if(header.numlumps < 0 || header.infotableofs < 0 || info_offset > openData.size ||
+      static_cast<size_t>(header.numlumps) > (openData.size - info_offset) / sizeof(filelump_t) ||
+      !W_MemoryLumpsFit(static_cast<byte *>(openData.base) + info_offset,
+                        header.numlumps, openData.size))
    {
       if(addInfo.flags & WFA_OPENFAILFATAL)
          I_Error("Failed reading directory for in-memory file\n");
@@ -367,6 +498,12 @@ bool WadDirectory::addMemoryWad(openwad_t &openData, wfileadd_t &addInfo,
       }
    }
 
+   // allocate enough fileinfo_t's to hold the wad directory
+   length = header.numlumps * sizeof(filelump_t);
+
+   fileinfo2free.alloc(length, true);              // killough
+   fileinfo = fileinfo2free.getAs<filelump_t *>();
+
    // read it in.
    byte *directoryBase = static_cast<byte *>(openData.base) + info_offset;
    memcpy(fileinfo, directoryBase, header.numlumps * sizeof(filelump_t));
@@ -435,14 +572,11 @@ bool WadDirectory::addWadFile(openwad_t &openData, wfileadd_t &addInfo,
 
    if(fread(&header, sizeof(header), 1, openData.handle) < 1)
    {
+      fclose(openData.handle);
       if(addInfo.flags & WFA_OPENFAILFATAL)
          I_Error("Failed reading header for wad file %s\n", openData.filename);
-      else
-      {
-         fclose(openData.handle);
-         printf("Failed reading header for wad file %s\n", openData.filename);
-         return false;            
-      }
+      printf("Failed reading header for wad file %s\n", openData.filename);
+      return false;
    }
 
    // Feed the wad header data into the hash computation
@@ -452,9 +586,14 @@ bool WadDirectory::addWadFile(openwad_t &openData, wfileadd_t &addInfo,
    header.numlumps     = SwapLong(header.numlumps);
    header.infotableofs = SwapLong(header.infotableofs);
 
+   // a directory that can't fit in the file is not worth allocating
+   if(header.numlumps < 0 ||
+      header.numlumps > M_FileLength(openData.handle) / static_cast<long>(sizeof(filelump_t)))
+      header.numlumps = -1;
+
    // allocate enough fileinfo_t's to hold the wad directory
-   length = header.numlumps * sizeof(filelump_t);
-  
+   length = header.numlumps > 0 ? header.numlumps * sizeof(filelump_t) : 0;
+
    fileinfo2free.alloc(length, true);              // killough
    fileinfo = fileinfo2free.getAs<filelump_t *>();
 
@@ -468,16 +607,13 @@ bool WadDirectory::addWadFile(openwad_t &openData, wfileadd_t &addInfo,
    fseek(openData.handle, info_offset, SEEK_SET);
 
    // read it in.
-   if(fread(fileinfo, length, 1, openData.handle) < 1)
+   if(header.numlumps < 0 || fread(fileinfo, length, 1, openData.handle) < 1)
    {
+      fclose(openData.handle);
       if(addInfo.flags & WFA_OPENFAILFATAL)
          I_Error("Failed reading directory for wad file %s\n", openData.filename);
-      else
-      {
-         fclose(openData.handle);
-         printf("Failed reading directory for wad file %s\n", openData.filename);
-         return false;
-      }
+      printf("Failed reading directory for wad file %s\n", openData.filename);
+      return false;
    }
 
    // Feed the wad directory into the hash computation, wrap it up, and if requested,
@@ -500,14 +636,14 @@ bool WadDirectory::addWadFile(openwad_t &openData, wfileadd_t &addInfo,
    if(!(addInfo.flags & WFA_PRIVATE) && this->ispublic)
    {
       // haleyjd 06/21/04: track handle of first wad added also
-      if(ResWADSource == -1)
-         ResWADSource = source;
+      if(reswadsource == -1)
+         reswadsource = source;
 
       // haleyjd 07/13/09: only track the first IWAD found
       // haleyjd 11/03/12: Status as the IWAD is now determined by how the file
       // was added to the game (ie., -iwad or -disk, vs. -file, autoloads, etc.)
-      if(IWADSource < 0 && (addInfo.flags & WFA_ISIWADFILE))
-         IWADSource = source;
+      if(iwadsource < 0 && (addInfo.flags & WFA_ISIWADFILE))
+         iwadsource = source;
    }
 
    // Add lumpinfo_t's for all lumps in the wad file
@@ -599,20 +735,18 @@ bool WadDirectory::addZipFile(openwad_t &openData, wfileadd_t &addInfo,
          lump_p->li_namespace = li_namespace;
          W_LumpNameFromFilePath(zipLump.name, lump_p->name, li_namespace);
       }
-
-      // Copy lfn
-      lump_p->lfn = estrdup(zipLump.name);
    }
 
-   // Hook the ZipFile instance into the WadDirectory's list of zips
+   // Hook the ZipFile instance into the WadDirectory's list of zips; from
+   // here on the directory owns it.
    zip->linkTo(&pImpl->zipFiles);
+   ZipFile *pzip = zip.release();
 
    incrementSource(openData);
 
    // Check for embedded wad files
-   zip->checkForWadFiles(*this);
+   pzip->checkForWadFiles(*this);
 
-   zip.release(); // don't destroy the ZipFile
    return true;
 }
 
@@ -664,6 +798,14 @@ bool WadDirectory::addFile(wfileadd_t &addInfo)
       openData.filename = "memory";
       openData.format   = W_FORMAT_WAD; // wad handler will deal with this.
    }
+   else if(addInfo.flags & WFA_OPENSTREAM)
+   {
+      // The caller has already opened the archive; from here on it is
+      // treated exactly as if it had been opened by name.
+      openData.filename = addInfo.filename;
+      openData.handle   = addInfo.f;
+      openData.format   = W_DetermineFileFormat(openData.handle, 0);
+   }
    else
    {
       // Open the physical archive file and determine its format
@@ -769,13 +911,10 @@ int WadDirectory::addDirectory(const char *dirpath)
    // Fill in lumpinfo
    startlump = numlumps;
    numlumps += localcount;
-   lumpinfo = erealloc(lumpinfo_t **, lumpinfo, numlumps * sizeof(lumpinfo_t *));
+   growLumpInfo();
 
    // create lumpinfo_t structures for the files
-   newlumps = estructalloc(lumpinfo_t, localcount);
-   
-   // keep track of this allocation of lumps
-   addInfoPtr(newlumps);
+   newlumps = allocInfoBlock(localcount);
 
    for(i = 0, globallump = startlump; i < fileslen; i++)
    {
@@ -787,16 +926,16 @@ int WadDirectory::addDirectory(const char *dirpath)
          M_Strupr(lump->name);
          lump->li_namespace = lumpinfo_t::ns_global; // TODO
          lump->type         = lumpinfo_t::lump_file;
-         lump->lfn          = estrdup(files[i].fullfn);
+         lump->file.path    = estrdup(files[i].fullfn);
          lump->source       = source;
-         lump->size         = files[i].size;
+         lump->size         = static_cast<uint32_t>(files[i].size);
 
          lumpinfo[globallump++] = lump;
       }
    }
 
    // push source filename
-   WadDirectoryPimpl::AddFileName(dirpath);
+   pImpl->addFileName(dirpath);
 
    // increment source
    ++source;
@@ -838,8 +977,8 @@ bool WadDirectory::addInMemoryWad(void *buffer, size_t size)
 
 static int W_IsMarker(const char *marker, const char *name)
 {
-   return !strncasecmp(name, marker, 8) ||
-      (*name == *marker && !strncasecmp(name+1, marker, 7));
+   return !M_FoldCompare(name, marker, 8) ||
+      (*name == *marker && !M_FoldCompare(name+1, marker, 7));
 }
 
 // namespace data
@@ -1011,18 +1150,19 @@ void WadDirectory::coalesceMarkedResources()
 //
 unsigned int WadDirectory::LumpNameHash(const char *s)
 {
-  using namespace ectype;
-  unsigned int hash;
-  (void) ((hash =        toUpper(s[0]), s[1]) &&
-          (hash = hash*3+toUpper(s[1]), s[2]) &&
-          (hash = hash*2+toUpper(s[2]), s[3]) &&
-          (hash = hash*2+toUpper(s[3]), s[4]) &&
-          (hash = hash*2+toUpper(s[4]), s[5]) &&
-          (hash = hash*2+toUpper(s[5]), s[6]) &&
-          (hash = hash*2+toUpper(s[6]),
-           hash = hash*2+toUpper(s[7]))
-         );
-  return hash;
+   return M_FoldKeyHash(M_FoldKey(s));
+}
+
+//
+// WadDirectory::LumpNameKey
+//
+// Packs an up-to-eight-character lump name into a single upper-cased 64-bit
+// key, so that names can be compared with one integer comparison. Bytes
+// following the name's terminator are zero.
+//
+uint64_t WadDirectory::LumpNameKey(const char *s)
+{
+   return M_FoldKey(s);
 }
 
 //
@@ -1050,7 +1190,8 @@ int WadDirectory::checkNumForName(const char *name, int li_namespace)
    // Hash function maps the name to one of possibly numlump chains.
    // It has been tuned so that the average chain length never exceeds 2.
    
-   unsigned int hashkey = LumpNameHash(name) % (unsigned int)numlumps;
+   uint64_t     namekey = LumpNameKey(name);
+   unsigned int hashkey = M_FoldKeyHash(namekey) % (unsigned int)numlumps;
    register int i = lumpinfo[hashkey]->namehash.index;
 
    // We search along the chain until end, looking for case-insensitive
@@ -1058,8 +1199,10 @@ int WadDirectory::checkNumForName(const char *name, int li_namespace)
    // not used for each namespace, because the performance benefit is not
    // worth the overhead, considering namespace collisions are rare in
    // Doom wads.
+   // Names are compared through the packed key array, so only
+   // the chain link is needed from each lumpinfo_t visited.
 
-   while(i >= 0 && (strncasecmp(lumpinfo[i]->name, name, 8) ||
+   while(i >= 0 && (lumpkeys[i] != namekey ||
          lumpinfo[i]->li_namespace != li_namespace))
       i = lumpinfo[i]->namehash.next;
 
@@ -1137,8 +1280,9 @@ int WadDirectory::checkNumForLFN(const char *lfn, int li_namespace)
 
    for(; i >= 0; i = lumpinfo[i]->lfnhash.next)
    {
-      if(lumpinfo[i]->lfn &&
-         !strcmp(lumpinfo[i]->lfn, lfn) &&
+      const char *lumplfn = lumpinfo[i]->getLFN();
+
+      if(lumplfn && !strcmp(lumplfn, lfn) &&
          lumpinfo[i]->li_namespace == li_namespace)
          break; // found it.
    }
@@ -1169,7 +1313,7 @@ const char *WadDirectory::getLumpFileName(int lump)
       return NULL;
 
    size_t lumpIdx = static_cast<size_t>(lump);
-   return WadDirectoryPimpl::FileNameForSource(lumpinfo[lumpIdx]->source);
+   return pImpl->fileNameForSource(lumpinfo[lumpIdx]->source);
 }
 
 //
@@ -1180,12 +1324,20 @@ const char *WadDirectory::getLumpFileName(int lump)
 void WadDirectory::initLumpHash()
 {
    int i;
+
+   // rebuild the packed name array alongside the hash
+   if(numlumps > pImpl->lumpkeysalloc)
+   {
+      lumpkeys = erealloc(uint64_t *, lumpkeys, numlumps * sizeof(uint64_t));
+      pImpl->lumpkeysalloc = numlumps;
+   }
    
    for(i = 0; i < numlumps; i++)
    {
       lumpinfo[i]->namehash.index = -1; // mark slots empty
       lumpinfo[i]->lfnhash.index  = -1;
       lumpinfo[i]->selfindex      =  i; // haleyjd: record position in array
+      lumpkeys[i] = LumpNameKey(lumpinfo[i]->name);
    }
 
    // Insert nodes to the beginning of each chain, in first-to-last
@@ -1200,15 +1352,16 @@ void WadDirectory::initLumpHash()
       if(!(lumpinfo[i]->name[0]))
          continue;
 
-      j = LumpNameHash(lumpinfo[i]->name) % (unsigned int)numlumps;
+      j = M_FoldKeyHash(lumpkeys[i]) % (unsigned int)numlumps;
       lumpinfo[i]->namehash.next = lumpinfo[j]->namehash.index; // Prepend to list
       lumpinfo[j]->namehash.index = i;
 
       // haleyjd 04/21/12: add to lfn hash also if has a valid LFN
-      if(!(lumpinfo[i]->lfn && *lumpinfo[i]->lfn))
+      const char *lfn = lumpinfo[i]->getLFN();
+      if(!(lfn && *lfn))
          continue;
 
-      j = D_HashTableKeyCase(lumpinfo[i]->lfn) % (unsigned int)numlumps;
+      j = D_HashTableKeyCase(lfn) % (unsigned int)numlumps;
       lumpinfo[i]->lfnhash.next = lumpinfo[j]->lfnhash.index;
       lumpinfo[j]->lfnhash.index = i;
    }
@@ -1300,7 +1453,7 @@ bool WadDirectory::addNewFile(const char *filename)
    return true;
 }
 
-bool WadDirectory::addNewPrivateFile(const char *filename)
+bool WadDirectory::addNewPrivateFile(const char *filename, unsigned int flags)
 {
    wfileadd_t newfile;
 
@@ -1309,7 +1462,7 @@ bool WadDirectory::addNewPrivateFile(const char *filename)
    newfile.baseoffset   = 0;
    newfile.li_namespace = lumpinfo_t::ns_global;
    newfile.requiredFmt  = -1;
-   newfile.flags        = WFA_PRIVATE;
+   newfile.flags        = WFA_PRIVATE | flags;
 
    if(!addFile(newfile))
       return false;
@@ -1321,6 +1474,54 @@ bool WadDirectory::addNewPrivateFile(const char *filename)
    return true;
 }
 
+//
+// WadDirectory::addNewPrivateMemoryFile
+//
+// Add an archive held in a buffer to a private directory, in the same way as
+// addNewPrivateFile. WAD files are read from the buffer directly; other
+// formats are read through a stream over it, where the C library can make
+// one. Lumps are read from the buffer for as long as the archive is loaded.
+//
+bool WadDirectory::addNewPrivateMemoryFile(void *buffer, size_t size, unsigned int flags)
+{
+   wfileadd_t newfile;
+
+   memset(&newfile, 0, sizeof(newfile));
+   newfile.filename     = "memory";
+   newfile.li_namespace = lumpinfo_t::ns_global;
+   newfile.requiredFmt  = -1;
+   newfile.flags        = WFA_PRIVATE | flags;
+
+   if(size >= sizeof(wadinfo_t) &&
+      (!memcmp(buffer, "IWAD", 4) || !memcmp(buffer, "PWAD", 4)))
+   {
+      newfile.memory = buffer;
+      newfile.size   = size;
+      newfile.flags |= WFA_INMEMORY;
+   }
+   else
+   {
+#ifndef _MSC_VER
+      if(size)
+         newfile.f = fmemopen(buffer, size, "rb");
+#endif
+      if(!newfile.f)
+      {
+         openwad_t openData;
+         handleOpenError(openData, newfile, newfile.filename);
+         return false;
+      }
+      newfile.flags |= WFA_OPENSTREAM;
+   }
+
+   if(!addFile(newfile))
+      return false;
+
+   initLumpHash();
+
+   return true;
+}
+
 //
 // W_LumpLength
 //
@@ -1414,11 +1615,182 @@ int W_ReadLumpHeader(int lump, void *dest, size_t size)
    return wGlobalDir.readLumpHeader(lump, dest, size);
 }
 
+//
+// WadDirectory::streamLump
+//
+// Pass a lump to a streamer, chunksize bytes at a time, so that large lumps
+// can be processed without holding all of them in memory. The buffer only
+// grows past chunksize if the streamer leaves a whole buffer unused. Lumps
+// which are already in memory are passed in one piece, without copying, and
+// compressed lumps are read whole.
+//
+void WadDirectory::streamLump(int lump, WadLumpStreamer &streamer, size_t chunksize)
+{
+   if(lump < 0 || lump >= numlumps)
+      I_Error("WadDirectory::streamLump: %d >= numlumps\n", lump);
+
+   lumpinfo_t *l = lumpinfo[lump];
+
+   if(l->type == lumpinfo_t::lump_memory)
+   {
+      memorylump_t &memory = l->memory;
+      streamer.consume(static_cast<const byte *>(memory.data) + memory.position,
+                       l->size, true);
+      return;
+   }
+
+   if(l->type != lumpinfo_t::lump_direct || l->size <= chunksize)
+   {
+      ZAutoBuffer whole;
+      cacheLumpAuto(lump, whole);
+      streamer.consume(whole.getAs<const byte *>(), l->size, true);
+      return;
+   }
+
+   directlump_t &direct = l->direct;
+   ZAutoBuffer buffer(chunksize, false);
+   size_t remaining = l->size;
+   size_t held      = 0; // unused data at the start of the buffer
+
+   fseek(direct.file, direct.position, SEEK_SET);
+
+   while(remaining)
+   {
+      if(held == buffer.getSize())
+         buffer.realloc(buffer.getSize() * 2);
+
+      byte  *data   = buffer.getAs<byte *>();
+      size_t toread = buffer.getSize() - held;
+      if(toread > remaining)
+         toread = remaining;
+
+      if(fread(data + held, 1, toread, direct.file) != toread)
+         I_Error("WadDirectory::streamLump: could not read lump %d\n", lump);
+      remaining -= toread;
+      held      += toread;
+
+      size_t used = streamer.consume(data, held, !remaining);
+      held -= used;
+      if(held)
+         memmove(data, data + used, held);
+   }
+}
+
+//
+// WadDirectory::syncCacheBytes
+//
+// Cached data can be freed behind the cache's back, by Z_FreeTags or by a
+// user that took ownership of it, so bring a record's byte count back in
+// line with the slots which are actually still resident.
+//
+void WadDirectory::syncCacheBytes(int lump)
+{
+   lumpcache_t *cache = lumpinfo[lump]->cache;
+   size_t resident = 0;
+
+   for(int fmt = 0; fmt != lumpinfo_t::fmt_maxfmts; fmt++)
+   {
+      if(cache->data[fmt])
+         resident += lumpinfo[lump]->size;
+   }
+
+   pImpl->cachebytes -= cache->bytes - resident;
+   cache->bytes = resident;
+}
+
+//
+// WadDirectory::evictCachedLumps
+//
+// Run the clock hand over the cached lumps, freeing purgable data that has
+// not been used since the hand last passed, until another "needed" bytes
+// will fit in the cache budget. Data cached at a non-purgable tag is never
+// freed here, so the budget is a target rather than a hard limit.
+//
+void WadDirectory::evictCachedLumps(size_t needed)
+{
+   WadDirectoryPimpl &impl = *pImpl;
+   PODCollection<int> &ring = impl.clockring;
+   size_t sweeps = 2 * ring.getLength(); // each entry may be passed twice
+
+   while(impl.cachebytes + needed > impl.cachebudget && ring.getLength() &&
+         sweeps--)
+   {
+      if(impl.clockhand >= ring.getLength())
+         impl.clockhand = 0;
+
+      int          lump  = ring[impl.clockhand];
+      lumpcache_t *cache = lumpinfo[lump]->cache;
+
+      syncCacheBytes(lump);
+
+      if(cache->referenced && cache->bytes)
+      {
+         // give it another pass
+         cache->referenced = false;
+         ++impl.clockhand;
+         continue;
+      }
+
+      for(int fmt = 0; fmt != lumpinfo_t::fmt_maxfmts; fmt++)
+      {
+         if(cache->data[fmt] && Z_CheckTag(cache->data[fmt]) >= PU_PURGELEVEL)
+         {
+            Z_Free(cache->data[fmt]);
+            cache->bytes    -= lumpinfo[lump]->size;
+            impl.cachebytes -= lumpinfo[lump]->size;
+            ++impl.cachestats.evictions;
+         }
+      }
+
+      if(!cache->bytes)
+      {
+         // nothing left; drop it from the ring, and examine the entry
+         // that takes its place
+         ring[impl.clockhand] = ring[ring.getLength() - 1];
+         ring.pop();
+         cache->inclock = false;
+      }
+      else
+         ++impl.clockhand;
+   }
+}
+
+//
+// WadDirectory::setCacheBudget
+//
+// Set the number of bytes of lump data cacheLumpNum may keep resident.
+// Zero removes the limit.
+//
+void WadDirectory::setCacheBudget(size_t budget)
+{
+   pImpl->cachebudget = budget;
+
+   if(budget)
+      evictCachedLumps(0);
+}
+
+//
+// WadDirectory::getCacheStats
+//
+WadDirectory::cachestats_t WadDirectory::getCacheStats() const
+{
+   cachestats_t stats = pImpl->cachestats;
+
+   stats.bytes  = pImpl->cachebytes;
+   stats.budget = pImpl->cachebudget;
+
+   return stats;
+}
+
 //
 // W_CacheLumpNum
 //
 // killough 4/25/98: simplified
 //
+// Lumps are read into per-format cache slots, which count against the
+// directory's cache budget. Purgable data that has gone unused the longest
+// is released to make room for new lumps.
+//
 void *WadDirectory::cacheLumpNum(int lump, int tag, WadLumpLoader *lfmt)
 {
    lumpinfo_t::lumpformat fmt = lumpinfo_t::fmt_default;
@@ -1429,26 +1801,62 @@ void *WadDirectory::cacheLumpNum(int lump, int tag, WadLumpLoader *lfmt)
    // haleyjd 08/14/02: again, should not be RANGECHECK only
    if(lump < 0 || lump >= numlumps)
       I_Error("WadDirectory::CacheLumpNum: %i >= numlumps\n", lump);
+
+   // cache slots are created the first time a lump is cached
+   if(!lumpinfo[lump]->cache)
+      lumpinfo[lump]->cache = estructalloc(lumpcache_t, 1);
+
+   lumpcache_t *record = lumpinfo[lump]->cache;
+   void       **cache  = record->data;
    
-   if(!(lumpinfo[lump]->cache[fmt]))      // read the lump in
+   if(!(cache[fmt]))      // read the lump in
    {
-      readLump(lump, 
-               Z_Malloc(lumpLength(lump), tag, &(lumpinfo[lump]->cache[fmt])), 
-               lfmt);
+      WadDirectoryPimpl &impl = *pImpl;
+      size_t size = lumpinfo[lump]->size;
+
+      ++impl.cachestats.misses;
+
+      // make room within the budget first
+      if(impl.cachebudget)
+         evictCachedLumps(size);
+
+      // a failed read must not leave a half-filled slot behind
+      try
+      {
+         readLump(lump, Z_Malloc(size, tag, &cache[fmt]), lfmt);
+      }
+      catch(...)
+      {
+         Z_Free(cache[fmt]);
+         throw;
+      }
+
+      record->bytes   += size;
+      impl.cachebytes += size;
+
+      if(!record->inclock)
+      {
+         impl.clockring.add(lump);
+         record->inclock = true;
+      }
    }
    else
    {
+      ++pImpl->cachestats.hits;
+
       // haleyjd: do not lower cache level and cause static users to lose their 
       // data unexpectedly (ie, do not change PU_STATIC into PU_CACHE -- that 
       // must be done using Z_ChangeTag explicitly)
       
-      int oldtag = Z_CheckTag(lumpinfo[lump]->cache[fmt]);
+      int oldtag = Z_CheckTag(cache[fmt]);
 
       if(tag < oldtag) 
-         Z_ChangeTag(lumpinfo[lump]->cache[fmt], tag);
+         Z_ChangeTag(cache[fmt], tag);
    }
+
+   record->referenced = true;
    
-   return lumpinfo[lump]->cache[fmt];
+   return cache[fmt];
 }
 
 //
@@ -1549,19 +1957,26 @@ void WadDirectory::freeDirectoryLumps()
 
    for(i = 0; i < numlumps; ++i)
    {
-      for(j = 0; j != lumpinfo_t::fmt_maxfmts; j++)
+      if(li[i]->cache)
       {
-         if(li[i]->cache[j])
+         for(j = 0; j != lumpinfo_t::fmt_maxfmts; j++)
          {
-            Z_Free(li[i]->cache[j]);
-            li[i]->cache[j] = NULL;
+            if(li[i]->cache->data[j])
+               Z_Free(li[i]->cache->data[j]);
          }
+         efree(li[i]->cache);
+         li[i]->cache = NULL;
       }
 
-      // free long filenames
-      if(li[i]->lfn)
-         efree(li[i]->lfn);
+      // free file paths, which are the only long filenames owned here
+      if(li[i]->type == lumpinfo_t::lump_file && li[i]->file.path)
+         efree(li[i]->file.path);
    }
+
+   // nothing is cached any longer
+   pImpl->clockring.makeEmpty();
+   pImpl->clockhand  = 0;
+   pImpl->cachebytes = 0;
 }
 
 //
@@ -1579,6 +1994,63 @@ void WadDirectory::freeDirectoryAllocs()
       efree(pImpl->infoptrs[i]);
 
    pImpl->infoptrs.clear();
+   pImpl->infosizes.clear();
+   pImpl->nextinfo = 0;
+}
+
+//
+// WadDirectory::closeDirectFiles
+//
+// Close every physical wad file that direct lumps are read from. Lumps from
+// the same file are contiguous, so each handle is seen in a single run.
+//
+void WadDirectory::closeDirectFiles()
+{
+   FILE *lastfile = NULL;
+
+   for(int i = 0; i < numlumps; i++)
+   {
+      lumpinfo_t *lump = lumpinfo[i];
+
+      if(lump->type != lumpinfo_t::lump_direct &&
+         lump->type != lumpinfo_t::lump_direct_jag)
+         continue;
+
+      if(lump->direct.file && lump->direct.file != lastfile)
+      {
+         lastfile = lump->direct.file;
+         fclose(lastfile);
+      }
+   }
+}
+
+//
+// WadDirectory::reset
+//
+// Return a private directory to its empty state so that another archive can
+// be loaded into it. Everything belonging to the loaded archives is released,
+// but the lumpinfo_t allocations and the lumpinfo and name key arrays are
+// kept for the next load. Public directories can't be reset.
+//
+void WadDirectory::reset()
+{
+   if(ispublic)
+      return;
+
+   // free all resources loaded from the archives
+   freeDirectoryLumps();
+   closeDirectFiles();
+   pImpl->deleteZipFiles();
+   pImpl->sourceFileNames.makeEmpty();
+
+   // all lumpinfo_t allocations become available again
+   pImpl->nextinfo = 0;
+
+   numlumps     = 0;
+   source       = 0;
+   iwadsource   = -1;
+   reswadsource = -1;
+   memset(m_namespaces, 0, sizeof(m_namespaces));
 }
 
 //
@@ -1591,12 +2063,7 @@ void WadDirectory::close()
    // close the wad file if it is open; public directories can't be closed
    if(lumpinfo && !ispublic)
    {
-      // free all resources loaded from the wad
-      freeDirectoryLumps();
-
-      if(lumpinfo[0]->type == lumpinfo_t::lump_direct &&
-         lumpinfo[0]->direct.file)
-         fclose(lumpinfo[0]->direct.file);
+      reset();
 
       // free all lumpinfo_t's allocated for the wad
       freeDirectoryAllocs();
@@ -1605,6 +2072,14 @@ void WadDirectory::close()
       Z_Free(lumpinfo);
 
       lumpinfo = NULL;
+      pImpl->lumpinfoalloc = 0;
+
+      if(lumpkeys)
+      {
+         efree(lumpkeys);
+         lumpkeys = NULL;
+         pImpl->lumpkeysalloc = 0;
+      }
    }
 }
 
@@ -1738,7 +2213,7 @@ static size_t W_FileReadLump(lumpinfo_t *l, void *dest)
    size_t size     = l->size;
    size_t sizeread = 0;
 
-   if((f = fopen(l->lfn, "rb")))
+   if((f = fopen(l->file.path, "rb")))
    {
       //I_BeginRead();
       sizeread = fread(dest, 1, size, f);
@@ -27,6 +27,7 @@
 #ifndef W_WAD_H__
 #define W_WAD_H__
 
+#include "doomtype.h"
 #include "z_zone.h"
 
 class  ZAutoBuffer;
@@ -71,19 +72,39 @@ struct ziplump_t
    ZipLump *zipLump; // pointer to zip lump instance
 };
 
+// A directory file lump is a physical file that is opened by path when read.
+struct pathlump_t
+{
+   char *path;       // full path to the file; doubles as its long file name
+};
+
+// Cache slots for a lump, allocated only once the lump is actually cached.
+struct lumpcache_t;
+
 //
 // WADFILE I/O related stuff.
 //
 
 // haleyjd 07/12/07: altered lumpinfo_t for separation of logical and physical
 // lump fields.
+//
+// Narrow fields are ordered so that the whole structure packs into a single
+// 64-byte cache line on 64-bit platforms; compilation wads with several
+// hundred thousand lumps spend most of their directory time on this table.
 
 struct lumpinfo_t
 {
    // haleyjd: logical lump data
-   char   name[9];
-   size_t size;
+   char    name[9];
+   uint8_t type;         // haleyjd: lump type (see enumeration below)
+   uint8_t li_namespace; // killough 4/17/98: namespace tag
+   int     source;       // haleyjd: unique id # for source of this lump
+   uint32_t size;
    
+   // haleyjd 03/27/11: array index into lumpinfo in the parent wad directory,
+   // for fast reverse lookup.
+   int selfindex;
+
    // killough 1/31/98: hash table fields, used for ultra-fast hash table lookup
    struct hash_t
    {
@@ -91,10 +112,6 @@ struct lumpinfo_t
    };
    hash_t namehash, lfnhash;
 
-   // haleyjd 03/27/11: array index into lumpinfo in the parent wad directory,
-   // for fast reverse lookup.
-   int selfindex;
-
    // killough 4/17/98: namespace tags, to prevent conflicts between resources
    enum 
    {
@@ -104,7 +121,6 @@ struct lumpinfo_t
       ns_flats,
       ns_max           // keep this last.
    };
-   int li_namespace;
 
    // haleyjd 09/03/12: lump cache formats
    typedef enum
@@ -114,7 +130,7 @@ struct lumpinfo_t
       fmt_maxfmts  // number of formats
    } lumpformat;
    
-   void *cache[fmt_maxfmts];  //sf
+   lumpcache_t *cache; // sf; null until the lump is first cached
 
    // haleyjd: lump type
    enum
@@ -126,19 +142,18 @@ struct lumpinfo_t
       lump_direct_jag, // lump accessed via stdio but is Jag-compressed
       lump_numtypes
    }; 
-   int type;
 
-   int source; // haleyjd: unique id # for source of this lump
-   
    // haleyjd: physical lump data (guarded union)
    union
    {
       directlump_t direct;
       memorylump_t memory;
       ziplump_t    zip;
+      pathlump_t   file;
    };
 
-   char *lfn;  // long file name, where relevant   
+   // long file name, where relevant; shared with the physical lump data
+   const char *getLFN() const;
 };
 
 // Flags for wfileadd_t
@@ -153,6 +168,7 @@ enum WFileAddFlags
    WFA_ALLOWHACKS     = 0x0040, // Allow application of wad directory hacks
    WFA_INMEMORY       = 0x0080, // Archive is in memory
    WFA_ISIWADFILE     = 0x0100, // Archive is the main IWAD file
+   WFA_OPENSTREAM     = 0x0200, // Archive is an open stream, given in f
 };
 
 //
@@ -166,7 +182,7 @@ struct wfileadd_t
 {
    const char *filename; // name of file as specified by end user
    int     li_namespace; // if not 0, special namespace to add file under
-   FILE   *f;            // pointer to file handle, IFF this is a subfile
+   FILE   *f;            // pointer to file handle, IFF this is a subfile or stream
    size_t  baseoffset;   // base offset if this is a subfile
    void   *memory;       // memory buffer, IFF archive is in memory
    size_t  size;         // size of buffer, IFF archive is in memory
@@ -207,6 +223,25 @@ public:
    virtual lumpinfo_t::lumpformat formatIndex() const { return lumpinfo_t::fmt_default; }
 };
 
+//
+// WadLumpStreamer
+//
+// Inherit from this interface class to receive a lump a piece at a time from
+// WadDirectory::streamLump, rather than all at once.
+//
+class WadLumpStreamer
+{
+public:
+   virtual ~WadLumpStreamer() {}
+
+   // consume is given the lump's data from where it last left off, and
+   // returns how much of it was used. Data not used is passed again at the
+   // start of the next call, followed by more of the lump. last is true once
+   // the data runs to the end of the lump; whatever is not used then is
+   // dropped.
+   virtual size_t consume(const byte *data, size_t size, bool last) = 0;
+};
+
 class WadDirectoryPimpl;
 
 //
@@ -233,15 +268,28 @@ public:
       ADDPRIVATE  // Add to a private directory
    };
    
-   static int IWADSource;   // source # of the global IWAD file
-   static int ResWADSource; // source # of the resource wad (ie. eternity.wad)
-
    struct namespace_t
    {
       int firstLump; // first lump
       int numLumps;  // number of lumps in namespace
    };
 
+   // lump cache statistics
+   struct cachestats_t
+   {
+      uint64_t hits;      // cacheLumpNum calls satisfied from the cache
+      uint64_t misses;    // cacheLumpNum calls that read the lump
+      uint64_t evictions; // cached lumps freed to stay within budget
+      size_t   bytes;     // bytes currently cached
+      size_t   budget;    // cache budget in bytes; 0 is unlimited
+   };
+
+   // default lump cache budget for new directories
+   static const size_t DEFAULT_CACHE_BUDGET = 32 * 1024 * 1024;
+
+   // default amount of a lump read at a time by streamLump
+   static const size_t STREAM_CHUNK_SIZE = 64 * 1024;
+
 private:
    WadDirectoryPimpl *pImpl; // private implementation object
 
@@ -257,9 +305,12 @@ protected:
       int     format;       // detected file format
    };
 
-   static int source;     // unique source ID for each wad file
+   int        source;       // unique source ID for each wad file
+   int        iwadsource;   // source # of the IWAD file, if any
+   int        reswadsource; // source # of the resource wad (ie. eternity.wad)
 
    lumpinfo_t **lumpinfo; // array of pointers to lumpinfo structures
+   uint64_t    *lumpkeys; // packed lump names, by lump number
    int        numlumps;   // number of lumps
    bool       ispublic;   // if false, don't call D_NewWadLumps
    int        type;       // directory type
@@ -270,7 +321,8 @@ protected:
    void initLumpHash();
    void initLFNHash();
    void initResources();
-   void addInfoPtr(lumpinfo_t *infoptr);
+   lumpinfo_t *allocInfoBlock(int count);
+   void growLumpInfo();
    void coalesceMarkedResources();
    void incrementSource(openwad_t &openData);
    void handleOpenError(openwad_t &openData, wfileadd_t &addInfo,
@@ -284,6 +336,9 @@ protected:
    bool addFile(wfileadd_t &addInfo);
    void freeDirectoryLumps();  // haleyjd 06/27/09
    void freeDirectoryAllocs(); // haleyjd 06/06/10
+   void closeDirectFiles();
+   void syncCacheBytes(int lump);
+   void evictCachedLumps(size_t needed);
 
    // Utilities
    static unsigned int LumpNameHash(const char *s);
@@ -302,21 +357,29 @@ public:
    // sf: add a new wad file after the game has already begun
    bool  addNewFile(const char *filename);
    // haleyjd 06/15/10: special private wad file support
-   bool  addNewPrivateFile(const char *filename);
+   bool  addNewPrivateFile(const char *filename, unsigned int flags = 0);
+   bool  addNewPrivateMemoryFile(void *buffer, size_t size, unsigned int flags = 0);
    int   addDirectory(const char *dirpath);
    bool  addInMemoryWad(void *buffer, size_t size);
    int   lumpLength(int lump);
    void  readLump(int lump, void *dest, WadLumpLoader *lfmt = NULL);
    int   readLumpHeader(int lump, void *dest, size_t size);
+   void  streamLump(int lump, WadLumpStreamer &streamer,
+                    size_t chunksize = STREAM_CHUNK_SIZE);
    void *cacheLumpNum(int lump, int tag, WadLumpLoader *lfmt = NULL);
    void *cacheLumpName(const char *name, int tag, WadLumpLoader *lfmt = NULL);
    void  cacheLumpAuto(int lumpnum, ZAutoBuffer &buffer);
    void  cacheLumpAuto(const char *name, ZAutoBuffer &buffer);
    bool  writeLump(const char *lumpname, const char *destpath);
+   void  setCacheBudget(size_t budget);
+   cachestats_t getCacheStats() const;
+   void  reset(); // release loaded archives, keeping allocations for reuse
    void  close(); // haleyjd 03/09/11
 
    lumpinfo_t *getLumpNameChain(const char *name) const;
 
+   static uint64_t LumpNameKey(const char *name);
+
    const char *getLumpFileName(int lump);
 
    // Accessors
@@ -324,16 +387,23 @@ public:
    void  setType(int i)   { type = i;    }
    
    // Read-only properties
-   int          getNumLumps() const { return numlumps; }
+   int          getNumLumps()     const { return numlumps;     }
+   int          getIWADSource()   const { return iwadsource;   }
+   int          getResWADSource() const { return reswadsource; }
    lumpinfo_t **getLumpInfo() const { return lumpinfo; }
 
+   // Packed, upper-cased name of a lump; see LumpNameKey.
+   uint64_t getLumpKey(int lump) const { return lumpkeys[lump]; }
+
    const namespace_t &getNamespace(int li_namespace) const
    {
       return m_namespaces[li_namespace];
    }
 };
 
-extern WadDirectory wGlobalDir; // the global wad directory
+// The global wad directory. The W_ functions below operate on it; code that
+// may run on more than one thread should use its own WadDirectory instead.
+extern WadDirectory wGlobalDir;
 
 int         W_CheckNumForName(const char *name);   // killough 4/17/98
 int         W_CheckNumForNameNS(const char *name, int li_namespace);
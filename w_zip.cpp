@@ -28,6 +28,7 @@
 
 #include "i_system.h"
 #include "m_buffer.h"
+#include "m_casefold.h"
 #include "m_compare.h"
 #include "m_qstr.h"
 #include "m_structio.h"
@@ -390,8 +391,8 @@ bool ZipFile::readCentralDirEntry(InBuffer &fin, ZipLump &lump, bool &skip)
    }
    
    // Save and normalize the name
+   M_FoldLower(name, entry.nameLength);
    namestr.copy(name, entry.nameLength);
-   namestr.toLower();
    namestr.replace("\\", '/');
 
    // Save important directory information
@@ -517,12 +518,13 @@ void ZipFile::checkForWadFiles(WadDirectory &parentDir)
       zipwad->size   = static_cast<size_t>(lumps[i].size);
       zipwad->buffer = Z_Malloc(zipwad->size, PU_STATIC, NULL);
 
+      // remember this zipwad before reading, so it is freed with the zip
+      // even if the read fails
+      zipwad->links.insert(zipwad, &wads);
+
       lumps[i].read(zipwad->buffer);
 
       parentDir.addInMemoryWad(zipwad->buffer, zipwad->size);
-
-      // remember this zipwad
-      zipwad->links.insert(zipwad, &wads);
    }
 }
 
@@ -0,0 +1,825 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Thingtypes defined by DECORATE, ZSCRIPT and MAPINFO lumps
+//
+//      Only actor and class headers, DoomEdNums blocks, and includes are
+//      read. Everything else is skipped a block at a time, by brace depth,
+//      rather than tokenized. A thingtype's class comes from the actors it
+//      inherits from, back to one whose class is known.
+//
+//-----------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "z_zone.h"
+#include "z_auto.h"
+#include "m_collection.h"
+#include "m_ctype.h"
+#include "p_thingtypes.h"
+#include "w_wad.h"
+#include "xl_ednums.h"
+#include "xl_scripts.h"
+
+// Deepest nesting of includes followed
+#define XLE_MAXINCLUDE 16
+
+// Longest chain of parents followed to find a class
+#define XLE_MAXPARENTS 64
+
+//=============================================================================
+//
+// Known actors
+//
+
+struct xlnative_t
+{
+   const char *name;
+   int         classtype;
+};
+
+//
+// Actors of the games' own, which archive actors inherit from
+//
+static const xlnative_t xlnatives[] =
+{
+   // base classes
+   { "Health",              CLASS_HEALTH    },
+   { "Armor",               CLASS_ARMOR     },
+   { "BasicArmorPickup",    CLASS_ARMOR     },
+   { "BasicArmorBonus",     CLASS_ARMOR     },
+   { "HexenArmor",          CLASS_ARMOR     },
+   { "Ammo",                CLASS_AMMO      },
+   { "BackpackItem",        CLASS_AMMO      },
+   { "Weapon",              CLASS_WEAPON    },
+   { "WeaponPiece",         CLASS_WEAPON    },
+   { "Key",                 CLASS_KEY       },
+   { "HealthPickup",        CLASS_ARTIFACT  },
+   { "PowerupGiver",        CLASS_POWERUP   },
+   { "MapRevealer",         CLASS_POWERUP   },
+   { "PuzzleItem",          CLASS_QUEST     },
+   { "QuestItem",           CLASS_QUEST     },
+   { "SwitchableDecoration", CLASS_DECOR    },
+   { "SwitchingDecoration", CLASS_DECOR     },
+   { "AmbientSound",        CLASS_AMBIENT   },
+   { "AmbientSoundNoGravity", CLASS_AMBIENT },
+   { "TeleportDest",        CLASS_TECHNICAL },
+   { "MapSpot",             CLASS_TECHNICAL },
+   { "PatrolPoint",         CLASS_TECHNICAL },
+   { "SecretTrigger",       CLASS_TECHNICAL },
+   { "SkyViewpoint",        CLASS_TECHNICAL },
+   { "InterpolationPoint",  CLASS_TECHNICAL },
+   { "PointPusher",         CLASS_TECHNICAL },
+   { "PointPuller",         CLASS_TECHNICAL },
+   { "DynamicLight",        CLASS_TECHNICAL },
+   { "BossTarget",          CLASS_TECHNICAL },
+   { "BossEye",             CLASS_TECHNICAL },
+
+   // Doom
+   { "ZombieMan",           CLASS_MONSTER   },
+   { "ShotgunGuy",          CLASS_MONSTER   },
+   { "ChaingunGuy",         CLASS_MONSTER   },
+   { "DoomImp",             CLASS_MONSTER   },
+   { "Demon",               CLASS_MONSTER   },
+   { "Spectre",             CLASS_MONSTER   },
+   { "LostSoul",            CLASS_MONSTER   },
+   { "Cacodemon",           CLASS_MONSTER   },
+   { "HellKnight",          CLASS_MONSTER   },
+   { "BaronOfHell",         CLASS_MONSTER   },
+   { "Arachnotron",         CLASS_MONSTER   },
+   { "PainElemental",       CLASS_MONSTER   },
+   { "Revenant",            CLASS_MONSTER   },
+   { "Fatso",               CLASS_MONSTER   },
+   { "Archvile",            CLASS_MONSTER   },
+   { "SpiderMastermind",    CLASS_MONSTER   },
+   { "Cyberdemon",          CLASS_MONSTER   },
+   { "WolfensteinSS",       CLASS_MONSTER   },
+   { "CommanderKeen",       CLASS_MONSTER   },
+   { "BossBrain",           CLASS_MONSTER   },
+   { "MBFHelperDog",        CLASS_MONSTER   },
+   { "Stimpack",            CLASS_HEALTH    },
+   { "Medikit",             CLASS_HEALTH    },
+   { "HealthBonus",         CLASS_HEALTH    },
+   { "Soulsphere",          CLASS_HEALTH    },
+   { "Megasphere",          CLASS_HEALTH    },
+   { "ArmorBonus",          CLASS_ARMOR     },
+   { "GreenArmor",          CLASS_ARMOR     },
+   { "BlueArmor",           CLASS_ARMOR     },
+   { "Clip",                CLASS_AMMO      },
+   { "ClipBox",             CLASS_AMMO      },
+   { "Shell",               CLASS_AMMO      },
+   { "ShellBox",            CLASS_AMMO      },
+   { "RocketAmmo",          CLASS_AMMO      },
+   { "RocketBox",           CLASS_AMMO      },
+   { "Cell",                CLASS_AMMO      },
+   { "CellPack",            CLASS_AMMO      },
+   { "Backpack",            CLASS_AMMO      },
+   { "Fist",                CLASS_WEAPON    },
+   { "Chainsaw",            CLASS_WEAPON    },
+   { "Pistol",              CLASS_WEAPON    },
+   { "Shotgun",             CLASS_WEAPON    },
+   { "SuperShotgun",        CLASS_WEAPON    },
+   { "Chaingun",            CLASS_WEAPON    },
+   { "RocketLauncher",      CLASS_WEAPON    },
+   { "PlasmaRifle",         CLASS_WEAPON    },
+   { "BFG9000",             CLASS_WEAPON    },
+   { "BlueCard",            CLASS_KEY       },
+   { "YellowCard",          CLASS_KEY       },
+   { "RedCard",             CLASS_KEY       },
+   { "BlueSkull",           CLASS_KEY       },
+   { "YellowSkull",         CLASS_KEY       },
+   { "RedSkull",            CLASS_KEY       },
+   { "InvulnerabilitySphere", CLASS_POWERUP },
+   { "Berserk",             CLASS_POWERUP   },
+   { "BlurSphere",          CLASS_POWERUP   },
+   { "RadSuit",             CLASS_POWERUP   },
+   { "Allmap",              CLASS_POWERUP   },
+   { "Infrared",            CLASS_POWERUP   },
+   { "ExplosiveBarrel",     CLASS_HAZARD    },
+
+   // Heretic
+   { "HereticImp",          CLASS_MONSTER   },
+   { "HereticImpLeader",    CLASS_MONSTER   },
+   { "Knight",              CLASS_MONSTER   },
+   { "KnightGhost",         CLASS_MONSTER   },
+   { "Wizard",              CLASS_MONSTER   },
+   { "Mummy",               CLASS_MONSTER   },
+   { "MummyGhost",          CLASS_MONSTER   },
+   { "MummyLeader",         CLASS_MONSTER   },
+   { "MummyLeaderGhost",    CLASS_MONSTER   },
+   { "Clink",               CLASS_MONSTER   },
+   { "Beast",               CLASS_MONSTER   },
+   { "Snake",               CLASS_MONSTER   },
+   { "Ironlich",            CLASS_MONSTER   },
+   { "Minotaur",            CLASS_MONSTER   },
+   { "Sorcerer1",           CLASS_MONSTER   },
+
+   // Hexen
+   { "Ettin",               CLASS_MONSTER   },
+   { "Centaur",             CLASS_MONSTER   },
+   { "CentaurLeader",       CLASS_MONSTER   },
+   { "Demon1",              CLASS_MONSTER   },
+   { "Demon2",              CLASS_MONSTER   },
+   { "FireDemon",           CLASS_MONSTER   },
+   { "Bishop",              CLASS_MONSTER   },
+   { "IceGuy",              CLASS_MONSTER   },
+   { "Serpent",             CLASS_MONSTER   },
+   { "SerpentLeader",       CLASS_MONSTER   },
+   { "Wraith",              CLASS_MONSTER   },
+   { "WraithBuried",        CLASS_MONSTER   },
+   { "Dragon",              CLASS_MONSTER   },
+   { "Korax",               CLASS_MONSTER   },
+   { "FighterBoss",         CLASS_MONSTER   },
+   { "ClericBoss",          CLASS_MONSTER   },
+   { "MageBoss",            CLASS_MONSTER   },
+   { "Heresiarch",          CLASS_MONSTER   },
+   { "Pig",                 CLASS_MONSTER   },
+
+   // Strife
+   { "Acolyte",             CLASS_MONSTER   },
+   { "Sentinel",            CLASS_MONSTER   },
+   { "Stalker",             CLASS_MONSTER   },
+   { "Templar",             CLASS_MONSTER   },
+   { "Reaver",              CLASS_MONSTER   },
+   { "Crusader",            CLASS_MONSTER   },
+   { "Inquisitor",          CLASS_MONSTER   },
+   { "Programmer",          CLASS_MONSTER   },
+   { "Loremaster",          CLASS_MONSTER   },
+   { "StrifeBishop",        CLASS_MONSTER   },
+   { "Oracle",              CLASS_MONSTER   },
+   { "AlienSpectre1",       CLASS_MONSTER   },
+   { "EntityBoss",          CLASS_MONSTER   },
+   { "Peasant",             CLASS_NPC       },
+   { "Beggar",              CLASS_NPC       },
+   { "Merchant",            CLASS_NPC       }
+};
+
+//
+// Find the class of one of the games' own actors. Returns -1 if the name is
+// not one of them.
+//
+static int XL_nativeClass(const char *name)
+{
+   for(size_t i = 0; i < earrlen(xlnatives); i++)
+   {
+      if(!strcasecmp(xlnatives[i].name, name))
+         return xlnatives[i].classtype;
+   }
+   return -1;
+}
+
+//=============================================================================
+//
+// Skip scanning
+//
+// The lumps share C-like comments, strings and braces. Text is always null
+// terminated, and unterminated constructs run to the end.
+//
+
+// Syntax of a lump
+enum
+{
+   XLE_DECORATE,
+   XLE_ZSCRIPT,
+   XLE_MAPINFO  // also allows ; comments, as in Hexen MAPINFO
+};
+
+//
+// Skip a string, from its opening quote to just past its closing quote.
+//
+static const char *XL_skipString(const char *p)
+{
+   for(++p; ; )
+   {
+      p += strcspn(p, "\"\\");
+      if(!*p)
+         return p;
+      if(*p == '"')
+         return p + 1;
+      p += p[1] ? 2 : 1; // escaped character
+   }
+}
+
+//
+// Skip a comment starting with the / at p. Returns p + 1 if it does not
+// start one.
+//
+static const char *XL_skipSlash(const char *p)
+{
+   const char *end;
+
+   if(p[1] == '/')
+      return (end = strchr(p, '\n')) ? end : p + strlen(p);
+   if(p[1] == '*')
+      return (end = strstr(p + 2, "*/")) ? end + 2 : p + strlen(p);
+   return p + 1;
+}
+
+//
+// Skip whitespace and comments.
+//
+static const char *XL_skipBlank(const char *p, int kind)
+{
+   for(;;)
+   {
+      while(ectype::isSpace(*p))
+         ++p;
+
+      if(*p == '/' && (p[1] == '/' || p[1] == '*'))
+         p = XL_skipSlash(p);
+      else if(*p == ';' && kind == XLE_MAPINFO)
+         p += strcspn(p, "\n");
+      else
+         return p;
+   }
+}
+
+//
+// Skip a block from its opening brace to just past the closing brace which
+// matches it, looking only at braces, strings and comments on the way.
+//
+static const char *XL_skipBlock(const char *p)
+{
+   int depth = 0;
+
+   for(;;)
+   {
+      p += strcspn(p, "{}\"/");
+
+      switch(*p)
+      {
+      case '\0':
+         return p;
+      case '{':
+         ++depth;
+         ++p;
+         break;
+      case '}':
+         ++p;
+         if(--depth <= 0)
+            return p;
+         break;
+      case '"':
+         p = XL_skipString(p);
+         break;
+      default:
+         p = XL_skipSlash(p);
+         break;
+      }
+   }
+}
+
+//
+// Read a word, a string, or a single punctuation character at p, which must
+// not be at the end of the text. The word is returned without quotes, and p
+// is left just past it.
+//
+static void XL_readWord(const char *&p, qstring &word)
+{
+   const char *start = p;
+
+   if(*p == '"')
+   {
+      p = XL_skipString(p);
+
+      // leave out the closing quote, if there was one
+      const char *end = (p - start > 1 && p[-1] == '"') ? p - 1 : p;
+      word.copy(start + 1, end - start - 1);
+      return;
+   }
+
+   while(*p && !ectype::isSpace(*p) && !strchr("{}()[]:;,=\"/", *p))
+      ++p;
+   if(p == start)
+      ++p;
+   word.copy(start, p - start);
+}
+
+//
+// True if a word is a whole number.
+//
+static bool XL_isNumber(const qstring &word)
+{
+   const char *s = word.constPtr();
+
+   if(*s == '-')
+      ++s;
+   if(!*s)
+      return false;
+   while(ectype::isDigit(*s))
+      ++s;
+   return !*s;
+}
+
+//=============================================================================
+//
+// Harvester
+//
+
+// An actor or class defined by the archive
+struct xlactor_t
+{
+   char *name;
+   char *parent;    // null if none given
+   int   doomednum; // 0 if none
+};
+
+// A DoomEdNums entry
+struct xlednum_t
+{
+   int   doomednum;
+   char *name;      // null for "none"
+};
+
+class XLEdNumHarvester : public XLParser
+{
+protected:
+   WadDirectory *dir;
+   int           kind;  // syntax of the lump being read
+   int           depth; // of includes
+
+   PODCollection<xlactor_t> actors;
+   PODCollection<xlednum_t> ednums;
+
+   void scan(const char *p);
+   void scanActor(const char *&p, bool record);
+   void scanEdNums(const char *&p);
+   void scanInclude(const char *&p);
+   int  findActor(const char *name) const;
+   int  classForActor(const char *name) const;
+
+   virtual void parseText(const char *text) { scan(text); }
+
+public:
+   XLEdNumHarvester() 
+      : XLParser(""), dir(NULL), kind(XLE_DECORATE), depth(0), actors(), ednums()
+   {
+   }
+   virtual ~XLEdNumHarvester();
+
+   void harvest(WadDirectory &pDir);
+   void addThingDefs();
+};
+
+//
+// XLEdNumHarvester Destructor
+//
+XLEdNumHarvester::~XLEdNumHarvester()
+{
+   for(xlactor_t &actor : actors)
+   {
+      efree(actor.name);
+      if(actor.parent)
+         efree(actor.parent);
+   }
+   for(xlednum_t &ednum : ednums)
+   {
+      if(ednum.name)
+         efree(ednum.name);
+   }
+}
+
+//
+// XLEdNumHarvester::scanActor
+//
+// Read an actor or class header, after its keyword, and skip its body.
+//
+void XLEdNumHarvester::scanActor(const char *&p, bool record)
+{
+   qstring name, parent, word;
+   int     doomednum = 0;
+
+   p = XL_skipBlank(p, kind);
+   if(!*p)
+      return;
+   XL_readWord(p, name);
+
+   for(;;)
+   {
+      p = XL_skipBlank(p, kind);
+
+      if(!*p)
+         break;
+      if(*p == '{')
+      {
+         p = XL_skipBlock(p);
+         break;
+      }
+      if(*p == ';' || *p == '}')
+      {
+         ++p;
+         break;
+      }
+      if(*p == '(')
+      {
+         // ZScript version("...") and the like
+         p += strcspn(p, ")");
+         if(*p)
+            ++p;
+         continue;
+      }
+
+      bool colon = (*p == ':');
+      if(colon)
+      {
+         ++p;
+         if(!*(p = XL_skipBlank(p, kind)))
+            break;
+      }
+      XL_readWord(p, word);
+
+      if(colon)
+         parent = word;
+      else if(!word.strCaseCmp("replaces"))
+      {
+         if(*(p = XL_skipBlank(p, kind)))
+            XL_readWord(p, word);
+      }
+      else if(kind == XLE_DECORATE && XL_isNumber(word))
+         doomednum = word.toInt();
+   }
+
+   const char *first = name.constPtr();
+   if(record && (ectype::isAlpha(*first) || *first == '_'))
+   {
+      xlactor_t &actor = actors.addNew();
+      actor.name      = name.duplicate(PU_STATIC);
+      actor.parent    = parent.length() ? parent.duplicate(PU_STATIC) : NULL;
+      actor.doomednum = doomednum > 0 ? doomednum : 0;
+   }
+}
+
+//
+// XLEdNumHarvester::scanEdNums
+//
+// Read a MAPINFO DoomEdNums block, from its opening brace.
+//
+void XLEdNumHarvester::scanEdNums(const char *&p)
+{
+   qstring word, name;
+
+   ++p;
+   for(;;)
+   {
+      p = XL_skipBlank(p, kind);
+      if(!*p)
+         break;
+      if(*p == '}')
+      {
+         ++p;
+         break;
+      }
+
+      XL_readWord(p, word);
+      if(!XL_isNumber(word))
+         continue;
+      int doomednum = word.toInt();
+
+      p = XL_skipBlank(p, kind);
+      if(*p != '=')
+         continue;
+      p = XL_skipBlank(p + 1, kind);
+      if(!*p || *p == '}')
+         continue;
+      XL_readWord(p, name);
+
+      // skip arguments
+      while(*(p = XL_skipBlank(p, kind)) == ',')
+      {
+         if(*(p = XL_skipBlank(p + 1, kind)))
+            XL_readWord(p, word);
+      }
+
+      xlednum_t &ednum = ednums.addNew();
+      ednum.doomednum = doomednum;
+      ednum.name      = name.strCaseCmp("none") ? name.duplicate(PU_STATIC) : NULL;
+   }
+}
+
+//
+// XLEdNumHarvester::scanInclude
+//
+// Read an included lump, named by the string after the include keyword. The
+// name is a path within a zip, or a lump name.
+//
+void XLEdNumHarvester::scanInclude(const char *&p)
+{
+   qstring path;
+
+   p = XL_skipBlank(p, kind);
+   if(*p != '"')
+      return;
+   XL_readWord(p, path);
+
+   if(depth >= XLE_MAXINCLUDE)
+      return;
+
+   lumpinfo_t **lumpinfo = dir->getLumpInfo();
+   int          numlumps = dir->getNumLumps();
+   int          lumpnum  = -1;
+
+   for(int i = numlumps - 1; i >= 0 && lumpnum < 0; i--)
+   {
+      const char *lfn = lumpinfo[i]->getLFN();
+      if(lfn && !strcasecmp(lfn, path.constPtr()))
+         lumpnum = i;
+   }
+   if(lumpnum < 0 && path.length() <= 8)
+      lumpnum = dir->checkNumForName(path.constPtr());
+   if(lumpnum < 0)
+      return;
+
+   size_t      size = lumpinfo[lumpnum]->size;
+   ZAutoBuffer buf(size + 2, true);
+   dir->readLump(lumpnum, buf.get());
+
+   ++depth;
+   scan(buf.getAs<const char *>());
+   --depth;
+}
+
+//
+// XLEdNumHarvester::scan
+//
+// Read the text of a lump.
+//
+void XLEdNumHarvester::scan(const char *p)
+{
+   qstring word;
+   bool    extend = false; // ZScript extend or mixin class
+
+   for(;;)
+   {
+      p = XL_skipBlank(p, kind);
+
+      if(!*p)
+         break;
+      if(*p == '{')
+      {
+         p = XL_skipBlock(p);
+         extend = false;
+         continue;
+      }
+      if(*p == '#')
+      {
+         ++p;
+         if(*p && !strncasecmp(p, "include", 7))
+         {
+            p += 7;
+            scanInclude(p);
+         }
+         continue;
+      }
+
+      XL_readWord(p, word);
+
+      if(kind == XLE_MAPINFO)
+      {
+         if(!word.strCaseCmp("DoomEdNums"))
+         {
+            if(*(p = XL_skipBlank(p, kind)) == '{')
+               scanEdNums(p);
+         }
+         else if(!word.strCaseCmp("include"))
+            scanInclude(p);
+      }
+      else if(!word.strCaseCmp(kind == XLE_ZSCRIPT ? "class" : "actor"))
+      {
+         scanActor(p, !extend);
+         extend = false;
+      }
+      else
+         extend = (!word.strCaseCmp("extend") || !word.strCaseCmp("mixin"));
+   }
+}
+
+//
+// XLEdNumHarvester::harvest
+//
+// Read the definitions in every DECORATE, ZSCRIPT and MAPINFO lump of a
+// directory, in order. As in ZDoom, MAPINFO is ignored if there is a
+// ZMAPINFO.
+//
+void XLEdNumHarvester::harvest(WadDirectory &pDir)
+{
+   const uint64_t decorate = WadDirectory::LumpNameKey("DECORATE");
+   const uint64_t zscript  = WadDirectory::LumpNameKey("ZSCRIPT");
+   const uint64_t mapinfo  = WadDirectory::LumpNameKey("MAPINFO");
+   const uint64_t zmapinfo = WadDirectory::LumpNameKey("ZMAPINFO");
+
+   lumpinfo_t **lumpinfo = pDir.getLumpInfo();
+   int          numlumps = pDir.getNumLumps();
+   bool         usezmap  = (pDir.checkNumForName("ZMAPINFO") >= 0);
+
+   dir = &pDir;
+
+   for(int i = 0; i < numlumps; i++)
+   {
+      uint64_t key = pDir.getLumpKey(i);
+
+      if(key == decorate)
+         kind = XLE_DECORATE;
+      else if(key == zscript)
+         kind = XLE_ZSCRIPT;
+      else if(key == (usezmap ? zmapinfo : mapinfo))
+         kind = XLE_MAPINFO;
+      else
+         continue;
+
+      if(lumpinfo[i]->li_namespace == lumpinfo_t::ns_global)
+         parseLump(pDir, lumpinfo[i], true);
+   }
+}
+
+//
+// XLEdNumHarvester::findActor
+//
+// Index of the last actor defined with a name, or -1. Actors must be
+// sorted by name.
+//
+int XLEdNumHarvester::findActor(const char *name) const
+{
+   int lo = 0, hi = static_cast<int>(actors.getLength());
+
+   // find the first actor after any with the name
+   while(lo < hi)
+   {
+      int mid = (lo + hi) / 2;
+
+      if(strcasecmp(actors[mid].name, name) <= 0)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+   return (lo > 0 && !strcasecmp(actors[lo - 1].name, name)) ? lo - 1 : -1;
+}
+
+//
+// XLEdNumHarvester::classForActor
+//
+// Find the class of an actor from those it inherits from.
+//
+int XLEdNumHarvester::classForActor(const char *name) const
+{
+   for(int i = 0; i < XLE_MAXPARENTS && name; i++)
+   {
+      int classtype, actor;
+
+      if((classtype = XL_nativeClass(name)) >= 0)
+         return classtype;
+      if((actor = findActor(name)) < 0)
+         break;
+      name = actors[actor].parent;
+   }
+   return CLASS_NONE;
+}
+
+//
+// XLEdNumHarvester::addThingDefs
+//
+// Merge the thingtypes defined into the tables in use. DoomEdNums entries
+// come after actor headers, so that they win, and "none" removes the
+// definitions before it.
+//
+void XLEdNumHarvester::addThingDefs()
+{
+   PODCollection<thingdef_t> defs;
+
+   for(const xlactor_t &actor : actors)
+   {
+      if(actor.doomednum)
+      {
+         thingdef_t &def = defs.addNew();
+         def.doomednum = actor.doomednum;
+         def.name      = actor.name;
+      }
+   }
+   for(const xlednum_t &ednum : ednums)
+   {
+      if(ednum.name)
+      {
+         thingdef_t &def = defs.addNew();
+         def.doomednum = ednum.doomednum;
+         def.name      = ednum.name;
+      }
+      else
+      {
+         for(thingdef_t &def : defs)
+         {
+            if(def.doomednum == ednum.doomednum)
+               def.name = NULL;
+         }
+      }
+   }
+
+   // classes are found by name once the definitions are all in
+   std::stable_sort(actors.begin(), actors.end(),
+                    [] (const xlactor_t &a, const xlactor_t &b) {
+                       return strcasecmp(a.name, b.name) < 0;
+                    });
+
+   PODCollection<thingdef_t> kept;
+   for(thingdef_t &def : defs)
+   {
+      if(def.name)
+      {
+         def.classtype = classForActor(def.name);
+         kept.add(def);
+      }
+   }
+
+   P_AddThingDefs(kept.getLength() ? &kept[0] : NULL, kept.getLength());
+}
+
+//=============================================================================
+//
+// External interface
+//
+
+//
+// Add the thingtypes an archive's DECORATE, ZSCRIPT and MAPINFO lumps
+// define to those in use.
+//
+void XL_HarvestThingDefs(WadDirectory &dir)
+{
+   XLEdNumHarvester harvester;
+
+   harvester.harvest(dir);
+   harvester.addThingDefs();
+}
+
+//
+// Whether an archive has any lumps XL_HarvestThingDefs would read.
+//
+bool XL_HasThingDefs(WadDirectory &dir)
+{
+   static const char *lumpnames[] = { "DECORATE", "ZSCRIPT", "MAPINFO", "ZMAPINFO" };
+
+   for(const char *name : lumpnames)
+   {
+      if(dir.checkNumForName(name) >= 0)
+         return true;
+   }
+   return false;
+}
+
+// EOF
+
@@ -0,0 +1,37 @@
+// Emacs style mode select   -*- C++ -*-
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2015 James Haley et al.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//      Thingtypes defined by DECORATE, ZSCRIPT and MAPINFO lumps
+//
+//-----------------------------------------------------------------------------
+
+#ifndef XL_EDNUMS_H__
+#define XL_EDNUMS_H__
+
+class WadDirectory;
+
+void XL_HarvestThingDefs(WadDirectory &dir);
+bool XL_HasThingDefs(WadDirectory &dir);
+
+#endif
+
+// EOF
+
@@ -30,6 +30,7 @@
 
 #include "z_zone.h"
 
+#include "m_casefold.h"
 #include "m_misc.h"
 #include "w_wad.h"
 #include "xl_scripts.h"
@@ -38,211 +39,280 @@
 //
 // XLTokenizer
 //
-// This class does proper FSA tokenization for Hexen lump parsers.
+// This class does proper FSA tokenization for Hexen lump parsers. Bytes are
+// classified through a table, and runs of whitespace and comments are
+// skipped in bulk.
 //
 
-//
-// Tokenizer States
-//
+// Character classes
+enum
+{
+   XLC_SPACE   = 0x01, // ' ', '\t', '\r'
+   XLC_NEWLINE = 0x02, // '\n'
+   XLC_END     = 0x04, // '\0' and ';', which always end a token
+   XLC_HASH    = 0x08, // '#', a comment with TF_HASHCOMMENTS
+   XLC_SLASH   = 0x10  // '/', a comment with TF_SLASHCOMMENTS if doubled
+};
 
-// Looking for the start of a new token
-void XLTokenizer::doStateScan()
+static const unsigned char xlcharclass[256] =
 {
-   char c = input[idx];
+   // 0x00 - 0x0F: '\0', '\t', '\n', '\r'
+   XLC_END, 0, 0, 0, 0, 0, 0, 0, 0, XLC_SPACE, XLC_NEWLINE, 0, 0, XLC_SPACE, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   // 0x20 - 0x2F: ' ', '#', '/'
+   XLC_SPACE, 0, 0, XLC_HASH, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, XLC_SLASH,
+   // 0x30 - 0x3F: ';'
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, XLC_END, 0, 0, 0, 0
+   // everything else is 0
+};
 
-   switch(c)
-   {
-   case ' ':
-   case '\t':
-   case '\r':
-      // remain in this state
-      break; 
-   case '\n':
-      // if linebreak tokens are enabled, return one now
-      if(flags & TF_LINEBREAKS)
-      {
-         tokentype = TOKEN_LINEBREAK;
-         state     = STATE_DONE;
-      }
-      // otherwise, remain in STATE_SCAN
-      break;
-   case '\0': // end of input
-      tokentype = TOKEN_EOF;
-      state     = STATE_DONE;
-      break;
-   case ';': // start of a comment
-      state = STATE_COMMENT;
-      break;
-   case '"': // start of quoted string
-      tokentype = TOKEN_STRING;
-      state     = STATE_QUOTED;
-      break;
-   default:
-      // anything else is the start of a new token
-      if(c == '#' && (flags & TF_HASHCOMMENTS)) // possible start of hash comment
-      {
-         state = STATE_COMMENT;
-         break;
-      }
-      else if(c == '/' && input[idx+1] == '/' && (flags & TF_SLASHCOMMENTS))
-      {
-         state = STATE_COMMENT;
-         break;
-      }
-      else if(c == '[' && (flags & TF_BRACKETS))
-      {
-         tokentype = TOKEN_BRACKETSTR;
-         state     = STATE_INBRACKETS;
-         break;
-      }
-      else if(c == '$') // detect $ keywords
-         tokentype = TOKEN_KEYWORD;
-      else
-         tokentype = TOKEN_STRING;
-      state = STATE_INTOKEN;
-      token += c;
-      break;
-   }
-}
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XL_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
-// Scanning inside a token
-void XLTokenizer::doStateInToken() 
+// Index of the lowest set bit of a nonzero mask
+static inline int XL_lowestBit(unsigned int mask)
 {
-   char c = input[idx];
-
-   switch(c)
-   {
-   case '\n':
-      if(flags & TF_LINEBREAKS) // if linebreaks are tokens, we need to back up
-         --idx;
-      // fall through
-   case ' ':  // whitespace
-   case '\t':
-   case '\r':
-      // end of token
-      state = STATE_DONE;
-      break;
-   case '\0':  // end of input -OR- start of a comment
-   case ';':   
-      --idx;   // backup, next call will handle it in STATE_SCAN.
-      state = STATE_DONE;
-      break;
-   default: 
-      if(c == '#' && (flags & TF_HASHCOMMENTS))
-      {
-         // hashes may conditionally be supported as comments
-         --idx;
-         state = STATE_DONE;
-         break;
-      }
-      else if(c == '/' && input[idx+1] == '/' && (flags & TF_SLASHCOMMENTS))
-      {
-         // double slashes may conditionally be supported as comments
-         --idx;
-         state = STATE_DONE;
-         break;
-      }
-      token += c;
-      break;
-   }
+#ifdef _MSC_VER
+   unsigned long bit;
+   _BitScanForward(&bit, mask);
+   return static_cast<int>(bit);
+#else
+   return __builtin_ctz(mask);
+#endif
 }
+#endif
 
-// Reading out a bracketed string token
-void XLTokenizer::doStateInBrackets()
+//
+// XL_skipSpace
+//
+// Skip characters in the given classes, which must be whitespace. Once a run
+// reaches a 16-byte boundary, it is scanned a block at a time; aligned loads
+// never cross into another page, so reading past the end of the input is
+// safe.
+//
+static const char *XL_skipSpace(const char *p, unsigned int mask)
 {
-   switch(input[idx])
+#ifdef XL_SSE2
+   while(reinterpret_cast<uintptr_t>(p) & 15)
    {
-   case ']':  // end of bracketed token
-      state = STATE_DONE;
-      break;
-   case '\0': // end of input (technically, malformed)
-      --idx;
-      state = STATE_DONE;
-      break;
-   default:   // anything else is part of the token
-      token += input[idx];
-      break;
+      if(!(xlcharclass[static_cast<unsigned char>(*p)] & mask))
+         return p;
+      ++p;
    }
-}
 
-// Reading out a quoted string token
-void XLTokenizer::doStateQuoted()
-{
-   switch(input[idx])
+   const __m128i spaces   = _mm_set1_epi8(' ');
+   const __m128i tabs     = _mm_set1_epi8('\t');
+   const __m128i returns  = _mm_set1_epi8('\r');
+   const __m128i newlines = (mask & XLC_NEWLINE) ? _mm_set1_epi8('\n') : spaces;
+
+   for(;; p += 16)
    {
-   case '"':  // end of quoted string
-      state = STATE_DONE;
-      break;
-   case '\0': // end of input (technically, this is malformed)
-      --idx;
-      state = STATE_DONE;
-      break;
-   default:
-      token += input[idx];
-      break;
+      __m128i block = _mm_load_si128(reinterpret_cast<const __m128i *>(p));
+      __m128i white = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, spaces),
+                                                _mm_cmpeq_epi8(block, tabs)),
+                                   _mm_or_si128(_mm_cmpeq_epi8(block, returns),
+                                                _mm_cmpeq_epi8(block, newlines)));
+      unsigned int other = ~static_cast<unsigned int>(_mm_movemask_epi8(white)) & 0xFFFF;
+      if(other)
+         return p + XL_lowestBit(other);
    }
+#else
+   while(xlcharclass[static_cast<unsigned char>(*p)] & mask)
+      ++p;
+   return p;
+#endif
 }
 
-// Reading out a single-line comment
-void XLTokenizer::doStateComment()
+//
+// XLTokenizer::setTokenFlags
+//
+// Select optional syntax; see the TF_ flags.
+//
+void XLTokenizer::setTokenFlags(unsigned int pFlags)
 {
-   // consume all input to the end of the line
-   if(input[idx] == '\n')
-   {
-      // if linebreak tokens are enabled, send one now
-      if(flags & TF_LINEBREAKS)
-      {
-         tokentype = TOKEN_LINEBREAK;
-         state     = STATE_DONE;
-      }
-      else
-         state = STATE_SCAN;
-   }
-   else if(input[idx] == '\0') // end of input
-   {
-      tokentype = TOKEN_EOF;
-      state     = STATE_DONE;
-   }
+   flags     = pFlags;
+   spacemask = XLC_SPACE;
+   endmask   = XLC_SPACE | XLC_NEWLINE | XLC_END;
+
+   if(!(flags & TF_LINEBREAKS))
+      spacemask |= XLC_NEWLINE;
+   if(flags & TF_HASHCOMMENTS)
+      endmask |= XLC_HASH;
+   if(flags & TF_SLASHCOMMENTS)
+      endmask |= XLC_SLASH;
 }
 
-// State table for the tokenizer - static array of method pointers :)
-void (XLTokenizer::* XLTokenizer::States[])() =
+//
+// XLTokenizer::skipComment
+//
+// Returns the end of the line a comment starts at p on: its line break, or
+// the end of input.
+//
+const char *XLTokenizer::skipComment(const char *p) const
 {
-   &XLTokenizer::doStateScan,
-   &XLTokenizer::doStateInToken,
-   &XLTokenizer::doStateInBrackets,
-   &XLTokenizer::doStateQuoted,
-   &XLTokenizer::doStateComment
-};
+   const char *nl = strchr(p, '\n');
+   return nl ? nl : p + strlen(p);
+}
 
 //
 // XLTokenizer::getNextToken
 //
 // Call this to retrieve the next token from the input string. The token
 // type is returned for convenience. Get the text of the token using the
-// GetToken() method.
+// getTokenPtr and getTokenLength methods.
 //
 int XLTokenizer::getNextToken()
 {
-   token.clear();
-   state     = STATE_SCAN; // always start out scanning for a new token
-   tokentype = TOKEN_NONE; // nothing has been determined yet
+   const char *p = input + idx;
+
+   tokenlen  = 0;
+   tokentype = TOKEN_NONE;
 
-   // already at end of input?
-   if(input[idx] != '\0')
+   while(tokentype == TOKEN_NONE)
    {
-      while(state != STATE_DONE)
+      p = XL_skipSpace(p, spacemask);
+      tokenptr = p;
+
+      switch(*p)
       {
-         (this->*States[state])();
-         ++idx;
+      case '\0': // end of input
+         tokentype = TOKEN_EOF;
+         break;
+      case '\n': // only reached if linebreak tokens are enabled
+         tokentype = TOKEN_LINEBREAK;
+         ++p;
+         break;
+      case ';': // start of a comment
+         p = skipComment(p);
+         break;
+      case '"': // quoted string
+         {
+            const char *end = strchr(++p, '"');
+            if(!end) // technically, this is malformed
+               end = p + strlen(p);
+            tokentype = TOKEN_STRING;
+            tokenptr  = p;
+            tokenlen  = end - p;
+            p         = *end ? end + 1 : end;
+         }
+         break;
+      case '[':
+         if(flags & TF_BRACKETS)
+         {
+            const char *end = strchr(++p, ']');
+            if(!end) // technically, this is malformed
+               end = p + strlen(p);
+            tokentype = TOKEN_BRACKETSTR;
+            tokenptr  = p;
+            tokenlen  = end - p;
+            p         = *end ? end + 1 : end;
+            break;
+         }
+         goto plain;
+      case '#':
+         if(flags & TF_HASHCOMMENTS)
+         {
+            p = skipComment(p);
+            break;
+         }
+         goto plain;
+      case '/':
+         if(p[1] == '/' && (flags & TF_SLASHCOMMENTS))
+         {
+            p = skipComment(p);
+            break;
+         }
+         goto plain;
+      default:
+      plain:
+         // anything else is the start of a new token, which runs until
+         // whitespace, end of input, or a comment
+         tokentype = (*p == '$') ? TOKEN_KEYWORD : TOKEN_STRING;
+         for(++p; ; ++p)
+         {
+            if(xlcharclass[static_cast<unsigned char>(*p)] & endmask)
+            {
+               if(*p != '/' || p[1] == '/')
+                  break;
+            }
+         }
+         tokenlen = p - tokenptr;
+         break;
       }
    }
-   else
-      tokentype = TOKEN_EOF;
 
+   idx = p - input;
    return tokentype;
 }
 
+//
+// XLTokenizer::tokenIs
+//
+// Case-insensitive comparison of the current token to a string.
+//
+bool XLTokenizer::tokenIs(const char *str) const
+{
+   return !M_FoldCompare(tokenptr, str, tokenlen) && str[tokenlen] == '\0';
+}
+
+//
+// XLTokenizer::tokenToNum
+//
+// Like M_StrToNumLinear: returns the index of the first string matching the
+// current token, or numstrings if none does.
+//
+int XLTokenizer::tokenToNum(const char **strings, int numstrings) const
+{
+   int index = 0;
+
+   while(index != numstrings && !tokenIs(strings[index]))
+      ++index;
+
+   return index;
+}
+
+//
+// XLTokenizer::tokenToInt
+//
+// Returns the current token converted to an integer via atoi.
+//
+int XLTokenizer::tokenToInt() const
+{
+   char   buf[32];
+   size_t len = tokenlen < sizeof(buf) - 1 ? tokenlen : sizeof(buf) - 1;
+
+   memcpy(buf, tokenptr, len);
+   buf[len] = '\0';
+   return atoi(buf);
+}
+
+//
+// XLTokenizer::copyToken
+//
+// Copy the current token into a qstring.
+//
+void XLTokenizer::copyToken(qstring &dest) const
+{
+   dest.copy(tokenptr, tokenlen);
+}
+
+//
+// XLTokenizer::duplicateToken
+//
+// Returns a copy of the current token, allocated from the zone.
+//
+char *XLTokenizer::duplicateToken() const
+{
+   char *str = emalloc(char *, tokenlen + 1);
+   memcpy(str, tokenptr, tokenlen);
+   str[tokenlen] = '\0';
+   return str;
+}
+
 //=============================================================================
 // 
 // XLParser
@@ -250,6 +320,32 @@ int XLTokenizer::getNextToken()
 // Base class for Hexen lump parsers
 //
 
+//
+// XLParser::parseText
+//
+// Tokenizes text, passing each token to doToken.
+//
+void XLParser::parseText(const char *text)
+{
+   XLTokenizer tokenizer(text);
+   bool early = false;
+
+   // allow subclasses to alter properties of the tokenizer now before parsing begins
+   initTokenizer(tokenizer);
+
+   while(tokenizer.getNextToken() != XLTokenizer::TOKEN_EOF)
+   {
+      if(!doToken(tokenizer))
+      {
+         early = true;
+         break; // the subclassed parser wants to stop parsing
+      }
+   }
+
+   // allow subclasses to handle EOF
+   onEOF(early);
+}
+
 //
 // XLParser::parseLump
 //
@@ -275,23 +371,7 @@ void XLParser::parseLump(WadDirectory &dir, lumpinfo_t *lump, bool global)
    lumpdata = ecalloc(char *, 1, lump->size + 2);
    dir.readLump(lump->selfindex, lumpdata);
 
-   XLTokenizer tokenizer(lumpdata);
-   bool early = false;
-
-   // allow subclasses to alter properties of the tokenizer now before parsing begins
-   initTokenizer(tokenizer);
-
-   while(tokenizer.getNextToken() != XLTokenizer::TOKEN_EOF)
-   {
-      if(!doToken(tokenizer))
-      {
-         early = true;
-         break; // the subclassed parser wants to stop parsing
-      }
-   }
-
-   // allow subclasses to handle EOF
-   onEOF(early);
+   parseText(lumpdata);
 }
 
 //
@@ -309,7 +389,7 @@ void XLParser::parseLumpRecursive(WadDirectory &dir, lumpinfo_t *curlump)
       parseLumpRecursive(dir, lumpinfo[curlump->namehash.next]);
 
    // Parse this lump, provided it matches by name and is global
-   if(!strncasecmp(curlump->name, lumpname, 8) &&
+   if(!M_FoldCompare(curlump->name, lumpname, 8) &&
       curlump->li_namespace == lumpinfo_t::ns_global)
       parseLump(dir, curlump, true);
 }
@@ -360,23 +440,7 @@ void XLParser::parseFile(const char *filename)
    if(!lumpdata)
       return;
 
-   XLTokenizer tokenizer(lumpdata);
-   bool early = false;
-
-   // allow subclasses to alter properties of the tokenizer now before parsing begins
-   initTokenizer(tokenizer);
-
-   while(tokenizer.getNextToken() != XLTokenizer::TOKEN_EOF)
-   {
-      if(!doToken(tokenizer))
-      {
-         early = true;
-         break; // the subclassed parser wants to stop parsing
-      }
-   }
-
-   // allow subclasses to handle EOF
-   onEOF(early);
+   parseText(lumpdata);
 }
 
 // EOF
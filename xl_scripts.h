@@ -37,22 +37,13 @@ class  WadDirectory;
 //
 // XLTokenizer
 //
-// Tokenizer used by XLParser
+// Tokenizer used by XLParser. Tokens are returned as views into the input,
+// which must stay loaded and unmodified while they are in use; copy them
+// with copyToken or duplicateToken to keep them longer.
 //
 class XLTokenizer
 {
 public:
-   // Tokenizer states
-   enum
-   {
-      STATE_SCAN,       // scanning for a string token
-      STATE_INTOKEN,    // in a string token
-      STATE_INBRACKETS, // in a bracketed token
-      STATE_QUOTED,     // in a quoted string
-      STATE_COMMENT,    // reading out a comment (eat rest of line)
-      STATE_DONE        // finished the current token
-   };
-
    // Token types
    enum
    {
@@ -76,37 +67,40 @@ public:
    };
 
 protected:
-   int state;          // state of the scanner
-   const char *input;  // input string
-   int idx;            // current position in input string
-   int tokentype;      // type of current token
-   qstring token;      // current token value
-   unsigned int flags; // parser flags
-
-   void doStateScan();
-   void doStateInToken();
-   void doStateInBrackets();
-   void doStateQuoted();
-   void doStateComment();
-
-   // State table declaration
-   static void (XLTokenizer::*States[])();
+   const char  *input;     // input string
+   size_t       idx;       // current position in input string
+   int          tokentype; // type of current token
+   const char  *tokenptr;  // current token, within the input
+   size_t       tokenlen;
+   unsigned int flags;     // parser flags
+   unsigned int spacemask; // character classes skipped between tokens
+   unsigned int endmask;   // character classes which end a plain token
+
+   const char *skipComment(const char *p) const;
 
 public:
    // Constructor / Destructor
    XLTokenizer(const char *str) 
-      : state(STATE_SCAN), input(str), idx(0), tokentype(TOKEN_NONE), token(32),
-        flags(TF_DEFAULT)
+      : input(str), idx(0), tokentype(TOKEN_NONE), tokenptr(str), tokenlen(0),
+        flags(TF_DEFAULT), spacemask(0), endmask(0)
    { 
+      setTokenFlags(TF_DEFAULT);
    }
 
    int getNextToken();
    
    // Accessors
-   int getTokenType() const { return tokentype; }
-   qstring &getToken() { return token; }
+   int         getTokenType()   const { return tokentype; }
+   const char *getTokenPtr()    const { return tokenptr;  }
+   size_t      getTokenLength() const { return tokenlen;  }
+
+   bool  tokenIs(const char *str) const;
+   int   tokenToNum(const char **strings, int numstrings) const;
+   int   tokenToInt() const;
+   void  copyToken(qstring &dest) const;
+   char *duplicateToken() const;
 
-   void setTokenFlags(unsigned int pFlags) { flags = pFlags; }
+   void setTokenFlags(unsigned int pFlags);
 };
 
 //
@@ -128,6 +122,10 @@ protected:
    virtual bool doToken(XLTokenizer &token) { return true; } // called for each token
    virtual void onEOF(bool early) {} // called when EOF is reached
 
+   // Called with the text of each lump or file; tokenizes it by default.
+   // Parsers for other syntax can scan it themselves instead.
+   virtual void parseText(const char *text);
+
    void parseLumpRecursive(WadDirectory &dir, lumpinfo_t *curlump);
 
 public:
@@ -90,6 +90,14 @@ public:
       return buffer;
    }
 
+   // Resize the buffer, keeping as much of its contents as will fit.
+   void *realloc(size_t pSize)
+   {
+      buffer = erealloc(void *, buffer, pSize);
+      size   = pSize;
+      return buffer;
+   }
+
    void  *get()     const { return buffer; }
    size_t getSize() const { return size;   }
 
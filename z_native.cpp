@@ -118,11 +118,14 @@ typedef struct memblock
 // 32-bit. 64-bit will use a 64-byte header.
 static const size_t header_size = (sizeof(memblock_t) + 15) & ~15;
 
-static memblock_t *blockbytag[PU_MAX];   // used for tracking all zone blocks
+// Each thread tracks its own blocks, so that threads can allocate and free
+// without locking. A block must be freed or re-tagged on the thread that
+// allocated it, and must not outlive that thread.
+static THREADLOCAL memblock_t *blockbytag[PU_MAX]; // tracks all zone blocks
 
 // ZoneObject class statics
-ZoneObject *ZoneObject::objectbytag[PU_MAX]; // like blockbytag but for objects
-void       *ZoneObject::newalloc;            // most recent ZoneObject alloc
+THREADLOCAL ZoneObject *ZoneObject::objectbytag[PU_MAX]; // like blockbytag but for objects
+THREADLOCAL void       *ZoneObject::newalloc;            // most recent ZoneObject alloc
 
 //=============================================================================
 //
@@ -212,7 +215,7 @@ static void Z_IDCheck(bool err, const char *errmsg,
 //
 
 // statistics for evaluating performance
-INSTRUMENT(size_t memorybytag[PU_MAX]); // haleyjd 04/02/11: track by tag
+INSTRUMENT(THREADLOCAL size_t memorybytag[PU_MAX]); // haleyjd 04/02/11: track by tag
 INSTRUMENT(int printstats = 0);         // killough 8/23/98
 
 // haleyjd 04/02/11: Instrumentation output has been moved to d_main.cpp and
@@ -672,6 +675,8 @@ int (Z_CheckTag)(void *ptr, const char *file, int line)
 //
 // Z_PrintZoneHeap
 //
+// Only the calling thread's blocks are printed.
+//
 void Z_PrintZoneHeap(void)
 {
    memblock_t *block;
@@ -892,7 +897,8 @@ void Z_SysFree(void *p)
 //
 // Z_FreeAlloca
 //
-// haleyjd 12/06/06: Frees all blocks allocated with Z_Alloca.
+// haleyjd 12/06/06: Frees all blocks allocated with Z_Alloca by the calling
+// thread.
 //
 void Z_FreeAlloca(void)
 {
@@ -190,8 +190,8 @@ class ZoneObject
 {
 private:
    // static data
-   static ZoneObject *objectbytag[PU_MAX];
-   static void *newalloc;
+   static THREADLOCAL ZoneObject *objectbytag[PU_MAX];
+   static THREADLOCAL void *newalloc;
 
    // instance data
    void        *zonealloc; // If non-null, the object is living on the zone heap